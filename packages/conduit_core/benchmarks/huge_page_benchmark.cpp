@@ -0,0 +1,78 @@
+// Large-message throughput with 4KB pages vs huge pages.
+//
+// One publisher and one raw subscriber on the same thread, 4MB messages in
+// a 16-slot (64MB) ring. "first lap" is the first pass over the ring, which
+// pays for page faults; "steady" is the following laps, which are bound by
+// memcpy bandwidth and TLB misses. The subscriber sums one word per cache
+// line so the read side touches every line as a real consumer would.
+//
+// Huge pages need a hugetlbfs mount and a reserved pool, e.g.
+//   echo 64 | sudo tee /proc/sys/vm/nr_hugepages
+// Without them the "huge" run falls back and reports a 4 KB page size.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./huge_page_benchmark
+
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/publisher.hpp"
+#include "conduit_core/subscriber.hpp"
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint32_t DEPTH = 16;
+constexpr uint32_t MESSAGE_SIZE = 4 * 1024 * 1024;
+constexpr int STEADY_LAPS = 20;
+constexpr char TOPIC[] = "bench_huge_pages";
+
+uint64_t consume(const Message& msg) {
+    const auto* words = static_cast<const uint64_t*>(msg.data);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < msg.size / sizeof(uint64_t); i += 8) {
+        sum += words[i];
+    }
+    return sum;
+}
+
+double transfer(internal::Publisher& pub, internal::Subscriber& sub,
+                const std::vector<uint8_t>& payload, int messages, uint64_t& checksum) {
+    auto start = Clock::now();
+    for (int i = 0; i < messages; ++i) {
+        pub.publish(payload.data(), payload.size());
+        if (auto msg = sub.take()) {
+            checksum += consume(*msg);
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(messages) * MESSAGE_SIZE / seconds / 1e9;
+}
+
+void run(const char* label, bool huge_pages) {
+    internal::ShmRegion::unlink(TOPIC);
+
+    internal::Publisher pub(TOPIC, PublisherOptions{DEPTH, MESSAGE_SIZE, huge_pages});
+    internal::Subscriber sub(TOPIC);
+    std::vector<uint8_t> payload(MESSAGE_SIZE, 0x5a);
+
+    uint64_t checksum = 0;
+    double first = transfer(pub, sub, payload, DEPTH, checksum);
+    double steady = transfer(pub, sub, payload, DEPTH * STEADY_LAPS, checksum);
+
+    fmt::print("{:<8} page={:>5} KB  first lap={:6.2f} GB/s  steady={:6.2f} GB/s  (checksum {})\n",
+               label, pub.page_size() / 1024, first, steady, checksum % 1000);
+}
+
+}  // namespace
+
+int main() {
+    run("4KB", false);
+    run("huge", true);
+    return 0;
+}
@@ -0,0 +1,158 @@
+// Cross-socket latency and throughput for every ring placement.
+//
+// The publisher is pinned to the first CPU of node 0. For each NUMA node
+// holding the ring (NumaPolicy::Node) and each node the subscriber runs on,
+// measures:
+//   latency     64-byte messages, publisher waits for each one to arrive
+//   throughput  1 MB messages, subscriber reads every cache line
+//
+// On a single-node machine this prints one row.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./numa_benchmark
+
+#include "conduit_core/internal/numa.hpp"
+#include "conduit_core/internal/scheduling.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/internal/time.hpp"
+#include "conduit_core/publisher.hpp"
+#include "conduit_core/subscriber.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr char TOPIC[] = "bench_numa";
+constexpr int PINGS = 20000;
+constexpr uint32_t LARGE = 1024 * 1024;
+constexpr int LARGE_MESSAGES = 2000;
+
+// First CPU of each node with CPUs, from sysfs
+std::vector<std::pair<int, int>> node_cpus() {
+    std::vector<std::pair<int, int>> result;
+    for (int node = 0; node < 64; ++node) {
+        std::ifstream list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        int cpu;
+        if (list >> cpu) {
+            result.emplace_back(node, cpu);
+        }
+    }
+    if (result.empty()) {
+        result.emplace_back(0, 0);
+    }
+    return result;
+}
+
+void pin(int cpu) {
+    ThreadOptions options;
+    options.cpus = {cpu};
+    internal::apply_thread_options(options);
+}
+
+// Publish with a one-message window: the publisher waits until the
+// subscriber has seen each message, so every sample is a full one-way trip
+double latency_p50_us(int ring_node, int pub_cpu, int sub_cpu) {
+    internal::ShmRegion::unlink(TOPIC);
+    internal::Publisher pub(TOPIC, {.depth = 64, .max_message_size = 64,
+                                    .numa = NumaPolicy::Node, .numa_node = ring_node});
+    internal::Subscriber sub(TOPIC);
+
+    std::atomic<int> received{0};
+    std::vector<uint64_t> samples;
+    samples.reserve(PINGS);
+
+    std::thread reader([&]() {
+        pin(sub_cpu);
+        for (int i = 0; i < PINGS; ++i) {
+            auto msg = sub.wait();
+            uint64_t sent;
+            std::memcpy(&sent, msg.data, sizeof(sent));
+            samples.push_back(internal::get_timestamp_ns() - sent);
+            received.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    pin(pub_cpu);
+    char payload[64] = {};
+    for (int i = 0; i < PINGS; ++i) {
+        uint64_t now = internal::get_timestamp_ns();
+        std::memcpy(payload, &now, sizeof(now));
+        pub.publish(payload, sizeof(payload));
+        while (received.load(std::memory_order_acquire) <= i) {
+            std::this_thread::yield();
+        }
+    }
+    reader.join();
+
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2] / 1000.0;
+}
+
+double throughput_gbs(int ring_node, int pub_cpu, int sub_cpu) {
+    internal::ShmRegion::unlink(TOPIC);
+    internal::Publisher pub(TOPIC, {.depth = 16, .max_message_size = LARGE,
+                                    .numa = NumaPolicy::Node, .numa_node = ring_node});
+    internal::Subscriber sub(TOPIC);
+    std::vector<uint8_t> payload(LARGE, 1);
+
+    std::atomic<int> received{0};
+    std::thread reader([&]() {
+        pin(sub_cpu);
+        uint64_t sum = 0;
+        for (int i = 0; i < LARGE_MESSAGES; ++i) {
+            auto msg = sub.wait();
+            const auto* words = static_cast<const uint64_t*>(msg.data);
+            for (size_t w = 0; w < msg.size / sizeof(uint64_t); w += 8) {
+                sum += words[w];
+            }
+            received.store(i + 1, std::memory_order_release);
+        }
+        (void)sum;
+    });
+
+    pin(pub_cpu);
+    auto start = Clock::now();
+    for (int i = 0; i < LARGE_MESSAGES; ++i) {
+        // Stay less than a ring behind so nothing is dropped
+        while (i - received.load(std::memory_order_acquire) >= 8) {
+            std::this_thread::yield();
+        }
+        pub.publish(payload.data(), payload.size());
+    }
+    reader.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(LARGE_MESSAGES) * LARGE / seconds / 1e9;
+}
+
+}  // namespace
+
+int main() {
+    auto nodes = node_cpus();
+    int pub_cpu = nodes.front().second;
+
+    fmt::print("publisher on node {} (cpu {})\n", nodes.front().first, pub_cpu);
+    for (const auto& [ring_node, ring_cpu] : nodes) {
+        (void)ring_cpu;
+        for (const auto& [sub_node, sub_cpu] : nodes) {
+            fmt::print("ring node {}  subscriber node {}:  latency p50={:7.2f} us  throughput={:6.2f} GB/s\n",
+                       ring_node, sub_node,
+                       latency_p50_us(ring_node, pub_cpu, sub_cpu),
+                       throughput_gbs(ring_node, pub_cpu, sub_cpu));
+        }
+    }
+
+    internal::ShmRegion::unlink(TOPIC);
+    return 0;
+}
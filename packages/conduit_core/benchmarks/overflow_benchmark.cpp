@@ -0,0 +1,91 @@
+// Mixed traffic: ring slots sized for the largest message vs an overflow arena.
+//
+// 99% of the messages are 64 bytes, every 100th is 1MB (say, odometry with
+// an occasional map snapshot). "oversized" gives all 16 slots room for 1MB;
+// "overflow" keeps 4KB slots and puts the large messages in a 4MB arena.
+// Footprint is the shared memory mapped for the topic. Throughput is
+// messages per second through one publisher and one raw subscriber on the
+// same thread; the subscriber sums one word per cache line so large reads
+// cost what they would for a real consumer.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./overflow_benchmark
+
+#include "conduit_core/internal/ring_buffer.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/publisher.hpp"
+#include "conduit_core/subscriber.hpp"
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint32_t DEPTH = 16;
+constexpr uint32_t SMALL_SIZE = 64;
+constexpr uint32_t LARGE_SIZE = 1024 * 1024;
+constexpr int LARGE_EVERY = 100;
+constexpr int MESSAGES = 200000;
+constexpr char TOPIC[] = "bench_overflow";
+
+uint64_t consume(const Message& msg) {
+    const auto* words = static_cast<const uint64_t*>(msg.data);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < msg.size / sizeof(uint64_t); i += 8) {
+        sum += words[i];
+    }
+    return sum;
+}
+
+void run(const char* label, uint32_t max_message_size, uint32_t overflow_size) {
+    internal::ShmRegion::unlink(TOPIC);
+    internal::ShmRegion::unlink(internal::overflow_name(TOPIC));
+
+    PublisherOptions options;
+    options.depth = DEPTH;
+    options.max_message_size = max_message_size;
+    options.overflow_size = overflow_size;
+    internal::Publisher pub(TOPIC, options);
+    internal::Subscriber sub(TOPIC);
+
+    std::vector<uint8_t> small(SMALL_SIZE, 0x11);
+    std::vector<uint8_t> large(LARGE_SIZE, 0x5a);
+
+    uint64_t checksum = 0;
+    uint64_t bytes = 0;
+    int received = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < MESSAGES; ++i) {
+        const auto& payload = i % LARGE_EVERY == 0 ? large : small;
+        pub.publish(payload.data(), payload.size());
+        if (auto msg = sub.take()) {
+            checksum += consume(*msg);
+            bytes += msg->size;
+            ++received;
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    size_t footprint = internal::calculate_region_size(
+        {DEPTH, static_cast<uint32_t>(internal::SLOT_HEADER_SIZE + max_message_size)});
+    if (overflow_size > 0) {
+        footprint += sizeof(internal::OverflowHeader) + overflow_size;
+    }
+
+    fmt::print("{:<10} footprint={:7.2f} MB  {:6.2f} M msg/s  {:6.2f} GB/s  received={} (checksum {})\n",
+               label, static_cast<double>(footprint) / (1024 * 1024), received / seconds / 1e6,
+               static_cast<double>(bytes) / seconds / 1e9, received, checksum % 1000);
+}
+
+}  // namespace
+
+int main() {
+    run("oversized", LARGE_SIZE, 0);
+    run("overflow", 4096, 4 * LARGE_SIZE);
+    return 0;
+}
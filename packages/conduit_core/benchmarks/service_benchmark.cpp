@@ -0,0 +1,88 @@
+// Service round-trip latency: one client, one server thread, 8-byte payloads.
+//
+// Measured with the client sleeping on the futex (spin=0) and busy-polling
+// for up to 50 us before sleeping. The server thread always sleeps when idle,
+// so the sleeping numbers include two futex wakeups per call.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./service_benchmark
+// (use taskset to pin client and server to separate cores)
+
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/service.hpp"
+
+#include <conduit_types/primitives/int.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int WARMUP = 1000;
+constexpr int CALLS = 20000;
+constexpr char SERVICE[] = "bench_service";
+
+void run(const char* label, std::chrono::nanoseconds spin) {
+    internal::ShmRegion::unlink(internal::service_region_name(SERVICE));
+
+    ServiceServer<Int, Int> server(SERVICE, ServiceOptions{16, sizeof(Int), sizeof(Int)});
+    std::atomic<bool> running{true};
+    std::thread serving([&]() {
+        while (running.load(std::memory_order_acquire)) {
+            server.serve_for(std::chrono::milliseconds(10), [](const Int& req) {
+                Int res;
+                res.value = req.value + 1;
+                return res;
+            });
+        }
+    });
+
+    ServiceClient<Int, Int> client(SERVICE, ClientOptions{spin});
+    client.wait_for_service(std::chrono::seconds(1));
+
+    std::vector<double> samples;
+    samples.reserve(CALLS);
+    Int req;
+    req.value = 0;
+
+    for (int i = 0; i < WARMUP + CALLS; ++i) {
+        auto start = Clock::now();
+        auto res = client.call(req, std::chrono::seconds(1));
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (res) {
+            req.value = res->value;
+        }
+        if (i >= WARMUP) {
+            samples.push_back(elapsed);
+        }
+    }
+
+    running.store(false, std::memory_order_release);
+    serving.join();
+
+    std::sort(samples.begin(), samples.end());
+    fmt::print("{:<10} p50={:8.2f} us  p99={:8.2f} us  max={:8.2f} us  ok={}\n",
+               label,
+               samples[samples.size() / 2] / 1000.0,
+               samples[samples.size() * 99 / 100] / 1000.0,
+               samples.back() / 1000.0,
+               req.value == WARMUP + CALLS ? "yes" : "no");
+}
+
+}  // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+
+    run("sleep", 0ns);
+    run("spin 50us", 50us);
+
+    return 0;
+}
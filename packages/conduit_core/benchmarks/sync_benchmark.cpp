@@ -0,0 +1,100 @@
+// Synchronizer matching cost for 3-5 topics, exact and approximate.
+//
+// Each round publishes BATCH messages per topic (IMU-sized, stamped with a
+// header), then times the BATCH take() calls that match them. Publishing is
+// not included in the measurement.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./sync_benchmark
+
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/publisher.hpp"
+#include "conduit_core/synchronizer.hpp"
+
+#include <conduit_types/derived/imu.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr uint32_t DEPTH = 64;
+constexpr int BATCH = 32;
+constexpr int ROUNDS = 2000;
+
+template <size_t N, size_t... Is>
+auto make_sync(const std::array<std::string, N>& topics, const SyncOptions& options,
+               std::index_sequence<Is...>) {
+    return Synchronizer<decltype((void)Is, Imu())...>(topics, options);
+}
+
+template <size_t N>
+void run(const char* label, std::chrono::nanoseconds window, uint64_t jitter_ns) {
+    std::array<std::string, N> topics;
+    std::vector<Publisher<Imu>> pubs;
+    for (size_t i = 0; i < N; ++i) {
+        topics[i] = "bench_sync_" + std::to_string(i);
+        internal::ShmRegion::unlink(topics[i]);
+        pubs.emplace_back(topics[i], PublisherOptions{DEPTH, static_cast<uint32_t>(sizeof(Imu))});
+    }
+
+    auto sync = make_sync<N>(topics, SyncOptions{window}, std::make_index_sequence<N>{});
+
+    std::vector<double> samples;
+    samples.reserve(ROUNDS);
+    uint64_t stamp = 1'000'000;
+    uint64_t matched = 0;
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (int b = 0; b < BATCH; ++b) {
+            stamp += 1'000'000;  // 1 kHz
+            for (size_t i = 0; i < N; ++i) {
+                Imu msg{};
+                msg.header.timestamp_ns = stamp + i * (jitter_ns / N);  // Spread within jitter
+                pubs[i].publish(msg);
+            }
+        }
+
+        auto start = Clock::now();
+        for (int b = 0; b < BATCH; ++b) {
+            if (sync.take()) {
+                ++matched;
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.push_back(elapsed / BATCH);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    fmt::print("{:<12} topics={}  p50={:7.1f} ns  p99={:7.1f} ns  matched={}/{}  dropped={}\n",
+               label, N,
+               samples[samples.size() / 2],
+               samples[samples.size() * 99 / 100],
+               matched, static_cast<uint64_t>(ROUNDS) * BATCH,
+               sync.dropped());
+}
+
+}  // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+
+    run<3>("exact", 0ns, 0);
+    run<4>("exact", 0ns, 0);
+    run<5>("exact", 0ns, 0);
+
+    run<3>("approximate", 200us, 50'000);
+    run<4>("approximate", 200us, 50'000);
+    run<5>("approximate", 200us, 50'000);
+
+    return 0;
+}
@@ -0,0 +1,438 @@
+#pragma once
+
+/// @file async.hpp
+/// @brief C++20 coroutine API: awaitable subscribers, timers and a scheduler.
+///
+/// Requires C++20. Link against `conduit_core::conduit_core_async`; the rest
+/// of conduit_core stays C++17.
+
+#if __cplusplus < 202002L
+#error "conduit_core/async.hpp requires C++20 (link conduit_core::conduit_core_async)"
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "conduit_core/internal/futex.hpp"
+#include "conduit_core/subscriber.hpp"
+
+/// @brief Coroutine-based API for conduit.
+namespace conduit::async {
+
+template <typename T = void>
+class Task;
+
+class Scheduler;
+
+namespace detail {
+
+/// @cond INTERNAL
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // Symmetric transfer back to whoever awaited us
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            auto continuation = h.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+    void return_value(T v) { value.emplace(std::move(v)); }
+    T result() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object();
+    void return_void() {}
+    void result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+/// A suspended coroutine waiting for futex words to change and/or a deadline.
+/// Lives in the awaiting coroutine's frame; the scheduler only keeps a pointer.
+struct WaitNode {
+    const internal::FutexWaitEntry* entries = nullptr;
+    size_t count = 0;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::coroutine_handle<> handle;
+    bool timed_out = false;
+};
+/// @endcond
+
+}  // namespace detail
+
+/// @brief Lazily started coroutine producing a T.
+///
+/// A Task does nothing until it is awaited (or spawned on a Scheduler).
+/// Exceptions propagate to the awaiting coroutine.
+///
+/// @tparam T Result type (void for none).
+template <typename T>
+class Task {
+public:
+    using promise_type = detail::Promise<T>;
+
+    /// @brief Take ownership of a coroutine frame.
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    /// @brief Move constructor.
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    /// @brief Move assignment operator.
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    /// @brief Start the task and suspend until it completes.
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept { return !handle || handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/// @cond INTERNAL
+namespace detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+}  // namespace detail
+/// @endcond
+
+/// @brief Runs coroutines on a small pool of threads.
+///
+/// Suspended tasks cost no thread: tasks waiting for messages are parked on
+/// their topic's futex word, and one worker at a time (the reactor) sleeps
+/// in futex_waitv() on all of them plus every pending timer. Thousands of
+/// tasks can wait on a handful of threads.
+///
+/// @code
+/// Task<void> control(Subscriber<Imu>& imu, Subscriber<Odometry>& odom) {
+///     while (true) {
+///         auto msg = co_await when_any(imu, odom);
+///         // ...
+///     }
+/// }
+///
+/// Scheduler scheduler(2);
+/// scheduler.spawn(control(imu, odom));
+/// scheduler.run();  // until all tasks finish or stop()
+/// @endcode
+class Scheduler {
+public:
+    /// @brief Construct a scheduler.
+    /// @param threads Number of worker threads used by run(), including the caller.
+    explicit Scheduler(size_t threads = 1);
+
+    /// @brief Destroy the scheduler and any tasks that did not finish.
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /// @brief Start a task. It first runs inside run().
+    /// @param task Task to run; its result is discarded and exceptions are logged.
+    void spawn(Task<void> task);
+
+    /// @brief Run tasks until all spawned tasks finish or stop() is called.
+    void run();
+
+    /// @brief Ask run() to return (can be called from any thread or task).
+    void stop();
+
+    /// @brief Scheduler running the calling thread's current task.
+    /// @return The scheduler, or nullptr outside of run().
+    static Scheduler* current();
+
+    /// @brief Queue a suspended coroutine for resumption.
+    /// @param handle Coroutine to resume on a worker thread.
+    void post(std::coroutine_handle<> handle);
+
+    /// @brief Park a coroutine until a futex word changes or its deadline passes.
+    /// @param node Wait description (must stay valid until resumed).
+    void wait(detail::WaitNode* node);
+
+private:
+    struct Root;
+
+    size_t threads_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<size_t> pending_{0};
+
+    // Ready queue
+    std::mutex ready_mutex_;
+    std::deque<std::coroutine_handle<>> ready_;
+
+    // Parked coroutines (owned by their frames)
+    std::mutex waits_mutex_;
+    std::vector<detail::WaitNode*> waits_;
+
+    // Top-level task frames still alive
+    std::mutex roots_mutex_;
+    std::unordered_set<void*> roots_;
+
+    // Idle workers and the reactor sleep on this word
+    std::atomic<uint32_t> wake_word_{0};
+    std::atomic<uint32_t> sleepers_{0};
+    std::atomic<bool> reactor_active_{false};
+
+    // Reactor scratch space (only touched by the active reactor)
+    std::vector<internal::FutexWaitEntry> poll_entries_;
+    std::vector<std::coroutine_handle<>> poll_ready_;
+
+    void worker();
+    void poll();
+    void notify();
+    std::coroutine_handle<> pop_ready();
+    void finish_root(void* address);
+
+    friend Root;
+    static Root run_root(Scheduler* scheduler, Task<void> task);
+};
+
+/// @cond INTERNAL
+namespace detail {
+
+/// Suspends the calling coroutine on a WaitNode of the current scheduler.
+struct WaitAwaiter {
+    WaitNode node;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    bool await_resume() const noexcept { return !node.timed_out; }
+};
+
+}  // namespace detail
+/// @endcond
+
+/// @brief Suspend the current task for a duration without blocking its thread.
+/// @param duration Time to sleep.
+/// @return Awaitable.
+inline detail::WaitAwaiter sleep_for(std::chrono::nanoseconds duration) {
+    detail::WaitAwaiter awaiter;
+    awaiter.node.deadline = std::chrono::steady_clock::now() + duration;
+    return awaiter;
+}
+
+/// @brief Suspend the current task until a point in time.
+/// @param deadline Time to resume at.
+/// @return Awaitable.
+inline detail::WaitAwaiter sleep_until(std::chrono::steady_clock::time_point deadline) {
+    detail::WaitAwaiter awaiter;
+    awaiter.node.deadline = deadline;
+    return awaiter;
+}
+
+/// @brief Let other ready tasks run before continuing.
+/// @return Awaitable.
+inline detail::WaitAwaiter yield() {
+    return sleep_until(std::chrono::steady_clock::time_point::min());
+}
+
+/// @brief Awaitable subscriber for use inside Scheduler tasks.
+///
+/// Wraps internal::Subscriber; waiting parks the task on the ring buffer's
+/// futex word instead of blocking a thread.
+///
+/// @tparam T Message type (FixedMessageType or VariableMessageType).
+template <typename T>
+class Subscriber {
+public:
+    /// @brief Open the topic and claim a reader slot.
+    /// @param topic Topic name.
+    /// @param options Subscriber configuration.
+    /// @throws SubscriberError If the topic cannot be opened or carries another type.
+    explicit Subscriber(const std::string& topic, const SubscriberOptions& options = {})
+        : impl_(topic, options, internal::frame_offset<T>()) {
+        impl_.check_type(internal::type_info_v<T>);
+    }
+
+    /// @brief Non-blocking read of the next message.
+    /// @return The next message, or std::nullopt if none is available.
+    std::optional<TypedMessage<T>> take() {
+        auto msg = impl_.take();
+        if (!msg) return std::nullopt;
+        return TypedMessage<T>{internal::decode_message<T>(*msg), msg->sequence, msg->timestamp_ns};
+    }
+
+    /// @brief Wait for the next message.
+    /// @return Task yielding the message.
+    Task<TypedMessage<T>> next() {
+        while (true) {
+            std::atomic<uint32_t>* word = futex_word();
+            uint32_t seen = word->load(std::memory_order_acquire);
+            if (auto msg = take()) {
+                co_return std::move(*msg);
+            }
+            if (futex_word() != word) {
+                continue;  // take() followed the topic to a new ring: seen is not its value
+            }
+            internal::FutexWaitEntry entry{word, seen};
+            detail::WaitAwaiter awaiter;
+            awaiter.node.entries = &entry;
+            awaiter.node.count = 1;
+            co_await awaiter;
+        }
+    }
+
+    /// @brief Wait for the next message or until timeout expires.
+    /// @param timeout Maximum time to wait.
+    /// @return Task yielding the message, or std::nullopt on timeout.
+    Task<std::optional<TypedMessage<T>>> next_for(std::chrono::nanoseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            std::atomic<uint32_t>* word = futex_word();
+            uint32_t seen = word->load(std::memory_order_acquire);
+            if (auto msg = take()) {
+                co_return msg;
+            }
+            if (futex_word() != word) {
+                continue;
+            }
+            internal::FutexWaitEntry entry{word, seen};
+            detail::WaitAwaiter awaiter;
+            awaiter.node.entries = &entry;
+            awaiter.node.count = 1;
+            awaiter.node.deadline = deadline;
+            if (!co_await awaiter) {
+                co_return take();  // Last chance after the deadline
+            }
+        }
+    }
+
+    /// @brief Futex word of the underlying ring buffer.
+    /// @return Pointer to the word in shared memory.
+    std::atomic<uint32_t>* futex_word() { return impl_.futex_word(); }
+
+    /// @brief Get the topic name.
+    /// @return Reference to the topic string.
+    const std::string& topic() const { return impl_.topic(); }
+
+private:
+    internal::Subscriber impl_;
+};
+
+/// @cond INTERNAL
+namespace detail {
+
+template <size_t I, typename Result, typename T>
+bool take_into(std::optional<Result>& out, Subscriber<T>& sub) {
+    if (auto msg = sub.take()) {
+        out.emplace(std::in_place_index<I>, std::move(*msg));
+        return true;
+    }
+    return false;
+}
+
+template <typename Result, size_t... Is, typename... Ts>
+bool take_any(std::optional<Result>& out, std::index_sequence<Is...>, Subscriber<Ts>&... subs) {
+    return (take_into<Is>(out, subs) || ...);
+}
+
+/// A subscriber whose take() followed its topic to a new ring waits on
+/// another word now; the value loaded from the old one means nothing there.
+template <size_t N, size_t... Is, typename... Ts>
+bool words_moved(const std::array<internal::FutexWaitEntry, N>& entries, std::index_sequence<Is...>,
+                 Subscriber<Ts>&... subs) {
+    return ((entries[Is].futex_word != subs.futex_word()) || ...);
+}
+
+}  // namespace detail
+/// @endcond
+
+/// @brief Wait for the next message on any of several subscribers.
+///
+/// When several subscribers have a message ready, earlier arguments win.
+/// The variant index identifies the subscriber that delivered.
+///
+/// @tparam Ts Message types.
+/// @param subs Subscribers to wait on (at most MAX_FUTEX_WAIT_ENTRIES - 1).
+/// @return Task yielding the message from one subscriber.
+template <typename... Ts>
+Task<std::variant<TypedMessage<Ts>...>> when_any(Subscriber<Ts>&... subs) {
+    using Result = std::variant<TypedMessage<Ts>...>;
+    static_assert(sizeof...(Ts) >= 1, "when_any needs at least one subscriber");
+
+    while (true) {
+        std::array<internal::FutexWaitEntry, sizeof...(Ts)> entries{
+            internal::FutexWaitEntry{subs.futex_word(),
+                                     subs.futex_word()->load(std::memory_order_acquire)}...};
+
+        std::optional<Result> result;
+        if (detail::take_any(result, std::index_sequence_for<Ts...>{}, subs...)) {
+            co_return std::move(*result);
+        }
+        if (detail::words_moved(entries, std::index_sequence_for<Ts...>{}, subs...)) {
+            continue;
+        }
+
+        detail::WaitAwaiter awaiter;
+        awaiter.node.entries = entries.data();
+        awaiter.node.count = entries.size();
+        co_await awaiter;
+    }
+}
+
+}  // namespace conduit::async
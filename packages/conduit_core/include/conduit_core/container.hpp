@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "conduit_core/exceptions.hpp"
+#include "conduit_core/node.hpp"
+
+namespace conduit {
+
+/// @brief Runs several nodes in one process.
+///
+/// Nodes added to a container share an address space, so typed
+/// subscriptions to topics published by another node in the container
+/// receive the publisher's object directly (see SharedMessage) instead of
+/// copying through shared memory. Every topic is still backed by its shm
+/// ring, and processes outside the container see it as usual.
+///
+/// @code
+/// conduit::Container container;
+/// container.add<LidarDriver>();
+/// container.add<GroundFilter>(0.2);
+/// container.add<Clusterer>();
+/// container.run();  // blocks until SIGINT/SIGTERM
+/// @endcode
+///
+/// @see Node
+class Container {
+public:
+    Container() = default;
+    ~Container();
+
+    Container(const Container&) = delete;
+    Container& operator=(const Container&) = delete;
+    Container(Container&&) = delete;
+    Container& operator=(Container&&) = delete;
+
+    /// @brief Construct a node in place and add it to the container.
+    /// @tparam NodeT Node subclass.
+    /// @param args Constructor arguments.
+    /// @return Reference to the new node (owned by the container).
+    /// @throws NodeError If the container is running.
+    template<typename NodeT, typename... Args>
+    NodeT& add(Args&&... args);
+
+    /// @brief Add an already constructed node.
+    /// @param node Node to take ownership of.
+    /// @return Reference to the node.
+    /// @throws NodeError If the container is running or @p node is null.
+    Node& add(std::unique_ptr<Node> node);
+
+    /// @brief Run all nodes, blocking until SIGINT/SIGTERM or stop() is called.
+    ///
+    /// Nodes are started in the order they were added; every publisher is
+    /// created in node constructors, so in-process subscriptions are wired
+    /// up before any thread starts.
+    void run();
+
+    /// @brief Stop the container and all of its nodes.
+    void stop();
+
+    /// @brief Check if the container is currently running.
+    /// @return true if run() has been called and stop() has not yet completed.
+    bool running() const;
+
+    /// @brief Number of nodes in the container.
+    /// @return Node count.
+    size_t size() const { return nodes_.size(); }
+
+private:
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::atomic<bool> running_{false};
+
+    // Signal handling
+    static std::atomic<Container*> active_container_;
+    static void signal_handler(int sig);
+};
+
+template<typename NodeT, typename... Args>
+NodeT& Container::add(Args&&... args) {
+    static_assert(std::is_base_of_v<Node, NodeT>, "NodeT must derive from conduit::Node");
+    auto node = std::make_unique<NodeT>(std::forward<Args>(args)...);
+    NodeT& ref = *node;
+    add(std::unique_ptr<Node>(std::move(node)));
+    return ref;
+}
+
+}  // namespace conduit
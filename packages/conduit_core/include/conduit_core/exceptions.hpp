@@ -35,6 +35,12 @@ public:
     using ConduitError::ConduitError;
 };
 
+/// @brief Error during service creation or a failed service call.
+class ServiceError : public ConduitError {
+public:
+    using ConduitError::ConduitError;
+};
+
 /// @brief Error in Node lifecycle (run, stop, signal handling).
 class NodeError : public ConduitError {
 public:
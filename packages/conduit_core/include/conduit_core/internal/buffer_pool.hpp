@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "conduit_core/internal/ring_buffer.hpp"
+
+namespace conduit {
+namespace internal {
+
+/// Region name suffix of a topic's buffer pool ("lidar@pool").
+constexpr char POOL_SUFFIX[] = "@pool";
+
+/// Free list terminator.
+constexpr uint32_t POOL_NIL = UINT32_MAX;
+
+/// @brief Control block at the start of a buffer pool region.
+struct PoolHeader {
+    uint32_t block_count;  ///< Number of blocks.
+    uint32_t block_size;   ///< Bytes per block (multiple of CACHE_LINE_SIZE).
+    /// Top of the free list: (pop count << 32) | block index. The count
+    /// changes on every pop, so a stale head never compares equal (ABA).
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> free_head;
+};
+
+/// @brief Per-block bookkeeping, one cache line each.
+struct alignas(CACHE_LINE_SIZE) PoolBlock {
+    /// (tag << 32) | reference count. The tag is bumped on every allocation,
+    /// so a handle to an earlier use of the block no longer matches.
+    std::atomic<uint64_t> state;
+    /// Next free block while this one is on the free list.
+    std::atomic<uint32_t> next_free;
+};
+
+/// @brief Fixed-size blocks in shared memory, shared by reference count.
+///
+/// Memory layout:
+/// @code
+///   ┌────────────────────────────────────────┐
+///   │  PoolHeader                            │
+///   ├────────────────────────────────────────┤
+///   │  PoolBlock[0..block_count-1]           │  state, next_free
+///   ├────────────────────────────────────────┤
+///   │  Block 0 data (block_size bytes)       │
+///   │  ...                                   │
+///   └────────────────────────────────────────┘
+/// @endcode
+///
+/// A publisher allocates a block, fills it in place and publishes its
+/// BlockHandle through the ring. Readers take a reference while they use
+/// the block; the block goes back to the lock-free free list when the last
+/// reference is released. Like RingBufferWriter this is a view on memory
+/// owned by a ShmRegion.
+class BufferPool {
+public:
+    /// @brief Calculate the region size needed for a pool.
+    /// @param block_count Number of blocks.
+    /// @param block_size Minimum bytes per block (rounded up to a cache line).
+    /// @return Total bytes for the region.
+    static size_t calculate_region_size(uint32_t block_count, uint32_t block_size);
+
+    /// @brief Initialize a new pool: all blocks free.
+    /// @param region Start of the pool region.
+    /// @param block_count Number of blocks.
+    /// @param block_size Minimum bytes per block (rounded up to a cache line).
+    static void initialize(void* region, uint32_t block_count, uint32_t block_size);
+
+    /// @brief Attach to an initialized pool.
+    /// @param region Start of the pool region.
+    explicit BufferPool(void* region);
+
+    /// @brief Take a free block, holding one reference to it.
+    /// @param size Message size recorded in the handle.
+    /// @return Handle, or nullopt if all blocks are in use or size exceeds block_size().
+    std::optional<BlockHandle> allocate(size_t size);
+
+    /// @brief Take another reference to a block, if the handle is still current.
+    /// @param handle Handle read from a ring slot.
+    /// @return false if the block has since been released and reused.
+    bool try_acquire(const BlockHandle& handle);
+
+    /// @brief Drop a reference; the last one puts the block back on the free list.
+    /// @param handle Handle the reference was taken with.
+    void release(const BlockHandle& handle);
+
+    /// @brief Check that a handle still refers to the current use of its block.
+    /// @param handle Handle read from a ring slot.
+    /// @return true if the block has not been released and reused since.
+    bool valid(const BlockHandle& handle) const;
+
+    /// @brief Start of a block's data.
+    /// @param index Block index.
+    /// @return Pointer to block_size() bytes.
+    uint8_t* data(uint32_t index) const { return data_ + static_cast<size_t>(index) * header_->block_size; }
+
+    /// @brief Bytes per block.
+    uint32_t block_size() const { return header_->block_size; }
+
+    /// @brief Number of blocks.
+    uint32_t block_count() const { return header_->block_count; }
+
+    /// @brief Count the blocks on the free list (racy; for tools and tests).
+    /// @return Number of free blocks.
+    uint32_t free_count() const;
+
+private:
+    PoolHeader* header_;
+    PoolBlock* blocks_;
+    uint8_t* data_;
+
+    void push_free(uint32_t index);
+};
+
+/// @brief Region name of a topic's buffer pool.
+/// @param topic Topic name.
+/// @return e.g. "lidar@pool".
+inline std::string pool_name(const std::string& topic) {
+    return topic + POOL_SUFFIX;
+}
+
+}  // namespace internal
+}  // namespace conduit
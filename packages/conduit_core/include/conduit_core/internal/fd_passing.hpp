@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace conduit {
+namespace internal {
+
+/// @brief Hands a file descriptor to every process that connects.
+///
+/// Listens on the abstract Unix socket `@conduit/{name}` and sends @p fd to
+/// each client via `SCM_RIGHTS`. Abstract sockets have no file: the name is
+/// released as soon as the listening process exits, even on a crash, and is
+/// scoped to the network namespace, so containers do not collide.
+///
+/// @see receive_fd, ShmRegion::create_memfd
+class FdServer {
+public:
+    /// @brief Start serving @p fd under @p name.
+    /// @param name Registry name (becomes `@conduit/{name}`).
+    /// @param fd File descriptor to hand out. Owned (closed) by the server.
+    /// @throws ShmError If the name is taken or the socket cannot be created.
+    FdServer(const std::string& name, int fd);
+
+    FdServer(const FdServer&) = delete;
+    FdServer& operator=(const FdServer&) = delete;
+
+    /// @brief Stop serving, join the accept thread and close both descriptors.
+    ~FdServer();
+
+private:
+    void serve();
+
+    int fd_;
+    int listen_fd_;
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+};
+
+/// @brief Fetch the file descriptor served under @p name.
+/// @param name Registry name passed to FdServer.
+/// @return The received descriptor (close-on-exec), or -1 if nobody serves @p name.
+int receive_fd(const std::string& name);
+
+/// @brief Check whether an FdServer is listening under @p name.
+/// @param name Registry name.
+/// @return true if a connection succeeds.
+bool fd_server_exists(const std::string& name);
+
+}  // namespace internal
+}  // namespace conduit
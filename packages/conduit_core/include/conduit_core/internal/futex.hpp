@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 
@@ -40,4 +41,29 @@ int futex_wake(std::atomic<uint32_t>* futex_word, int count = 1);
 /// @return Number of waiters actually woken.
 int futex_wake_all(std::atomic<uint32_t>* futex_word);
 
+/// @brief One futex word and the value it is expected to hold, for futex_wait_any().
+struct FutexWaitEntry {
+    std::atomic<uint32_t>* futex_word;  ///< Word to watch.
+    uint32_t expected_value;            ///< Sleep only while the word holds this value.
+};
+
+/// Maximum number of entries accepted by futex_wait_any() (kernel limit).
+constexpr size_t MAX_FUTEX_WAIT_ENTRIES = 128;
+
+/// @brief Wait until any of several futex words changes.
+///
+/// Wraps the Linux `futex_waitv` syscall (5.16+). On older kernels it falls
+/// back to waiting on the first entry in slices of at most 1 ms, so callers
+/// must re-check every word after returning, just as with futex_wait().
+///
+/// @param entries Words to watch (at most MAX_FUTEX_WAIT_ENTRIES).
+/// @param count Number of entries.
+/// @param timeout Optional maximum wait duration. std::nullopt means wait forever.
+/// @return true if woken or a word already differed, false on timeout.
+bool futex_wait_any(
+    const FutexWaitEntry* entries,
+    size_t count,
+    std::optional<std::chrono::nanoseconds> timeout = std::nullopt
+);
+
 }  // namespace conduit::internal
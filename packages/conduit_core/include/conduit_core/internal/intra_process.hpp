@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace conduit::internal {
+
+/// @brief A message handed between a publisher and subscriber in the same process.
+///
+/// The payload is the publisher's object itself, shared rather than copied.
+struct IntraProcessMessage {
+    std::shared_ptr<const void> data;  ///< Type-erased pointer to the published object.
+    uint64_t sequence;                 ///< Per-topic intra-process sequence number.
+    uint64_t timestamp_ns;             ///< CLOCK_MONOTONIC_RAW timestamp in nanoseconds.
+};
+
+/// @brief Bounded per-subscriber queue of intra-process messages.
+///
+/// Mirrors the ring buffer's lossy semantics: when full, the oldest message
+/// is dropped. The consumer sleeps on a process-private futex word, and the
+/// producer only issues a wake syscall when the consumer is actually asleep.
+class IntraProcessQueue {
+public:
+    /// @brief Construct a queue holding at most @p depth messages.
+    /// @param depth Queue capacity (at least 1).
+    explicit IntraProcessQueue(size_t depth);
+
+    /// @brief Enqueue a message, dropping the oldest if the queue is full.
+    /// @param msg Message to enqueue.
+    void push(IntraProcessMessage msg);
+
+    /// @brief Non-blocking dequeue.
+    /// @return The oldest message, or std::nullopt if the queue is empty.
+    std::optional<IntraProcessMessage> try_pop();
+
+    /// @brief Block until a message is available or timeout expires.
+    /// @param timeout Maximum time to wait.
+    /// @return The oldest message, or std::nullopt on timeout.
+    std::optional<IntraProcessMessage> wait_for(std::chrono::nanoseconds timeout);
+
+private:
+    std::mutex mutex_;
+    std::vector<IntraProcessMessage> buffer_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    std::atomic<uint32_t> futex_word_{0};
+    std::atomic<bool> sleeping_{false};
+};
+
+/// @brief Delivery point for one topic's in-process subscribers.
+///
+/// Owned jointly by the IntraProcessManager registry and the publisher.
+class IntraProcessChannel {
+public:
+    /// @brief Construct a channel carrying objects of the given type.
+    /// @param type Published C++ type.
+    /// @param depth Queue depth given to each attached subscriber.
+    IntraProcessChannel(std::type_index type, size_t depth) : type_(type), depth_(depth) {}
+
+    /// @brief Published C++ type.
+    /// @return Type index of the publisher's message type.
+    std::type_index type() const { return type_; }
+
+    /// @brief Queue depth for subscribers (the publisher's ring depth).
+    /// @return Number of messages a subscriber queue holds.
+    size_t depth() const { return depth_; }
+
+    /// @brief Check whether any in-process subscriber is attached (lock-free).
+    /// @return true if deliver() would reach at least one queue.
+    bool has_subscribers() const {
+        return subscriber_count_.load(std::memory_order_acquire) > 0;
+    }
+
+    /// @brief Hand a message to every attached subscriber queue.
+    /// @param data Shared pointer to the published object.
+    /// @param timestamp_ns Publish timestamp.
+    void deliver(std::shared_ptr<const void> data, uint64_t timestamp_ns);
+
+    /// @brief Attach a subscriber queue.
+    /// @param queue Queue to receive future messages.
+    void attach(std::shared_ptr<IntraProcessQueue> queue);
+
+    /// @brief Detach a subscriber queue.
+    /// @param queue Queue previously passed to attach().
+    void detach(const std::shared_ptr<IntraProcessQueue>& queue);
+
+private:
+    std::type_index type_;
+    size_t depth_;
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<IntraProcessQueue>> queues_;
+    std::atomic<size_t> subscriber_count_{0};
+    uint64_t sequence_ = 0;
+};
+
+/// @brief Process-wide registry of topics published from this process.
+///
+/// Publishers register a channel on construction; subscribers in the same
+/// process look it up to bypass shared memory entirely.
+class IntraProcessManager {
+public:
+    /// @brief Access the process-wide instance.
+    /// @return Singleton manager.
+    static IntraProcessManager& instance();
+
+    /// @brief Register an in-process publisher for @p topic.
+    /// @param topic Topic name.
+    /// @param type Published C++ type.
+    /// @param depth Queue depth for subscribers.
+    /// @return Channel the publisher delivers through.
+    std::shared_ptr<IntraProcessChannel> advertise(const std::string& topic,
+                                                   std::type_index type, size_t depth);
+
+    /// @brief Remove a publisher's channel from the registry.
+    /// @param topic Topic name.
+    /// @param channel Channel returned by advertise().
+    void unadvertise(const std::string& topic, const std::shared_ptr<IntraProcessChannel>& channel);
+
+    /// @brief Find the channel for @p topic if it carries @p type.
+    /// @param topic Topic name.
+    /// @param type Expected C++ type.
+    /// @return The channel, or nullptr if there is no matching in-process publisher.
+    std::shared_ptr<IntraProcessChannel> find(const std::string& topic, std::type_index type);
+
+private:
+    IntraProcessManager() = default;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<IntraProcessChannel>> channels_;
+};
+
+/// @brief RAII registration of an in-process publisher channel.
+///
+/// Held by Publisher<T>; unregisters the channel when destroyed.
+class IntraProcessPublisher {
+public:
+    /// @brief Register a channel for @p topic.
+    /// @param topic Topic name.
+    /// @param type Published C++ type.
+    /// @param depth Queue depth for subscribers.
+    IntraProcessPublisher(const std::string& topic, std::type_index type, size_t depth)
+        : topic_(topic),
+          channel_(IntraProcessManager::instance().advertise(topic, type, depth)) {}
+
+    /// @brief Move constructor.
+    IntraProcessPublisher(IntraProcessPublisher&&) noexcept = default;
+    /// @brief Move assignment operator.
+    IntraProcessPublisher& operator=(IntraProcessPublisher&& other) noexcept {
+        if (this != &other) {
+            reset();
+            topic_ = std::move(other.topic_);
+            channel_ = std::move(other.channel_);
+        }
+        return *this;
+    }
+    IntraProcessPublisher(const IntraProcessPublisher&) = delete;
+    IntraProcessPublisher& operator=(const IntraProcessPublisher&) = delete;
+
+    ~IntraProcessPublisher() { reset(); }
+
+    /// @brief Check whether any in-process subscriber is attached.
+    /// @return true if deliver() would reach at least one subscriber.
+    bool has_subscribers() const { return channel_ && channel_->has_subscribers(); }
+
+    /// @brief Hand a message to all in-process subscribers.
+    /// @param data Shared pointer to the published object.
+    /// @param timestamp_ns Publish timestamp.
+    void deliver(std::shared_ptr<const void> data, uint64_t timestamp_ns) {
+        channel_->deliver(std::move(data), timestamp_ns);
+    }
+
+private:
+    void reset() {
+        if (channel_) {
+            IntraProcessManager::instance().unadvertise(topic_, channel_);
+            channel_.reset();
+        }
+    }
+
+    std::string topic_;
+    std::shared_ptr<IntraProcessChannel> channel_;
+};
+
+}  // namespace conduit::internal
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+
+namespace conduit::internal {
+
+/// @brief NUMA node of the CPU the calling thread is running on.
+/// @return Node index (0 on single-node machines or if unknown).
+int current_numa_node();
+
+/// @brief Prefer allocating the pages of a mapping on one NUMA node.
+///
+/// Wraps `mbind(MPOL_PREFERRED)`. For shared memory the policy belongs to
+/// the shared object, so it also applies to pages first touched by other
+/// processes. Pages already allocated stay put unless @p move is set. Then
+/// all of them are migrated if the process has CAP_SYS_NICE, otherwise
+/// only those no other process maps. Logs a warning on failure.
+///
+/// @param addr Page-aligned start of the mapping.
+/// @param len Length in bytes.
+/// @param node Target NUMA node.
+/// @param move Also migrate pages that are already allocated.
+/// @return true if the policy was applied.
+bool prefer_numa_node(void* addr, size_t len, int node, bool move = false);
+
+/// @brief Count the resident pages of a mapping per NUMA node.
+///
+/// Uses `move_pages()` in query mode. Resident pages are read once so they
+/// are mapped in the caller; pages nobody has touched are not allocated.
+///
+/// @param addr Page-aligned start of the mapping.
+/// @param len Length in bytes.
+/// @param page_size Page size of the mapping.
+/// @return Page count per node; key -1 counts pages not yet allocated.
+///         Empty if the kernel does not support the query.
+std::map<int, size_t> numa_page_nodes(const void* addr, size_t len, size_t page_size);
+
+}  // namespace conduit::internal
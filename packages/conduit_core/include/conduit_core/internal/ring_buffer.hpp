@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
 
 namespace conduit {
 namespace internal {
@@ -31,12 +32,131 @@ struct RingBufferConfig {
     uint32_t slot_size;     ///< Bytes per slot (including slot header).
 };
 
+/// @brief Slot payload of a message stored in a BufferPool block.
+struct BlockHandle {
+    uint32_t index;  ///< Block index in the pool.
+    uint32_t tag;    ///< Allocation count of the block when it was handed out.
+    uint64_t size;   ///< Message size in bytes.
+};
+
 /// @brief Result of a successful ring buffer read.
 struct ReadResult {
     const void* data;       ///< Pointer to payload within the slot.
     size_t size;            ///< Payload size in bytes.
     uint64_t sequence;      ///< Message sequence number.
     uint64_t timestamp_ns;  ///< CLOCK_MONOTONIC_RAW timestamp in nanoseconds.
+    /// Pool block holding the payload, if it was published from a BufferPool.
+    /// data is only valid while the caller holds a reference (BufferPool::try_acquire).
+    std::optional<BlockHandle> block = std::nullopt;
+};
+
+/// Size of the frame name matched by ReadFilter (same as Header::frame).
+constexpr size_t FILTER_FRAME_SIZE = 64;
+
+/// @brief Read-side predicate applied before a message is returned.
+///
+/// A message is delivered only if all configured conditions hold. Messages
+/// that fail are consumed silently.
+struct ReadFilter {
+    /// Deliver a message only if its sequence is at least the last delivered one + decimation.
+    uint32_t decimation = 1;
+    /// Deliver a message only if published at least this long after the last
+    /// delivered one. The newest message is kept instead and delivered once
+    /// the interval has passed.
+    uint64_t min_interval_ns = 0;
+    /// Payload offset of a null-terminated frame name, or -1 for no frame match.
+    int32_t frame_offset = -1;
+    /// Frame name to match at frame_offset.
+    char frame[FILTER_FRAME_SIZE] = {};
+    /// Skip straight to the newest message on each read, dropping the backlog.
+    bool latest = false;
+
+    /// @brief Check whether any condition is configured.
+    /// @return true if the filter can reject messages.
+    bool active() const { return decimation > 1 || min_interval_ns > 0 || frame_offset >= 0 || latest; }
+};
+
+/// @brief Wake conditions a filtered reader publishes for the writer.
+///
+/// The writer evaluates them after each write and bumps @c futex_word only
+/// for readers that will accept the message, so filtered readers are not
+/// woken for messages they would discard.
+struct alignas(CACHE_LINE_SIZE) ReaderWake {
+    std::atomic<uint32_t> futex_word;          ///< Bumped when a matching message is written.
+    int32_t frame_offset;                      ///< ReadFilter::frame_offset.
+    std::atomic<uint64_t> next_sequence;       ///< Lowest sequence the reader will accept.
+    std::atomic<uint64_t> next_timestamp_ns;   ///< Earliest publish time the reader will accept.
+    char frame[FILTER_FRAME_SIZE];             ///< ReadFilter::frame.
+    uint64_t block_timeout_ns;                 ///< How long the writer waits for a reliable reader.
+};
+
+/// Separates a topic name from its ring generation in region names ("camera@2").
+constexpr char GENERATION_SEPARATOR = '@';
+
+/// Region name suffix of a topic's overflow arena ("camera@overflow").
+constexpr char OVERFLOW_SUFFIX[] = "@overflow";
+
+/// Set in a slot's size field when the slot holds an OverflowDescriptor.
+constexpr uint32_t OVERFLOW_FLAG = 0x80000000u;
+
+/// Set in a slot's size field when the slot holds a BlockHandle.
+constexpr uint32_t POOL_FLAG = 0x40000000u;
+
+/// Flag bits of a slot's size field; messages must be smaller than the lowest.
+constexpr uint32_t SIZE_FLAGS = OVERFLOW_FLAG | POOL_FLAG;
+
+/// Alignment of messages in the overflow arena.
+constexpr size_t OVERFLOW_ALIGNMENT = CACHE_LINE_SIZE;
+
+/// @brief Control block at the start of a topic's overflow arena.
+///
+/// The arena holds messages too large for a ring slot. It is a circular
+/// byte log: the writer appends each message at the next aligned offset
+/// (wrapping to 0 when the rest does not fit) and the ring slot carries an
+/// OverflowDescriptor pointing at it.
+struct OverflowHeader {
+    uint64_t capacity;  ///< Bytes in the data area, which follows this header.
+    /// Total bytes ever reserved (monotonic). Arena offset = reserved % capacity.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> reserved;
+};
+
+/// @brief Slot payload of a message stored in the overflow arena.
+struct OverflowDescriptor {
+    uint64_t position;  ///< Start of the message in the arena's reserved count.
+    uint64_t size;      ///< Message size in bytes.
+};
+
+/// Size of TopicInfo::type_name, including the terminator.
+constexpr size_t TYPE_NAME_SIZE = 128;
+
+/// Size of TopicInfo::publisher_name (same as a Linux thread name).
+constexpr size_t PROCESS_NAME_SIZE = 16;
+
+/// Length of the window TopicStats rates are measured over.
+constexpr uint64_t STATS_WINDOW_NS = 1'000'000'000;
+
+/// @brief Publish statistics, kept by the writer next to write_idx.
+///
+/// Only the writer stores to these (relaxed); tools read them without
+/// subscribing. The rate fields describe the last completed window of at
+/// least STATS_WINDOW_NS, so they are up to one window old.
+struct TopicStats {
+    std::atomic<uint64_t> bytes_written;    ///< Payload bytes written since creation.
+    std::atomic<uint64_t> last_write_ns;    ///< Timestamp of the newest message (CLOCK_MONOTONIC_RAW).
+    std::atomic<uint64_t> window_messages;  ///< Messages written in the last window.
+    std::atomic<uint64_t> window_bytes;     ///< Payload bytes written in the last window.
+    std::atomic<uint64_t> window_ns;        ///< Length of the last window (0 = none completed yet).
+};
+
+/// @brief Topic metadata written once by the publisher before initialize().
+struct alignas(CACHE_LINE_SIZE) TopicInfo {
+    char type_name[TYPE_NAME_SIZE];           ///< Message type name (empty = untyped publisher).
+    uint64_t type_hash;                       ///< Type fingerprint checked by typed subscribers (0 = untyped).
+    uint64_t layout_hash;                     ///< Layout part of the fingerprint (TypeInfo::layout).
+    uint32_t type_size;                       ///< sizeof(T) for fixed types, 0 otherwise.
+    int32_t publisher_pid;                    ///< Process ID of the publisher.
+    uint64_t created_ns;                      ///< Creation time (CLOCK_REALTIME, ns since epoch).
+    char publisher_name[PROCESS_NAME_SIZE];   ///< Publisher process name (/proc/self/comm).
 };
 
 /// @brief Cache-line-aligned atomic uint64_t to prevent false sharing.
@@ -57,12 +177,22 @@ struct alignas(CACHE_LINE_SIZE) AlignedAtomicU64 {
 ///   │  ┌──────────────────────────────────┐  │
 ///   │  │ config (immutable after init)    │  │
 ///   │  │  slot_count, slot_size, etc.     │  │
+///   │  │  generation, start_idx           │  │
+///   │  │  overflow_capacity, pool_blocks  │  │
 ///   │  ├──────────────────────────────────┤  │  aligned 64B
-///   │  │ write_idx (writer only)          │  │
+///   │  │ write_idx + stats (writer only)  │  │
 ///   │  ├──────────────────────────────────┤  │  aligned 64B
 ///   │  │ subscriber_mask + futex_word     │  │
+///   │  │  + filtered_mask                 │  │
+///   │  │  + next_generation               │  │
+///   │  │  + reliable_mask + space_word    │  │
+///   │  │  + writer_blocked                │  │
 ///   │  ├──────────────────────────────────┤  │  aligned 64B
 ///   │  │ read_idx[0..MAX_SUBSCRIBERS-1]   │  │  each aligned 64B
+///   │  ├──────────────────────────────────┤  │
+///   │  │ reader_wake[0..MAX_SUBSCRIBERS-1]│  │  each 128B
+///   │  ├──────────────────────────────────┤  │
+///   │  │ info (type, publisher, created)  │  │
 ///   │  └──────────────────────────────────┘  │
 ///   ├────────────────────────────────────────┤
 ///   │  Slot[0]: [hdr 20B | payload ...]     │
@@ -76,20 +206,67 @@ struct RingBufferHeader {
     uint32_t slot_count;        ///< Number of slots.
     uint32_t slot_size;         ///< Bytes per slot.
     uint32_t max_subscribers;   ///< Maximum reader slots.
-    uint32_t padding0;          ///< Padding for alignment.
+    uint32_t numa_policy;       ///< NUMA placement requested by the publisher (NumaPolicy).
+    uint32_t generation;        ///< Which ring of the topic this is (0 = the original, see Publisher::resize).
+    uint32_t pool_blocks;       ///< Blocks in the topic's buffer pool (0 = none).
+    uint64_t start_idx;         ///< First write index of this ring (continues the previous generation).
+    uint64_t overflow_capacity; ///< Size of the topic's overflow arena (0 = none).
 
     /// Writer's next write index (own cache line to avoid false sharing).
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> write_idx;
+    /// Publish statistics (same cache line as write_idx, which the writer owns).
+    TopicStats stats;
 
     /// Bitmask of claimed subscriber slots (own cache line).
     alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> subscriber_mask;
     /// Futex word used for subscriber wake signaling.
     std::atomic<uint32_t> futex_word;
+    /// Bitmask of readers with a ReadFilter; they sleep on reader_wake[i] instead.
+    std::atomic<uint32_t> filtered_mask;
+    /// Generation of the ring that replaced this one (0 = this ring is current).
+    /// The original ring (generation 0) always names the newest generation.
+    std::atomic<uint32_t> next_generation;
+    /// Bitmask of reliable readers: the writer does not overwrite a message
+    /// they have not read, for up to their reader_wake[i].block_timeout_ns.
+    std::atomic<uint32_t> reliable_mask;
+    /// Futex word a blocked writer sleeps on; reliable readers bump it.
+    std::atomic<uint32_t> space_word;
+    /// Non-zero while the writer waits for a reliable reader.
+    std::atomic<uint32_t> writer_blocked;
 
     /// Per-reader current read index (each on own cache line).
     alignas(CACHE_LINE_SIZE) AlignedAtomicU64 read_idx[MAX_SUBSCRIBERS];
+
+    /// Per-reader wake conditions (filtered readers) and block timeouts (reliable readers).
+    ReaderWake reader_wake[MAX_SUBSCRIBERS];
+
+    /// Topic metadata (immutable after init).
+    TopicInfo info;
 };
 
+/// @brief Region name of one generation of a topic's ring.
+/// @param topic Topic name.
+/// @param generation Ring generation (0 = the original ring).
+/// @return @p topic for generation 0, otherwise e.g. "camera@2".
+inline std::string generation_name(const std::string& topic, uint32_t generation) {
+    if (generation == 0) {
+        return topic;
+    }
+    return topic + GENERATION_SEPARATOR + std::to_string(generation);
+}
+
+/// @brief Region name of a topic's overflow arena.
+/// @param topic Topic name.
+/// @return e.g. "camera@overflow".
+inline std::string overflow_name(const std::string& topic) {
+    return topic + OVERFLOW_SUFFIX;
+}
+
+/// @brief Initialize the control block of a new overflow arena.
+/// @param region Start of the arena region.
+/// @param region_size Total region size, including the OverflowHeader.
+void initialize_overflow(void* region, size_t region_size);
+
 /// @brief Check if n is a power of two.
 /// @param n Value to check.
 /// @return true if n is a power of two.
@@ -104,6 +281,8 @@ inline size_t calculate_region_size(const RingBufferConfig& config) {
     return sizeof(RingBufferHeader) + static_cast<size_t>(config.slot_count) * config.slot_size;
 }
 
+class BufferPool;
+
 /// @brief Writer side of the lock-free SPMC ring buffer.
 ///
 /// There is exactly one writer per topic. The writer initializes the shared
@@ -120,28 +299,94 @@ public:
     RingBufferWriter(void* region, size_t region_size, const RingBufferConfig& config);
 
     /// @brief Initialize the ring buffer header in shared memory.
-    void initialize();
+    ///
+    /// Leaves header()->info alone: the publisher fills it in beforehand,
+    /// so it is published by the same release fence.
+    ///
+    /// @param generation Generation number of this ring (0 = the topic's first ring).
+    /// @param start_idx First write index; a replacement ring continues the
+    ///        sequence numbers of the ring it replaces.
+    void initialize(uint32_t generation = 0, uint64_t start_idx = 0);
+
+    /// @brief Mark this ring as replaced and wake every reader.
+    ///
+    /// Call after the new ring is initialized and no longer write to this
+    /// one. Readers drain what is left, then move to the new ring.
+    ///
+    /// @param next_generation Generation of the replacement ring.
+    void retire(uint32_t next_generation);
+
+    /// @brief Store messages too large for a slot in an overflow arena.
+    ///
+    /// Call before initialize(), which records the arena's capacity in the
+    /// header so readers know to map it.
+    ///
+    /// @param region Overflow arena, set up with initialize_overflow().
+    void set_overflow(void* region);
 
     /// @brief Write a message to the next slot in the ring buffer.
     ///
     /// Automatically timestamps the message with CLOCK_MONOTONIC_RAW,
     /// increments the sequence number, and wakes waiting subscribers.
+    /// Messages larger than a slot go to the overflow arena, if one is set.
     ///
     /// @param data Pointer to the payload.
     /// @param len Payload size in bytes.
-    /// @return true if written, false if len exceeds the slot's payload capacity.
+    /// @return true if written, false if len exceeds both the slot's payload
+    ///         capacity and the overflow arena.
     bool try_write(const void* data, size_t len);
 
+    /// @brief Record the topic's buffer pool in the header.
+    ///
+    /// Call before initialize(), like set_overflow().
+    ///
+    /// @param pool Pool that try_write_block() handles refer to.
+    void set_pool(BufferPool* pool);
+
+    /// @brief Publish a filled pool block: the slot only gets its handle.
+    ///
+    /// The ring does not take a reference; the caller keeps the block alive
+    /// until the slot is overwritten.
+    ///
+    /// @param handle Block from the pool passed to set_pool().
+    /// @return true if written, false if the handle does not fit a slot.
+    bool try_write_block(const BlockHandle& handle);
+
     /// @brief Access the ring buffer header.
     /// @return Pointer to the header in shared memory.
     RingBufferHeader* header() { return header_; }
 
+    /// @brief Number of writes that gave up waiting for a reliable reader.
+    uint64_t reliable_timeouts() const { return reliable_timeouts_; }
+
 private:
     RingBufferHeader* header_;
     uint8_t* slots_;
     uint32_t slot_size_;
     uint32_t slot_count_;
     uint32_t slot_count_mask_;
+
+    /// Reliable readers that timed out; not waited for again until they catch up.
+    uint32_t lapped_readers_ = 0;
+    uint64_t reliable_timeouts_ = 0;
+
+    OverflowHeader* overflow_ = nullptr;
+    uint8_t* overflow_data_ = nullptr;
+    BufferPool* pool_ = nullptr;
+
+    // Statistics bookkeeping (writer-local copies of TopicStats)
+    uint64_t bytes_written_ = 0;
+    uint64_t window_start_ns_ = 0;
+    uint64_t window_start_idx_ = 0;
+    uint64_t window_start_bytes_ = 0;
+
+    void update_stats(uint64_t idx, uint64_t timestamp_ns, size_t len);
+    void wait_for_readers(uint64_t idx);
+    const uint8_t* write_overflow(const void* data, size_t len, OverflowDescriptor& descriptor);
+    void write_slot(const void* record, size_t record_len, uint32_t size_field,
+                    const uint8_t* payload, size_t len);
+    void wake_filtered(uint32_t filtered, uint64_t sequence, uint64_t timestamp_ns,
+                       const uint8_t* payload, size_t len);
 };
 
 /// @brief Reader side of the lock-free SPMC ring buffer.
@@ -163,27 +408,126 @@ public:
     /// @return Slot index (0..MAX_SUBSCRIBERS-1), or -1 if all slots are taken.
     int claim_slot();
 
+    /// @brief Map the topic's overflow arena for messages stored outside the slots.
+    ///
+    /// Without it, such messages are skipped.
+    ///
+    /// @param region Overflow arena (header()->overflow_capacity != 0).
+    void set_overflow(const void* region);
+
+    /// @brief Map the topic's buffer pool for messages published from blocks.
+    ///
+    /// Without it, such messages are skipped. Reads of pool messages carry
+    /// ReadResult::block; the data is only safe to use after taking a
+    /// reference with BufferPool::try_acquire().
+    ///
+    /// @param pool Pool of the topic (header()->pool_blocks != 0).
+    void set_pool(const BufferPool* pool);
+
+    /// @brief Move a reader's position.
+    ///
+    /// Used when a reader moves over from a retired ring, to continue where
+    /// it left off. Clamped to the messages this ring has seen.
+    ///
+    /// @param slot Reader slot index from claim_slot().
+    /// @param idx Index of the next message to read.
+    void seek(int slot, uint64_t idx);
+
+    /// @brief Index of the next message the reader will read.
+    /// @param slot Reader slot index.
+    /// @return Current read index.
+    uint64_t position(int slot) const;
+
+    /// @brief Check whether the ring was replaced and the reader has read all of it.
+    /// @param slot Reader slot index.
+    /// @return true if the reader should move to header()->next_generation.
+    bool retired(int slot) const;
+
     /// @brief Release a previously claimed subscriber slot.
     /// @param slot Slot index to release.
     void release_slot(int slot);
 
+    /// @brief Make this a reliable reader: the writer does not overwrite
+    ///        messages it has not read yet.
+    ///
+    /// A write that would lap the reader waits until it catches up, for at
+    /// most @p timeout; after that the writer overwrites as usual and does
+    /// not wait for this reader again until it has caught up. The message
+    /// last returned by try_read() is protected too, so it stays valid
+    /// until the next read. Call once, right after claim_slot().
+    ///
+    /// @param slot Reader slot index from claim_slot().
+    /// @param timeout Longest time a write waits for this reader.
+    void set_reliable(int slot, std::chrono::nanoseconds timeout);
+
+    /// @brief Filter messages returned by try_read(), wait() and wait_for().
+    ///
+    /// Also publishes the filter's wake conditions in shared memory, so the
+    /// writer stops waking this reader for messages it would discard. Call
+    /// once, right after claim_slot().
+    ///
+    /// @param slot Reader slot index from claim_slot().
+    /// @param filter Conditions a message must meet (inactive filters are ignored).
+    void set_filter(int slot, const ReadFilter& filter);
+
     /// @brief Non-blocking read of the next message.
+    ///
+    /// With a filter set, messages that fail it are consumed and skipped.
+    ///
     /// @param slot Reader slot index from claim_slot().
     /// @return The next message, or std::nullopt if no new message is available.
     std::optional<ReadResult> try_read(int slot);
 
+    /// @brief Futex word bumped when a message for this reader is written.
+    ///
+    /// The ring's shared futex_word, or the reader's own word when a filter
+    /// is set.
+    ///
+    /// @param slot Reader slot index.
+    /// @return Pointer to the futex word in shared memory.
+    std::atomic<uint32_t>* wake_word(int slot);
+
+    /// @brief Look at a message ahead of the reader's position without consuming it.
+    ///
+    /// Ignores the filter.
+    ///
+    /// The returned pointer refers to the slot in shared memory and stays
+    /// valid until the writer laps it. If the writer has already lapped the
+    /// reader, the read position is first moved to the oldest available
+    /// message, as in try_read(). A next unread message whose pool block was
+    /// already reused is consumed and skipped, also as in try_read().
+    ///
+    /// @param slot Reader slot index from claim_slot().
+    /// @param offset Messages past the current read position (0 = next unread).
+    /// @return The message, or std::nullopt if it has not been written yet.
+    std::optional<ReadResult> peek(int slot, uint64_t offset = 0);
+
+    /// @brief Consume messages without reading them.
+    /// @param slot Reader slot index from claim_slot().
+    /// @param count Number of messages to skip (clamped to the write position).
+    void advance(int slot, uint64_t count = 1);
+
+    /// @brief Block until peek(slot) succeeds or timeout expires.
+    /// @param slot Reader slot index.
+    /// @param timeout Maximum time to wait.
+    /// @return The next unread message (not consumed), or std::nullopt on
+    ///         timeout or once the ring is retired and drained.
+    std::optional<ReadResult> wait_peek_for(int slot, std::chrono::nanoseconds timeout);
+
     /// @brief Block until a message is available (waits forever).
     ///
     /// Uses futex-based signaling for zero CPU usage while idle.
     ///
     /// @param slot Reader slot index.
-    /// @return The next message, or std::nullopt on spurious wakeup.
+    /// @return The next message, or std::nullopt on spurious wakeup or
+    ///         once the ring is retired and drained.
     std::optional<ReadResult> wait(int slot);
 
     /// @brief Block until a message is available or timeout expires.
     /// @param slot Reader slot index.
     /// @param timeout Maximum time to wait.
-    /// @return The next message, or std::nullopt on timeout.
+    /// @return The next message, or std::nullopt on timeout or once the
+    ///         ring is retired and drained.
     std::optional<ReadResult> wait_for(int slot, std::chrono::nanoseconds timeout);
 
     /// @brief Access the ring buffer header.
@@ -195,6 +539,23 @@ private:
     uint8_t* slots_;
     uint32_t slot_size_;
     uint32_t slot_count_mask_;
+    ReadFilter filter_;
+    bool filtered_ = false;
+    bool reliable_ = false;
+    /// When the message left unread for min_interval is due (0 = none).
+    uint64_t pending_ns_ = 0;
+    const OverflowHeader* overflow_ = nullptr;
+    const uint8_t* overflow_data_ = nullptr;
+    const BufferPool* pool_ = nullptr;
+
+    bool resolve_overflow(ReadResult& result) const;
+    bool resolve_block(ReadResult& result) const;
+    bool resolve(uint32_t size, ReadResult& result) const;
+    std::optional<ReadResult> read_next(int slot);
+    void skip_to_newest(int slot);
+    void store_position(int slot, uint64_t idx);
+    bool accept(int slot, const ReadResult& result);
+    std::chrono::nanoseconds until_pending(std::chrono::nanoseconds limit) const;
 };
 
 }  // namespace internal
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "conduit_core/scheduling.hpp"
+
+namespace conduit::internal {
+
+/// @brief Apply affinity and scheduling options to the calling thread.
+///
+/// Affinity is applied first, then the scheduling policy. Each failure is
+/// logged as a warning; the thread keeps running either way.
+///
+/// @param options Options to apply. Default-constructed options are a no-op.
+/// @return true if every requested setting was applied.
+bool apply_thread_options(const ThreadOptions& options);
+
+/// @brief Lock all current and future pages of the process into RAM.
+///
+/// Wraps `mlockall(MCL_CURRENT | MCL_FUTURE)` so that ring buffer pages and
+/// thread stacks never page-fault after startup. Logs a warning on failure
+/// (typically EPERM or RLIMIT_MEMLOCK too low).
+///
+/// @return true if memory was locked.
+bool lock_memory();
+
+}  // namespace conduit::internal
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "conduit_core/internal/ring_buffer.hpp"
+
+namespace conduit {
+namespace internal {
+
+/// Maximum number of clients connected to one service at a time.
+constexpr size_t MAX_SERVICE_CLIENTS = 32;
+
+/// @brief Size of each request slot's header in bytes.
+///
+/// Request slot header layout:
+/// @code
+///   ┌────────────────┬─────────────┬───────────┬─────────────────┬────────────────┐
+///   │ sequence (8B)  │ client (4B) │ size (4B) │ request_id (8B) │ timestamp (8B) │  = 32 bytes
+///   └────────────────┴─────────────┴───────────┴─────────────────┴────────────────┘
+/// @endcode
+constexpr size_t REQUEST_HEADER_SIZE = 32;
+
+/// @brief Outcome of a service call, stored with each response.
+enum class ServiceStatus : uint32_t {
+    Ok = 0,               ///< Handler returned a response.
+    HandlerError = 1,     ///< Handler threw an exception.
+    ResponseTooLarge = 2  ///< Response exceeded max_response_size.
+};
+
+/// @brief Service channel configuration.
+struct ServiceConfig {
+    uint32_t queue_depth;        ///< Request slots (must be power of 2).
+    uint32_t max_request_size;   ///< Maximum request payload in bytes.
+    uint32_t max_response_size;  ///< Maximum response payload in bytes.
+};
+
+/// @brief A request dequeued by the server.
+struct ServiceRequest {
+    const void* data;       ///< Pointer to payload in the request slot (valid until finish()).
+    size_t size;            ///< Payload size in bytes.
+    uint32_t client;        ///< Client slot the response goes to.
+    uint64_t request_id;    ///< Unique id, echoed in the response.
+    uint64_t timestamp_ns;  ///< When the client sent the request.
+};
+
+/// @brief Per-client response slot header, followed by the response payload.
+///
+/// Each client has exactly one call in flight, so a single slot per client
+/// is enough. @c futex_word is bumped after every response.
+struct alignas(CACHE_LINE_SIZE) ServiceResponseSlot {
+    std::atomic<uint32_t> futex_word;  ///< Bumped by the server after each response.
+    std::atomic<uint32_t> waiting;     ///< Non-zero while the client sleeps on futex_word.
+    uint32_t status;                   ///< ServiceStatus of the last response.
+    uint32_t size;                     ///< Response payload size in bytes.
+    std::atomic<uint64_t> request_id;  ///< Request this response answers (stored last).
+};
+
+/// @brief Shared memory layout for a service channel.
+///
+/// @code
+///   ┌────────────────────────────────────────┐  offset 0
+///   │  ServiceHeader                         │
+///   │   config, enqueue_idx, dequeue_idx,    │
+///   │   client_mask, request futex           │
+///   ├────────────────────────────────────────┤
+///   │  Request[0..queue_depth-1]             │  [hdr 32B | payload ...]
+///   ├────────────────────────────────────────┤
+///   │  Response[0..MAX_SERVICE_CLIENTS-1]    │  [ServiceResponseSlot | payload ...]
+///   └────────────────────────────────────────┘
+/// @endcode
+struct ServiceHeader {
+    // Configuration (immutable after init)
+    uint32_t queue_depth;         ///< Number of request slots.
+    uint32_t request_slot_size;   ///< Bytes per request slot (header + payload).
+    uint32_t response_slot_size;  ///< Bytes per response slot (header + payload).
+    uint32_t max_clients;         ///< Number of response slots.
+
+    /// Next request slot to claim (shared by all clients).
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> enqueue_idx;
+
+    /// Next request slot to serve (server only).
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> dequeue_idx;
+
+    /// Bitmask of claimed client slots (own cache line).
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> client_mask;
+    /// Bumped after every enqueued request; the server sleeps on it.
+    std::atomic<uint32_t> request_futex;
+    /// Non-zero while the server sleeps on request_futex.
+    std::atomic<uint32_t> server_waiting;
+    /// Source of request ids, unique across all clients of the service.
+    std::atomic<uint64_t> next_request_id;
+};
+
+/// @brief Calculate total shared memory region size for a service channel.
+/// @param config Service configuration.
+/// @return Total size in bytes (header + request slots + response slots).
+size_t calculate_service_region_size(const ServiceConfig& config);
+
+/// @brief Server side of a service channel.
+///
+/// Requests from all clients go through one bounded MPSC queue; each
+/// response is written into the calling client's own response slot.
+///
+/// @see ServiceChannelClient
+class ServiceChannelServer {
+public:
+    /// @brief Construct a server over a shared memory region.
+    /// @param region Pointer to the shared memory region.
+    /// @param region_size Total size of the region in bytes.
+    /// @param config Service configuration (queue_depth must be power of 2).
+    ServiceChannelServer(void* region, size_t region_size, const ServiceConfig& config);
+
+    /// @brief Initialize the header and request slots in shared memory.
+    void initialize();
+
+    /// @brief Non-blocking dequeue of the next request.
+    ///
+    /// The request stays in its slot until finish() is called, so exactly
+    /// one request can be in progress at a time.
+    ///
+    /// @return The request, or std::nullopt if the queue is empty.
+    std::optional<ServiceRequest> try_receive();
+
+    /// @brief Block until a request is available or timeout expires.
+    /// @param timeout Maximum time to wait.
+    /// @return The request, or std::nullopt on timeout.
+    std::optional<ServiceRequest> wait_for(std::chrono::nanoseconds timeout);
+
+    /// @brief Response payload buffer of a client slot.
+    /// @param client Client slot index from the request.
+    /// @return Pointer to max_response_size writable bytes.
+    void* response_buffer(uint32_t client);
+
+    /// @brief Publish the response written into response_buffer() and release the request slot.
+    /// @param request The request being answered.
+    /// @param status Outcome of the call.
+    /// @param size Response payload size in bytes (ignored unless status is Ok).
+    void finish(const ServiceRequest& request, ServiceStatus status, size_t size);
+
+    /// @brief Access the service header.
+    /// @return Pointer to the header in shared memory.
+    ServiceHeader* header() { return header_; }
+
+private:
+    ServiceHeader* header_;
+    uint8_t* requests_;
+    uint8_t* responses_;
+    ServiceConfig config_;
+    uint32_t request_slot_size_;
+    uint32_t response_slot_size_;
+};
+
+/// @brief Client side of a service channel.
+///
+/// Each client claims one of MAX_SERVICE_CLIENTS response slots and has at
+/// most one call in flight.
+///
+/// @see ServiceChannelServer
+class ServiceChannelClient {
+public:
+    /// @brief Construct a client over an existing, initialized service region.
+    /// @param region Pointer to the shared memory region.
+    /// @param region_size Total size of the region in bytes.
+    ServiceChannelClient(void* region, size_t region_size);
+
+    /// @brief Claim a client slot.
+    /// @return Slot index, or -1 if all slots are taken.
+    int claim_slot();
+
+    /// @brief Release a previously claimed client slot.
+    /// @param slot Slot index to release.
+    void release_slot(int slot);
+
+    /// @brief Enqueue a request and wake the server.
+    /// @param slot Client slot index.
+    /// @param data Request payload.
+    /// @param size Payload size in bytes.
+    /// @return Id the response will carry, or std::nullopt if the queue is full
+    ///         or the payload exceeds max_request_size().
+    std::optional<uint64_t> try_send(int slot, const void* data, size_t size);
+
+    /// @brief Wait for the response to @p request_id.
+    ///
+    /// Responses to earlier, timed-out requests are skipped.
+    ///
+    /// @param slot Client slot index.
+    /// @param request_id Request to wait for.
+    /// @param deadline Give up at this time.
+    /// @param spin Busy-poll this long before sleeping on the futex.
+    /// @return The response slot, or nullptr on timeout.
+    const ServiceResponseSlot* wait_response(int slot, uint64_t request_id,
+                                             std::chrono::steady_clock::time_point deadline,
+                                             std::chrono::nanoseconds spin);
+
+    /// @brief Response payload of a client slot.
+    /// @param slot Client slot index.
+    /// @return Pointer to the payload following the slot header.
+    const void* response_data(int slot) const;
+
+    /// @brief Maximum request payload in bytes.
+    uint32_t max_request_size() const { return header_->request_slot_size - REQUEST_HEADER_SIZE; }
+
+    /// @brief Access the service header.
+    /// @return Pointer to the header in shared memory.
+    ServiceHeader* header() { return header_; }
+
+private:
+    ServiceHeader* header_;
+    uint8_t* requests_;
+    uint8_t* responses_;
+    uint32_t request_slot_size_;
+    uint32_t response_slot_size_;
+    uint32_t queue_mask_;
+
+    ServiceResponseSlot* response_slot(int slot) const;
+};
+
+}  // namespace internal
+}  // namespace conduit
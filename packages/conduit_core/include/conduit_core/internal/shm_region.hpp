@@ -3,11 +3,15 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <memory>
+#include <optional>
 #include <string>
 
 namespace conduit {
 namespace internal {
 
+class FdServer;
+
 /// @brief RAII wrapper for a POSIX shared memory region.
 ///
 /// Provides factory methods to create (publisher) or open (subscriber)
@@ -16,15 +20,43 @@ namespace internal {
 /// the shared memory file is **not** unlinked automatically — call
 /// unlink() explicitly when the topic is retired.
 ///
+/// Regions from create_memfd() have no file at all: subscribers receive the
+/// memfd from the publisher over a Unix socket (see FdServer), and the
+/// memory is freed when the last user exits, even after a crash.
+///
+/// A newly created region reads as zeros, but its pages are only faulted in
+/// on first touch; use prefault() to pay that cost up front.
+///
 /// @see Publisher, Subscriber
 class ShmRegion {
 public:
     /// @brief Create a new shared memory region (used by publishers).
+    ///
+    /// With @p huge_pages, the region is placed on the hugetlbfs mount from
+    /// huge_page_dir() and the size is rounded up to a whole huge page. If
+    /// there is no mount or not enough free huge pages, the region silently
+    /// falls back to `/dev/shm`; check page_size() to see which one was used.
+    ///
     /// @param name Region name (becomes `/dev/shm/conduit_{name}`).
     /// @param size Size in bytes.
+    /// @param huge_pages Back the region with huge pages if possible.
     /// @return A mapped ShmRegion.
     /// @throws ShmError If shm_open or mmap fails.
-    static ShmRegion create(const std::string& name, size_t size);
+    static ShmRegion create(const std::string& name, size_t size, bool huge_pages = false);
+
+    /// @brief Create an anonymous, sealed region backed by memfd_create().
+    ///
+    /// The size is sealed (`F_SEAL_SHRINK`, `F_SEAL_GROW`), so readers can
+    /// never be hit by SIGBUS from a truncated mapping. The fd is served
+    /// under @p name until this region is destroyed; open(), exists() and
+    /// the CLI tools find it like any other topic.
+    ///
+    /// @param name Region name (served as `@conduit/{name}`).
+    /// @param size Size in bytes.
+    /// @param huge_pages Try `MFD_HUGETLB` first, falling back to normal pages.
+    /// @return A mapped ShmRegion.
+    /// @throws ShmError If the name is taken or memfd_create/mmap fails.
+    static ShmRegion create_memfd(const std::string& name, size_t size, bool huge_pages = false);
 
     /// @brief Open an existing shared memory region (used by subscribers).
     /// @param name Region name.
@@ -47,9 +79,20 @@ public:
                                   std::chrono::milliseconds poll_interval = std::chrono::milliseconds(100));
 
     /// @brief Remove the shared memory file from the filesystem.
+    ///
+    /// Memfd regions have no file and need no unlink.
+    ///
     /// @param name Region name.
     static void unlink(const std::string& name);
 
+    /// @brief Directory used for huge-page-backed regions.
+    ///
+    /// The `CONDUIT_HUGETLBFS` environment variable if set (empty disables
+    /// huge pages), otherwise the first hugetlbfs mount in `/proc/mounts`.
+    ///
+    /// @return Directory path, or an empty string if none is available.
+    static std::string huge_page_dir();
+
     /// @brief Move constructor.
     ShmRegion(ShmRegion&& other) noexcept;
     /// @brief Move assignment operator.
@@ -60,6 +103,18 @@ public:
     /// @brief Destructor. Unmaps the memory region (does **not** unlink).
     ~ShmRegion();
 
+    /// @brief Fault in every page of the mapping ahead of time.
+    ///
+    /// Avoids first-touch page faults on the hot path. Uses
+    /// `MADV_POPULATE_READ`/`MADV_POPULATE_WRITE` where available and falls
+    /// back to touching one byte per page.
+    ///
+    /// @param write Populate pages writable. The fallback rewrites one byte
+    ///        per page, so only the region's single writer should pass true.
+    /// @param threads Split the region across this many threads (the
+    ///        caller plus threads - 1 helpers). Useful for rings of 100s of MB.
+    void prefault(bool write = false, unsigned threads = 1);
+
     /// @brief Get a writable pointer to the mapped memory.
     /// @return Pointer to the start of the region.
     void* data() { return data_; }
@@ -76,12 +131,20 @@ public:
     /// @return Reference to the name string.
     const std::string& name() const { return name_; }
 
+    /// @brief Get the page size backing the region.
+    /// @return Page size in bytes (e.g. 4096, or 2 MB for huge pages).
+    size_t page_size() const { return page_size_; }
+
 private:
-    ShmRegion(const std::string& name, void* data, size_t size);
+    ShmRegion(const std::string& name, void* data, size_t size, size_t page_size);
+
+    static std::optional<ShmRegion> create_huge(const std::string& name, size_t size);
 
     std::string name_;
     void* data_;
     size_t size_;
+    size_t page_size_;
+    std::unique_ptr<FdServer> server_;  ///< Serves the memfd (create_memfd only).
 };
 
 }  // namespace internal
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <conduit_types/fixed_message_type.hpp>
+#include <conduit_types/header.hpp>
+
+namespace conduit::internal {
+
+/// @brief Message type fingerprint recorded in a topic's header.
+///
+/// All fields are compile-time constants (see type_info_v), so checking
+/// them costs nothing after construction.
+struct TypeInfo {
+    std::string_view name;  ///< Qualified type name, e.g. "conduit::Imu" (empty = untyped).
+    uint64_t hash = 0;      ///< Fingerprint of name and layout (0 = untyped).
+    uint64_t layout = 0;    ///< Hash of the layout alone (see type_info_v).
+    uint32_t size = 0;      ///< sizeof(T) for fixed types, 0 for variable types.
+};
+
+/// @brief 64-bit FNV-1a hash, usable at compile time.
+/// @param data Bytes to hash.
+/// @param hash Running hash (defaults to the FNV offset basis).
+/// @return Updated hash.
+constexpr uint64_t fnv1a(std::string_view data, uint64_t hash = 0xcbf29ce484222325ull) {
+    for (char c : data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/// @brief Mix an integer into an FNV-1a hash, one byte at a time.
+/// @param value Value to mix in.
+/// @param hash Running hash.
+/// @return Updated hash.
+constexpr uint64_t fnv1a(uint64_t value, uint64_t hash) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (8 * i)) & 0xff;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/// @brief Qualified name of T, extracted from the compiler's function signature.
+/// @tparam T Any type.
+/// @return Name such as "conduit::Imu".
+template <typename T>
+constexpr std::string_view type_name() {
+    // GCC: "... type_name() [with T = conduit::Imu; std::string_view = ...]"
+    // Clang: "... type_name() [T = conduit::Imu]"
+    std::string_view signature = __PRETTY_FUNCTION__;
+    size_t start = signature.find("T = ") + 4;
+    size_t end = signature.find_first_of(";]", start);
+    return signature.substr(start, end - start);
+}
+
+/// @cond INTERNAL
+template <typename T, typename = void>
+struct has_header : std::false_type {};
+
+template <typename T>
+struct has_header<T, std::void_t<decltype(std::declval<T>().header.timestamp_ns)>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct schema_version : std::integral_constant<uint32_t, 0> {};
+
+template <typename T>
+struct schema_version<T, std::void_t<decltype(T::schema_version)>>
+    : std::integral_constant<uint32_t, T::schema_version> {};
+/// @endcond
+
+/// @brief Hash of what the compiler can tell about T's layout.
+///
+/// C++17 cannot enumerate a struct's fields, so this covers size, alignment,
+/// the offset of `header` and an optional `static constexpr uint32_t
+/// schema_version` member that type authors bump when they change fields
+/// without changing the size.
+///
+/// @tparam T Message type.
+/// @return Layout hash.
+template <typename T>
+constexpr uint64_t layout_hash() {
+    uint64_t hash = fnv1a(std::is_base_of_v<FixedMessageType, T> ? "fixed" : "variable");
+    if constexpr (std::is_base_of_v<FixedMessageType, T>) {
+        hash = fnv1a(sizeof(T), hash);
+        hash = fnv1a(alignof(T), hash);
+        if constexpr (has_header<T>::value) {
+            hash = fnv1a(offsetof(T, header), hash);
+        }
+    }
+    return fnv1a(schema_version<T>::value, hash);
+}
+
+/// @brief Fingerprint of a message type.
+/// @tparam T Message type.
+/// @return Name, fingerprint, layout hash and size of T.
+template <typename T>
+constexpr TypeInfo type_info_of() {
+    uint32_t size = std::is_base_of_v<FixedMessageType, T> ? sizeof(T) : 0;
+    std::string_view name = type_name<T>();
+    uint64_t layout = layout_hash<T>();
+    return TypeInfo{name, fnv1a(layout, fnv1a(name)), layout, size};
+}
+
+/// @brief Fingerprint of T as a constant: computed by the compiler, not at runtime.
+/// @tparam T Message type.
+template <typename T>
+inline constexpr TypeInfo type_info_v = type_info_of<T>();
+
+}  // namespace conduit::internal
@@ -1,18 +1,52 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
+#include "conduit_core/internal/intra_process.hpp"
 #include "conduit_core/publisher.hpp"
+#include "conduit_core/scheduling.hpp"
+#include "conduit_core/service.hpp"
 #include "conduit_core/subscriber.hpp"
+#include "conduit_core/synchronizer.hpp"
 
 namespace conduit {
 
+/// @brief Thread placement and memory options for a Node.
+///
+/// The `CONDUIT_LOCK_MEMORY` and `CONDUIT_PREFAULT` environment variables
+/// (set to `1`) also enable lock_memory and prefault, and
+/// `CONDUIT_PREFAULT_THREADS` sets prefault_threads, which is how
+/// `conduit flow` passes these settings to child processes.
+/// `CONDUIT_SCHED_RUNTIME_NS`, `CONDUIT_SCHED_DEADLINE_NS` and
+/// `CONDUIT_SCHED_PERIOD_NS` make loop threads SCHED_DEADLINE, and
+/// subscription threads too if a period is set: a deadline process could
+/// not create its threads, so `conduit flow` passes the policy this way.
+struct NodeOptions {
+    /// Scheduling applied to every subscription thread.
+    ThreadOptions subscription_threads;
+    /// Per-topic overrides of subscription_threads.
+    std::map<std::string, ThreadOptions> topic_threads;
+    /// Scheduling applied to every loop thread.
+    ThreadOptions loop_threads;
+    /// Call mlockall() in run() before any thread starts.
+    bool lock_memory = false;
+    /// Fault in all ring buffer pages (advertised and subscribed) at startup.
+    bool prefault = false;
+    /// Threads used to prefault each ring buffer.
+    unsigned prefault_threads = 1;
+};
+
 /// @brief Base class for conduit processing nodes.
 ///
 /// A Node manages subscriptions and publish loops. Each subscription
@@ -35,11 +69,16 @@ namespace conduit {
 /// };
 /// @endcode
 ///
-/// @see Publisher, Subscriber
+/// Typed subscriptions to a topic published from the same process (for
+/// example by another node in the same Container) receive the publisher's
+/// object directly instead of going through shared memory.
+///
+/// @see Publisher, Subscriber, Container
 class Node {
 public:
     /// @brief Construct a node.
-    Node();
+    /// @param options Thread placement and memory options.
+    explicit Node(const NodeOptions& options = {});
     virtual ~Node();
 
     // No copy, no move (prevent slicing)
@@ -79,8 +118,44 @@ protected:
     /// @tparam T Derived Node type.
     /// @param topic Topic name to subscribe to.
     /// @param callback Member function receiving TypedMessage<MsgT>.
+    /// @param options Read-side filters (decimation, min_interval, frame).
     template<typename MsgT, typename T>
-    void subscribe(const std::string& topic, void (T::* callback)(const TypedMessage<MsgT>&));
+    void subscribe(const std::string& topic, void (T::* callback)(const TypedMessage<MsgT>&),
+                   const SubscriberOptions& options = {});
+
+    /// @brief Subscribe to a topic with a shared (zero-copy) member function callback.
+    ///
+    /// When the publisher lives in the same process the callback receives
+    /// the published object itself. Otherwise each message is deserialized
+    /// from shared memory into a newly allocated object.
+    ///
+    /// @tparam MsgT Message type.
+    /// @tparam T Derived Node type.
+    /// @param topic Topic name to subscribe to.
+    /// @param callback Member function receiving SharedMessage<MsgT>.
+    /// @param options Read-side filters (decimation, min_interval, frame).
+    template<typename MsgT, typename T>
+    void subscribe(const std::string& topic, void (T::* callback)(const SharedMessage<MsgT>&),
+                   const SubscriberOptions& options = {});
+
+    /// @brief Receive time-matched messages from several topics in one callback.
+    ///
+    /// Runs on its own thread, like a subscription. See Synchronizer for
+    /// the matching rules.
+    ///
+    /// @code
+    /// synchronize<Imu, Odometry>({"imu", "odom"}, &Fusion::on_pair, SyncOptions{2ms});
+    /// @endcode
+    ///
+    /// @tparam MsgTs Message types, one per topic.
+    /// @tparam T Derived Node type.
+    /// @param topics Topic names, in the order of MsgTs.
+    /// @param callback Member function receiving one TypedMessage per topic.
+    /// @param options Matching policy (default: exact stamps).
+    template<typename... MsgTs, typename T>
+    void synchronize(const std::array<std::string, sizeof...(MsgTs)>& topics,
+                     void (T::* callback)(const TypedMessage<MsgTs>&...),
+                     const SyncOptions& options = {});
 
     /// @brief Subscribe to a topic with a lambda or std::function callback (raw).
     /// @param topic Topic name to subscribe to.
@@ -108,11 +183,73 @@ protected:
     template<typename T>
     Publisher<T> advertise(const std::string& topic, const PublisherOptions& options = {});
 
+    /// @brief Offer a request/response service handled by a member function.
+    ///
+    /// The service is created immediately, so clients can connect before
+    /// run(); their requests are queued until it starts. Requests are
+    /// handled one at a time on a dedicated thread.
+    ///
+    /// @code
+    /// advertise_service("get_param", &ParamServer::on_get);
+    /// ParamValue on_get(const ParamRequest& req) { /* ... */ }
+    /// @endcode
+    ///
+    /// @tparam Req Request type.
+    /// @tparam Res Response type.
+    /// @tparam T Derived Node type.
+    /// @param name Service name.
+    /// @param handler Member function returning the response.
+    /// @param options Queue and payload sizing.
+    /// @throws ServiceError If the service already exists.
+    template<typename Req, typename Res, typename T>
+    void advertise_service(const std::string& name, Res (T::* handler)(const Req&),
+                           const ServiceOptions& options = {});
+
+    /// @brief Create a client for a service.
+    ///
+    /// The client connects on its first call, so the service may start later.
+    ///
+    /// @tparam Req Request type.
+    /// @tparam Res Response type.
+    /// @param name Service name.
+    /// @param options Client configuration.
+    /// @return A ServiceClient<Req, Res>.
+    template<typename Req, typename Res>
+    ServiceClient<Req, Res> client(const std::string& name, const ClientOptions& options = {});
+
 private:
+    friend class Container;
+
+    using IntraCallback = std::function<void(const internal::IntraProcessMessage&)>;
+
     struct Subscription {
         std::string topic;
+        SubscriberOptions options;
+        int32_t frame_offset = -1;
+        internal::TypeInfo type_info;  // Checked against the publisher's (untyped: not checked)
         std::function<void(const Message&)> callback;
         std::unique_ptr<internal::Subscriber> subscriber;
+        // Intra-process path, used when a matching publisher is in this process
+        std::type_index type = typeid(void);
+        IntraCallback intra_callback;
+        std::shared_ptr<internal::IntraProcessChannel> channel;
+        std::shared_ptr<internal::IntraProcessQueue> queue;
+        std::thread thread;
+    };
+
+    struct Synchronization {
+        std::vector<std::string> topics;
+        std::vector<internal::StampFn> stamps;
+        std::vector<internal::TypeInfo> types;
+        SyncOptions options;
+        std::function<void(const std::vector<Message>&)> callback;
+        std::unique_ptr<internal::SyncCore> core;
+        std::thread thread;
+    };
+
+    struct Service {
+        std::unique_ptr<internal::ServiceServer> server;
+        internal::ServiceServer::Handler handler;
         std::thread thread;
     };
 
@@ -123,11 +260,43 @@ private:
         std::thread thread;
     };
 
+    NodeOptions options_;
     std::vector<std::unique_ptr<Subscription>> subscriptions_;
+    std::vector<std::unique_ptr<Synchronization>> synchronizations_;
+    std::vector<std::unique_ptr<Service>> services_;
     std::vector<std::unique_ptr<Loop>> loops_;
     std::atomic<bool> running_{false};
 
+    const ThreadOptions& subscription_thread_options(const std::string& topic) const;
+
+    void add_subscription(const std::string& topic,
+                          std::function<void(const Message&)> callback,
+                          std::type_index type, IntraCallback intra_callback,
+                          const SubscriberOptions& options = {}, int32_t frame_offset = -1,
+                          const internal::TypeInfo& type_info = {});
+
+    // Wait for topics and start all threads. Returns false if stopped while waiting.
+    bool start();
+    // Join all threads and detach from intra-process channels.
+    void join();
+
     void spin_subscription(Subscription* sub);
+    void spin_intra_subscription(Subscription* sub);
+    void spin_synchronization(Synchronization* sync);
+    void spin_service(Service* service);
+
+    void add_synchronization(std::vector<std::string> topics,
+                             std::vector<internal::StampFn> stamps,
+                             std::vector<internal::TypeInfo> types,
+                             const SyncOptions& options,
+                             std::function<void(const std::vector<Message>&)> callback);
+
+    void add_service(const std::string& name, const ServiceOptions& options,
+                     internal::ServiceServer::Handler handler);
+
+    template<typename... MsgTs, typename T, size_t... Is>
+    void invoke_synchronized(void (T::* callback)(const TypedMessage<MsgTs>&...),
+                             const std::vector<Message>& msgs, std::index_sequence<Is...>);
     void spin_loop(Loop* lp);
 
     // Signal handling
@@ -146,21 +315,63 @@ void Node::subscribe(const std::string& topic, Func T::* callback) {
 }
 
 template<typename MsgT, typename T>
-void Node::subscribe(const std::string& topic, void (T::* callback)(const TypedMessage<MsgT>&)) {
-    subscribe(topic, [this, callback](const Message& msg) {
-        MsgT data = [&]() {
-            if constexpr (std::is_base_of_v<FixedMessageType, MsgT>) {
-                MsgT d;
-                std::memcpy(&d, msg.data, sizeof(MsgT));
-                return d;
-            } else {
-                return MsgT::deserialize(
-                    static_cast<const uint8_t*>(msg.data), msg.size);
-            }
-        }();
-        TypedMessage<MsgT> typed{std::move(data), msg.sequence, msg.timestamp_ns};
-        (static_cast<T*>(this)->*callback)(typed);
-    });
+void Node::subscribe(const std::string& topic, void (T::* callback)(const TypedMessage<MsgT>&),
+                     const SubscriberOptions& options) {
+    add_subscription(topic,
+        [this, callback](const Message& msg) {
+            TypedMessage<MsgT> typed{internal::decode_message<MsgT>(msg), msg.sequence, msg.timestamp_ns};
+            (static_cast<T*>(this)->*callback)(typed);
+        },
+        typeid(MsgT),
+        [this, callback](const internal::IntraProcessMessage& msg) {
+            // Callback takes its own copy; the shared object stays immutable
+            TypedMessage<MsgT> typed{*static_cast<const MsgT*>(msg.data.get()),
+                                     msg.sequence, msg.timestamp_ns};
+            (static_cast<T*>(this)->*callback)(typed);
+        },
+        options, internal::frame_offset<MsgT>(), internal::type_info_v<MsgT>);
+}
+
+template<typename MsgT, typename T>
+void Node::subscribe(const std::string& topic, void (T::* callback)(const SharedMessage<MsgT>&),
+                     const SubscriberOptions& options) {
+    add_subscription(topic,
+        [this, callback](const Message& msg) {
+            SharedMessage<MsgT> shared{
+                std::make_shared<const MsgT>(internal::decode_message<MsgT>(msg)),
+                msg.sequence, msg.timestamp_ns};
+            (static_cast<T*>(this)->*callback)(shared);
+        },
+        typeid(MsgT),
+        [this, callback](const internal::IntraProcessMessage& msg) {
+            SharedMessage<MsgT> shared{std::static_pointer_cast<const MsgT>(msg.data),
+                                       msg.sequence, msg.timestamp_ns};
+            (static_cast<T*>(this)->*callback)(shared);
+        },
+        options, internal::frame_offset<MsgT>(), internal::type_info_v<MsgT>);
+}
+
+template<typename... MsgTs, typename T>
+void Node::synchronize(const std::array<std::string, sizeof...(MsgTs)>& topics,
+                       void (T::* callback)(const TypedMessage<MsgTs>&...),
+                       const SyncOptions& options) {
+    static_assert(sizeof...(MsgTs) >= 2, "synchronize() needs at least two topics");
+    add_synchronization(
+        std::vector<std::string>(topics.begin(), topics.end()),
+        {&internal::message_stamp<MsgTs>...},
+        {internal::type_info_v<MsgTs>...},
+        options,
+        [this, callback](const std::vector<Message>& msgs) {
+            invoke_synchronized<MsgTs...>(callback, msgs, std::index_sequence_for<MsgTs...>{});
+        });
+}
+
+template<typename... MsgTs, typename T, size_t... Is>
+void Node::invoke_synchronized(void (T::* callback)(const TypedMessage<MsgTs>&...),
+                               const std::vector<Message>& msgs, std::index_sequence<Is...>) {
+    (static_cast<T*>(this)->*callback)(
+        TypedMessage<MsgTs>{internal::decode_message<MsgTs>(msgs[Is]),
+                            msgs[Is].sequence, msgs[Is].timestamp_ns}...);
 }
 
 template<typename T, typename Func>
@@ -172,7 +383,28 @@ void Node::loop(double rate_hz, Func T::* callback) {
 
 template<typename T>
 Publisher<T> Node::advertise(const std::string& topic, const PublisherOptions& options) {
-    return Publisher<T>(topic, options);
+    Publisher<T> pub(topic, options);
+    // NearSubscribers places pages when the first subscriber attaches
+    if (options_.prefault && options.numa != NumaPolicy::NearSubscribers) {
+        pub.prefault(options_.prefault_threads);
+    }
+    return pub;
+}
+
+template<typename Req, typename Res, typename T>
+void Node::advertise_service(const std::string& name, Res (T::* handler)(const Req&),
+                             const ServiceOptions& options) {
+    internal::validate_message_type<Req>();
+    internal::validate_message_type<Res>();
+    add_service(name, options, internal::make_service_handler<Req, Res>(
+        [this, handler](const Req& request) {
+            return (static_cast<T*>(this)->*handler)(request);
+        }));
+}
+
+template<typename Req, typename Res>
+ServiceClient<Req, Res> Node::client(const std::string& name, const ClientOptions& options) {
+    return ServiceClient<Req, Res>(name, options);
 }
 
 }  // namespace conduit
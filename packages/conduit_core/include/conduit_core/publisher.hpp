@@ -1,23 +1,112 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
+#include "conduit_core/internal/buffer_pool.hpp"
+#include "conduit_core/internal/intra_process.hpp"
 #include "conduit_core/internal/ring_buffer.hpp"
 #include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/internal/time.hpp"
+#include "conduit_core/internal/type_info.hpp"
 
 namespace conduit {
 
+/// @brief Where a topic's ring buffer pages are allocated on NUMA machines.
+enum class NumaPolicy : uint32_t {
+    FirstTouch,       ///< Kernel default: the node of whichever CPU touches a page first.
+    Node,             ///< The node in PublisherOptions::numa_node.
+    NearPublisher,    ///< The node the publisher is constructed on (pin its thread first).
+    NearSubscribers,  ///< The node of the first subscriber to attach.
+};
+
 /// @brief Configuration for topic publisher and ring buffer sizing.
 struct PublisherOptions {
     /// Number of message slots in the ring buffer (must be power of 2).
     uint32_t depth = 16;
     /// Maximum payload size in bytes. Messages exceeding this are rejected.
     uint32_t max_message_size = 4096;
+    /// Back the ring with huge pages (hugetlbfs) when available. Falls back
+    /// to normal pages otherwise. Worth it for rings of several MB.
+    bool huge_pages = false;
+    /// Use an anonymous memfd instead of a `/dev/shm` file. Nothing is left
+    /// behind if the process crashes; subscribers get the fd over a socket.
+    bool memfd = false;
+    /// NUMA placement of the ring buffer. With NearSubscribers, slots are
+    /// allocated once a subscriber has attached, so do not prefault the
+    /// publisher before that. Pages written before then only move if the
+    /// subscriber has CAP_SYS_NICE.
+    NumaPolicy numa = NumaPolicy::FirstTouch;
+    /// Target node for NumaPolicy::Node.
+    int numa_node = 0;
+    /// Instead of rejecting a message larger than max_message_size, move
+    /// the topic to a ring with slots that fit it (see Publisher::resize).
+    /// Slot sizes are rounded up to a power of two.
+    bool grow = false;
+    /// Size in bytes of a shared overflow arena for messages larger than
+    /// max_message_size (0 = none). Lets the slots be sized for the common
+    /// message when a few are much larger (see "Large messages").
+    uint32_t overflow_size = 0;
+    /// Number of blocks in a shared buffer pool (0 = none). Messages are
+    /// built in a block (see Publisher::loan) and only a handle goes
+    /// through the ring. Needs at least depth + one per subscriber + the
+    /// loans held at a time.
+    uint32_t pool_blocks = 0;
+    /// Bytes per buffer pool block: the largest message it can hold.
+    uint32_t pool_block_size = 0;
+};
+
+namespace internal {
+class Publisher;
+}  // namespace internal
+
+/// @brief A buffer pool block lent to a publisher, to build a message in place.
+///
+/// Obtained from Publisher::loan() and handed back with
+/// Publisher::publish(Loan&&). A loan that is dropped without being
+/// published returns its block to the pool. It must not outlive its publisher.
+class Loan {
+public:
+    /// @brief Move constructor.
+    Loan(Loan&& other) noexcept;
+    /// @brief Move assignment operator.
+    Loan& operator=(Loan&& other) noexcept;
+    Loan(const Loan&) = delete;
+    Loan& operator=(const Loan&) = delete;
+
+    ~Loan();
+
+    /// @brief Start of the block.
+    /// @return Pointer to capacity() writable bytes in shared memory.
+    void* data() const;
+
+    /// @brief Size of the message that will be published.
+    size_t size() const { return handle_.size; }
+
+    /// @brief Bytes available in the block.
+    size_t capacity() const;
+
+    /// @brief Change the size of the message, e.g. once the point count is known.
+    /// @param size New size in bytes.
+    /// @throws PublisherError If size exceeds capacity().
+    void resize(size_t size);
+
+private:
+    friend class internal::Publisher;
+
+    Loan(internal::BufferPool* pool, const internal::BlockHandle& handle) : pool_(pool), handle_(handle) {}
+
+    internal::BufferPool* pool_;
+    internal::BlockHandle handle_;
 };
 
 namespace internal {
@@ -34,8 +123,10 @@ public:
     /// @brief Construct a publisher for the given topic.
     /// @param topic Topic name used to create the shared memory region.
     /// @param options Ring buffer configuration (depth and max message size).
+    /// @param type Message type recorded in the topic header for subscribers
+    ///        and tools to check (default: untyped).
     /// @throws PublisherError If shared memory creation fails.
-    Publisher(const std::string& topic, const PublisherOptions& options = {});
+    Publisher(const std::string& topic, const PublisherOptions& options = {}, const TypeInfo& type = {});
 
     /// @brief Move constructor.
     Publisher(Publisher&&) noexcept;
@@ -49,22 +140,111 @@ public:
     /// @brief Publish raw data to the topic.
     /// @param data Pointer to the payload bytes.
     /// @param size Size of the payload in bytes.
-    /// @return true if the message was written, false if size exceeds max_message_size.
+    /// @return true if the message was written, false if size exceeds
+    ///         max_message_size, the overflow arena and the pool's blocks (and
+    ///         PublisherOptions::grow is off), or the pool is exhausted.
     bool publish(const void* data, size_t size);
 
+    /// @brief Borrow a buffer pool block to build a message in.
+    ///
+    /// Write the message into Loan::data() and pass the loan to
+    /// publish(Loan&&). Subscribers read the block itself: nothing is copied.
+    ///
+    /// @param size Size of the message (can be changed with Loan::resize()).
+    /// @return The loan, or std::nullopt if every block is in use.
+    /// @throws PublisherError If the publisher has no pool or size exceeds
+    ///         PublisherOptions::pool_block_size.
+    std::optional<Loan> loan(size_t size);
+
+    /// @brief Publish a message built in a loaned block.
+    ///
+    /// The block stays referenced by the ring until the publisher laps its
+    /// slot, and by each subscriber while the message is its current one.
+    ///
+    /// @param loan Loan from this publisher's loan().
+    /// @return true if the message was written.
+    bool publish(Loan&& loan);
+
+    /// @brief Check whether a message of this size is published through the buffer pool.
+    /// @param size Payload size in bytes.
+    /// @return true if it exceeds max_message_size and the overflow arena
+    ///         but fits a pool block.
+    bool pooled(size_t size) const {
+        return pool_ && size > std::max(options_.max_message_size, options_.overflow_size)
+            && size <= options_.pool_block_size;
+    }
+
+    /// @brief Move the topic to a ring with a different depth or slot size.
+    ///
+    /// Creates the next generation of the ring buffer (`{topic}@{n}`) and
+    /// retires the current one. Sequence numbers continue. Subscribers read
+    /// what is left in the old ring, then switch over on their own: nothing
+    /// has to be restarted. Does nothing if both values are unchanged.
+    ///
+    /// @param depth Number of slots (must be a power of 2).
+    /// @param max_message_size Maximum payload size in bytes.
+    /// @throws PublisherError If depth is not a power of 2, or is 1 while
+    ///         reliable subscribers are attached.
+    /// @throws ShmError If the new region cannot be created.
+    void resize(uint32_t depth, uint32_t max_message_size);
+
+    /// @brief Check whether a payload of this size can be published.
+    /// @param size Payload size in bytes.
+    /// @return true if it fits max_message_size, the overflow arena or a
+    ///         pool block, or the publisher grows on demand.
+    bool fits(size_t size) const {
+        return options_.grow || size <= std::max(options_.max_message_size, options_.overflow_size)
+            || (pool_ && size <= options_.pool_block_size);
+    }
+
+    /// @brief Check whether any subscriber has claimed a reader slot on the ring.
+    /// @return true if at least one shared memory reader is attached, to the
+    ///         current ring or to a retired one it has not left yet.
+    bool has_readers() const;
+
+    /// @brief Fault in all pages of the ring buffer ahead of the first publish.
+    /// @param threads Number of threads to split the work across.
+    void prefault(unsigned threads = 1) { shm_.prefault(true, threads); }
+
     /// @brief Get the topic name.
     /// @return Reference to the topic string.
     const std::string& topic() const { return topic_; }
 
     /// @brief Get the maximum allowed message size.
     /// @return Maximum payload size in bytes.
-    uint32_t max_message_size() const { return max_message_size_; }
+    uint32_t max_message_size() const { return options_.max_message_size; }
+
+    /// @brief Get the page size backing the ring buffer.
+    /// @return Page size in bytes; larger than 4096 if huge pages are in use.
+    size_t page_size() const { return shm_.page_size(); }
+
+    /// @brief Get the current ring generation.
+    /// @return 0 until the first resize(), then incremented by each one.
+    uint32_t generation() const { return generation_; }
 
 private:
     std::string topic_;
-    uint32_t max_message_size_;
+    PublisherOptions options_;
+    TypeInfo type_;
+    uint32_t generation_ = 0;
     ShmRegion shm_;
     std::unique_ptr<RingBufferWriter> writer_;
+    /// Generation 0 ring, kept once resized: new subscribers open it to find the current one.
+    std::unique_ptr<ShmRegion> origin_;
+    /// Retired intermediate generations whose readers have not all followed yet.
+    std::vector<ShmRegion> retired_;
+    /// Arena for messages larger than a slot (PublisherOptions::overflow_size).
+    std::unique_ptr<ShmRegion> overflow_;
+    /// Buffer pool (PublisherOptions::pool_blocks) and its region.
+    std::unique_ptr<ShmRegion> pool_region_;
+    std::unique_ptr<BufferPool> pool_;
+    /// Published blocks the ring still holds, by sequence number.
+    std::deque<std::pair<uint64_t, BlockHandle>> ring_blocks_;
+
+    void release_lapped();
+    void start_ring(ShmRegion& shm, RingBufferWriter& writer, const TopicInfo& info,
+                    uint32_t generation, uint64_t start_idx);
+    void unlink();
 };
 
 }  // namespace internal
@@ -83,6 +263,12 @@ namespace conduit {
 /// For VariableMessageType derivatives, serialize() is called into an
 /// internal buffer before publishing.
 ///
+/// Subscribers in the same process (typed Node subscriptions) receive the
+/// object itself as a `std::shared_ptr<const T>`, bypassing shared memory.
+/// The ring buffer is only written when a reader has claimed a slot on it
+/// or no in-process subscriber exists, so external tools such as
+/// `conduit echo` still see every message.
+///
 /// @tparam T Message type (must derive from FixedMessageType or VariableMessageType).
 /// @see PublisherOptions, Node::advertise
 template <typename T>
@@ -92,7 +278,7 @@ public:
     /// @param topic Topic name used to create the shared memory region.
     /// @param options Ring buffer configuration.
     Publisher(const std::string& topic, const PublisherOptions& options = {})
-        : impl_(topic, options) {
+        : impl_(topic, options, internal::type_info_v<T>), intra_(topic, typeid(T), options.depth) {
         validate();
     }
 
@@ -106,21 +292,47 @@ public:
     /// @brief Publish a typed message.
     ///
     /// Fixed types are published via memcpy. Variable types are serialized
-    /// into an internal buffer first.
+    /// into an internal buffer first. When in-process subscribers exist the
+    /// message is copied once into a shared object and handed to them.
     ///
     /// @param msg The message to publish.
     /// @return true if the message was written, false if it exceeds max_message_size.
     bool publish(const T& msg) {
-        if constexpr (std::is_base_of_v<FixedMessageType, T>) {
-            return impl_.publish(&msg, sizeof(T));
-        } else {
-            size_t size = msg.serialized_size();
-            buffer_.resize(size);
-            msg.serialize(buffer_.data());
-            return impl_.publish(buffer_.data(), size);
+        if (intra_.has_subscribers()) {
+            return publish(std::make_shared<const T>(msg));
+        }
+        return write(msg);
+    }
+
+    /// @brief Publish a shared message without copying it for in-process subscribers.
+    ///
+    /// In-process subscribers receive @p msg itself. The ring buffer is
+    /// written only if a shared memory reader is attached.
+    ///
+    /// @param msg The message to publish (must not be null).
+    /// @return true if the message was delivered, false if it exceeds max_message_size.
+    bool publish(std::shared_ptr<const T> msg) {
+        if (!intra_.has_subscribers()) {
+            return write(*msg);
+        }
+        if (!impl_.fits(serialized_size(*msg))) {
+            return false;
         }
+        bool external = impl_.has_readers();
+        intra_.deliver(msg, internal::get_timestamp_ns());
+        return external ? write(*msg) : true;
     }
 
+    /// @brief Fault in all pages of the ring buffer ahead of the first publish.
+    /// @param threads Number of threads to split the work across.
+    void prefault(unsigned threads = 1) { impl_.prefault(threads); }
+
+    /// @brief Move the topic to a ring with a different depth or slot size.
+    /// @param depth Number of slots (must be a power of 2).
+    /// @param max_message_size Maximum payload size in bytes.
+    /// @see internal::Publisher::resize
+    void resize(uint32_t depth, uint32_t max_message_size) { impl_.resize(depth, max_message_size); }
+
     /// @brief Get the topic name.
     /// @return Reference to the topic string.
     const std::string& topic() const { return impl_.topic(); }
@@ -131,8 +343,38 @@ public:
 
 private:
     internal::Publisher impl_;
+    internal::IntraProcessPublisher intra_;
     std::vector<uint8_t> buffer_;  ///< Serialization scratch space for variable types.
 
+    bool write(const T& msg) {
+        if constexpr (std::is_base_of_v<FixedMessageType, T>) {
+            return impl_.publish(&msg, sizeof(T));
+        } else {
+            size_t size = msg.serialized_size();
+            if (impl_.pooled(size)) {
+                // Serialize straight into shared memory
+                auto loan = impl_.loan(size);
+                if (!loan) {
+                    return false;
+                }
+                msg.serialize(static_cast<uint8_t*>(loan->data()));
+                return impl_.publish(std::move(*loan));
+            }
+            buffer_.resize(size);
+            msg.serialize(buffer_.data());
+            return impl_.publish(buffer_.data(), size);
+        }
+    }
+
+    static size_t serialized_size(const T& msg) {
+        if constexpr (std::is_base_of_v<FixedMessageType, T>) {
+            (void)msg;
+            return sizeof(T);
+        } else {
+            return msg.serialized_size();
+        }
+    }
+
     static constexpr void validate() {
         if constexpr (std::is_base_of_v<FixedMessageType, T>) {
             validate_fixed_message_type<T>();
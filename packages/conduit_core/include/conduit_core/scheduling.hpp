@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace conduit {
+
+/// @brief Linux scheduling policy applied to a conduit-managed thread.
+enum class SchedPolicy {
+    Inherit,     ///< Leave the policy inherited from the creating thread.
+    Other,       ///< SCHED_OTHER (default time-sharing).
+    Fifo,        ///< SCHED_FIFO (real-time, first-in first-out).
+    RoundRobin,  ///< SCHED_RR (real-time, round-robin).
+    Deadline     ///< SCHED_DEADLINE (earliest deadline first, needs runtime/deadline/period).
+};
+
+/// @brief CPU affinity and scheduling parameters for a thread.
+///
+/// Default-constructed options leave the thread untouched, so threads keep
+/// whatever affinity and policy the process was started with.
+///
+/// Real-time policies usually require CAP_SYS_NICE (or a suitable
+/// RLIMIT_RTPRIO). Failures are logged and the thread keeps running with
+/// default scheduling rather than aborting the node.
+struct ThreadOptions {
+    /// CPUs the thread may run on. Empty means no pinning. With
+    /// SchedPolicy::Deadline the CPUs must be an exclusive cpuset, or the
+    /// kernel refuses the policy.
+    std::vector<int> cpus;
+    /// Scheduling policy.
+    SchedPolicy policy = SchedPolicy::Inherit;
+    /// Static priority for Fifo/RoundRobin (1-99).
+    int priority = 0;
+    /// SCHED_DEADLINE runtime budget per period.
+    std::chrono::nanoseconds runtime{0};
+    /// SCHED_DEADLINE relative deadline (defaults to period when zero).
+    std::chrono::nanoseconds deadline{0};
+    /// SCHED_DEADLINE period. Loops use their own period when zero.
+    std::chrono::nanoseconds period{0};
+};
+
+}  // namespace conduit
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "conduit_core/internal/service_channel.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/subscriber.hpp"
+
+namespace conduit {
+
+/// @brief Configuration for a service server and its request queue.
+struct ServiceOptions {
+    /// Number of request slots shared by all clients (must be power of 2).
+    uint32_t depth = 16;
+    /// Maximum request payload size in bytes.
+    uint32_t max_request_size = 4096;
+    /// Maximum response payload size in bytes.
+    uint32_t max_response_size = 4096;
+};
+
+/// @brief Configuration for a service client.
+struct ClientOptions {
+    /// Busy-poll for the response this long before sleeping on the futex.
+    /// Saves two context switches per call when the handler is fast, at
+    /// the cost of a busy core while waiting.
+    std::chrono::nanoseconds spin{0};
+};
+
+namespace internal {
+
+/// @brief Shared memory name of a service (`/dev/shm/conduit_srv.{name}`).
+/// @param name Service name.
+/// @return Region name passed to ShmRegion.
+inline std::string service_region_name(const std::string& name) {
+    return "srv." + name;
+}
+
+/// @brief Low-level service server answering raw byte requests.
+///
+/// Creates the service's shared memory region. Requests are handled one at
+/// a time on the thread calling serve_for(); the handler writes its
+/// response straight into the client's response slot.
+///
+/// @see conduit::ServiceServer
+class ServiceServer {
+public:
+    /// @brief Handle one request.
+    ///
+    /// Receives the request (valid for the duration of the call) and a
+    /// buffer of @c capacity bytes for the response.
+    ///
+    /// @return Response size, or std::nullopt if it does not fit.
+    using Handler = std::function<std::optional<size_t>(const Message& request, void* response, size_t capacity)>;
+
+    /// @brief Construct a server for the given service name.
+    /// @param name Service name.
+    /// @param options Queue and payload sizing.
+    /// @throws ServiceError If the options are invalid or the service already exists.
+    ServiceServer(const std::string& name, const ServiceOptions& options = {});
+
+    /// @brief Move constructor.
+    ServiceServer(ServiceServer&&) noexcept;
+    /// @brief Move assignment operator.
+    ServiceServer& operator=(ServiceServer&&) noexcept;
+    ServiceServer(const ServiceServer&) = delete;
+    ServiceServer& operator=(const ServiceServer&) = delete;
+
+    ~ServiceServer();
+
+    /// @brief Wait for one request and answer it.
+    ///
+    /// Exceptions thrown by the handler are logged and reported to the
+    /// client as a failed call.
+    ///
+    /// @param timeout Maximum time to wait for a request.
+    /// @param handler Called with the request.
+    /// @return true if a request was handled, false on timeout.
+    bool serve_for(std::chrono::nanoseconds timeout, const Handler& handler);
+
+    /// @brief Get the service name.
+    /// @return Reference to the name string.
+    const std::string& name() const { return name_; }
+
+private:
+    std::string name_;
+    uint32_t max_response_size_;
+    ShmRegion shm_;
+    std::unique_ptr<ServiceChannelServer> channel_;
+};
+
+/// @brief Low-level service client sending raw byte requests.
+///
+/// Connects lazily: the server may start after the client. One call at a
+/// time; like Publisher, a client must not be shared between threads.
+///
+/// @see conduit::ServiceClient
+class ServiceClient {
+public:
+    /// @brief Construct a client for the given service name.
+    /// @param name Service name.
+    /// @param options Client configuration.
+    ServiceClient(const std::string& name, const ClientOptions& options = {});
+
+    /// @brief Move constructor.
+    ServiceClient(ServiceClient&&) noexcept;
+    /// @brief Move assignment operator.
+    ServiceClient& operator=(ServiceClient&&) noexcept;
+    ServiceClient(const ServiceClient&) = delete;
+    ServiceClient& operator=(const ServiceClient&) = delete;
+
+    ~ServiceClient();
+
+    /// @brief Block until the service exists and a client slot is claimed.
+    /// @param timeout Maximum time to wait.
+    /// @return true if connected.
+    /// @throws ServiceError If the service has no free client slot.
+    bool wait_for_service(std::chrono::nanoseconds timeout);
+
+    /// @brief Send a request and wait for the response.
+    ///
+    /// On timeout the connection is dropped, so a restarted server is
+    /// picked up by the next call.
+    ///
+    /// @param data Request payload.
+    /// @param size Payload size in bytes.
+    /// @param timeout Maximum time for the whole call, including connecting.
+    /// @return The response (valid until the next call), or std::nullopt on timeout.
+    /// @throws ServiceError If the request is too large or the handler failed.
+    std::optional<Message> call(const void* data, size_t size, std::chrono::nanoseconds timeout);
+
+    /// @brief Check whether the client is connected to a server.
+    /// @return true if a client slot is held.
+    bool connected() const { return slot_ >= 0; }
+
+    /// @brief Get the service name.
+    /// @return Reference to the name string.
+    const std::string& name() const { return name_; }
+
+private:
+    std::string name_;
+    ClientOptions options_;
+    std::optional<ShmRegion> shm_;
+    std::unique_ptr<ServiceChannelClient> channel_;
+    int slot_ = -1;
+
+    void disconnect();
+};
+
+/// @brief Encode a message into a caller-provided buffer (memcpy or serialize).
+/// @tparam MsgT Message type.
+/// @param msg Message to encode.
+/// @param out Destination buffer.
+/// @param capacity Size of @p out in bytes.
+/// @return Encoded size, or std::nullopt if it exceeds @p capacity.
+template <typename MsgT>
+std::optional<size_t> encode_message(const MsgT& msg, void* out, size_t capacity) {
+    if constexpr (std::is_base_of_v<FixedMessageType, MsgT>) {
+        if (sizeof(MsgT) > capacity) {
+            return std::nullopt;
+        }
+        std::memcpy(out, &msg, sizeof(MsgT));
+        return sizeof(MsgT);
+    } else {
+        size_t size = msg.serialized_size();
+        if (size > capacity) {
+            return std::nullopt;
+        }
+        msg.serialize(static_cast<uint8_t*>(out));
+        return size;
+    }
+}
+
+/// @brief Wrap a typed `Res(const Req&)` callable as a raw service handler.
+/// @tparam Req Request type.
+/// @tparam Res Response type.
+/// @param handler Typed handler.
+/// @return Handler for ServiceServer::serve_for().
+template <typename Req, typename Res, typename Func>
+ServiceServer::Handler make_service_handler(Func handler) {
+    return [handler = std::move(handler)](const Message& request, void* response, size_t capacity) {
+        Res result = handler(decode_message<Req>(request));
+        return encode_message<Res>(result, response, capacity);
+    };
+}
+
+/// @brief Compile-time check that T is a fixed or variable message type.
+template <typename T>
+constexpr void validate_message_type() {
+    if constexpr (std::is_base_of_v<FixedMessageType, T>) {
+        validate_fixed_message_type<T>();
+    } else {
+        validate_variable_message_type<T>();
+    }
+}
+
+}  // namespace internal
+
+/// @brief Type-safe service server answering Req with Res.
+///
+/// Usually created through Node::advertise_service(), which also runs the
+/// serving thread.
+///
+/// @code
+/// ServiceServer<Int, Int> server("double");
+/// server.serve_for(100ms, [](const Int& req) { Int res; res.value = 2 * req.value; return res; });
+/// @endcode
+///
+/// @tparam Req Request type.
+/// @tparam Res Response type.
+/// @see ServiceClient, Node::advertise_service
+template <typename Req, typename Res>
+class ServiceServer {
+public:
+    /// @brief Construct a typed server for the given service name.
+    /// @param name Service name.
+    /// @param options Queue and payload sizing.
+    ServiceServer(const std::string& name, const ServiceOptions& options = {})
+        : impl_(name, options) {
+        internal::validate_message_type<Req>();
+        internal::validate_message_type<Res>();
+    }
+
+    /// @brief Wait for one request and answer it.
+    /// @param timeout Maximum time to wait for a request.
+    /// @param handler Callable `Res(const Req&)`.
+    /// @return true if a request was handled, false on timeout.
+    template <typename Func>
+    bool serve_for(std::chrono::nanoseconds timeout, Func&& handler) {
+        return impl_.serve_for(timeout, internal::make_service_handler<Req, Res>(std::forward<Func>(handler)));
+    }
+
+    /// @brief Get the service name.
+    /// @return Reference to the name string.
+    const std::string& name() const { return impl_.name(); }
+
+private:
+    internal::ServiceServer impl_;
+};
+
+/// @brief Type-safe service client sending Req and receiving Res.
+///
+/// @code
+/// ServiceClient<Int, Int> client("double");
+/// if (auto res = client.call(req, 10ms)) { ... }
+/// @endcode
+///
+/// @tparam Req Request type.
+/// @tparam Res Response type.
+/// @see ServiceServer, Node::client
+template <typename Req, typename Res>
+class ServiceClient {
+public:
+    /// @brief Construct a typed client for the given service name.
+    /// @param name Service name.
+    /// @param options Client configuration.
+    ServiceClient(const std::string& name, const ClientOptions& options = {})
+        : impl_(name, options) {
+        internal::validate_message_type<Req>();
+        internal::validate_message_type<Res>();
+    }
+
+    /// @brief Send a request and wait for the response.
+    /// @param request Request message.
+    /// @param timeout Maximum time for the whole call.
+    /// @return The response, or std::nullopt on timeout.
+    /// @throws ServiceError If the request is too large or the handler failed.
+    std::optional<Res> call(const Req& request, std::chrono::nanoseconds timeout) {
+        std::optional<Message> response;
+        if constexpr (std::is_base_of_v<FixedMessageType, Req>) {
+            response = impl_.call(&request, sizeof(Req), timeout);
+        } else {
+            buffer_.resize(request.serialized_size());
+            request.serialize(buffer_.data());
+            response = impl_.call(buffer_.data(), buffer_.size(), timeout);
+        }
+        if (!response) return std::nullopt;
+        return internal::decode_message<Res>(*response);
+    }
+
+    /// @brief Block until the service exists.
+    /// @param timeout Maximum time to wait.
+    /// @return true if connected.
+    bool wait_for_service(std::chrono::nanoseconds timeout) { return impl_.wait_for_service(timeout); }
+
+    /// @brief Get the service name.
+    /// @return Reference to the name string.
+    const std::string& name() const { return impl_.name(); }
+
+private:
+    internal::ServiceClient impl_;
+    std::vector<uint8_t> buffer_;  ///< Serialization scratch space for variable types.
+};
+
+}  // namespace conduit
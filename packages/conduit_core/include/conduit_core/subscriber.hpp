@@ -1,27 +1,66 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
 #include <type_traits>
 
+#include "conduit_core/internal/buffer_pool.hpp"
 #include "conduit_core/internal/ring_buffer.hpp"
 #include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/internal/type_info.hpp"
 
 namespace conduit {
 
 /// @brief Configuration for topic subscriber.
+///
+/// The filters are evaluated in the ring buffer reader before a message is
+/// returned, and the publisher only wakes a filtered subscriber for
+/// messages that pass. A message is delivered if it passes all of them.
 struct SubscriberOptions {
-    // reserved for future use
+    /// Deliver every Nth message (1 = every message).
+    uint32_t decimation = 1;
+    /// Skip messages published less than this after the last delivered one.
+    /// The newest of them is still delivered once the interval has passed,
+    /// so the last value of a burst is not lost.
+    std::chrono::nanoseconds min_interval{0};
+    /// Deliver only messages whose `header.frame` equals this (empty = any).
+    /// Requires a fixed-size message type with a Header.
+    std::string frame;
+    /// Deliver only the newest message on each read, skipping any backlog.
+    bool latest_only = false;
+    /// Deliver at most this many messages per second (0 = unlimited).
+    /// Same as min_interval = 1 s / max_rate_hz; the longer interval wins.
+    double max_rate_hz = 0;
+    /// Do not let the publisher overwrite messages this subscriber has not
+    /// read: a publish that would lap it waits for it to catch up, for up
+    /// to reliable_timeout. For recorders that must not lose data; every
+    /// reliable subscriber can slow the publisher down. Needs a topic depth
+    /// of at least 2.
+    bool reliable = false;
+    /// Longest time a publish waits for a reliable subscriber. After that
+    /// the subscriber is lapped as usual and the publisher stops waiting
+    /// for it until it has caught up.
+    std::chrono::nanoseconds reliable_timeout = std::chrono::milliseconds(100);
+
+    /// @brief Check whether any filter is set.
+    /// @return true if some messages may not be delivered.
+    bool filtered() const {
+        return decimation > 1 || min_interval.count() > 0 || !frame.empty() || latest_only || max_rate_hz > 0;
+    }
 };
 
 /// @brief Raw message received from a topic.
 ///
 /// Contains a pointer into shared memory that is only valid until the
 /// next call to take()/wait()/wait_for() on the same subscriber.
+/// A message published from a buffer pool block keeps the block referenced
+/// until then, so the publisher cannot reuse it while it is being read.
 struct Message {
     const void* data;        ///< Pointer to payload in shared memory (transient).
     size_t size;             ///< Payload size in bytes.
@@ -42,9 +81,14 @@ class Subscriber {
 public:
     /// @brief Construct a subscriber for the given topic.
     /// @param topic Topic name of the shared memory region to open.
-    /// @param options Subscriber configuration (reserved for future use).
-    /// @throws SubscriberError If shared memory cannot be opened or no reader slots available.
-    Subscriber(const std::string& topic, const SubscriberOptions& options = {});
+    /// @param options Subscriber configuration and filters.
+    /// @param frame_offset Payload offset of `header.frame`, or -1 if the
+    ///        type has none (see frame_offset()).
+    /// @throws SubscriberError If shared memory cannot be opened, no reader
+    ///         slots are available, a frame filter is set without a frame offset,
+    ///         or a reliable subscriber is asked for on a topic of depth 1.
+    Subscriber(const std::string& topic, const SubscriberOptions& options = {},
+               int32_t frame_offset = -1);
 
     /// @brief Move constructor.
     Subscriber(Subscriber&&) noexcept;
@@ -71,6 +115,46 @@ public:
     /// @return The next message, or std::nullopt on timeout.
     std::optional<Message> wait_for(std::chrono::nanoseconds timeout);
 
+    /// @brief Look at a queued message without consuming it.
+    ///
+    /// A message published from a buffer pool block keeps the block
+    /// referenced until it is consumed, so it stays valid across peeks.
+    ///
+    /// @param offset Messages past the next unread one (0 = next unread).
+    /// @return The message, or std::nullopt if it has not been published yet.
+    std::optional<Message> peek(uint64_t offset = 0);
+
+    /// @brief Consume messages without reading them.
+    /// @param count Number of messages to skip.
+    void advance(uint64_t count = 1);
+
+    /// @brief Block until a message is available, without consuming it.
+    /// @param timeout Maximum time to wait.
+    /// @return The next unread message, or std::nullopt on timeout.
+    std::optional<Message> wait_peek_for(std::chrono::nanoseconds timeout);
+
+    /// @brief Futex word the publisher bumps after every write.
+    ///
+    /// For event loops that wait on several topics at once (see
+    /// futex_wait_any()). Load it before checking take() and sleep only
+    /// while it still holds the loaded value. The word moves when the
+    /// publisher resizes the topic, so fetch it again on every iteration.
+    ///
+    /// @return Pointer to the futex word in shared memory.
+    std::atomic<uint32_t>* futex_word() { return reader_->wake_word(slot_); }
+
+    /// @brief Check the topic's message type against the expected one.
+    ///
+    /// Passes if either side is untyped (hash 0), e.g. a raw publisher.
+    ///
+    /// @param expected Type the caller will decode messages as.
+    /// @throws SubscriberError If the publisher recorded a different type.
+    void check_type(const TypeInfo& expected) const;
+
+    /// @brief Fault in all pages of the ring buffer (read-only).
+    /// @param threads Number of threads to split the work across.
+    void prefault(unsigned threads = 1) { shm_.prefault(false, threads); }
+
     /// @brief Get the topic name.
     /// @return Reference to the topic string.
     const std::string& topic() const { return topic_; }
@@ -79,7 +163,22 @@ private:
     std::string topic_;
     ShmRegion shm_;
     std::unique_ptr<RingBufferReader> reader_;
-    int slot_;
+    int slot_ = -1;
+    ReadFilter filter_;  ///< Re-applied when following the topic to a new ring.
+    std::optional<std::chrono::nanoseconds> reliable_timeout_;  ///< Set for reliable subscribers; re-applied too.
+    std::unique_ptr<ShmRegion> overflow_;  ///< Topic's overflow arena, once mapped.
+    std::unique_ptr<ShmRegion> pool_region_;  ///< Topic's buffer pool, once mapped.
+    std::unique_ptr<BufferPool> pool_;
+    std::optional<BlockHandle> held_;  ///< Pool block of the last message returned.
+    /// Pool blocks of peeked messages not consumed yet, by sequence number.
+    std::deque<std::pair<uint64_t, BlockHandle>> peeked_;
+
+    void attach_overflow(RingBufferReader& reader);
+    bool hold(const ReadResult& result);
+    void drop_held();
+    bool hold_peeked(const ReadResult& result);
+    void drop_peeked(bool all = false);
+    bool follow();
 };
 
 }  // namespace internal
@@ -88,6 +187,7 @@ private:
 
 // Include message type traits for Subscriber<T>
 #include <conduit_types/fixed_message_type.hpp>
+#include <conduit_types/header.hpp>
 #include <conduit_types/variable_message_type.hpp>
 
 namespace conduit {
@@ -101,6 +201,51 @@ struct TypedMessage {
     uint64_t timestamp_ns;   ///< CLOCK_MONOTONIC_RAW timestamp in nanoseconds.
 };
 
+namespace internal {
+
+/// @brief Decode a raw message into a MsgT (memcpy or deserialize).
+/// @tparam MsgT Message type.
+/// @param msg Raw message from the ring buffer.
+/// @return The decoded message.
+template <typename MsgT>
+MsgT decode_message(const Message& msg) {
+    if constexpr (std::is_base_of_v<FixedMessageType, MsgT>) {
+        MsgT d;
+        std::memcpy(&d, msg.data, sizeof(MsgT));
+        return d;
+    } else {
+        return MsgT::deserialize(static_cast<const uint8_t*>(msg.data), msg.size);
+    }
+}
+
+/// @brief Payload offset of `header.frame` for frame filters.
+/// @tparam MsgT Message type.
+/// @return Byte offset for fixed types with a Header, -1 otherwise.
+template <typename MsgT>
+constexpr int32_t frame_offset() {
+    if constexpr (std::is_base_of_v<FixedMessageType, MsgT> && has_header<MsgT>::value) {
+        return static_cast<int32_t>(offsetof(MsgT, header) + offsetof(Header, frame));
+    } else {
+        return -1;
+    }
+}
+
+}  // namespace internal
+
+/// @brief Message shared by reference with an in-process publisher.
+///
+/// Delivered to Node subscriptions when the publisher lives in the same
+/// process; @c data points at the publisher's object, which must not be
+/// modified.
+///
+/// @tparam T The message type.
+template <typename T>
+struct SharedMessage {
+    std::shared_ptr<const T> data;  ///< Published object (shared, not copied).
+    uint64_t sequence;              ///< Monotonically increasing message sequence number.
+    uint64_t timestamp_ns;          ///< CLOCK_MONOTONIC_RAW timestamp in nanoseconds.
+};
+
 /// @brief Type-safe subscriber that deserializes messages of type T.
 ///
 /// For FixedMessageType derivatives, messages are deserialized via memcpy.
@@ -114,9 +259,12 @@ public:
     /// @brief Construct a typed subscriber for the given topic.
     /// @param topic Topic name of the shared memory region to open.
     /// @param options Subscriber configuration.
+    /// @throws SubscriberError If the topic cannot be opened or its publisher
+    ///         publishes a different message type.
     Subscriber(const std::string& topic, const SubscriberOptions& options = {})
-        : impl_(topic, options) {
+        : impl_(topic, options, internal::frame_offset<T>()) {
         validate();
+        impl_.check_type(internal::type_info_v<T>);
     }
 
     /// @brief Move constructor.
@@ -157,17 +305,7 @@ private:
     internal::Subscriber impl_;
 
     static TypedMessage<T> convert(const Message& msg) {
-        T data = [&]() {
-            if constexpr (std::is_base_of_v<FixedMessageType, T>) {
-                T d;
-                std::memcpy(&d, msg.data, sizeof(T));
-                return d;
-            } else {
-                return T::deserialize(
-                    static_cast<const uint8_t*>(msg.data), msg.size);
-            }
-        }();
-        return TypedMessage<T>{std::move(data), msg.sequence, msg.timestamp_ns};
+        return TypedMessage<T>{internal::decode_message<T>(msg), msg.sequence, msg.timestamp_ns};
     }
 
     static constexpr void validate() {
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "conduit_core/subscriber.hpp"
+
+#include <conduit_types/header.hpp>
+
+namespace conduit {
+
+/// @brief Matching policy for time-synchronized subscriptions.
+struct SyncOptions {
+    /// Maximum spread between the stamps of a matched set.
+    /// Zero requires identical stamps (exact policy).
+    std::chrono::nanoseconds window{0};
+};
+
+namespace internal {
+
+/// @brief Extracts the stamp used for matching from a raw message.
+using StampFn = uint64_t (*)(const Message&);
+
+/// @brief Type-erased core of the multi-topic synchronizer.
+///
+/// Holds one ring buffer reader per topic and matches messages in place:
+/// candidates are inspected with Subscriber::peek() and only consumed once
+/// they are either part of a match or can no longer match. No message is
+/// copied, and no memory is allocated after construction.
+///
+/// @see conduit::Synchronizer
+class SyncCore {
+public:
+    /// @brief Open a reader for every topic.
+    /// @param topics Topic names (at least two).
+    /// @param stamps Stamp extractor per topic.
+    /// @param options Matching policy.
+    /// @param types Expected message type per topic (empty = not checked).
+    /// @throws SubscriberError If a topic cannot be opened or carries another type.
+    SyncCore(const std::vector<std::string>& topics,
+             const std::vector<StampFn>& stamps,
+             const SyncOptions& options,
+             const std::vector<TypeInfo>& types = {});
+
+    /// @brief Try to form a match from messages already in the rings.
+    ///
+    /// On success matched() holds one message per topic, still in shared
+    /// memory, until consume() is called.
+    ///
+    /// @return true if a match is ready.
+    bool try_match();
+
+    /// @brief Block until a match is ready or timeout expires.
+    /// @param timeout Maximum time to wait.
+    /// @return true if a match is ready.
+    bool wait_for_match(std::chrono::nanoseconds timeout);
+
+    /// @brief Messages of the current match, in topic order.
+    /// @return One message per topic (valid until consume()).
+    const std::vector<Message>& matched() const { return heads_; }
+
+    /// @brief Consume the current match.
+    void consume();
+
+    /// @brief Number of messages skipped because they could not be matched.
+    /// @return Dropped message count since construction.
+    uint64_t dropped() const { return dropped_; }
+
+private:
+    std::vector<std::unique_ptr<Subscriber>> subscribers_;
+    std::vector<StampFn> stamps_;
+    std::vector<Message> heads_;
+    std::vector<uint64_t> head_stamps_;
+    uint64_t window_ns_;
+    uint64_t dropped_ = 0;
+    size_t missing_ = 0;  ///< Topic without a queued message after a failed try_match().
+};
+
+/// @brief Stamp used to match messages of type T.
+///
+/// Fixed types with a `Header header` member are matched on
+/// `header.timestamp_ns`, read straight from shared memory. Everything else
+/// is matched on the publish timestamp of the slot.
+///
+/// @tparam T Message type.
+/// @param msg Raw message.
+/// @return Stamp in nanoseconds.
+template <typename T>
+uint64_t message_stamp(const Message& msg) {
+    if constexpr (std::is_base_of_v<FixedMessageType, T> && has_header<T>::value) {
+        uint64_t stamp;
+        std::memcpy(&stamp,
+                    static_cast<const uint8_t*>(msg.data)
+                        + offsetof(T, header) + offsetof(Header, timestamp_ns),
+                    sizeof(stamp));
+        return stamp;
+    } else {
+        return msg.timestamp_ns;
+    }
+}
+
+}  // namespace internal
+
+/// @brief Delivers sets of messages from several topics that share a timestamp.
+///
+/// Each topic's messages stay in its ring buffer until they are matched or
+/// can no longer be matched; only matched messages are decoded. With a zero
+/// SyncOptions::window, stamps must be identical (exact policy). Otherwise
+/// the newest stamp among the topics' oldest messages is the pivot, each
+/// topic contributes its message closest to (and not after) the pivot, and
+/// the set is delivered if all stamps lie within the window (approximate
+/// policy).
+///
+/// Stamps come from `header.timestamp_ns` for fixed types that have a
+/// Header, and from the publish timestamp otherwise.
+///
+/// @code
+/// Synchronizer<Image, PointCloud, Imu> sync({"camera", "lidar", "imu"},
+///                                          SyncOptions{5ms});
+/// if (auto set = sync.wait_for(100ms)) {
+///     auto& [image, cloud, imu] = *set;
+/// }
+/// @endcode
+///
+/// @tparam Ts Message types, one per topic.
+/// @see SyncOptions, Node::synchronize
+template <typename... Ts>
+class Synchronizer {
+public:
+    static_assert(sizeof...(Ts) >= 2, "Synchronizer needs at least two topics");
+
+    /// @brief Tuple of typed messages delivered per match.
+    using Match = std::tuple<TypedMessage<Ts>...>;
+
+    /// @brief Construct a synchronizer over the given topics.
+    /// @param topics Topic names, in the order of Ts.
+    /// @param options Matching policy.
+    /// @throws SubscriberError If a topic cannot be opened or carries another type.
+    Synchronizer(const std::array<std::string, sizeof...(Ts)>& topics,
+                 const SyncOptions& options = {})
+        : core_(std::vector<std::string>(topics.begin(), topics.end()),
+                {&internal::message_stamp<Ts>...},
+                options,
+                {internal::type_info_v<Ts>...}) {}
+
+    /// @brief Non-blocking read of the next matched set.
+    /// @return Decoded messages, or std::nullopt if no match is ready.
+    std::optional<Match> take() {
+        if (!core_.try_match()) return std::nullopt;
+        return consume();
+    }
+
+    /// @brief Block until a matched set is available or timeout expires.
+    /// @param timeout Maximum time to wait.
+    /// @return Decoded messages, or std::nullopt on timeout.
+    std::optional<Match> wait_for(std::chrono::nanoseconds timeout) {
+        if (!core_.wait_for_match(timeout)) return std::nullopt;
+        return consume();
+    }
+
+    /// @brief Number of messages skipped because they could not be matched.
+    /// @return Dropped message count since construction.
+    uint64_t dropped() const { return core_.dropped(); }
+
+private:
+    internal::SyncCore core_;
+
+    Match consume() {
+        Match match = decode(core_.matched(), std::index_sequence_for<Ts...>{});
+        core_.consume();
+        return match;
+    }
+
+    template <size_t... Is>
+    static Match decode(const std::vector<Message>& msgs, std::index_sequence<Is...>) {
+        return Match{TypedMessage<Ts>{internal::decode_message<Ts>(msgs[Is]),
+                                      msgs[Is].sequence, msgs[Is].timestamp_ns}...};
+    }
+};
+
+}  // namespace conduit
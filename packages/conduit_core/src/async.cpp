@@ -0,0 +1,335 @@
+/**
+ * @file async.cpp
+ * @brief Coroutine scheduler - many waiting tasks, few threads
+ *
+ * == Why not a thread per subscription? ==
+ *
+ * Node gives every subscription its own thread. That is simple, but logic
+ * like "send a request, wait for the matching reply, then wait for the next
+ * state update" turns into state machines spread over several callbacks.
+ * Coroutines let that logic read top to bottom:
+ *
+ *   auto state = co_await state_sub.next();
+ *   auto reply = co_await when_any(ack_sub, nack_sub);
+ *   co_await sleep_for(10ms);
+ *
+ * A suspended coroutine is just a heap frame, so thousands of them are fine.
+ *
+ * == How waiting works ==
+ *
+ * Every ring buffer already has a futex word that the publisher bumps after
+ * each write. A task that finds no message records (word, value it saw) in a
+ * WaitNode and suspends. The scheduler keeps a list of these nodes.
+ *
+ *   Worker threads:   pop ready coroutine -> resume it -> repeat
+ *   Reactor (one idle worker at a time):
+ *     1. Resume nodes whose word changed or whose deadline passed
+ *     2. Otherwise futex_waitv() on every distinct word + our own wake word,
+ *        with a timeout at the earliest deadline
+ *
+ * The wake word is bumped whenever a coroutine becomes ready or a new node is
+ * parked, so the reactor never sleeps on a stale list.
+ *
+ * == Limits ==
+ *
+ * futex_waitv() takes at most 128 words. With more distinct topics than
+ * that, the reactor waits on the first 127 and polls the rest every 1 ms.
+ */
+
+#include "conduit_core/async.hpp"
+#include "conduit_core/exceptions.hpp"
+#include "conduit_core/log.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+namespace conduit::async {
+
+namespace {
+
+thread_local Scheduler* current_scheduler = nullptr;
+
+}  // namespace
+
+/**
+ * Top-level coroutine wrapping a spawned Task.
+ *
+ * Nobody awaits it, so its final awaiter hands the frame back to the
+ * scheduler, which destroys it and counts the task as finished.
+ */
+struct Scheduler::Root {
+    struct promise_type {
+        Scheduler* scheduler = nullptr;
+
+        Root get_return_object() {
+            return Root{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                Scheduler* scheduler = h.promise().scheduler;
+                void* address = h.address();
+                h.destroy();
+                scheduler->finish_root(address);
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() {}  // run_root() catches everything
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+Scheduler::Root Scheduler::run_root(Scheduler* scheduler, Task<void> task) {
+    (void)scheduler;
+    try {
+        co_await task;
+    } catch (const std::exception& e) {
+        log::error("Unhandled exception in task: {}", e.what());
+    } catch (...) {
+        log::error("Unhandled exception in task");
+    }
+}
+
+Scheduler::Scheduler(size_t threads) : threads_(std::max<size_t>(threads, 1)) {}
+
+Scheduler::~Scheduler() {
+    // Tasks still parked when run() returned: destroying the root frame
+    // destroys the Task chain it owns
+    std::lock_guard<std::mutex> lock(roots_mutex_);
+    for (void* address : roots_) {
+        std::coroutine_handle<>::from_address(address).destroy();
+    }
+}
+
+Scheduler* Scheduler::current() {
+    return current_scheduler;
+}
+
+void Scheduler::spawn(Task<void> task) {
+    Root root = run_root(this, std::move(task));
+    root.handle.promise().scheduler = this;
+    {
+        std::lock_guard<std::mutex> lock(roots_mutex_);
+        roots_.insert(root.handle.address());
+    }
+    pending_.fetch_add(1, std::memory_order_acq_rel);
+    post(root.handle);
+}
+
+void Scheduler::finish_root(void* address) {
+    {
+        std::lock_guard<std::mutex> lock(roots_mutex_);
+        roots_.erase(address);
+    }
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        notify();  // Last task: let every worker see pending_ == 0
+    }
+}
+
+void Scheduler::run() {
+    stopping_.store(false, std::memory_order_release);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threads_; ++i) {
+        threads.emplace_back(&Scheduler::worker, this);
+    }
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void Scheduler::stop() {
+    stopping_.store(true, std::memory_order_release);
+    notify();
+}
+
+void Scheduler::notify() {
+    wake_word_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        internal::futex_wake_all(&wake_word_);
+    }
+}
+
+void Scheduler::post(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_.push_back(handle);
+    }
+    notify();
+}
+
+void Scheduler::wait(detail::WaitNode* node) {
+    {
+        std::lock_guard<std::mutex> lock(waits_mutex_);
+        waits_.push_back(node);
+    }
+    notify();  // The reactor may be asleep on an older list
+}
+
+std::coroutine_handle<> Scheduler::pop_ready() {
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    if (ready_.empty()) {
+        return nullptr;
+    }
+    auto handle = ready_.front();
+    ready_.pop_front();
+    return handle;
+}
+
+/**
+ * Worker loop.
+ *
+ * Resume ready coroutines; when there are none, become the reactor if
+ * nobody else is, otherwise sleep on the wake word.
+ */
+void Scheduler::worker() {
+    current_scheduler = this;
+
+    while (!stopping_.load(std::memory_order_acquire)
+           && pending_.load(std::memory_order_acquire) > 0) {
+        if (auto handle = pop_ready()) {
+            handle.resume();
+            continue;
+        }
+
+        if (!reactor_active_.exchange(true, std::memory_order_acq_rel)) {
+            poll();
+            reactor_active_.store(false, std::memory_order_release);
+            continue;
+        }
+
+        // Idle: announce, re-check, sleep
+        uint32_t seen = wake_word_.load(std::memory_order_acquire);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        bool empty;
+        {
+            std::lock_guard<std::mutex> lock(ready_mutex_);
+            empty = ready_.empty();
+        }
+        if (empty) {
+            internal::futex_wait(&wake_word_, seen, 100ms);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    current_scheduler = nullptr;
+}
+
+/**
+ * One reactor pass.
+ *
+ * Steps:
+ * 1. Under the lock, resume nodes that are due; collect the rest's words
+ * 2. If anything became ready, return so workers can run it
+ * 3. Otherwise sleep in futex_waitv() until a word changes, the wake word
+ *    changes, or the earliest deadline passes
+ */
+void Scheduler::poll() {
+    uint32_t wake_seen = wake_word_.load(std::memory_order_acquire);
+
+    poll_entries_.clear();
+    poll_ready_.clear();
+    std::optional<std::chrono::steady_clock::time_point> next_deadline;
+    bool overflow = false;
+
+    {
+        std::lock_guard<std::mutex> lock(waits_mutex_);
+        auto now = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < waits_.size();) {
+            detail::WaitNode* node = waits_[i];
+
+            bool ready = false;
+            if (node->deadline && *node->deadline <= now) {
+                node->timed_out = true;
+                ready = true;
+            } else {
+                for (size_t e = 0; e < node->count; ++e) {
+                    const auto& entry = node->entries[e];
+                    if (entry.futex_word->load(std::memory_order_acquire) != entry.expected_value) {
+                        ready = true;
+                        break;
+                    }
+                }
+            }
+
+            if (ready) {
+                poll_ready_.push_back(node->handle);
+                waits_[i] = waits_.back();
+                waits_.pop_back();
+                continue;
+            }
+
+            if (node->deadline && (!next_deadline || *node->deadline < *next_deadline)) {
+                next_deadline = node->deadline;
+            }
+
+            // Distinct words only; one slot is kept for the wake word
+            for (size_t e = 0; e < node->count; ++e) {
+                const auto& entry = node->entries[e];
+                bool seen = std::any_of(poll_entries_.begin(), poll_entries_.end(),
+                    [&](const internal::FutexWaitEntry& p) { return p.futex_word == entry.futex_word; });
+                if (seen) {
+                    continue;
+                }
+                if (poll_entries_.size() + 1 < internal::MAX_FUTEX_WAIT_ENTRIES) {
+                    poll_entries_.push_back(entry);
+                } else {
+                    overflow = true;
+                }
+            }
+            ++i;
+        }
+    }
+
+    if (!poll_ready_.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(ready_mutex_);
+            ready_.insert(ready_.end(), poll_ready_.begin(), poll_ready_.end());
+        }
+        notify();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        if (!ready_.empty()) {
+            return;
+        }
+    }
+
+    std::chrono::nanoseconds timeout = 100ms;
+    if (next_deadline) {
+        auto remaining = *next_deadline - std::chrono::steady_clock::now();
+        timeout = std::max(std::chrono::nanoseconds::zero(),
+                           std::min(timeout, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining)));
+    }
+    if (overflow) {
+        timeout = std::min<std::chrono::nanoseconds>(timeout, 1ms);
+    }
+
+    poll_entries_.push_back({&wake_word_, wake_seen});
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    internal::futex_wait_any(poll_entries_.data(), poll_entries_.size(), timeout);
+    sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void detail::WaitAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    Scheduler* scheduler = Scheduler::current();
+    if (scheduler == nullptr) {
+        throw ConduitError("conduit::async awaitable used outside of Scheduler::run()");
+    }
+    node.handle = handle;
+    scheduler->wait(&node);
+}
+
+}  // namespace conduit::async
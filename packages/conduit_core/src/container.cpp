@@ -0,0 +1,110 @@
+#include "conduit_core/container.hpp"
+#include "conduit_core/internal/scheduling.hpp"
+#include "conduit_core/log.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace conduit {
+
+std::atomic<Container*> Container::active_container_{nullptr};
+
+void Container::signal_handler(int sig) {
+    (void)sig;
+    if (auto* container = active_container_.load(std::memory_order_relaxed)) {
+        container->stop();
+    }
+}
+
+Container::~Container() {
+    stop();
+}
+
+Node& Container::add(std::unique_ptr<Node> node) {
+    if (running_.load(std::memory_order_acquire)) {
+        throw NodeError("Cannot add node while container is running");
+    }
+    if (!node) {
+        throw NodeError("Cannot add null node");
+    }
+
+    nodes_.push_back(std::move(node));
+    return *nodes_.back();
+}
+
+void Container::run() {
+    if (running_.load(std::memory_order_acquire)) {
+        throw NodeError("Container already running");
+    }
+    for (const auto& node : nodes_) {
+        if (node->running()) {
+            throw NodeError("Node already running");
+        }
+    }
+
+    // mlockall() is process-wide, so one node asking is enough
+    for (const auto& node : nodes_) {
+        if (node->options_.lock_memory) {
+            if (internal::lock_memory()) {
+                log::info("Memory locked (mlockall)");
+            }
+            break;
+        }
+    }
+
+    active_container_.store(this, std::memory_order_relaxed);
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    running_.store(true, std::memory_order_release);
+    for (auto& node : nodes_) {
+        node->running_.store(true, std::memory_order_release);
+    }
+
+    bool started = true;
+    for (auto& node : nodes_) {
+        if (!node->start()) {
+            started = false;  // Stopped while waiting for a topic
+            break;
+        }
+    }
+
+    if (started) {
+        log::info("Container running {} nodes. Press Ctrl+C to stop.", nodes_.size());
+
+        // Wait for stop signal
+        while (running_.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(100ms);
+        }
+    }
+
+    for (auto& node : nodes_) {
+        node->stop();
+    }
+    for (auto& node : nodes_) {
+        node->join();
+    }
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    active_container_.store(nullptr, std::memory_order_relaxed);
+    running_.store(false, std::memory_order_release);
+
+    log::info("Container stopped.");
+}
+
+void Container::stop() {
+    running_.store(false, std::memory_order_release);
+    for (auto& node : nodes_) {
+        node->stop();
+    }
+}
+
+bool Container::running() const {
+    return running_.load(std::memory_order_acquire);
+}
+
+}  // namespace conduit
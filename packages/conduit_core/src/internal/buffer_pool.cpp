@@ -0,0 +1,201 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief Shared memory buffer pool - Large messages without the copy into a slot
+ *
+ * == Why? ==
+ *
+ * A 12 MB point cloud published through the ring is built somewhere, then
+ * copied into a slot. With a pool the publisher builds it directly in a
+ * shared block and only a 16-byte BlockHandle goes through the ring:
+ *
+ *   Publisher                    Ring                 Subscriber
+ *   ─────────                    ────                 ──────────
+ *   loan() -> block 3
+ *   fill block 3 in place
+ *   publish(loan)  ───────────>  [idx 7: {3, tag, size}]
+ *                                            ───────>  try_acquire(block 3)
+ *                                                      read block 3 (zero copy)
+ *                                                      release on next take()
+ *
+ * == Reference counts ==
+ *
+ * Each block has a reference count in shared memory. The ring slot holds
+ * one reference until the publisher laps it, and each subscriber holds one
+ * while the message is its current one. The last release puts the block
+ * back on the free list.
+ *
+ * A subscriber can read a handle after the block was released and reused
+ * (it fell a lap behind). The block's tag, bumped on every allocation,
+ * tells: try_acquire() only succeeds while tag and handle agree and the
+ * count is non-zero, checked and incremented in one CAS.
+ *
+ * == Free list ==
+ *
+ * A Treiber stack: free_head holds the top block's index, each free block
+ * the index of the next. The head also carries a counter bumped on every
+ * pop, so a pop that read a head which has since been popped and pushed
+ * again fails its CAS instead of corrupting the list (ABA).
+ *
+ *   free_head = (5 << 32) | 2     block 2 -> block 0 -> block 7 -> NIL
+ *   pop:        CAS to (6 << 32) | 0, hand out block 2
+ */
+
+#include "conduit_core/internal/buffer_pool.hpp"
+
+#include <cassert>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+constexpr uint64_t LOW_MASK = 0xffffffffull;
+
+size_t round_block_size(uint32_t block_size) {
+    return (static_cast<size_t>(block_size) + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+}
+
+size_t blocks_offset() {
+    return (sizeof(PoolHeader) + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+}
+
+}  // namespace
+
+size_t BufferPool::calculate_region_size(uint32_t block_count, uint32_t block_size) {
+    return blocks_offset() + static_cast<size_t>(block_count) * sizeof(PoolBlock)
+         + static_cast<size_t>(block_count) * round_block_size(block_size);
+}
+
+/**
+ * Set up an empty pool.
+ *
+ * Steps:
+ * 1. Record the geometry
+ * 2. Chain all blocks into the free list: 0 -> 1 -> ... -> NIL
+ * 3. Release fence, as for RingBufferWriter::initialize()
+ */
+void BufferPool::initialize(void* region, uint32_t block_count, uint32_t block_size) {
+    // Step 1
+    auto* header = static_cast<PoolHeader*>(region);
+    header->block_count = block_count;
+    header->block_size = static_cast<uint32_t>(round_block_size(block_size));
+
+    // Step 2
+    auto* blocks = reinterpret_cast<PoolBlock*>(static_cast<uint8_t*>(region) + blocks_offset());
+    for (uint32_t i = 0; i < block_count; ++i) {
+        blocks[i].state.store(0, std::memory_order_relaxed);
+        blocks[i].next_free.store(i + 1 < block_count ? i + 1 : POOL_NIL, std::memory_order_relaxed);
+    }
+    header->free_head.store(block_count > 0 ? 0 : POOL_NIL, std::memory_order_relaxed);
+
+    // Step 3
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+BufferPool::BufferPool(void* region)
+    : header_(static_cast<PoolHeader*>(region)),
+      blocks_(reinterpret_cast<PoolBlock*>(static_cast<uint8_t*>(region) + blocks_offset())),
+      data_(reinterpret_cast<uint8_t*>(blocks_ + header_->block_count)) {
+}
+
+/**
+ * Pop a block off the free list.
+ *
+ * Steps:
+ * 1. Read the head; NIL means the pool is exhausted
+ * 2. CAS the head to the next free block, bumping the pop counter
+ * 3. Start a new use of the block: next tag, one reference
+ */
+std::optional<BlockHandle> BufferPool::allocate(size_t size) {
+    if (size > header_->block_size) {
+        return std::nullopt;
+    }
+
+    // Step 1
+    uint64_t head = header_->free_head.load(std::memory_order_acquire);
+    uint32_t index;
+    while (true) {
+        index = static_cast<uint32_t>(head & LOW_MASK);
+        if (index == POOL_NIL) {
+            return std::nullopt;
+        }
+
+        // Step 2 - next_free may be stale if another thread won; the CAS then fails
+        uint32_t next = blocks_[index].next_free.load(std::memory_order_relaxed);
+        uint64_t replacement = (((head >> 32) + 1) << 32) | next;
+        if (header_->free_head.compare_exchange_weak(head, replacement,
+                                                     std::memory_order_acquire,
+                                                     std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    // Step 3 - nobody can acquire a block with count 0, so a plain store is safe
+    uint32_t tag = static_cast<uint32_t>(blocks_[index].state.load(std::memory_order_relaxed) >> 32) + 1;
+    blocks_[index].state.store((static_cast<uint64_t>(tag) << 32) | 1, std::memory_order_release);
+    return BlockHandle{index, tag, size};
+}
+
+bool BufferPool::try_acquire(const BlockHandle& handle) {
+    if (handle.index >= header_->block_count) {
+        return false;
+    }
+
+    auto& state = blocks_[handle.index].state;
+    uint64_t current = state.load(std::memory_order_acquire);
+    while (static_cast<uint32_t>(current >> 32) == handle.tag && (current & LOW_MASK) != 0) {
+        if (state.compare_exchange_weak(current, current + 1,
+                                        std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+            return true;
+        }
+    }
+    return false;  // Released and possibly reused since the handle was written
+}
+
+void BufferPool::release(const BlockHandle& handle) {
+    uint64_t previous = blocks_[handle.index].state.fetch_sub(1, std::memory_order_acq_rel);
+    assert(static_cast<uint32_t>(previous >> 32) == handle.tag && (previous & LOW_MASK) != 0);
+    if ((previous & LOW_MASK) == 1) {
+        push_free(handle.index);
+    }
+}
+
+bool BufferPool::valid(const BlockHandle& handle) const {
+    if (handle.index >= header_->block_count) {
+        return false;
+    }
+    uint64_t current = blocks_[handle.index].state.load(std::memory_order_acquire);
+    return static_cast<uint32_t>(current >> 32) == handle.tag && (current & LOW_MASK) != 0;
+}
+
+/**
+ * Push a block back on the free list.
+ *
+ * Pushes keep the counter: only pops need it to tell heads apart.
+ */
+void BufferPool::push_free(uint32_t index) {
+    uint64_t head = header_->free_head.load(std::memory_order_relaxed);
+    while (true) {
+        blocks_[index].next_free.store(static_cast<uint32_t>(head & LOW_MASK), std::memory_order_relaxed);
+        uint64_t replacement = (head & ~LOW_MASK) | index;
+        if (header_->free_head.compare_exchange_weak(head, replacement,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+uint32_t BufferPool::free_count() const {
+    uint32_t count = 0;
+    uint32_t index = static_cast<uint32_t>(header_->free_head.load(std::memory_order_acquire) & LOW_MASK);
+    while (index != POOL_NIL && count < header_->block_count) {
+        index = blocks_[index].next_free.load(std::memory_order_relaxed);
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,216 @@
+/**
+ * @file fd_passing.cpp
+ * @brief File descriptor passing - How memfd topics are found by subscribers
+ *
+ * == Why? ==
+ *
+ * A memfd (memfd_create) is shared memory without a file name. Nothing is
+ * left behind in /dev/shm when the publisher crashes: the memory is freed
+ * once the last process holding the fd or a mapping of it goes away.
+ *
+ * The catch: a subscriber cannot shm_open() something without a name. It
+ * has to get the fd itself from the publisher.
+ *
+ * == How ==
+ *
+ * Unix domain sockets can carry file descriptors (SCM_RIGHTS). The kernel
+ * installs a duplicate of the sender's fd in the receiving process:
+ *
+ *   Publisher                               Subscriber
+ *   ─────────                               ──────────
+ *   memfd_create()  -> fd 7
+ *   FdServer: listen on @conduit/cam
+ *                                           connect(@conduit/cam)
+ *   accept() -> sendmsg(SCM_RIGHTS, 7)  ──>  recvmsg() -> fd 12
+ *                                           mmap(fd 12)  (same pages)
+ *
+ * The socket lives in the abstract namespace (leading '\0' in sun_path):
+ * it has no file either, and disappears with the publisher process.
+ */
+
+#include "conduit_core/internal/fd_passing.hpp"
+#include "conduit_core/exceptions.hpp"
+
+#include <sys/socket.h>  // socket, bind, listen, accept4, sendmsg, recvmsg
+#include <sys/un.h>      // sockaddr_un
+#include <unistd.h>      // close
+#include <cerrno>
+#include <cstddef>       // offsetof
+#include <cstring>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+/**
+ * Build the abstract socket address for a name.
+ *
+ * Example: "cam" -> "\0conduit/cam" (shown as @conduit/cam in ss / netstat)
+ */
+socklen_t make_address(const std::string& name, sockaddr_un& addr) {
+    std::string path = std::string(1, '\0') + "conduit/" + name;
+    if (path.size() > sizeof(addr.sun_path)) {
+        throw ShmError("Name too long for fd registry: " + name);
+    }
+
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.data(), path.size());
+    // Abstract names are not null-terminated: the length is the name
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size());
+}
+
+/**
+ * Connect to the server for a name. Returns the socket, or -1.
+ */
+int connect_to(const std::string& name) {
+    sockaddr_un addr;
+    socklen_t len = make_address(name, addr);
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        return -1;
+    }
+    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), len) < 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/**
+ * Send one fd over a connected socket.
+ *
+ * SCM_RIGHTS needs at least one byte of ordinary data to travel with it.
+ */
+void send_fd(int sock, int fd) {
+    char byte = 0;
+    iovec iov{&byte, 1};
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    // The client may already be gone (exists() checks); no SIGPIPE
+    sendmsg(sock, &msg, MSG_NOSIGNAL);
+}
+
+}  // namespace
+
+/**
+ * Start serving.
+ *
+ * Steps:
+ * 1. Bind the abstract name - EADDRINUSE means another publisher has it
+ * 2. listen()
+ * 3. Start the accept thread
+ */
+FdServer::FdServer(const std::string& name, int fd) : fd_(fd) {
+    sockaddr_un addr;
+    socklen_t len = make_address(name, addr);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        throw ShmError("socket failed for '" + name + "': " + strerror(errno));
+    }
+
+    // Step 1 + 2
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), len) < 0
+        || listen(listen_fd_, 16) < 0) {
+        int err = errno;
+        close(listen_fd_);
+        if (err == EADDRINUSE) {
+            throw ShmError("Shared memory already exists: " + name);
+        }
+        throw ShmError("Cannot serve '" + name + "': " + strerror(err));
+    }
+
+    // Step 3
+    thread_ = std::thread(&FdServer::serve, this);
+}
+
+/**
+ * Stop serving.
+ *
+ * shutdown() on a listening socket makes a blocked accept() return, so the
+ * thread exits without polling.
+ */
+FdServer::~FdServer() {
+    running_.store(false, std::memory_order_release);
+    shutdown(listen_fd_, SHUT_RDWR);
+    thread_.join();
+    close(listen_fd_);
+    close(fd_);
+}
+
+/**
+ * Accept loop: every connection gets the fd, then is closed.
+ */
+void FdServer::serve() {
+    while (running_.load(std::memory_order_acquire)) {
+        int client = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;  // Shut down
+        }
+        send_fd(client, fd_);
+        close(client);
+    }
+}
+
+/**
+ * Fetch the fd from the server.
+ *
+ * MSG_CMSG_CLOEXEC: the received fd must not leak into processes we exec
+ * (conduit flow starts nodes that way).
+ */
+int receive_fd(const std::string& name) {
+    int sock = connect_to(name);
+    if (sock < 0) {
+        return -1;
+    }
+
+    char byte;
+    iovec iov{&byte, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    int fd = -1;
+    if (recvmsg(sock, &msg, MSG_CMSG_CLOEXEC) > 0) {
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+
+    close(sock);
+    return fd;
+}
+
+bool fd_server_exists(const std::string& name) {
+    int sock = connect_to(name);
+    if (sock < 0) {
+        return false;
+    }
+    close(sock);
+    return true;
+}
+
+}  // namespace internal
+}  // namespace conduit
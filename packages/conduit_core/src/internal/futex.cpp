@@ -56,8 +56,14 @@
 #include <linux/futex.h>  // FUTEX_WAIT, FUTEX_WAKE
 #include <sys/syscall.h>  // SYS_futex
 #include <unistd.h>       // syscall()
+#include <algorithm>      // std::min
 #include <cerrno>         // errno, EAGAIN, ETIMEDOUT
 #include <climits>        // INT_MAX
+#include <ctime>          // clock_gettime
+
+#ifndef SYS_futex_waitv
+#define SYS_futex_waitv 449
+#endif
 
 namespace conduit::internal {
 
@@ -175,4 +181,75 @@ int futex_wake_all(std::atomic<uint32_t>* futex_word) {
     return futex_wake(futex_word, INT_MAX);
 }
 
+/**
+ * Wait on several futex words at once.
+ *
+ * futex_waitv() is to futex_wait() what poll() is to read(): one sleeping
+ * thread can watch many ring buffers. The coroutine scheduler uses it to
+ * wait for every topic its tasks are blocked on.
+ *
+ * Unlike FUTEX_WAIT, the timeout is an ABSOLUTE CLOCK_MONOTONIC time.
+ */
+bool futex_wait_any(
+    const FutexWaitEntry* entries,
+    size_t count,
+    std::optional<std::chrono::nanoseconds> timeout
+) {
+    if (count == 0) {
+        return true;
+    }
+
+    // Kernel ABI (linux/futex.h only has it from 5.16 headers on)
+    struct WaitV {
+        uint64_t val;
+        uint64_t uaddr;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    constexpr uint32_t futex_32 = 2;  // FUTEX_32: 32-bit futex word
+    WaitV waiters[MAX_FUTEX_WAIT_ENTRIES];
+    count = std::min(count, MAX_FUTEX_WAIT_ENTRIES);
+    for (size_t i = 0; i < count; ++i) {
+        waiters[i].val = entries[i].expected_value;
+        waiters[i].uaddr = reinterpret_cast<uint64_t>(entries[i].futex_word);
+        waiters[i].flags = futex_32;
+        waiters[i].reserved = 0;
+    }
+
+    struct timespec deadline;
+    struct timespec* deadline_ptr = nullptr;
+    if (timeout.has_value()) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        int64_t ns = deadline.tv_nsec + timeout->count();
+        deadline.tv_sec += static_cast<time_t>(ns / 1'000'000'000);
+        deadline.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        deadline_ptr = &deadline;
+    }
+
+    long result = syscall(SYS_futex_waitv, waiters, static_cast<unsigned int>(count), 0,
+                          deadline_ptr, CLOCK_MONOTONIC);
+    if (result >= 0) {
+        return true;  // Index of the woken futex
+    }
+
+    if (errno == ETIMEDOUT) {
+        return false;
+    }
+
+    if (errno == ENOSYS) {
+        // Pre-5.16 kernel: sleep on the first word, wake up often enough
+        // for the caller to notice changes on the others
+        std::chrono::nanoseconds slice = std::chrono::milliseconds(1);
+        if (timeout.has_value()) {
+            slice = std::min(slice, *timeout);
+        }
+        futex_wait(entries[0].futex_word, entries[0].expected_value, slice);
+        return !timeout.has_value() || *timeout > slice;
+    }
+
+    // EAGAIN (a word already changed), EINTR: caller re-checks
+    return true;
+}
+
 }  // namespace conduit::internal
@@ -0,0 +1,180 @@
+/**
+ * @file intra_process.cpp
+ * @brief Intra-process delivery - skipping shared memory inside one process
+ *
+ * == Why? ==
+ *
+ * The shared memory ring is the right transport between processes, but when
+ * a publisher and subscriber live in the same process (for example, several
+ * nodes loaded into one Container) it does needless work:
+ *
+ *   publish():  serialize/memcpy into the slot, futex_wake syscall
+ *   callback:   memcpy/deserialize back out of the slot
+ *
+ * Inside one address space we can just hand over the object itself:
+ *
+ *   Publisher<T>  --shared_ptr<const T>-->  IntraProcessQueue  -->  callback
+ *
+ * == How it fits together ==
+ *
+ *   IntraProcessManager   Process-wide map: topic -> channel
+ *   IntraProcessChannel   One per publisher, fans out to queues
+ *   IntraProcessQueue     One per subscriber, bounded and lossy like the ring
+ *
+ * The publisher still owns the shm ring. It writes to the ring whenever a
+ * reader from another process (or `conduit echo`, `conduit record`, ...) has
+ * claimed a slot, so tooling keeps seeing every topic.
+ *
+ * == Waking subscribers ==
+ *
+ * The queue uses a process-private futex word. Unlike the ring, which always
+ * calls futex_wake_all(), the producer only enters the kernel when the
+ * consumer has announced that it is about to sleep. A busy subscriber costs
+ * the publisher no syscalls at all.
+ */
+
+#include "conduit_core/internal/intra_process.hpp"
+#include "conduit_core/internal/futex.hpp"
+
+#include <algorithm>
+
+namespace conduit::internal {
+
+// === IntraProcessQueue ===
+
+IntraProcessQueue::IntraProcessQueue(size_t depth)
+    : buffer_(std::max<size_t>(depth, 1)) {}
+
+/**
+ * Enqueue a message.
+ *
+ * When the queue is full the oldest message is overwritten, matching the
+ * ring buffer where a slow subscriber gets lapped.
+ *
+ * Steps:
+ * 1. Insert under the lock
+ * 2. Bump the futex word (so a consumer about to sleep returns immediately)
+ * 3. Wake only if the consumer is actually sleeping
+ */
+void IntraProcessQueue::push(IntraProcessMessage msg) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t tail = (head_ + count_) % buffer_.size();
+        buffer_[tail] = std::move(msg);
+        if (count_ == buffer_.size()) {
+            head_ = (head_ + 1) % buffer_.size();  // Dropped the oldest
+        } else {
+            ++count_;
+        }
+    }
+
+    futex_word_.fetch_add(1, std::memory_order_release);
+    if (sleeping_.load(std::memory_order_seq_cst)) {
+        futex_wake_all(&futex_word_);
+    }
+}
+
+std::optional<IntraProcessMessage> IntraProcessQueue::try_pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (count_ == 0) {
+        return std::nullopt;
+    }
+    IntraProcessMessage msg = std::move(buffer_[head_]);
+    buffer_[head_].data.reset();  // Don't keep the object alive in the queue
+    head_ = (head_ + 1) % buffer_.size();
+    --count_;
+    return msg;
+}
+
+/**
+ * Block until a message arrives or the timeout expires.
+ *
+ * Same pattern as RingBufferReader::wait_for():
+ * 1. Load the futex word
+ * 2. Announce we are about to sleep, then re-check the queue
+ * 3. futex_wait() on the loaded value - if push() already bumped it,
+ *    the kernel returns immediately
+ */
+std::optional<IntraProcessMessage> IntraProcessQueue::wait_for(std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        uint32_t seq = futex_word_.load(std::memory_order_acquire);
+        sleeping_.store(true, std::memory_order_seq_cst);
+
+        auto msg = try_pop();
+        if (msg.has_value()) {
+            sleeping_.store(false, std::memory_order_relaxed);
+            return msg;
+        }
+
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            sleeping_.store(false, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        futex_wait(&futex_word_, seq,
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+}
+
+// === IntraProcessChannel ===
+
+void IntraProcessChannel::deliver(std::shared_ptr<const void> data, uint64_t timestamp_ns) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    IntraProcessMessage msg{std::move(data), sequence_++, timestamp_ns};
+    for (auto& queue : queues_) {
+        queue->push(msg);  // Copies the shared_ptr, not the object
+    }
+}
+
+void IntraProcessChannel::attach(std::shared_ptr<IntraProcessQueue> queue) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queues_.push_back(std::move(queue));
+    subscriber_count_.store(queues_.size(), std::memory_order_release);
+}
+
+void IntraProcessChannel::detach(const std::shared_ptr<IntraProcessQueue>& queue) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queues_.erase(std::remove(queues_.begin(), queues_.end(), queue), queues_.end());
+    subscriber_count_.store(queues_.size(), std::memory_order_release);
+}
+
+// === IntraProcessManager ===
+
+IntraProcessManager& IntraProcessManager::instance() {
+    static IntraProcessManager manager;
+    return manager;
+}
+
+std::shared_ptr<IntraProcessChannel> IntraProcessManager::advertise(const std::string& topic,
+                                                                     std::type_index type,
+                                                                     size_t depth) {
+    auto channel = std::make_shared<IntraProcessChannel>(type, depth);
+    std::lock_guard<std::mutex> lock(mutex_);
+    channels_[topic] = channel;
+    return channel;
+}
+
+void IntraProcessManager::unadvertise(const std::string& topic,
+                                      const std::shared_ptr<IntraProcessChannel>& channel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = channels_.find(topic);
+    if (it != channels_.end() && it->second == channel) {
+        channels_.erase(it);
+    }
+}
+
+std::shared_ptr<IntraProcessChannel> IntraProcessManager::find(const std::string& topic,
+                                                               std::type_index type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = channels_.find(topic);
+    if (it == channels_.end() || it->second->type() != type) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+}  // namespace conduit::internal
@@ -0,0 +1,162 @@
+/**
+ * @file numa.cpp
+ * @brief NUMA placement of ring buffer pages
+ *
+ * == Why does this matter? ==
+ *
+ * On a dual-socket machine each socket has its own memory. A CPU reading
+ * memory attached to the other socket pays an extra hop over the
+ * interconnect (UPI/Infinity Fabric): higher latency and a fraction of the
+ * bandwidth.
+ *
+ *   Socket 0                      Socket 1
+ *   ┌──────────┐   interconnect   ┌──────────┐
+ *   │ CPUs 0-15│◄────────────────►│CPUs 16-31│
+ *   ├──────────┤                  ├──────────┤
+ *   │  Node 0  │                  │  Node 1  │
+ *   │  memory  │                  │  memory  │
+ *   └──────────┘                  └──────────┘
+ *
+ * By default Linux places a page on the node of the CPU that touches it
+ * first. For a ring buffer that is usually the publisher (it writes each
+ * slot first), which is wrong when all subscribers sit on the other socket.
+ *
+ * == What we can do about it ==
+ *
+ *   mbind(MPOL_PREFERRED)   Allocate the mapping's pages on a given node.
+ *                           For shared memory the policy is stored with the
+ *                           shared object, so it holds no matter which
+ *                           process touches a page first.
+ *   move_pages(nodes=NULL)  Query which node each page is on (conduit info).
+ *                           Only sees pages mapped in the caller, so
+ *                           resident pages (mincore) are read once first.
+ *
+ * MPOL_PREFERRED rather than MPOL_BIND: if the node runs out of memory the
+ * allocation falls back to another node instead of failing.
+ *
+ * == Pages that are already there ==
+ *
+ * A policy only steers new allocations. NearSubscribers is set when the
+ * first subscriber attaches, after the publisher has written the header
+ * (and any slots it published so far). Those pages are mapped by both
+ * processes, and MPOL_MF_MOVE only migrates pages nobody else maps:
+ *
+ *   MPOL_MF_MOVE       pages mapped by this process only
+ *   MPOL_MF_MOVE_ALL   shared pages too; needs CAP_SYS_NICE
+ *
+ * So we ask for MPOL_MF_MOVE_ALL and fall back to MPOL_MF_MOVE without the
+ * capability. Then the pages written before the subscriber attached stay
+ * where they are, and only the slots written afterwards follow the policy.
+ *
+ * glibc has no wrappers for these (they live in libnuma), so we use
+ * syscall() directly.
+ */
+
+#include "conduit_core/internal/numa.hpp"
+#include "conduit_core/log.hpp"
+
+#include <linux/mempolicy.h>  // MPOL_PREFERRED, MPOL_MF_MOVE(_ALL)
+#include <sys/mman.h>         // mincore
+#include <sys/syscall.h>      // SYS_mbind, SYS_move_pages, SYS_getcpu
+#include <unistd.h>           // syscall
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>            // strerror
+#include <vector>
+
+namespace conduit::internal {
+
+namespace {
+
+constexpr size_t MASK_BITS = 8 * sizeof(unsigned long);
+constexpr size_t QUERY_BATCH = 4096;  // Pages per move_pages() call
+
+}  // namespace
+
+int current_numa_node() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) < 0) {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+/**
+ * Set the preferred node for a mapping.
+ *
+ * The nodemask is a bitmap of unsigned longs; the kernel reads maxnode - 1
+ * bits of it. Moving shared pages fails with EPERM without CAP_SYS_NICE;
+ * we then move what we may (see "Pages that are already there").
+ */
+bool prefer_numa_node(void* addr, size_t len, int node, bool move) {
+    if (node < 0) {
+        return false;
+    }
+
+    std::vector<unsigned long> mask(static_cast<size_t>(node) / MASK_BITS + 1, 0);
+    mask[static_cast<size_t>(node) / MASK_BITS] |= 1ul << (static_cast<size_t>(node) % MASK_BITS);
+    unsigned long maxnode = mask.size() * MASK_BITS + 1;
+    unsigned flags = move ? MPOL_MF_MOVE_ALL : 0;
+
+    long result = syscall(SYS_mbind, addr, len, MPOL_PREFERRED, mask.data(), maxnode, flags);
+    if (result < 0 && move && errno == EPERM) {
+        log::debug("No CAP_SYS_NICE: pages already shared stay off NUMA node {}", node);
+        result = syscall(SYS_mbind, addr, len, MPOL_PREFERRED, mask.data(), maxnode, MPOL_MF_MOVE);
+    }
+    if (result < 0) {
+        log::warn("mbind to NUMA node {} failed: {}", node, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Query page placement.
+ *
+ * With nodes == NULL, move_pages() moves nothing and writes each page's
+ * node into status, or a negative errno (-ENOENT: not mapped).
+ *
+ * A page another process allocated is not in our page tables until we
+ * touch it. mincore() reports what is resident in the shared object itself,
+ * so we read one byte of each resident page to map it - without allocating
+ * the pages nobody has touched yet.
+ */
+std::map<int, size_t> numa_page_nodes(const void* addr, size_t len, size_t page_size) {
+    std::map<int, size_t> counts;
+    auto* base = static_cast<const uint8_t*>(addr);
+    size_t pages = (len + page_size - 1) / page_size;
+
+    // mincore() works in base pages
+    const size_t base_page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> resident((len + base_page - 1) / base_page);
+    if (mincore(const_cast<uint8_t*>(base), len, resident.data()) == 0) {
+        for (size_t i = 0; i < resident.size(); ++i) {
+            if (resident[i] & 1) {
+                (void)*reinterpret_cast<const volatile uint8_t*>(base + i * base_page);
+            }
+        }
+    }
+
+    std::vector<void*> batch;
+    std::vector<int> status;
+    for (size_t first = 0; first < pages; first += QUERY_BATCH) {
+        size_t count = std::min(QUERY_BATCH, pages - first);
+        batch.resize(count);
+        status.assign(count, 0);
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = const_cast<uint8_t*>(base + (first + i) * page_size);
+        }
+
+        if (syscall(SYS_move_pages, 0, count, batch.data(), nullptr, status.data(), 0) < 0) {
+            return {};  // No NUMA support (or not permitted)
+        }
+        for (int node : status) {
+            counts[node >= 0 ? node : -1]++;
+        }
+    }
+    return counts;
+}
+
+}  // namespace conduit::internal
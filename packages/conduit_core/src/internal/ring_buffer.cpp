@@ -85,6 +85,96 @@
  * - Crashed processes don't block others
  * - Single writer, multiple readers (SPMC pattern)
  *
+ * == Read Filters ==
+ *
+ * A visualization node that only wants every 10th frame, or only one camera
+ * frame id, would still be woken for every message and throw most of them
+ * away. A reader can set a ReadFilter (decimation, minimum interval, frame
+ * match). try_read() then consumes rejected messages silently, and the
+ * reader publishes its wake conditions in reader_wake[slot]:
+ *
+ *   writer, after each write:
+ *     unfiltered readers  -> shared futex_word, as always
+ *     filtered readers    -> for each bit in filtered_mask:
+ *                              sequence >= next_sequence?
+ *                              timestamp >= next_timestamp_ns?
+ *                              frame matches?
+ *                            all yes -> bump + wake reader_wake[i].futex_word
+ *
+ * A filtered reader sleeps on its own word, so it only wakes for messages
+ * it will accept. The conditions are only hints: the reader re-checks every
+ * message, so a stale next_sequence can only cause an extra wakeup, never a
+ * missed message.
+ *
+ * A "latest" filter is for consumers that only care about the current
+ * value (UI, telemetry). Instead of draining the backlog one message at a
+ * time, try_read() moves read_idx straight to write_idx - 1:
+ *
+ *   read_idx=3, write_idx=9:   [3][4][5][6][7][8]  -> read 8 only
+ *
+ * Combined with min_interval this gives "newest message, at most N Hz":
+ * the writer does not wake the reader before the interval has passed, and
+ * when it does, everything queued in between is skipped in one store.
+ *
+ * A message that arrives inside the interval and is still the newest one
+ * is not dropped but left unread, and the reader's waits end when the
+ * interval expires. It is then delivered unless a newer one has replaced
+ * it, so the last value of a burst always arrives, at most one interval
+ * late:
+ *
+ *   interval 20 ms:  t=0 A -> delivered
+ *                    t=1 B, t=2 C (newest, too early) -> C left unread
+ *                    t=20 -> C delivered; next accepted from t=40
+ *
+ * == Generations (resizing) ==
+ *
+ * Slot count and size are fixed once a ring exists. To grow, the publisher
+ * creates a second ring next to it and retires the first:
+ *
+ *   camera     gen 0  write_idx=500 (final)  next_generation=1
+ *   camera@1   gen 1  start_idx=500, write_idx=500 -> 501 -> ...
+ *
+ * The new ring continues the sequence numbers, so a reader drains the old
+ * ring up to 500, claims a slot in the new one and seeks to 500: no message
+ * is lost or repeated. Readers notice the move only when they run out of
+ * messages; wait() returns early once the ring is retired and drained.
+ *
+ * == Overflow Arena ==
+ *
+ * Sizing every slot for the largest message wastes memory when big messages
+ * are rare (a map snapshot among odometry updates). A topic can have an
+ * overflow arena next to its ring ("camera@overflow"). A message that does
+ * not fit its slot is appended to the arena, and the slot only carries an
+ * OverflowDescriptor {position, size} with OVERFLOW_FLAG set in the size:
+ *
+ *   slot 7:  [size=1MB|FLAG][seq][ts][position=4096, size=1MB]
+ *                                              │
+ *   arena:   [....][msg 6][ 1MB message ][....]◄┘
+ *
+ * The arena is reused in circles just like the ring. A reader that falls a
+ * whole arena behind finds its message overwritten (reserved has moved past
+ * position + capacity) and skips it, as it would skip a lapped slot.
+ *
+ * A publisher with a buffer pool (buffer_pool.cpp) goes one step further:
+ * the message is built in a pool block and the slot carries a BlockHandle
+ * with POOL_FLAG set. The payload is not copied at all.
+ *
+ * == Reliable Readers ==
+ *
+ * Normally the writer never waits: a slow reader is lapped and skips
+ * ahead. A reader registered with set_reliable() (a recorder that must not
+ * lose data) instead makes the writer wait before it reuses a slot the
+ * reader has not read:
+ *
+ *   slot_count 8, reliable reader at read_idx 3 (still using message 2):
+ *     write 9  reuses slot of 1  -> fine
+ *     write 10 reuses slot of 2  -> wait until read_idx >= 4
+ *
+ * The wait is bounded by the reader's timeout. A reader that does not make
+ * it in time is lapped as usual and not waited for again until it has
+ * caught up, so a stuck or crashed recorder costs the publisher one
+ * timeout, not one per message.
+ *
  * == Cache Line Alignment ==
  *
  * Each reader's read_idx is on its own 64-byte cache line.
@@ -92,9 +182,11 @@
  */
 
 #include "conduit_core/internal/ring_buffer.hpp"
+#include "conduit_core/internal/buffer_pool.hpp"
 #include "conduit_core/internal/futex.hpp"
 #include "conduit_core/internal/time.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -139,27 +231,79 @@ RingBufferWriter::RingBufferWriter(void* region, size_t region_size, const RingB
  * The memory_order_release fence ensures all writes are visible
  * to other processes before they can read the header.
  */
-void RingBufferWriter::initialize() {
+void RingBufferWriter::initialize(uint32_t generation, uint64_t start_idx) {
     // Write configuration (immutable after init)
     header_->slot_count = slot_count_;
     header_->slot_size = slot_size_;
     header_->max_subscribers = MAX_SUBSCRIBERS;
-    header_->padding0 = 0;
+    header_->numa_policy = 0;
+    header_->generation = generation;
+    header_->start_idx = start_idx;
+    header_->overflow_capacity = overflow_ != nullptr ? overflow_->capacity : 0;
+    header_->pool_blocks = pool_ != nullptr ? pool_->block_count() : 0;
 
-    // Initialize indices to 0
-    header_->write_idx.store(0, std::memory_order_relaxed);
+    // Initialize indices (a replacement ring continues the old sequence)
+    header_->write_idx.store(start_idx, std::memory_order_relaxed);
     header_->subscriber_mask.store(0, std::memory_order_relaxed);
     header_->futex_word.store(0, std::memory_order_relaxed);
+    header_->filtered_mask.store(0, std::memory_order_relaxed);
+    header_->next_generation.store(0, std::memory_order_relaxed);
+    header_->reliable_mask.store(0, std::memory_order_relaxed);
+    header_->space_word.store(0, std::memory_order_relaxed);
+    header_->writer_blocked.store(0, std::memory_order_relaxed);
 
-    // Initialize all reader positions to 0
+    // Statistics start empty
+    header_->stats.bytes_written.store(0, std::memory_order_relaxed);
+    header_->stats.last_write_ns.store(0, std::memory_order_relaxed);
+    header_->stats.window_messages.store(0, std::memory_order_relaxed);
+    header_->stats.window_bytes.store(0, std::memory_order_relaxed);
+    header_->stats.window_ns.store(0, std::memory_order_relaxed);
+    bytes_written_ = 0;
+    window_start_ns_ = get_timestamp_ns();
+    window_start_idx_ = start_idx;
+    window_start_bytes_ = 0;
+
+    // Initialize all reader positions
     for (size_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
-        header_->read_idx[i].value.store(0, std::memory_order_relaxed);
+        header_->read_idx[i].value.store(start_idx, std::memory_order_relaxed);
+        header_->reader_wake[i].futex_word.store(0, std::memory_order_relaxed);
+        header_->reader_wake[i].block_timeout_ns = 0;
     }
 
     // Ensure all initializations are visible before anyone reads
     std::atomic_thread_fence(std::memory_order_release);
 }
 
+void initialize_overflow(void* region, size_t region_size) {
+    auto* header = static_cast<OverflowHeader*>(region);
+    header->capacity = region_size - sizeof(OverflowHeader);
+    header->reserved.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void RingBufferWriter::set_overflow(void* region) {
+    overflow_ = static_cast<OverflowHeader*>(region);
+    overflow_data_ = static_cast<uint8_t*>(region) + sizeof(OverflowHeader);
+}
+
+/**
+ * Hand the topic over to a new ring.
+ *
+ * Readers only look at next_generation once they have run out of messages,
+ * so the store must be visible before they are woken: every futex word a
+ * reader may sleep on is bumped afterwards.
+ */
+void RingBufferWriter::retire(uint32_t next_generation) {
+    header_->next_generation.store(next_generation, std::memory_order_release);
+
+    header_->futex_word.fetch_add(1, std::memory_order_release);
+    futex_wake_all(&header_->futex_word);
+    for (size_t i = 0; i < MAX_SUBSCRIBERS; ++i) {
+        header_->reader_wake[i].futex_word.fetch_add(1, std::memory_order_release);
+        futex_wake_all(&header_->reader_wake[i].futex_word);
+    }
+}
+
 /**
  * Write a message to the ring buffer.
  *
@@ -190,16 +334,55 @@ void RingBufferWriter::initialize() {
  *
  * 6. WAKE SUBSCRIBERS
  *    Signal anyone sleeping via futex
+ *
+ * 7. STATISTICS
+ *    Byte count and window rate for `conduit info` (same cache line as
+ *    write_idx, so no extra line is dirtied)
  */
 bool RingBufferWriter::try_write(const void* data, size_t len) {
     // Step 1: Check message fits in slot
     // Slot layout: [header:20 bytes][payload:len bytes]
-    if (len + SLOT_HEADER_SIZE > slot_size_) {
+    // Larger messages go to the overflow arena, the slot gets a descriptor
+    if (len + SLOT_HEADER_SIZE <= slot_size_) {
+        write_slot(data, len, static_cast<uint32_t>(len), nullptr, len);
+        return true;
+    }
+    if (overflow_ == nullptr || len > overflow_->capacity || len >= POOL_FLAG) {
         return false;  // Message too large for configured slot size
     }
 
+    OverflowDescriptor descriptor;
+    const uint8_t* payload = write_overflow(data, len, descriptor);
+    write_slot(&descriptor, sizeof(descriptor), static_cast<uint32_t>(len) | OVERFLOW_FLAG, payload, len);
+    return true;
+}
+
+void RingBufferWriter::set_pool(BufferPool* pool) {
+    pool_ = pool;
+}
+
+bool RingBufferWriter::try_write_block(const BlockHandle& handle) {
+    if (sizeof(BlockHandle) + SLOT_HEADER_SIZE > slot_size_ || handle.size >= POOL_FLAG) {
+        return false;
+    }
+    write_slot(&handle, sizeof(handle), static_cast<uint32_t>(handle.size) | POOL_FLAG,
+               pool_->data(handle.index), handle.size);
+    return true;
+}
+
+/**
+ * Fill the next slot and publish it.
+ *
+ * @param record      What goes into the slot: the payload, or a descriptor
+ *                    of a payload stored elsewhere
+ * @param size_field  Payload size, with OVERFLOW_FLAG / POOL_FLAG for descriptors
+ * @param payload     Where the payload is, for filters (nullptr: in the slot)
+ */
+void RingBufferWriter::write_slot(const void* record, size_t record_len, uint32_t size_field,
+                                  const uint8_t* payload, size_t len) {
     // Step 2: Get current write position and calculate slot
     uint64_t idx = header_->write_idx.load(std::memory_order_relaxed);
+    wait_for_readers(idx);
 
     // Fast modulo using bitmask (works because slot_count is power of 2)
     // e.g., idx=13, slot_count=8 -> 13 & 7 = 5
@@ -213,13 +396,15 @@ bool RingBufferWriter::try_write(const void* data, size_t len) {
 
     // Step 4: Write slot header
     // Layout: [size:4B @ offset 0][sequence:8B @ offset 4][timestamp:8B @ offset 12]
-    uint32_t size32 = static_cast<uint32_t>(len);
-    std::memcpy(slot_ptr + 0, &size32, sizeof(uint32_t));      // bytes 0-3
+    std::memcpy(slot_ptr + 0, &size_field, sizeof(uint32_t));  // bytes 0-3
     std::memcpy(slot_ptr + 4, &idx, sizeof(uint64_t));         // bytes 4-11
     std::memcpy(slot_ptr + 12, &timestamp_ns, sizeof(uint64_t)); // bytes 12-19
 
     // Step 5: Write payload data after header
-    std::memcpy(slot_ptr + SLOT_HEADER_SIZE, data, len);       // bytes 20+
+    std::memcpy(slot_ptr + SLOT_HEADER_SIZE, record, record_len);  // bytes 20+
+    if (payload == nullptr) {
+        payload = slot_ptr + SLOT_HEADER_SIZE;
+    }
 
     // Step 6: Publish - increment write_idx
     // memory_order_release ensures all writes above are visible
@@ -231,7 +416,172 @@ bool RingBufferWriter::try_write(const void* data, size_t len) {
     header_->futex_word.fetch_add(1, std::memory_order_release);
     futex_wake_all(&header_->futex_word);  // Wake all sleeping subscribers
 
-    return true;
+    // Step 8: Wake filtered readers that want this message
+    uint32_t filtered = header_->filtered_mask.load(std::memory_order_acquire);
+    if (filtered != 0) {
+        wake_filtered(filtered, idx, timestamp_ns, payload, len);
+    }
+
+    // Step 9: Statistics
+    update_stats(idx, timestamp_ns, len);
+}
+
+/**
+ * Hold a write while it would overwrite a message a reliable reader still needs.
+ *
+ * Writing idx reuses the slot of idx - slot_count. A reader at read_idx may
+ * still be using read_idx - 1 (the message it last returned), so a write
+ * waits while read_idx + slot_count - 1 <= idx.
+ *
+ * Steps:
+ * 1. Readers that timed out before are waited for again once they caught up
+ * 2. For each reliable reader that is too far behind, sleep on space_word
+ *    until it reads or its timeout has passed since this write started
+ * 3. On timeout, give up on that reader: it gets lapped like any other
+ *
+ * To sleep, the writer announces writer_blocked, fences, checks again and
+ * only then calls futex_wait(). The reader stores its position, fences,
+ * then checks writer_blocked (store_position()), so one of the two always
+ * sees the other.
+ */
+void RingBufferWriter::wait_for_readers(uint64_t idx) {
+    uint32_t reliable = header_->reliable_mask.load(std::memory_order_acquire);
+    if (reliable == 0) {
+        lapped_readers_ = 0;
+        return;
+    }
+    const uint64_t limit = slot_count_ - 1;
+    auto behind = [this, idx, limit](uint32_t i) {
+        return header_->read_idx[i].value.load(std::memory_order_acquire) + limit <= idx;
+    };
+
+    // Step 1
+    for (uint32_t lapped = lapped_readers_; lapped != 0; lapped &= lapped - 1) {
+        uint32_t i = static_cast<uint32_t>(__builtin_ctz(lapped));
+        if ((reliable & (1u << i)) == 0 || !behind(i)) {
+            lapped_readers_ &= ~(1u << i);
+        }
+    }
+    reliable &= ~lapped_readers_;
+
+    // Step 2
+    const auto start = std::chrono::steady_clock::now();
+    while (reliable != 0) {
+        uint32_t i = static_cast<uint32_t>(__builtin_ctz(reliable));
+        uint32_t bit = 1u << i;
+        if ((header_->reliable_mask.load(std::memory_order_acquire) & bit) == 0 || !behind(i)) {
+            reliable &= ~bit;
+            continue;
+        }
+
+        auto deadline = start + std::chrono::nanoseconds(header_->reader_wake[i].block_timeout_ns);
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            // Step 3
+            lapped_readers_ |= bit;
+            ++reliable_timeouts_;
+            reliable &= ~bit;
+            continue;
+        }
+
+        uint32_t seen = header_->space_word.load(std::memory_order_acquire);
+        header_->writer_blocked.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((header_->reliable_mask.load(std::memory_order_acquire) & bit) != 0 && behind(i)) {
+            futex_wait(&header_->space_word, seen,
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now));
+        }
+        header_->writer_blocked.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Append a message to the overflow arena and describe it for the slot.
+ *
+ * The arena is a byte log; positions only grow and map to offset
+ * position % capacity. A message never wraps: if it does not fit before the
+ * end, the tail is skipped and it starts at offset 0.
+ *
+ *   capacity 1000, reserved 900, message 300:
+ *     900 + 300 runs past the end -> position 1000 (offset 0), reserved 1300
+ *
+ * reserved is advanced before the bytes are copied, so a reader that finds
+ * reserved <= position + capacity knows its message was not yet reused.
+ */
+const uint8_t* RingBufferWriter::write_overflow(const void* data, size_t len, OverflowDescriptor& descriptor) {
+    const uint64_t capacity = overflow_->capacity;
+    uint64_t position = overflow_->reserved.load(std::memory_order_relaxed);
+    position = (position + OVERFLOW_ALIGNMENT - 1) & ~static_cast<uint64_t>(OVERFLOW_ALIGNMENT - 1);
+    if (position % capacity + len > capacity) {
+        position += capacity - position % capacity;
+    }
+
+    overflow_->reserved.store(position + len, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);  // Reserve before overwriting
+
+    uint8_t* target = overflow_data_ + position % capacity;
+    std::memcpy(target, data, len);
+
+    descriptor = OverflowDescriptor{position, len};
+    return target;
+}
+
+/**
+ * Update the statistics in the header.
+ *
+ * Counting happens in writer-local members; the shared fields are only
+ * stored, never read back. Rates are published once per window rather than
+ * as running averages, so readers need no locking to get a consistent
+ * messages/bytes/duration triple (a torn read at worst mixes two adjacent
+ * windows).
+ */
+void RingBufferWriter::update_stats(uint64_t idx, uint64_t timestamp_ns, size_t len) {
+    bytes_written_ += len;
+    header_->stats.bytes_written.store(bytes_written_, std::memory_order_relaxed);
+    header_->stats.last_write_ns.store(timestamp_ns, std::memory_order_relaxed);
+
+    uint64_t elapsed = timestamp_ns - window_start_ns_;
+    if (elapsed < STATS_WINDOW_NS) {
+        return;
+    }
+    header_->stats.window_messages.store(idx + 1 - window_start_idx_, std::memory_order_relaxed);
+    header_->stats.window_bytes.store(bytes_written_ - window_start_bytes_, std::memory_order_relaxed);
+    header_->stats.window_ns.store(elapsed, std::memory_order_relaxed);
+    window_start_ns_ = timestamp_ns;
+    window_start_idx_ = idx + 1;
+    window_start_bytes_ = bytes_written_;
+}
+
+/**
+ * Wake the filtered readers whose published conditions this message meets.
+ *
+ * Same checks as RingBufferReader::accept(), against the values the reader
+ * last published. Those may lag behind the reader by one message, which
+ * only costs an extra wakeup.
+ */
+void RingBufferWriter::wake_filtered(uint32_t filtered, uint64_t sequence, uint64_t timestamp_ns,
+                                     const uint8_t* payload, size_t len) {
+    while (filtered != 0) {
+        uint32_t i = static_cast<uint32_t>(__builtin_ctz(filtered));
+        filtered &= filtered - 1;
+
+        ReaderWake& wake = header_->reader_wake[i];
+        if (sequence < wake.next_sequence.load(std::memory_order_relaxed)
+            || timestamp_ns < wake.next_timestamp_ns.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (wake.frame_offset >= 0) {
+            auto offset = static_cast<size_t>(wake.frame_offset);
+            if (offset + FILTER_FRAME_SIZE > len
+                || std::strncmp(reinterpret_cast<const char*>(payload + offset), wake.frame,
+                                FILTER_FRAME_SIZE) != 0) {
+                continue;
+            }
+        }
+
+        wake.futex_word.fetch_add(1, std::memory_order_release);
+        futex_wake_all(&wake.futex_word);
+    }
 }
 
 // ============================================================================
@@ -310,6 +660,104 @@ int RingBufferReader::claim_slot() {
     }
 }
 
+void RingBufferReader::set_overflow(const void* region) {
+    overflow_ = static_cast<const OverflowHeader*>(region);
+    overflow_data_ = static_cast<const uint8_t*>(region) + sizeof(OverflowHeader);
+}
+
+/**
+ * Turn a slot holding an OverflowDescriptor into the message it points at.
+ *
+ * Returns false if the arena has since wrapped over the message (the
+ * reader fell behind by a whole arena) or is not mapped.
+ */
+bool RingBufferReader::resolve_overflow(ReadResult& result) const {
+    if (overflow_ == nullptr) {
+        return false;
+    }
+
+    OverflowDescriptor descriptor;
+    std::memcpy(&descriptor, result.data, sizeof(descriptor));
+    if (overflow_->reserved.load(std::memory_order_acquire) > descriptor.position + overflow_->capacity) {
+        return false;  // Reused
+    }
+
+    result.data = overflow_data_ + descriptor.position % overflow_->capacity;
+    result.size = descriptor.size;
+    return true;
+}
+
+void RingBufferReader::set_pool(const BufferPool* pool) {
+    pool_ = pool;
+}
+
+/**
+ * Turn a slot holding a BlockHandle into the block's data.
+ *
+ * Only a first check: the block can still be released between here and
+ * the caller's try_acquire(), which has the final word.
+ */
+bool RingBufferReader::resolve_block(ReadResult& result) const {
+    if (pool_ == nullptr) {
+        return false;
+    }
+
+    BlockHandle handle;
+    std::memcpy(&handle, result.data, sizeof(handle));
+    if (!pool_->valid(handle)) {
+        return false;  // Lapped and released
+    }
+
+    result.data = pool_->data(handle.index);
+    result.size = handle.size;
+    result.block = handle;
+    return true;
+}
+
+/**
+ * Resolve a slot that holds a descriptor instead of the payload.
+ *
+ * Returns false if the payload it points at is gone.
+ */
+bool RingBufferReader::resolve(uint32_t size, ReadResult& result) const {
+    if (size & OVERFLOW_FLAG) {
+        return resolve_overflow(result);
+    }
+    if (size & POOL_FLAG) {
+        return resolve_block(result);
+    }
+    return true;
+}
+
+/**
+ * Continue at a position carried over from a retired ring.
+ *
+ * Indices below start_idx belong to the old ring - the slots they map to
+ * here were never written.
+ */
+void RingBufferReader::seek(int slot, uint64_t idx) {
+    uint64_t write_idx = header_->write_idx.load(std::memory_order_acquire);
+    idx = std::min(std::max(idx, header_->start_idx), write_idx);
+    store_position(slot, idx);
+}
+
+uint64_t RingBufferReader::position(int slot) const {
+    return header_->read_idx[slot].value.load(std::memory_order_relaxed);
+}
+
+/**
+ * Retired and drained.
+ *
+ * The writer stops writing before it sets next_generation, so once that is
+ * visible (acquire) write_idx is final.
+ */
+bool RingBufferReader::retired(int slot) const {
+    if (header_->next_generation.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    return position(slot) >= header_->write_idx.load(std::memory_order_acquire);
+}
+
 /**
  * Release a subscriber slot.
  *
@@ -317,11 +765,178 @@ int RingBufferReader::claim_slot() {
  */
 void RingBufferReader::release_slot(int slot) {
     uint32_t bit = 1u << static_cast<uint32_t>(slot);
+    header_->filtered_mask.fetch_and(~bit, std::memory_order_release);
+    if (reliable_) {
+        // A writer waiting for us must not wait out the timeout
+        header_->reliable_mask.fetch_and(~bit, std::memory_order_release);
+        header_->space_word.fetch_add(1, std::memory_order_release);
+        futex_wake_all(&header_->space_word);
+    }
     header_->subscriber_mask.fetch_and(~bit, std::memory_order_release);
 }
 
+void RingBufferReader::set_reliable(int slot, std::chrono::nanoseconds timeout) {
+    header_->reader_wake[slot].block_timeout_ns = static_cast<uint64_t>(std::max<int64_t>(timeout.count(), 0));
+    reliable_ = true;
+    header_->reliable_mask.fetch_or(1u << static_cast<uint32_t>(slot), std::memory_order_release);
+}
+
+/**
+ * Store the read position; a reliable reader also wakes a blocked writer.
+ *
+ * The fence pairs with the one in RingBufferWriter::wait_for_readers().
+ */
+void RingBufferReader::store_position(int slot, uint64_t idx) {
+    header_->read_idx[slot].value.store(idx, std::memory_order_release);
+    if (reliable_) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (header_->writer_blocked.load(std::memory_order_relaxed) != 0) {
+            header_->space_word.fetch_add(1, std::memory_order_release);
+            futex_wake_all(&header_->space_word);
+        }
+    }
+}
+
+/**
+ * Install a read filter.
+ *
+ * Steps:
+ * 1. Keep a local copy for try_read()
+ * 2. Publish the wake conditions in reader_wake[slot]
+ * 3. Set our bit in filtered_mask - from now on the writer checks the
+ *    conditions and bumps our own futex word instead of relying on the
+ *    shared one
+ */
+void RingBufferReader::set_filter(int slot, const ReadFilter& filter) {
+    if (!filter.active()) {
+        return;
+    }
+
+    // Step 1: Local copy
+    filter_ = filter;
+    filter_.frame[FILTER_FRAME_SIZE - 1] = '\0';
+    filtered_ = true;
+
+    // Step 2: Wake conditions (the first message after the current position qualifies)
+    ReaderWake& wake = header_->reader_wake[slot];
+    wake.frame_offset = filter_.frame_offset;
+    std::memcpy(wake.frame, filter_.frame, FILTER_FRAME_SIZE);
+    wake.next_sequence.store(header_->read_idx[slot].value.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+    wake.next_timestamp_ns.store(0, std::memory_order_relaxed);
+
+    // Step 3: Tell the writer
+    header_->filtered_mask.fetch_or(1u << static_cast<uint32_t>(slot), std::memory_order_release);
+}
+
+std::atomic<uint32_t>* RingBufferReader::wake_word(int slot) {
+    return filtered_ ? &header_->reader_wake[slot].futex_word : &header_->futex_word;
+}
+
+/**
+ * Read the next message that passes the filter.
+ *
+ * Without a filter this is just read_next(). With one, rejected messages
+ * are consumed and we move on to the next; an accepted message updates the
+ * wake conditions for the one after it.
+ */
+std::optional<ReadResult> RingBufferReader::try_read(int slot) {
+    if (!filtered_) {
+        return read_next(slot);
+    }
+
+    pending_ns_ = 0;
+    if (filter_.latest) {
+        skip_to_newest(slot);
+    }
+    while (auto result = read_next(slot)) {
+        if (accept(slot, *result)) {
+            return result;
+        }
+        if (pending_ns_ != 0) {
+            break;  // Left unread until it is due
+        }
+    }
+    return std::nullopt;
+}
+
+/**
+ * Move the read position to the newest written message.
+ *
+ * Only moves forward; a reader that is already caught up stays put.
+ */
+void RingBufferReader::skip_to_newest(int slot) {
+    uint64_t read_idx = header_->read_idx[slot].value.load(std::memory_order_relaxed);
+    uint64_t write_idx = header_->write_idx.load(std::memory_order_acquire);
+
+    if (write_idx > read_idx + 1) {
+        store_position(slot, write_idx - 1);
+    }
+}
+
+/**
+ * Check a message against the filter and, if accepted, advance the wake
+ * conditions past it.
+ *
+ * Steps:
+ * 1. Decimation and frame match
+ * 2. Published too early: drop it if a newer message exists. If it is the
+ *    newest, deliver it once the interval has passed on the clock, and
+ *    until then leave it unread and note when that is (pending_ns_)
+ * 3. Advance the wake conditions; an interval counts from the delivery
+ *    of a late message
+ */
+bool RingBufferReader::accept(int slot, const ReadResult& result) {
+    ReaderWake& wake = header_->reader_wake[slot];
+
+    // Step 1
+    if (result.sequence < wake.next_sequence.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (filter_.frame_offset >= 0) {
+        auto offset = static_cast<size_t>(filter_.frame_offset);
+        if (offset + FILTER_FRAME_SIZE > result.size
+            || std::strncmp(static_cast<const char*>(result.data) + offset, filter_.frame,
+                            FILTER_FRAME_SIZE) != 0) {
+            return false;
+        }
+    }
+
+    // Step 2
+    uint64_t start = result.timestamp_ns;
+    uint64_t next_timestamp_ns = wake.next_timestamp_ns.load(std::memory_order_relaxed);
+    if (start < next_timestamp_ns) {
+        if (result.sequence + 1 < header_->write_idx.load(std::memory_order_acquire)) {
+            return false;
+        }
+        start = get_timestamp_ns();
+        if (start < next_timestamp_ns) {
+            store_position(slot, result.sequence);
+            pending_ns_ = next_timestamp_ns;
+            return false;
+        }
+    }
+
+    // Step 3
+    wake.next_sequence.store(result.sequence + filter_.decimation, std::memory_order_relaxed);
+    wake.next_timestamp_ns.store(start + filter_.min_interval_ns, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Time until a message left unread by accept() is due, capped at @p limit.
+ */
+std::chrono::nanoseconds RingBufferReader::until_pending(std::chrono::nanoseconds limit) const {
+    if (pending_ns_ == 0) {
+        return limit;
+    }
+    uint64_t now = get_timestamp_ns();
+    auto due = std::chrono::nanoseconds(pending_ns_ > now ? pending_ns_ - now : 0);
+    return std::min(due, limit);
+}
+
 /**
- * Try to read the next message (non-blocking).
+ * Read the next message, ignoring the filter (non-blocking).
  *
  * @param slot  Subscriber slot number (from claim_slot)
  * @return      ReadResult with pointer to data, or nullopt if no data
@@ -344,7 +959,7 @@ void RingBufferReader::release_slot(int slot) {
  * 5. RETURN RESULT
  *    Pointer directly into shared memory (zero-copy!)
  */
-std::optional<ReadResult> RingBufferReader::try_read(int slot) {
+std::optional<ReadResult> RingBufferReader::read_next(int slot) {
     // Step 1: Load our read position and publisher's write position
     uint64_t read_idx = header_->read_idx[slot].value.load(std::memory_order_relaxed);
     uint64_t write_idx = header_->write_idx.load(std::memory_order_acquire);
@@ -384,15 +999,91 @@ std::optional<ReadResult> RingBufferReader::try_read(int slot) {
     }
 
     // Step 5: Success! Advance read position
-    header_->read_idx[slot].value.store(read_idx + 1, std::memory_order_release);
+    store_position(slot, read_idx + 1);
 
     // Return pointer directly into shared memory (ZERO COPY!)
-    return ReadResult{
+    ReadResult result{
         .data = slot_ptr + SLOT_HEADER_SIZE,  // Pointer to payload
         .size = size,                          // Payload size
         .sequence = sequence,                  // For debugging/ordering
         .timestamp_ns = timestamp_ns           // When published
     };
+
+    // Step 6: Large message - the slot only points into the overflow arena or pool
+    if (!resolve(size, result)) {
+        return read_next(slot);  // Lost, like a lapped slot: move on
+    }
+    return result;
+}
+
+/**
+ * Look ahead without consuming.
+ *
+ * Same checks as try_read(), but for read_idx + offset and without
+ * storing the new read position. Used by the synchronizer, which needs to
+ * compare timestamps of several queued messages before deciding which
+ * ones to consume - the messages stay in the ring, nothing is copied.
+ */
+std::optional<ReadResult> RingBufferReader::peek(int slot, uint64_t offset) {
+    uint64_t read_idx = header_->read_idx[slot].value.load(std::memory_order_relaxed);
+    uint64_t write_idx = header_->write_idx.load(std::memory_order_acquire);
+
+    // Lapped: oldest available message becomes the next unread one
+    if (write_idx - read_idx > header_->slot_count) {
+        read_idx = write_idx - header_->slot_count;
+        header_->read_idx[slot].value.store(read_idx, std::memory_order_relaxed);
+    }
+
+    uint64_t idx = read_idx + offset;
+    if (idx >= write_idx) {
+        return std::nullopt;  // Not written yet
+    }
+
+    uint32_t slot_idx = static_cast<uint32_t>(idx & slot_count_mask_);
+    uint8_t* slot_ptr = slots_ + (static_cast<size_t>(slot_idx) * slot_size_);
+
+    uint32_t size;
+    uint64_t sequence;
+    uint64_t timestamp_ns;
+    std::memcpy(&size, slot_ptr + 0, sizeof(uint32_t));
+    std::memcpy(&sequence, slot_ptr + 4, sizeof(uint64_t));
+    std::memcpy(&timestamp_ns, slot_ptr + 12, sizeof(uint64_t));
+
+    if (sequence != idx) {
+        return std::nullopt;  // Overwritten; next peek sees the lap
+    }
+
+    ReadResult result{
+        .data = slot_ptr + SLOT_HEADER_SIZE,
+        .size = size,
+        .sequence = sequence,
+        .timestamp_ns = timestamp_ns
+    };
+    if (!resolve(size, result)) {
+        if (offset > 0) {
+            return std::nullopt;  // Reused; the head will skip it
+        }
+        store_position(slot, idx + 1);  // Lost, like a lapped slot: move on
+        return peek(slot);
+    }
+    return result;
+}
+
+/**
+ * Skip messages.
+ *
+ * Never moves past write_idx: a reader cannot consume messages that do not
+ * exist yet.
+ */
+void RingBufferReader::advance(int slot, uint64_t count) {
+    uint64_t read_idx = header_->read_idx[slot].value.load(std::memory_order_relaxed);
+    uint64_t write_idx = header_->write_idx.load(std::memory_order_acquire);
+
+    uint64_t next = read_idx + count;
+    if (next > write_idx) {
+        next = write_idx;
+    }
+    store_position(slot, next);
 }
 
 /**
@@ -413,16 +1104,26 @@ std::optional<ReadResult> RingBufferReader::wait(int slot) {
 
         // No data - prepare to sleep
         // Load futex word BEFORE checking for data again
-        uint32_t current = header_->futex_word.load(std::memory_order_acquire);
+        uint32_t current = wake_word(slot)->load(std::memory_order_acquire);
 
         // Double-check: data might have arrived between try_read and futex load
         if (auto result = try_read(slot)) {
             return result;
         }
 
+        // Replaced by a new ring: nothing more will arrive here
+        if (retired(slot)) {
+            return std::nullopt;
+        }
+
         // Sleep until futex word changes (publisher increments it)
-        // This is a Linux system call that puts thread to sleep efficiently
-        futex_wait(&header_->futex_word, current);
+        // This is a Linux system call that puts thread to sleep efficiently.
+        // A message held back by min_interval is due without any write
+        if (pending_ns_ != 0) {
+            futex_wait(wake_word(slot), current, until_pending(std::chrono::nanoseconds::max()));
+        } else {
+            futex_wait(wake_word(slot), current);
+        }
 
         // Woken up - loop back and try to read
     }
@@ -455,13 +1156,49 @@ std::optional<ReadResult> RingBufferReader::wait_for(int slot, std::chrono::nano
         auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
 
         // Load futex and double-check
-        uint32_t current = header_->futex_word.load(std::memory_order_acquire);
+        uint32_t current = wake_word(slot)->load(std::memory_order_acquire);
 
         if (auto result = try_read(slot)) {
             return result;
         }
+        if (retired(slot)) {
+            return std::nullopt;
+        }
+
+        // Sleep with timeout, or until a held back message is due
+        futex_wait(wake_word(slot), current, until_pending(remaining));
+    }
+}
+
+/**
+ * Wait until the next unread message exists, without consuming it.
+ *
+ * Same futex pattern as wait_for(), with peek() instead of try_read().
+ */
+std::optional<ReadResult> RingBufferReader::wait_peek_for(int slot, std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        if (auto result = peek(slot)) {
+            return result;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return std::nullopt;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+
+        uint32_t current = header_->futex_word.load(std::memory_order_acquire);
+
+        if (auto result = peek(slot)) {
+            return result;
+        }
+        if (retired(slot)) {
+            return std::nullopt;
+        }
 
-        // Sleep with timeout
         futex_wait(&header_->futex_word, current, remaining);
     }
 }
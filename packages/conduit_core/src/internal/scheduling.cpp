@@ -0,0 +1,169 @@
+/**
+ * @file scheduling.cpp
+ * @brief Thread placement and real-time scheduling for deterministic latency
+ *
+ * == Why does this matter? ==
+ *
+ * By default every conduit thread is a normal SCHED_OTHER thread that the
+ * kernel may migrate to any CPU at any time. On a machine that also runs
+ * heavy perception workloads this shows up as latency spikes:
+ *
+ *   - Migration: the thread wakes on a CPU whose caches are cold
+ *   - Preemption: a busy batch job delays the wakeup by a full timeslice
+ *   - Page faults: the first touch of a ring buffer page costs a trap
+ *
+ * == What we can do about it ==
+ *
+ *   sched_setaffinity()  Pin the thread to a fixed set of CPUs
+ *   sched_setscheduler() Real-time priority (SCHED_FIFO / SCHED_RR)
+ *   sched_setattr()      SCHED_DEADLINE (runtime/deadline/period budget)
+ *   mlockall()           Keep every page resident, no major faults
+ *
+ * All of these need privileges in most setups (CAP_SYS_NICE, CAP_IPC_LOCK or
+ * raised rlimits). A node that cannot get real-time scheduling still works,
+ * so failures are logged rather than thrown.
+ */
+
+#include "conduit_core/internal/scheduling.hpp"
+#include "conduit_core/log.hpp"
+
+#include <sched.h>         // sched_setaffinity, sched_setscheduler, CPU_SET
+#include <sys/mman.h>      // mlockall
+#include <sys/syscall.h>   // SYS_sched_setattr
+#include <unistd.h>        // syscall
+#include <cerrno>
+#include <cstring>         // strerror
+
+namespace conduit::internal {
+
+namespace {
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+/**
+ * Kernel ABI for sched_setattr(2).
+ *
+ * glibc only gained a wrapper in 2.41, so we declare the struct ourselves
+ * and go through syscall() directly.
+ */
+struct SchedAttr {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+};
+
+bool apply_affinity(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            log::warn("Ignoring invalid CPU index: {}", cpu);
+            continue;
+        }
+        CPU_SET(cpu, &set);
+    }
+
+    // pid 0 = calling thread
+    if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+        log::warn("sched_setaffinity failed: {}", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool apply_deadline(const ThreadOptions& options) {
+    if (options.runtime.count() <= 0 || options.period.count() <= 0) {
+        log::warn("SCHED_DEADLINE requires positive runtime and period");
+        return false;
+    }
+
+    SchedAttr attr{};
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_runtime = static_cast<uint64_t>(options.runtime.count());
+    attr.sched_period = static_cast<uint64_t>(options.period.count());
+    attr.sched_deadline = options.deadline.count() > 0
+        ? static_cast<uint64_t>(options.deadline.count())
+        : attr.sched_period;
+
+    if (syscall(SYS_sched_setattr, 0, &attr, 0) < 0) {
+        if (errno == EPERM && !options.cpus.empty()) {
+            log::warn("sched_setattr(SCHED_DEADLINE) failed: {} (pinned threads need an exclusive cpuset)",
+                      strerror(errno));
+        } else {
+            log::warn("sched_setattr(SCHED_DEADLINE) failed: {}", strerror(errno));
+        }
+        return false;
+    }
+    return true;
+}
+
+bool apply_policy(const ThreadOptions& options) {
+    int policy;
+    switch (options.policy) {
+        case SchedPolicy::Inherit:    return true;
+        case SchedPolicy::Deadline:   return apply_deadline(options);
+        case SchedPolicy::Other:      policy = SCHED_OTHER; break;
+        case SchedPolicy::Fifo:       policy = SCHED_FIFO; break;
+        case SchedPolicy::RoundRobin: policy = SCHED_RR; break;
+        default:                      return false;
+    }
+
+    struct sched_param param{};
+    param.sched_priority = (policy == SCHED_OTHER) ? 0 : options.priority;
+
+    if (sched_setscheduler(0, policy, &param) < 0) {
+        log::warn("sched_setscheduler failed (priority {}): {}",
+                  options.priority, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+/**
+ * Apply affinity, then policy.
+ *
+ * SCHED_DEADLINE admission control works per root domain, so the kernel
+ * refuses both orders: narrowing the affinity of a deadline task, and
+ * making a task whose affinity is narrower than its root domain a deadline
+ * task (EPERM). Pinning plus SCHED_DEADLINE therefore only works when
+ * the CPUs form a root domain of their own, i.e. an exclusive cpuset.
+ * Otherwise the policy fails and the thread stays pinned under SCHED_OTHER.
+ */
+bool apply_thread_options(const ThreadOptions& options) {
+    bool ok = true;
+
+    if (!options.cpus.empty()) {
+        ok = apply_affinity(options.cpus) && ok;
+    }
+
+    ok = apply_policy(options) && ok;
+
+    return ok;
+}
+
+/**
+ * Lock all pages into RAM.
+ *
+ * MCL_CURRENT covers what is mapped now (code, heap, ring buffers that
+ * already exist); MCL_FUTURE covers regions mapped later, such as
+ * subscriber rings opened in Node::run().
+ */
+bool lock_memory() {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        log::warn("mlockall failed: {}", strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace conduit::internal
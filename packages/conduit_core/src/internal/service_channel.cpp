@@ -0,0 +1,404 @@
+/**
+ * @file service_channel.cpp
+ * @brief Service Channel - request/response over one shared memory region
+ *
+ * == Why not two topics? ==
+ *
+ * A request topic plus a response topic works, but every client then sees
+ * every response, has to filter by a correlation id, and the request topic
+ * has a single writer - so each client needs its own. A service channel
+ * gives many clients one queue into the server and each client a private
+ * mailbox for its answer.
+ *
+ * == Memory Layout ==
+ *
+ *   ┌─────────────────────────────────────────────────────────────────┐
+ *   │                         ServiceHeader                           │
+ *   │  - queue_depth, slot sizes (config)                             │
+ *   │  - enqueue_idx (clients), dequeue_idx (server)                  │
+ *   │  - client_mask (which response slots are taken)                 │
+ *   │  - request_futex (server sleeps here)                           │
+ *   ├─────────────────────────────────────────────────────────────────┤
+ *   │  Request 0 .. queue_depth-1                                     │
+ *   │  [sequence:8B][client:4B][size:4B][request_id:8B][ts:8B][data]  │
+ *   ├─────────────────────────────────────────────────────────────────┤
+ *   │  Response 0 .. 31  (one per client)                             │
+ *   │  [futex_word][waiting][status][size][request_id] [data]         │
+ *   └─────────────────────────────────────────────────────────────────┘
+ *
+ * == How a call flows through ==
+ *
+ *   Client                                   Server
+ *   1. claim request slot (CAS enqueue_idx)
+ *   2. write header + payload
+ *   3. slot.sequence = idx + 1  (publish)
+ *   4. bump request_futex, wake if the
+ *      server is asleep                  ->  5. sees sequence == idx + 1
+ *                                            6. handler writes straight into
+ *                                               the client's response slot
+ *                                            7. status, size, then request_id
+ *   9. sees futex_word change and        <-  8. bump slot futex_word, wake if
+ *      its own request_id                       the client is asleep
+ *
+ * The request queue is a bounded MPSC queue in the style of Dmitry Vyukov's:
+ * each slot carries a sequence number that says whose turn it is.
+ *
+ *   sequence == idx          slot free for the client enqueuing at idx
+ *   sequence == idx + 1      request written, server may read it
+ *   sequence == idx + depth  server done, free for the next lap
+ *
+ * == Wakeups ==
+ *
+ * A futex_wake() is a syscall even when nobody sleeps. Both sides set a
+ * "waiting" flag before sleeping, and the other side only calls
+ * futex_wake() when it sees the flag, so a busy server answering a
+ * spinning client makes no syscalls at all.
+ *
+ * == Timeouts ==
+ *
+ * A client that gives up simply stops waiting. Its request stays queued;
+ * when the answer arrives later it carries the old request_id and the
+ * client skips it while waiting for the next one.
+ */
+
+#include "conduit_core/internal/service_channel.hpp"
+#include "conduit_core/internal/futex.hpp"
+#include "conduit_core/internal/time.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+uint32_t align_to_cache_line(size_t size) {
+    return static_cast<uint32_t>((size + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1));
+}
+
+uint32_t request_slot_size(const ServiceConfig& config) {
+    return align_to_cache_line(REQUEST_HEADER_SIZE + config.max_request_size);
+}
+
+uint32_t response_slot_size(const ServiceConfig& config) {
+    return align_to_cache_line(sizeof(ServiceResponseSlot) + config.max_response_size);
+}
+
+// Request slot header field offsets
+constexpr size_t CLIENT_OFFSET = 8;
+constexpr size_t SIZE_OFFSET = 12;
+constexpr size_t REQUEST_ID_OFFSET = 16;
+constexpr size_t TIMESTAMP_OFFSET = 24;
+
+std::atomic<uint64_t>* slot_sequence(uint8_t* slot_ptr) {
+    return reinterpret_cast<std::atomic<uint64_t>*>(slot_ptr);
+}
+
+}  // namespace
+
+size_t calculate_service_region_size(const ServiceConfig& config) {
+    return sizeof(ServiceHeader)
+        + static_cast<size_t>(config.queue_depth) * request_slot_size(config)
+        + MAX_SERVICE_CLIENTS * static_cast<size_t>(response_slot_size(config));
+}
+
+// ============================================================================
+// ServiceChannelServer
+// ============================================================================
+
+ServiceChannelServer::ServiceChannelServer(void* region, size_t region_size, const ServiceConfig& config)
+    : header_(static_cast<ServiceHeader*>(region)),
+      requests_(static_cast<uint8_t*>(region) + sizeof(ServiceHeader)),
+      responses_(requests_ + static_cast<size_t>(config.queue_depth) * request_slot_size(config)),
+      config_(config),
+      request_slot_size_(request_slot_size(config)),
+      response_slot_size_(response_slot_size(config)) {
+    assert(is_power_of_two(config.queue_depth));
+    assert(region_size >= calculate_service_region_size(config));
+    (void)region_size;
+}
+
+/**
+ * Initialize the channel.
+ *
+ * Every request slot starts with sequence == its index: free for the
+ * client that claims that index on the first lap.
+ */
+void ServiceChannelServer::initialize() {
+    header_->queue_depth = config_.queue_depth;
+    header_->request_slot_size = request_slot_size_;
+    header_->response_slot_size = response_slot_size_;
+    header_->max_clients = MAX_SERVICE_CLIENTS;
+
+    header_->enqueue_idx.store(0, std::memory_order_relaxed);
+    header_->dequeue_idx.store(0, std::memory_order_relaxed);
+    header_->client_mask.store(0, std::memory_order_relaxed);
+    header_->request_futex.store(0, std::memory_order_relaxed);
+    header_->server_waiting.store(0, std::memory_order_relaxed);
+    header_->next_request_id.store(1, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < config_.queue_depth; ++i) {
+        uint8_t* slot_ptr = requests_ + static_cast<size_t>(i) * request_slot_size_;
+        slot_sequence(slot_ptr)->store(i, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < MAX_SERVICE_CLIENTS; ++i) {
+        auto* slot = reinterpret_cast<ServiceResponseSlot*>(responses_ + i * response_slot_size_);
+        slot->futex_word.store(0, std::memory_order_relaxed);
+        slot->waiting.store(0, std::memory_order_relaxed);
+        slot->status = 0;
+        slot->size = 0;
+        slot->request_id.store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+/**
+ * Dequeue without waiting.
+ *
+ * Single consumer, so dequeue_idx needs no CAS. The slot is not released
+ * here - the handler reads the payload in place and finish() frees it.
+ */
+std::optional<ServiceRequest> ServiceChannelServer::try_receive() {
+    uint64_t idx = header_->dequeue_idx.load(std::memory_order_relaxed);
+    uint8_t* slot_ptr = requests_ + static_cast<size_t>(idx & (config_.queue_depth - 1)) * request_slot_size_;
+
+    if (slot_sequence(slot_ptr)->load(std::memory_order_acquire) != idx + 1) {
+        return std::nullopt;  // Not written yet
+    }
+
+    ServiceRequest request;
+    uint32_t size;
+    std::memcpy(&request.client, slot_ptr + CLIENT_OFFSET, sizeof(uint32_t));
+    std::memcpy(&size, slot_ptr + SIZE_OFFSET, sizeof(uint32_t));
+    std::memcpy(&request.request_id, slot_ptr + REQUEST_ID_OFFSET, sizeof(uint64_t));
+    std::memcpy(&request.timestamp_ns, slot_ptr + TIMESTAMP_OFFSET, sizeof(uint64_t));
+    request.size = size;
+    request.data = slot_ptr + REQUEST_HEADER_SIZE;
+    return request;
+}
+
+/**
+ * Wait for a request with timeout.
+ *
+ * Same pattern as RingBufferReader::wait_for(), plus the server_waiting
+ * flag so clients only make the wake syscall when it is needed.
+ */
+std::optional<ServiceRequest> ServiceChannelServer::wait_for(std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        if (auto request = try_receive()) {
+            return request;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return std::nullopt;
+        }
+
+        uint32_t current = header_->request_futex.load(std::memory_order_acquire);
+        header_->server_waiting.store(1, std::memory_order_seq_cst);
+
+        // A client that enqueued before seeing the flag has bumped the word
+        if (auto request = try_receive()) {
+            header_->server_waiting.store(0, std::memory_order_relaxed);
+            return request;
+        }
+
+        futex_wait(&header_->request_futex, current,
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now));
+        header_->server_waiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+void* ServiceChannelServer::response_buffer(uint32_t client) {
+    return responses_ + static_cast<size_t>(client) * response_slot_size_ + sizeof(ServiceResponseSlot);
+}
+
+/**
+ * Answer a request.
+ *
+ * Steps:
+ * 1. Fill in status and size (payload is already in place)
+ * 2. Store request_id - this publishes the response
+ * 3. Bump the slot's futex word
+ * 4. Wake the client if it is sleeping
+ * 5. Hand the request slot back to the clients for the next lap
+ */
+void ServiceChannelServer::finish(const ServiceRequest& request, ServiceStatus status, size_t size) {
+    auto* slot = reinterpret_cast<ServiceResponseSlot*>(
+        responses_ + static_cast<size_t>(request.client) * response_slot_size_);
+
+    slot->status = static_cast<uint32_t>(status);
+    slot->size = status == ServiceStatus::Ok ? static_cast<uint32_t>(size) : 0;
+    slot->request_id.store(request.request_id, std::memory_order_release);
+
+    slot->futex_word.fetch_add(1, std::memory_order_seq_cst);
+    if (slot->waiting.load(std::memory_order_seq_cst) != 0) {
+        futex_wake_all(&slot->futex_word);
+    }
+
+    uint64_t idx = header_->dequeue_idx.load(std::memory_order_relaxed);
+    uint8_t* slot_ptr = requests_ + static_cast<size_t>(idx & (config_.queue_depth - 1)) * request_slot_size_;
+    slot_sequence(slot_ptr)->store(idx + config_.queue_depth, std::memory_order_release);
+    header_->dequeue_idx.store(idx + 1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// ServiceChannelClient
+// ============================================================================
+
+ServiceChannelClient::ServiceChannelClient(void* region, size_t region_size)
+    : header_(static_cast<ServiceHeader*>(region)),
+      requests_(static_cast<uint8_t*>(region) + sizeof(ServiceHeader)),
+      responses_(requests_ + static_cast<size_t>(header_->queue_depth) * header_->request_slot_size),
+      request_slot_size_(header_->request_slot_size),
+      response_slot_size_(header_->response_slot_size),
+      queue_mask_(header_->queue_depth - 1) {
+    (void)region_size;
+}
+
+/**
+ * Claim a client slot - same bitmask CAS as RingBufferReader::claim_slot().
+ */
+int ServiceChannelClient::claim_slot() {
+    uint32_t mask = header_->client_mask.load(std::memory_order_acquire);
+
+    while (true) {
+        uint32_t free = ~mask;
+        if (header_->max_clients < 32) {
+            free &= (1u << header_->max_clients) - 1;
+        }
+        if (free == 0) {
+            return -1;  // No slots available
+        }
+
+        uint32_t i = static_cast<uint32_t>(__builtin_ctz(free));
+        if (header_->client_mask.compare_exchange_weak(
+                mask, mask | (1u << i),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            return static_cast<int>(i);
+        }
+        // CAS failed - mask was reloaded, retry
+    }
+}
+
+void ServiceChannelClient::release_slot(int slot) {
+    uint32_t bit = 1u << static_cast<uint32_t>(slot);
+    header_->client_mask.fetch_and(~bit, std::memory_order_release);
+}
+
+/**
+ * Enqueue a request.
+ *
+ * Steps:
+ * 1. Take a request id from the shared counter, then
+ *    claim index idx with a CAS on enqueue_idx, but only if slot idx is
+ *    free for this lap (sequence == idx); sequence < idx means full
+ * 2. Write header and payload
+ * 3. sequence = idx + 1 hands the slot to the server
+ * 4. Bump request_futex and wake the server if it sleeps
+ */
+std::optional<uint64_t> ServiceChannelClient::try_send(int slot, const void* data, size_t size) {
+    if (size + REQUEST_HEADER_SIZE > request_slot_size_) {
+        return std::nullopt;
+    }
+
+    uint64_t idx = header_->enqueue_idx.load(std::memory_order_relaxed);
+    uint8_t* slot_ptr;
+
+    // Step 1: Claim a request slot
+    while (true) {
+        slot_ptr = requests_ + static_cast<size_t>(idx & queue_mask_) * request_slot_size_;
+        uint64_t sequence = slot_sequence(slot_ptr)->load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence - idx);
+
+        if (diff == 0) {
+            if (header_->enqueue_idx.compare_exchange_weak(idx, idx + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return std::nullopt;  // Queue full: server has not finished this slot's last lap
+        } else {
+            idx = header_->enqueue_idx.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Step 2: Write header and payload
+    // Ids are unique across clients, so a slot's next owner never mistakes
+    // a late answer to its previous owner for its own
+    uint64_t request_id = header_->next_request_id.fetch_add(1, std::memory_order_relaxed);
+    auto client = static_cast<uint32_t>(slot);
+    auto size32 = static_cast<uint32_t>(size);
+    uint64_t timestamp_ns = get_timestamp_ns();
+    std::memcpy(slot_ptr + CLIENT_OFFSET, &client, sizeof(uint32_t));
+    std::memcpy(slot_ptr + SIZE_OFFSET, &size32, sizeof(uint32_t));
+    std::memcpy(slot_ptr + REQUEST_ID_OFFSET, &request_id, sizeof(uint64_t));
+    std::memcpy(slot_ptr + TIMESTAMP_OFFSET, &timestamp_ns, sizeof(uint64_t));
+    std::memcpy(slot_ptr + REQUEST_HEADER_SIZE, data, size);
+
+    // Step 3: Publish to the server
+    slot_sequence(slot_ptr)->store(idx + 1, std::memory_order_release);
+
+    // Step 4: Wake the server
+    header_->request_futex.fetch_add(1, std::memory_order_seq_cst);
+    if (header_->server_waiting.load(std::memory_order_seq_cst) != 0) {
+        futex_wake(&header_->request_futex);
+    }
+
+    return request_id;
+}
+
+/**
+ * Wait for our response.
+ *
+ * A response is ours when the slot's futex word has moved and it carries
+ * our request_id. Spinning first avoids two context switches when the
+ * handler is fast; after that, the waiting flag tells the server to wake us.
+ */
+const ServiceResponseSlot* ServiceChannelClient::wait_response(
+        int slot, uint64_t request_id,
+        std::chrono::steady_clock::time_point deadline,
+        std::chrono::nanoseconds spin) {
+    ServiceResponseSlot* response = response_slot(slot);
+    auto spin_until = std::chrono::steady_clock::now() + spin;
+
+    while (true) {
+        uint32_t current = response->futex_word.load(std::memory_order_acquire);
+        if (response->request_id.load(std::memory_order_acquire) == request_id) {
+            return response;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return nullptr;
+        }
+
+        if (now < spin_until) {
+            continue;
+        }
+
+        response->waiting.store(1, std::memory_order_seq_cst);
+        if (response->futex_word.load(std::memory_order_seq_cst) == current) {
+            futex_wait(&response->futex_word, current,
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now));
+        }
+        response->waiting.store(0, std::memory_order_relaxed);
+    }
+}
+
+const void* ServiceChannelClient::response_data(int slot) const {
+    return reinterpret_cast<const uint8_t*>(response_slot(slot)) + sizeof(ServiceResponseSlot);
+}
+
+ServiceResponseSlot* ServiceChannelClient::response_slot(int slot) const {
+    return reinterpret_cast<ServiceResponseSlot*>(
+        responses_ + static_cast<size_t>(slot) * response_slot_size_);
+}
+
+}  // namespace internal
+}  // namespace conduit
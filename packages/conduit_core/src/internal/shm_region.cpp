@@ -45,18 +45,66 @@
  *   float first_x = cloud->x[0];  // Read directly, no copy
  *
  * A 12MB point cloud is never copied - both processes access the same RAM.
+ *
+ * == Huge Pages ==
+ *
+ * /dev/shm is backed by 4KB pages. A 256MB camera ring is 65536 pages: as
+ * many page faults on first touch, and far more TLB entries than the CPU
+ * has, so streaming through the ring keeps missing the TLB. With 2MB huge
+ * pages the same ring is 128 pages.
+ *
+ * POSIX shm_open() cannot ask for huge pages, but a file on a hugetlbfs
+ * mount can be mmap()ed exactly like a /dev/shm file:
+ *
+ *   huge_pages = false:  /dev/shm/conduit_cam          (4KB pages)
+ *   huge_pages = true:   /dev/hugepages/conduit_cam    (2MB pages)
+ *
+ * Subscribers do not need to know which one the publisher picked: open()
+ * looks in /dev/shm first, then in the hugetlbfs directory. Huge pages are
+ * reserved at mmap() time, so if the pool is empty we find out right away
+ * and fall back to /dev/shm instead of crashing with SIGBUS later.
+ *
+ * == Memfd Regions ==
+ *
+ * Named files have two problems: a publisher that crashes never reaches
+ * its unlink(), so /dev/shm fills up with stale conduit_* files, and two
+ * containers sharing /dev/shm see each other's topics.
+ *
+ * create_memfd() uses memfd_create() instead. There is no file; the
+ * publisher hands the fd to subscribers over an abstract Unix socket (see
+ * fd_passing.cpp), and the kernel frees the memory when the last process
+ * using it exits. The size is sealed, so no one can ftruncate() the region
+ * under a reader's mapping.
+ *
+ *   open("cam"):  /dev/shm/conduit_cam?  -> shm_open
+ *                 <hugetlbfs>/conduit_cam? -> open
+ *                 @conduit/cam socket?    -> receive the memfd
  */
 
 #include "conduit_core/internal/shm_region.hpp"
 #include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/fd_passing.hpp"
 
-#include <sys/mman.h>   // mmap, munmap - memory mapping functions
+#include <sys/mman.h>   // mmap, munmap, memfd_create - memory mapping functions
 #include <sys/stat.h>   // fstat - get file info
-#include <fcntl.h>      // O_CREAT, O_RDWR - file open flags
+#include <sys/vfs.h>    // statfs - hugetlbfs page size
+#include <fcntl.h>      // O_CREAT, O_RDWR - file open flags, F_ADD_SEALS
 #include <unistd.h>     // close, ftruncate - POSIX functions
+#include <algorithm>    // min, max
 #include <cerrno>       // errno - error codes
-#include <cstring>      // strerror, memset
-#include <thread>       // sleep_for
+#include <cstdint>      // uint8_t
+#include <cstdlib>      // getenv
+#include <cstring>      // strerror
+#include <fstream>      // /proc/mounts
+#include <thread>       // sleep_for, parallel prefault
+#include <vector>
+
+#ifndef MADV_POPULATE_READ
+#define MADV_POPULATE_READ 22
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
 
 namespace conduit {
 namespace internal {
@@ -75,8 +123,85 @@ std::string make_shm_path(const std::string& name) {
     return "/conduit_" + name;
 }
 
+/**
+ * Path of a topic's file on the hugetlbfs mount, or "" if there is none.
+ */
+std::string make_huge_path(const std::string& name) {
+    std::string dir = ShmRegion::huge_page_dir();
+    return dir.empty() ? std::string() : dir + "/conduit_" + name;
+}
+
 }  // namespace
 
+/**
+ * Find the hugetlbfs mount.
+ *
+ * /proc/mounts is parsed once; the environment override is checked on each
+ * call so tests can redirect it.
+ */
+std::string ShmRegion::huge_page_dir() {
+    if (const char* dir = std::getenv("CONDUIT_HUGETLBFS")) {
+        return dir;
+    }
+
+    static const std::string mount = []() {
+        std::ifstream mounts("/proc/mounts");
+        std::string device, dir, type, rest;
+        while (mounts >> device >> dir >> type && std::getline(mounts, rest)) {
+            if (type == "hugetlbfs") {
+                return dir;
+            }
+        }
+        return std::string();
+    }();
+    return mount;
+}
+
+/**
+ * Create the region on hugetlbfs.
+ *
+ * Returns nullopt when huge pages are unavailable (no mount, pool empty) so
+ * the caller can fall back to /dev/shm. Throws only if the topic exists.
+ */
+std::optional<ShmRegion> ShmRegion::create_huge(const std::string& name, size_t size) {
+    std::string path = make_huge_path(name);
+    if (path.empty()) {
+        return std::nullopt;
+    }
+
+    int fd = ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0) {
+        if (errno == EEXIST) {
+            throw ShmError("Shared memory already exists: " + name);
+        }
+        return std::nullopt;
+    }
+
+    // hugetlbfs files are sized in whole huge pages
+    struct statfs fs;
+    if (fstatfs(fd, &fs) < 0) {
+        close(fd);
+        ::unlink(path.c_str());
+        return std::nullopt;
+    }
+    size_t page = static_cast<size_t>(fs.f_bsize);
+    size_t rounded = (size + page - 1) / page * page;
+
+    // mmap() reserves the huge pages: fails here, not on first touch
+    void* ptr = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(rounded)) == 0) {
+        ptr = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (ptr == MAP_FAILED) {
+        ::unlink(path.c_str());
+        return std::nullopt;
+    }
+
+    return ShmRegion(name, ptr, rounded, page);
+}
+
 /**
  * Create a new shared memory region (used by Publisher).
  *
@@ -87,16 +212,35 @@ std::string make_shm_path(const std::string& name) {
  * 1. shm_open() - Creates /dev/shm/conduit_{name} (like creating a file)
  * 2. ftruncate() - Sets the file size (allocates RAM)
  * 3. mmap() - Maps the file into our address space (gives us a pointer)
- * 4. memset() - Zeros the memory (clean slate)
  *
  * After this, we have a pointer to `size` bytes of shared memory.
  *
+ * There is no memset(): the file is new (O_EXCL), and the kernel hands out
+ * zero-filled pages on first touch. Zeroing it ourselves would fault in
+ * every page up front - seconds and gigabytes of RSS for a 1GB ring before
+ * the first message. The ring buffer writer initializes its header
+ * explicitly; prefault() is the opt-in for paying the faults at startup.
+ *
+ * With huge_pages, the same steps run on the hugetlbfs mount first (see
+ * "Huge Pages" above); any failure there falls through to /dev/shm.
+ *
  * Error handling: If the topic already exists (another publisher), we fail.
  * This prevents multiple writers to the same topic (single-producer design).
  */
-ShmRegion ShmRegion::create(const std::string& name, size_t size) {
+ShmRegion ShmRegion::create(const std::string& name, size_t size, bool huge_pages) {
     std::string path = make_shm_path(name);
 
+    // A topic lives in exactly one of the two places
+    if (huge_pages && !exists(name)) {
+        if (auto region = create_huge(name, size)) {
+            return std::move(*region);
+        }
+    }
+    std::string huge_path = make_huge_path(name);
+    if ((!huge_path.empty() && access(huge_path.c_str(), F_OK) == 0) || fd_server_exists(name)) {
+        throw ShmError("Shared memory already exists: " + name);
+    }
+
     // Step 1: Create shared memory object
     // O_CREAT = create if doesn't exist
     // O_EXCL  = fail if already exists (ensures single publisher)
@@ -134,11 +278,68 @@ ShmRegion ShmRegion::create(const std::string& name, size_t size) {
         throw ShmError("mmap failed for '" + name + "': " + strerror(err));
     }
 
-    // Step 4: Zero-initialize the memory
-    // Important for ring buffer header initialization
-    std::memset(ptr, 0, size);
+    return ShmRegion(name, ptr, size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+}
 
-    return ShmRegion(name, ptr, size);
+/**
+ * Create an anonymous region (see "Memfd Regions" above).
+ *
+ * Steps:
+ * 1. memfd_create() - with MFD_HUGETLB first if asked, plain otherwise
+ * 2. ftruncate() to the size (rounded up to whole pages)
+ * 3. Seal the size: F_SEAL_SHRINK | F_SEAL_GROW, then F_SEAL_SEAL so the
+ *    seals themselves cannot be changed
+ * 4. mmap()
+ * 5. Start serving the fd under the name; the server owns the fd from here
+ */
+ShmRegion ShmRegion::create_memfd(const std::string& name, size_t size, bool huge_pages) {
+    // Same name space as file-backed topics
+    if (exists(name)) {
+        throw ShmError("Shared memory already exists: " + name);
+    }
+
+    // Step 1: Create the memfd
+    std::string label = "conduit_" + name;
+    int fd = -1;
+    if (huge_pages) {
+        fd = memfd_create(label.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING | MFD_HUGETLB);
+    }
+    if (fd < 0) {
+        fd = memfd_create(label.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    }
+    if (fd < 0) {
+        throw ShmError("memfd_create failed for '" + name + "': " + strerror(errno));
+    }
+
+    // Step 2: Size it (hugetlb memfds must be whole huge pages)
+    struct stat st;
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if (fstat(fd, &st) == 0) {
+        page = static_cast<size_t>(st.st_blksize);
+    }
+    size_t rounded = (size + page - 1) / page * page;
+
+    // Step 3 + 4: Seal and map
+    void* ptr = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(rounded)) == 0
+        && fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) == 0) {
+        ptr = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (ptr == MAP_FAILED) {
+        int err = errno;
+        close(fd);
+        throw ShmError("Cannot map memfd for '" + name + "': " + strerror(err));
+    }
+
+    // Step 5: Serve it
+    ShmRegion region(name, ptr, rounded, page);
+    try {
+        region.server_ = std::make_unique<FdServer>(name, fd);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    return region;
 }
 
 /**
@@ -150,6 +351,8 @@ ShmRegion ShmRegion::create(const std::string& name, size_t size) {
  * - No O_CREAT/O_EXCL (topic must already exist)
  * - No ftruncate (size already set by publisher)
  * - No memset (don't want to overwrite publisher's data!)
+ * - Falls back to the hugetlbfs directory if /dev/shm has no such topic,
+ *   then to the memfd registry (whose regions must have a sealed size)
  *
  * Returns a pointer to the SAME memory the publisher is using.
  */
@@ -158,6 +361,19 @@ ShmRegion ShmRegion::open(const std::string& name) {
 
     // Open existing shared memory (no O_CREAT)
     int fd = shm_open(path.c_str(), O_RDWR, 0666);
+    if (fd < 0) {
+        std::string huge_path = make_huge_path(name);
+        if (!huge_path.empty()) {
+            fd = ::open(huge_path.c_str(), O_RDWR);
+        }
+    }
+    if (fd < 0) {
+        fd = receive_fd(name);
+        if (fd >= 0 && (fcntl(fd, F_GET_SEALS) & F_SEAL_SHRINK) == 0) {
+            close(fd);
+            throw ShmError("Memfd for '" + name + "' is not size-sealed");
+        }
+    }
     if (fd < 0) {
         throw ShmError("Shared memory not found: " + name);
     }
@@ -171,6 +387,7 @@ ShmRegion ShmRegion::open(const std::string& name) {
     }
 
     size_t size = static_cast<size_t>(st.st_size);
+    size_t page = static_cast<size_t>(st.st_blksize);  // Huge page size on hugetlbfs
 
     // Map into our address space
     void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
@@ -180,7 +397,7 @@ ShmRegion ShmRegion::open(const std::string& name) {
         throw ShmError("mmap failed for '" + name + "': " + strerror(errno));
     }
 
-    return ShmRegion(name, ptr, size);
+    return ShmRegion(name, ptr, size, page);
 }
 
 /**
@@ -195,7 +412,9 @@ bool ShmRegion::exists(const std::string& name) {
     // Try to open read-only (don't create)
     int fd = shm_open(path.c_str(), O_RDONLY, 0);
     if (fd < 0) {
-        return false;  // Doesn't exist
+        // Maybe a huge page or memfd topic
+        std::string huge_path = make_huge_path(name);
+        return (!huge_path.empty() && access(huge_path.c_str(), F_OK) == 0) || fd_server_exists(name);
     }
 
     close(fd);
@@ -237,18 +456,78 @@ bool ShmRegion::wait_until_exists(const std::string& name,
 void ShmRegion::unlink(const std::string& name) {
     std::string path = make_shm_path(name);
     shm_unlink(path.c_str());  // Ignore errors (might not exist)
+
+    std::string huge_path = make_huge_path(name);
+    if (!huge_path.empty()) {
+        ::unlink(huge_path.c_str());
+    }
+}
+
+/**
+ * Fault in all pages of the mapping.
+ *
+ * mmap() only reserves address space - the kernel maps each 4KB page on the
+ * first access. For a 64MB camera ring that is 16384 page faults spread over
+ * the first few seconds of operation, right where latency matters.
+ *
+ * MADV_POPULATE_{READ,WRITE} (Linux 5.14+) does the faulting in one syscall.
+ * On older kernels we touch one byte per page instead.
+ *
+ * Most of the cost is the kernel zeroing fresh pages, which parallelizes
+ * well. With threads > 1 the region is split into page-aligned chunks:
+ *
+ *   [ chunk 0 (caller) | chunk 1 (thread) | ... | chunk N-1 (thread) ]
+ */
+void ShmRegion::prefault(bool write, unsigned threads) {
+    if (data_ == nullptr || size_ == 0) {
+        return;
+    }
+
+    auto populate = [this, write](size_t begin, size_t end) {
+        auto* bytes = static_cast<uint8_t*>(data_);
+        int advice = write ? MADV_POPULATE_WRITE : MADV_POPULATE_READ;
+        if (madvise(bytes + begin, end - begin, advice) == 0) {
+            return;
+        }
+
+        // Fallback: touch every page
+        auto* pages = reinterpret_cast<volatile uint8_t*>(bytes);
+        for (size_t offset = begin; offset < end; offset += page_size_) {
+            uint8_t value = pages[offset];
+            if (write) {
+                pages[offset] = value;
+            }
+        }
+    };
+
+    // Page-aligned chunks, no more than one per page
+    size_t pages = (size_ + page_size_ - 1) / page_size_;
+    size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, pages));
+    size_t chunk = (pages + chunks - 1) / chunks * page_size_;
+
+    std::vector<std::thread> workers;
+    for (size_t begin = chunk; begin < size_; begin += chunk) {
+        workers.emplace_back(populate, begin, std::min(begin + chunk, size_));
+    }
+    populate(0, std::min(chunk, size_));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
 }
 
 // === Constructor and move semantics ===
 
-ShmRegion::ShmRegion(const std::string& name, void* data, size_t size)
-    : name_(name), data_(data), size_(size) {}
+ShmRegion::ShmRegion(const std::string& name, void* data, size_t size, size_t page_size)
+    : name_(name), data_(data), size_(size), page_size_(page_size) {}
 
 // Move constructor - transfers ownership
 ShmRegion::ShmRegion(ShmRegion&& other) noexcept
     : name_(std::move(other.name_)),
       data_(other.data_),
-      size_(other.size_) {
+      size_(other.size_),
+      page_size_(other.page_size_),
+      server_(std::move(other.server_)) {
     // Prevent other's destructor from unmapping
     other.data_ = nullptr;
     other.size_ = 0;
@@ -265,6 +544,8 @@ ShmRegion& ShmRegion::operator=(ShmRegion&& other) noexcept {
         name_ = std::move(other.name_);
         data_ = other.data_;
         size_ = other.size_;
+        page_size_ = other.page_size_;
+        server_ = std::move(other.server_);
 
         other.data_ = nullptr;
         other.size_ = 0;
@@ -277,6 +558,8 @@ ShmRegion& ShmRegion::operator=(ShmRegion&& other) noexcept {
  *
  * Note: Does NOT unlink! The shared memory file persists.
  * This is intentional - publisher must explicitly unlink when done.
+ * (A memfd region stops being served here; its memory lives on in any
+ * subscriber that still maps it.)
  */
 ShmRegion::~ShmRegion() {
     if (data_ != nullptr) {
@@ -1,10 +1,15 @@
 #include "conduit_core/node.hpp"
 #include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/intra_process.hpp"
+#include "conduit_core/internal/scheduling.hpp"
 #include "conduit_core/internal/shm_region.hpp"
 #include "conduit_core/log.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
 
 using namespace std::chrono_literals;
 
@@ -19,22 +24,54 @@ void Node::signal_handler(int sig) {
     }
 }
 
-Node::Node() = default;
+static bool env_flag(const char* name) {
+    const char* value = std::getenv(name);
+    return value != nullptr && std::strcmp(value, "1") == 0;
+}
 
-Node::~Node() {
-    stop();
+static std::chrono::nanoseconds env_ns(const char* name) {
+    const char* value = std::getenv(name);
+    return std::chrono::nanoseconds(value != nullptr ? std::strtoll(value, nullptr, 10) : 0);
+}
 
-    for (auto& sub : subscriptions_) {
-        if (sub->thread.joinable()) {
-            sub->thread.join();
-        }
+/**
+ * SCHED_DEADLINE parameters from `conduit flow` (CONDUIT_SCHED_*_NS).
+ *
+ * Loop threads get them, falling back to the loop period. Subscription
+ * threads only when a period is given: they have no period of their own.
+ */
+static void apply_env_deadline(NodeOptions& options) {
+    if (std::getenv("CONDUIT_SCHED_RUNTIME_NS") == nullptr) {
+        return;
+    }
+    auto set = [](ThreadOptions& threads) {
+        threads.policy = SchedPolicy::Deadline;
+        threads.runtime = env_ns("CONDUIT_SCHED_RUNTIME_NS");
+        threads.deadline = env_ns("CONDUIT_SCHED_DEADLINE_NS");
+        threads.period = env_ns("CONDUIT_SCHED_PERIOD_NS");
+    };
+    set(options.loop_threads);
+    if (env_ns("CONDUIT_SCHED_PERIOD_NS").count() > 0) {
+        set(options.subscription_threads);
     }
+}
 
-    for (auto& lp : loops_) {
-        if (lp->thread.joinable()) {
-            lp->thread.join();
-        }
+Node::Node(const NodeOptions& options) : options_(options) {
+    if (env_flag("CONDUIT_LOCK_MEMORY")) {
+        options_.lock_memory = true;
     }
+    if (env_flag("CONDUIT_PREFAULT")) {
+        options_.prefault = true;
+    }
+    if (const char* threads = std::getenv("CONDUIT_PREFAULT_THREADS")) {
+        options_.prefault_threads = static_cast<unsigned>(std::max(1, std::atoi(threads)));
+    }
+    apply_env_deadline(options_);
+}
+
+Node::~Node() {
+    stop();
+    join();
 }
 
 void Node::install_signal_handlers() {
@@ -50,18 +87,61 @@ void Node::uninstall_signal_handlers() {
 }
 
 void Node::subscribe(const std::string& topic, std::function<void(const Message&)> callback) {
+    add_subscription(topic, std::move(callback), typeid(void), nullptr);
+}
+
+void Node::add_subscription(const std::string& topic,
+                            std::function<void(const Message&)> callback,
+                            std::type_index type, IntraCallback intra_callback,
+                            const SubscriberOptions& options, int32_t frame_offset,
+                            const internal::TypeInfo& type_info) {
     if (running_.load(std::memory_order_acquire)) {
         throw NodeError("Cannot subscribe while running");
     }
 
     auto sub = std::make_unique<Subscription>();
     sub->topic = topic;
+    sub->options = options;
+    sub->frame_offset = frame_offset;
+    sub->type_info = type_info;
     sub->callback = std::move(callback);
-    sub->subscriber = nullptr;  // created in run()
+    sub->subscriber = nullptr;  // created in start()
+    sub->type = type;
+    sub->intra_callback = std::move(intra_callback);
 
     subscriptions_.push_back(std::move(sub));
 }
 
+void Node::add_synchronization(std::vector<std::string> topics,
+                               std::vector<internal::StampFn> stamps,
+                               std::vector<internal::TypeInfo> types,
+                               const SyncOptions& options,
+                               std::function<void(const std::vector<Message>&)> callback) {
+    if (running_.load(std::memory_order_acquire)) {
+        throw NodeError("Cannot synchronize while running");
+    }
+
+    auto sync = std::make_unique<Synchronization>();
+    sync->topics = std::move(topics);
+    sync->stamps = std::move(stamps);
+    sync->types = std::move(types);
+    sync->options = options;
+    sync->callback = std::move(callback);
+    synchronizations_.push_back(std::move(sync));
+}
+
+void Node::add_service(const std::string& name, const ServiceOptions& options,
+                       internal::ServiceServer::Handler handler) {
+    if (running_.load(std::memory_order_acquire)) {
+        throw NodeError("Cannot advertise a service while running");
+    }
+
+    auto service = std::make_unique<Service>();
+    service->server = std::make_unique<internal::ServiceServer>(name, options);
+    service->handler = std::move(handler);
+    services_.push_back(std::move(service));
+}
+
 void Node::loop(double rate_hz, std::function<void()> callback) {
     if (running_.load(std::memory_order_acquire)) {
         throw NodeError("Cannot add loop while running");
@@ -83,49 +163,123 @@ void Node::run() {
         throw NodeError("Node already running");
     }
 
+    if (options_.lock_memory && internal::lock_memory()) {
+        log::info("Memory locked (mlockall)");
+    }
+
     install_signal_handlers();
 
     running_.store(true, std::memory_order_release);
 
+    if (start()) {
+        log::info("Node running. Press Ctrl+C to stop.");
+
+        // Wait for stop signal
+        while (running_.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(100ms);
+        }
+    }
+
+    join();
+
+    uninstall_signal_handlers();
+    running_.store(false, std::memory_order_release);
+
+    log::info("Node stopped.");
+}
+
+bool Node::start() {
     // Wait for all topics to exist before creating subscribers
     for (const auto& sub : subscriptions_) {
         if (!internal::ShmRegion::exists(sub->topic)) {
             log::info("Waiting for topic: {}", sub->topic);
             if (!internal::ShmRegion::wait_until_exists(sub->topic, running_)) {
-                // Stopped before topic appeared
-                uninstall_signal_handlers();
-                running_.store(false, std::memory_order_release);
-                log::info("Node stopped.");
-                return;
+                return false;  // Stopped before topic appeared
+            }
+        }
+    }
+    for (const auto& sync : synchronizations_) {
+        for (const auto& topic : sync->topics) {
+            if (!internal::ShmRegion::exists(topic)) {
+                log::info("Waiting for topic: {}", topic);
+                if (!internal::ShmRegion::wait_until_exists(topic, running_)) {
+                    return false;
+                }
             }
         }
     }
 
     // Create subscribers and start threads
     for (auto& sub : subscriptions_) {
-        sub->subscriber = std::make_unique<internal::Subscriber>(sub->topic);
+        // Publisher in this process with the same type: skip shared memory.
+        // Filtered subscriptions stay on the ring, where the filter runs,
+        // and so do reliable ones: the in-process queue drops its oldest.
+        if (sub->intra_callback && !sub->options.filtered() && !sub->options.reliable) {
+            sub->channel = internal::IntraProcessManager::instance().find(sub->topic, sub->type);
+        }
+
+        if (sub->channel) {
+            sub->queue = std::make_shared<internal::IntraProcessQueue>(sub->channel->depth());
+            sub->channel->attach(sub->queue);
+            sub->thread = std::thread(&Node::spin_intra_subscription, this, sub.get());
+            log::info("Subscribed to: {} (intra-process)", sub->topic);
+            continue;
+        }
+
+        sub->subscriber = std::make_unique<internal::Subscriber>(sub->topic, sub->options, sub->frame_offset);
+        sub->subscriber->check_type(sub->type_info);
+        if (options_.prefault) {
+            sub->subscriber->prefault(options_.prefault_threads);
+        }
         sub->thread = std::thread(&Node::spin_subscription, this, sub.get());
         log::info("Subscribed to: {}", sub->topic);
     }
 
+    // Synchronized subscriptions read the rings directly
+    for (auto& sync : synchronizations_) {
+        sync->core = std::make_unique<internal::SyncCore>(sync->topics, sync->stamps, sync->options, sync->types);
+        sync->thread = std::thread(&Node::spin_synchronization, this, sync.get());
+        log::info("Synchronizing {} topics", sync->topics.size());
+    }
+
+    // Services answer requests on their own threads
+    for (auto& service : services_) {
+        service->thread = std::thread(&Node::spin_service, this, service.get());
+        log::info("Serving: {}", service->server->name());
+    }
+
     // Start loop threads
     for (auto& lp : loops_) {
         lp->thread = std::thread(&Node::spin_loop, this, lp.get());
         log::info("Started loop: {} Hz", lp->rate_hz);
     }
 
-    log::info("Node running. Press Ctrl+C to stop.");
-
-    // Wait for stop signal
-    while (running_.load(std::memory_order_acquire)) {
-        std::this_thread::sleep_for(100ms);
-    }
+    return true;
+}
 
+void Node::join() {
     // Join subscription threads
     for (auto& sub : subscriptions_) {
         if (sub->thread.joinable()) {
             sub->thread.join();
         }
+        if (sub->channel) {
+            sub->channel->detach(sub->queue);
+            sub->channel.reset();
+            sub->queue.reset();
+        }
+    }
+
+    for (auto& sync : synchronizations_) {
+        if (sync->thread.joinable()) {
+            sync->thread.join();
+        }
+    }
+
+    for (auto& service : services_) {
+        if (service->thread.joinable()) {
+            service->thread.join();
+        }
     }
 
     // Join loop threads
@@ -134,10 +288,6 @@ void Node::run() {
             lp->thread.join();
         }
     }
-
-    uninstall_signal_handlers();
-
-    log::info("Node stopped.");
 }
 
 void Node::stop() {
@@ -148,7 +298,17 @@ bool Node::running() const {
     return running_.load(std::memory_order_acquire);
 }
 
+const ThreadOptions& Node::subscription_thread_options(const std::string& topic) const {
+    auto it = options_.topic_threads.find(topic);
+    if (it != options_.topic_threads.end()) {
+        return it->second;
+    }
+    return options_.subscription_threads;
+}
+
 void Node::spin_subscription(Subscription* sub) {
+    internal::apply_thread_options(subscription_thread_options(sub->topic));
+
     while (running_.load(std::memory_order_acquire)) {
         // Wait with timeout so we can check running_ periodically
         auto msg = sub->subscriber->wait_for(100ms);
@@ -163,7 +323,56 @@ void Node::spin_subscription(Subscription* sub) {
     }
 }
 
+void Node::spin_intra_subscription(Subscription* sub) {
+    internal::apply_thread_options(subscription_thread_options(sub->topic));
+
+    while (running_.load(std::memory_order_acquire)) {
+        auto msg = sub->queue->wait_for(100ms);
+
+        if (msg.has_value()) {
+            try {
+                sub->intra_callback(*msg);
+            } catch (const std::exception& e) {
+                log::error("Exception in callback for {}: {}", sub->topic, e.what());
+            }
+        }
+    }
+}
+
+void Node::spin_synchronization(Synchronization* sync) {
+    internal::apply_thread_options(options_.subscription_threads);
+
+    while (running_.load(std::memory_order_acquire)) {
+        if (!sync->core->wait_for_match(100ms)) {
+            continue;
+        }
+
+        try {
+            sync->callback(sync->core->matched());
+        } catch (const std::exception& e) {
+            log::error("Exception in synchronized callback for {}: {}",
+                       sync->topics.front(), e.what());
+        }
+        sync->core->consume();
+    }
+}
+
+void Node::spin_service(Service* service) {
+    internal::apply_thread_options(subscription_thread_options(service->server->name()));
+
+    while (running_.load(std::memory_order_acquire)) {
+        // Handler exceptions are caught and reported to the client by serve_for()
+        service->server->serve_for(100ms, service->handler);
+    }
+}
+
 void Node::spin_loop(Loop* lp) {
+    ThreadOptions thread_options = options_.loop_threads;
+    if (thread_options.policy == SchedPolicy::Deadline && thread_options.period.count() == 0) {
+        thread_options.period = lp->period;
+    }
+    internal::apply_thread_options(thread_options);
+
     auto next_time = std::chrono::steady_clock::now();
 
     while (running_.load(std::memory_order_acquire)) {
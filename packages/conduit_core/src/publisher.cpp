@@ -1,50 +1,250 @@
 #include "conduit_core/publisher.hpp"
 #include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/numa.hpp"
+
+#include <unistd.h>  // getpid
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 
 namespace conduit {
 
-internal::Publisher::Publisher(const std::string& topic, const PublisherOptions& options)
+namespace {
+
+internal::ShmRegion create_shm(const std::string& name, size_t size, const PublisherOptions& options) {
+    if (options.memfd) {
+        return internal::ShmRegion::create_memfd(name, size, options.huge_pages);
+    }
+    return internal::ShmRegion::create(name, size, options.huge_pages);
+}
+
+/**
+ * Bytes per slot. A slot must be able to hold the descriptor of a message
+ * stored in the overflow arena or buffer pool, however small max_message_size is.
+ */
+uint32_t slot_size(const PublisherOptions& options) {
+    uint32_t payload = options.max_message_size;
+    if (options.overflow_size > 0 || options.pool_blocks > 0) {
+        payload = std::max<uint32_t>(payload, std::max(sizeof(internal::OverflowDescriptor),
+                                                       sizeof(internal::BlockHandle)));
+    }
+    return static_cast<uint32_t>(internal::SLOT_HEADER_SIZE + payload);
+}
+
+internal::ShmRegion create_region(const std::string& topic, const PublisherOptions& options) {
+    size_t size = internal::calculate_region_size({options.depth, slot_size(options)});
+    return create_shm(topic, size, options);
+}
+
+/**
+ * Create the overflow arena, if the options ask for one.
+ *
+ * It outlives resizes: every generation of the ring points into the same
+ * arena, so readers still draining an old ring find their messages.
+ */
+std::unique_ptr<internal::ShmRegion> create_overflow(const std::string& topic, const PublisherOptions& options) {
+    if (options.overflow_size == 0) {
+        return nullptr;
+    }
+    auto region = std::make_unique<internal::ShmRegion>(create_shm(
+        internal::overflow_name(topic), sizeof(internal::OverflowHeader) + options.overflow_size, options));
+    internal::initialize_overflow(region->data(), region->size());
+    return region;
+}
+
+std::unique_ptr<internal::RingBufferWriter> make_writer(internal::ShmRegion& shm,
+                                                       const PublisherOptions& options) {
+    return std::make_unique<internal::RingBufferWriter>(
+        shm.data(),
+        shm.size(),
+        internal::RingBufferConfig{options.depth, slot_size(options)});
+}
+
+/**
+ * Create the buffer pool, if the options ask for one. Like the overflow
+ * arena it is shared by all generations of the ring.
+ */
+std::unique_ptr<internal::ShmRegion> create_pool(const std::string& topic, const PublisherOptions& options) {
+    if (options.pool_blocks == 0) {
+        return nullptr;
+    }
+    if (options.pool_block_size == 0) {
+        throw PublisherError("pool_block_size must be set with pool_blocks for topic: " + topic);
+    }
+    auto region = std::make_unique<internal::ShmRegion>(create_shm(
+        internal::pool_name(topic),
+        internal::BufferPool::calculate_region_size(options.pool_blocks, options.pool_block_size),
+        options));
+    internal::BufferPool::initialize(region->data(), options.pool_blocks, options.pool_block_size);
+    return region;
+}
+
+/// Check whether any subscriber holds a slot on a ring.
+bool ring_has_readers(const internal::ShmRegion& shm) {
+    // Mask is cleared as subscribers release their slots
+    auto* header = static_cast<const internal::RingBufferHeader*>(shm.data());
+    return header->subscriber_mask.load(std::memory_order_acquire) != 0;
+}
+
+/**
+ * Fill in the topic metadata read by subscribers and `conduit info`.
+ */
+void write_info(internal::TopicInfo& info, const internal::TypeInfo& type) {
+    std::memset(&info, 0, sizeof(info));
+
+    size_t len = std::min(type.name.size(), internal::TYPE_NAME_SIZE - 1);
+    std::memcpy(info.type_name, type.name.data(), len);
+    info.type_hash = type.hash;
+    info.layout_hash = type.layout;
+    info.type_size = type.size;
+
+    info.publisher_pid = static_cast<int32_t>(getpid());
+    std::string comm;
+    std::getline(std::ifstream("/proc/self/comm"), comm);
+    std::strncpy(info.publisher_name, comm.c_str(), internal::PROCESS_NAME_SIZE - 1);
+    info.created_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+}  // namespace
+
+internal::Publisher::Publisher(const std::string& topic, const PublisherOptions& options, const TypeInfo& type)
     : topic_(topic),
-      max_message_size_(options.max_message_size),
-      shm_(internal::ShmRegion::create(
-          topic,
-          internal::calculate_region_size({
-              options.depth,
-              static_cast<uint32_t>(internal::SLOT_HEADER_SIZE + options.max_message_size)
-          })
-      )),
-      writer_(std::make_unique<internal::RingBufferWriter>(
-          shm_.data(),
-          shm_.size(),
-          internal::RingBufferConfig{
-              options.depth,
-              static_cast<uint32_t>(internal::SLOT_HEADER_SIZE + options.max_message_size)
-          }
-      )) {
-    writer_->initialize();
+      options_(options),
+      type_(type),
+      shm_(create_region(topic, options)),
+      writer_(make_writer(shm_, options)),
+      overflow_(create_overflow(topic, options)),
+      pool_region_(create_pool(topic, options)) {
+    if (pool_region_) {
+        pool_ = std::make_unique<BufferPool>(pool_region_->data());
+    }
+    TopicInfo info;
+    write_info(info, type_);
+    start_ring(shm_, *writer_, info, 0, 0);
+}
+
+/**
+ * Place and initialize a freshly created ring.
+ *
+ * Nothing has touched the pages yet (create() does not zero them), so
+ * the NUMA policy decides where every page goes.
+ */
+void internal::Publisher::start_ring(ShmRegion& shm, RingBufferWriter& writer, const TopicInfo& info,
+                                     uint32_t generation, uint64_t start_idx) {
+    if (options_.numa == NumaPolicy::Node) {
+        internal::prefer_numa_node(shm.data(), shm.size(), options_.numa_node);
+    } else if (options_.numa == NumaPolicy::NearPublisher) {
+        internal::prefer_numa_node(shm.data(), shm.size(), internal::current_numa_node());
+    }
+
+    // Before initialize(): its release fence publishes the metadata too
+    writer.header()->info = info;
+    if (overflow_) {
+        writer.set_overflow(overflow_->data());
+    }
+    writer.set_pool(pool_.get());
+    writer.initialize(generation, start_idx);
+    // NearSubscribers is applied by the first subscriber
+    writer.header()->numa_policy = static_cast<uint32_t>(options_.numa);
+}
+
+/**
+ * Move to a new ring.
+ *
+ * Steps:
+ * 1. Create and initialize the next generation, continuing at write_idx
+ * 2. Retire the current ring - its readers drain it and follow
+ * 3. Point the original ring at the new one (new subscribers start there)
+ * 4. Drop the old ring. An intermediate generation is unlinked: readers
+ *    still draining it keep their mapping, later ones find the newest
+ *    generation through the original ring. We keep it mapped while it
+ *    has readers so has_readers() still counts them
+ */
+void internal::Publisher::resize(uint32_t depth, uint32_t max_message_size) {
+    if (!is_power_of_two(depth)) {
+        throw PublisherError("Depth must be a power of two: " + std::to_string(depth));
+    }
+    if (depth == options_.depth && max_message_size == options_.max_message_size) {
+        return;
+    }
+    if (depth < 2 && writer_->header()->reliable_mask.load(std::memory_order_acquire) != 0) {
+        throw PublisherError("Depth must be at least 2 with reliable subscribers on: " + topic_);
+    }
+
+    // Step 1
+    PublisherOptions options = options_;
+    options.depth = depth;
+    options.max_message_size = max_message_size;
+    uint32_t generation = generation_ + 1;
+    std::string name = generation_name(topic_, generation);
+    ShmRegion::unlink(name);  // Left behind by a crashed publisher of this topic
+
+    ShmRegion shm = create_region(name, options);
+    auto writer = make_writer(shm, options);
+    start_ring(shm, *writer, writer_->header()->info, generation,
+               writer_->header()->write_idx.load(std::memory_order_relaxed));
+
+    // Step 2
+    writer_->retire(generation);
+
+    // Step 3 + 4
+    if (origin_) {
+        static_cast<RingBufferHeader*>(origin_->data())->next_generation.store(generation, std::memory_order_release);
+        ShmRegion::unlink(generation_name(topic_, generation_));
+        retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                      [](const ShmRegion& ring) { return !ring_has_readers(ring); }),
+                       retired_.end());
+        if (ring_has_readers(shm_)) {
+            retired_.push_back(std::move(shm_));
+        }
+    } else {
+        origin_ = std::make_unique<ShmRegion>(std::move(shm_));
+    }
+    shm_ = std::move(shm);
+    writer_ = std::move(writer);
+    options_ = options;
+    generation_ = generation;
 }
 
 internal::Publisher::Publisher(Publisher&& other) noexcept
     : topic_(std::move(other.topic_)),
-      max_message_size_(other.max_message_size_),
+      options_(other.options_),
+      type_(other.type_),
+      generation_(other.generation_),
       shm_(std::move(other.shm_)),
-      writer_(std::move(other.writer_)) {
-    other.max_message_size_ = 0;
+      writer_(std::move(other.writer_)),
+      origin_(std::move(other.origin_)),
+      retired_(std::move(other.retired_)),
+      overflow_(std::move(other.overflow_)),
+      pool_region_(std::move(other.pool_region_)),
+      pool_(std::move(other.pool_)),
+      ring_blocks_(std::move(other.ring_blocks_)) {
+    other.options_.max_message_size = 0;
 }
 
 internal::Publisher& internal::Publisher::operator=(Publisher&& other) noexcept {
     if (this != &other) {
         // Clean up current state
         if (writer_) {
-            internal::ShmRegion::unlink(topic_);
+            unlink();
         }
 
         topic_ = std::move(other.topic_);
-        max_message_size_ = other.max_message_size_;
+        options_ = other.options_;
+        type_ = other.type_;
+        generation_ = other.generation_;
         shm_ = std::move(other.shm_);
         writer_ = std::move(other.writer_);
+        origin_ = std::move(other.origin_);
+        retired_ = std::move(other.retired_);
+        overflow_ = std::move(other.overflow_);
+        pool_region_ = std::move(other.pool_region_);
+        pool_ = std::move(other.pool_);
+        ring_blocks_ = std::move(other.ring_blocks_);
 
-        other.max_message_size_ = 0;
+        other.options_.max_message_size = 0;
     }
     return *this;
 }
@@ -52,12 +252,153 @@ internal::Publisher& internal::Publisher::operator=(Publisher&& other) noexcept
 internal::Publisher::~Publisher() {
     // Unlink shared memory so it's removed when publisher is destroyed
     if (writer_) {
-        internal::ShmRegion::unlink(topic_);
+        unlink();
     }
 }
 
+void internal::Publisher::unlink() {
+    internal::ShmRegion::unlink(topic_);
+    if (generation_ > 0) {
+        internal::ShmRegion::unlink(generation_name(topic_, generation_));
+    }
+    if (overflow_) {
+        internal::ShmRegion::unlink(overflow_name(topic_));
+    }
+    if (pool_) {
+        internal::ShmRegion::unlink(pool_name(topic_));
+    }
+}
+
+/**
+ * Readers of a retired ring count too: they have not followed yet, and
+ * will look for the messages published meanwhile in the current ring.
+ */
+bool internal::Publisher::has_readers() const {
+    if (ring_has_readers(shm_)) {
+        return true;
+    }
+    if (origin_ && ring_has_readers(*origin_)) {
+        return true;
+    }
+    return std::any_of(retired_.begin(), retired_.end(), ring_has_readers);
+}
+
+/**
+ * Publish, growing the ring first if allowed and needed.
+ *
+ * Slot payloads are rounded up to a power of two so a stream of slowly
+ * growing messages does not resize on every publish. Messages the overflow
+ * arena or buffer pool take do not grow the ring; pool messages are copied
+ * into a block here (loan() avoids that copy).
+ */
 bool internal::Publisher::publish(const void* data, size_t size) {
-    return writer_->try_write(data, size);
+    if (pooled(size)) {
+        auto block = loan(size);
+        if (!block) {
+            return false;
+        }
+        std::memcpy(block->data(), data, size);
+        return publish(std::move(*block));
+    }
+    if (size > std::max(options_.max_message_size, options_.overflow_size) && options_.grow
+        && size <= UINT32_MAX / 2) {
+        uint32_t max_message_size = std::max<uint32_t>(options_.max_message_size, 1);
+        while (max_message_size < size) {
+            max_message_size *= 2;
+        }
+        resize(options_.depth, max_message_size);
+    }
+    bool written = writer_->try_write(data, size);
+    release_lapped();
+    return written;
+}
+
+std::optional<Loan> internal::Publisher::loan(size_t size) {
+    if (!pool_) {
+        throw PublisherError("Topic has no buffer pool (PublisherOptions::pool_blocks): " + topic_);
+    }
+    if (size > pool_->block_size()) {
+        throw PublisherError("Loan of " + std::to_string(size) + " bytes exceeds pool_block_size on " + topic_);
+    }
+    auto handle = pool_->allocate(size);
+    if (!handle) {
+        return std::nullopt;
+    }
+    return Loan(pool_.get(), *handle);
+}
+
+/**
+ * Publish a loaned block.
+ *
+ * Steps:
+ * 1. Write the handle; the loan's reference now belongs to the ring
+ * 2. Drop the references of blocks whose slots this write lapped
+ */
+bool internal::Publisher::publish(Loan&& loan) {
+    // Step 1
+    uint64_t sequence = writer_->header()->write_idx.load(std::memory_order_relaxed);
+    if (!writer_->try_write_block(loan.handle_)) {
+        return false;  // The loan returns the block
+    }
+    ring_blocks_.emplace_back(sequence, loan.handle_);
+    loan.pool_ = nullptr;
+
+    // Step 2
+    release_lapped();
+    return true;
+}
+
+/**
+ * Release the ring's reference to blocks whose slot has been overwritten.
+ *
+ * Sequence s lives in the slot until write s + depth replaces it. Readers
+ * that still want the block took their own reference when they read it.
+ */
+void internal::Publisher::release_lapped() {
+    uint64_t write_idx = writer_->header()->write_idx.load(std::memory_order_relaxed);
+    while (!ring_blocks_.empty() && ring_blocks_.front().first + options_.depth <= write_idx) {
+        pool_->release(ring_blocks_.front().second);
+        ring_blocks_.pop_front();
+    }
+}
+
+Loan::Loan(Loan&& other) noexcept : pool_(other.pool_), handle_(other.handle_) {
+    other.pool_ = nullptr;
+}
+
+Loan& Loan::operator=(Loan&& other) noexcept {
+    if (this != &other) {
+        if (pool_) {
+            pool_->release(handle_);
+        }
+        pool_ = other.pool_;
+        handle_ = other.handle_;
+        other.pool_ = nullptr;
+    }
+    return *this;
+}
+
+Loan::~Loan() {
+    // Not published: the block goes straight back
+    if (pool_) {
+        pool_->release(handle_);
+    }
+}
+
+void* Loan::data() const {
+    return pool_->data(handle_.index);
+}
+
+size_t Loan::capacity() const {
+    return pool_->block_size();
+}
+
+void Loan::resize(size_t size) {
+    if (size > capacity()) {
+        throw PublisherError("Loan resize to " + std::to_string(size) + " bytes exceeds the block size of "
+                             + std::to_string(capacity()));
+    }
+    handle_.size = size;
 }
 
 }  // namespace conduit
@@ -0,0 +1,241 @@
+#include "conduit_core/service.hpp"
+#include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/time.hpp"
+#include "conduit_core/log.hpp"
+
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace conduit {
+
+namespace {
+
+internal::ServiceConfig make_config(const ServiceOptions& options) {
+    if (!internal::is_power_of_two(options.depth)) {
+        throw ServiceError("Service depth must be a power of 2");
+    }
+    return internal::ServiceConfig{options.depth, options.max_request_size, options.max_response_size};
+}
+
+}  // namespace
+
+// ============================================================================
+// ServiceServer
+// ============================================================================
+
+internal::ServiceServer::ServiceServer(const std::string& name, const ServiceOptions& options)
+    : name_(name),
+      max_response_size_(options.max_response_size),
+      shm_([&]() {
+          try {
+              return ShmRegion::create(service_region_name(name),
+                                       calculate_service_region_size(make_config(options)));
+          } catch (const ShmError& e) {
+              throw ServiceError("Cannot create service '" + name + "': " + e.what());
+          }
+      }()),
+      channel_(std::make_unique<ServiceChannelServer>(shm_.data(), shm_.size(), make_config(options))) {
+    channel_->initialize();
+}
+
+internal::ServiceServer::ServiceServer(ServiceServer&& other) noexcept
+    : name_(std::move(other.name_)),
+      max_response_size_(other.max_response_size_),
+      shm_(std::move(other.shm_)),
+      channel_(std::move(other.channel_)) {}
+
+internal::ServiceServer& internal::ServiceServer::operator=(ServiceServer&& other) noexcept {
+    if (this != &other) {
+        if (channel_) {
+            ShmRegion::unlink(service_region_name(name_));
+        }
+
+        name_ = std::move(other.name_);
+        max_response_size_ = other.max_response_size_;
+        shm_ = std::move(other.shm_);
+        channel_ = std::move(other.channel_);
+    }
+    return *this;
+}
+
+internal::ServiceServer::~ServiceServer() {
+    // Connected clients keep their mapping and time out; new ones wait
+    if (channel_) {
+        ShmRegion::unlink(service_region_name(name_));
+    }
+}
+
+/**
+ * Serve one request.
+ *
+ * Steps:
+ * 1. Wait for a request (futex, zero CPU while idle)
+ * 2. Run the handler with the request payload in place and the client's
+ *    response slot as output buffer - neither side is copied
+ * 3. Publish the response and release the request slot
+ */
+bool internal::ServiceServer::serve_for(std::chrono::nanoseconds timeout, const Handler& handler) {
+    auto request = channel_->wait_for(timeout);
+    if (!request) {
+        return false;
+    }
+
+    Message msg{request->data, request->size, request->request_id, request->timestamp_ns};
+    ServiceStatus status = ServiceStatus::Ok;
+    size_t size = 0;
+
+    try {
+        auto written = handler(msg, channel_->response_buffer(request->client), max_response_size_);
+        if (written) {
+            size = *written;
+        } else {
+            status = ServiceStatus::ResponseTooLarge;
+            log::error("Response for service {} exceeds {} bytes", name_, max_response_size_);
+        }
+    } catch (const std::exception& e) {
+        status = ServiceStatus::HandlerError;
+        log::error("Exception in service handler for {}: {}", name_, e.what());
+    }
+
+    channel_->finish(*request, status, size);
+    return true;
+}
+
+// ============================================================================
+// ServiceClient
+// ============================================================================
+
+internal::ServiceClient::ServiceClient(const std::string& name, const ClientOptions& options)
+    : name_(name), options_(options) {}
+
+internal::ServiceClient::ServiceClient(ServiceClient&& other) noexcept
+    : name_(std::move(other.name_)),
+      options_(other.options_),
+      shm_(std::move(other.shm_)),
+      channel_(std::move(other.channel_)),
+      slot_(other.slot_) {
+    other.shm_.reset();
+    other.slot_ = -1;
+}
+
+internal::ServiceClient& internal::ServiceClient::operator=(ServiceClient&& other) noexcept {
+    if (this != &other) {
+        disconnect();
+
+        name_ = std::move(other.name_);
+        options_ = other.options_;
+        shm_ = std::move(other.shm_);
+        channel_ = std::move(other.channel_);
+        slot_ = other.slot_;
+
+        other.shm_.reset();
+        other.slot_ = -1;
+    }
+    return *this;
+}
+
+internal::ServiceClient::~ServiceClient() {
+    disconnect();
+}
+
+void internal::ServiceClient::disconnect() {
+    if (slot_ >= 0 && channel_) {
+        channel_->release_slot(slot_);
+    }
+    slot_ = -1;
+    channel_.reset();
+    shm_.reset();
+}
+
+bool internal::ServiceClient::wait_for_service(std::chrono::nanoseconds timeout) {
+    if (connected()) {
+        return true;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        if (ShmRegion::exists(service_region_name(name_))) {
+            try {
+                shm_.emplace(ShmRegion::open(service_region_name(name_)));
+            } catch (const ShmError&) {
+                shm_.reset();  // Server is still sizing the region, or went away
+            }
+            // queue_depth is zero until the server has initialized the header
+            if (shm_ && static_cast<const ServiceHeader*>(shm_->data())->queue_depth != 0) {
+                break;
+            }
+            shm_.reset();
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+
+    channel_ = std::make_unique<ServiceChannelClient>(shm_->data(), shm_->size());
+    slot_ = channel_->claim_slot();
+    if (slot_ < 0) {
+        disconnect();
+        throw ServiceError("Too many clients for service: " + name_);
+    }
+    return true;
+}
+
+/**
+ * Make one call.
+ *
+ * Steps:
+ * 1. Connect if needed (the server may not be up yet)
+ * 2. Enqueue the request; retry while the queue is full
+ * 3. Wait for the response carrying our request id
+ * 4. Map the status: timeout -> nullopt, handler failure -> ServiceError
+ */
+std::optional<Message> internal::ServiceClient::call(const void* data, size_t size,
+                                                     std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    // Step 1: Connect
+    if (!wait_for_service(timeout)) {
+        return std::nullopt;
+    }
+    if (size > channel_->max_request_size()) {
+        throw ServiceError("Request for service " + name_ + " exceeds max_request_size");
+    }
+
+    // Step 2: Send
+    std::optional<uint64_t> request_id;
+    while (!(request_id = channel_->try_send(slot_, data, size))) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            disconnect();
+            return std::nullopt;
+        }
+        std::this_thread::yield();  // Queue full, server is busy
+    }
+
+    // Step 3: Wait
+    const ServiceResponseSlot* response = channel_->wait_response(slot_, *request_id, deadline, options_.spin);
+    if (response == nullptr) {
+        disconnect();  // Server may be gone; reconnect on the next call
+        return std::nullopt;
+    }
+
+    // Step 4: Status
+    switch (static_cast<ServiceStatus>(response->status)) {
+        case ServiceStatus::Ok:
+            break;
+        case ServiceStatus::ResponseTooLarge:
+            throw ServiceError("Response for service " + name_ + " exceeds max_response_size");
+        default:
+            throw ServiceError("Service handler failed: " + name_);
+    }
+
+    return Message{
+        .data = channel_->response_data(slot_),
+        .size = response->size,
+        .sequence = *request_id,
+        .timestamp_ns = get_timestamp_ns()
+    };
+}
+
+}  // namespace conduit
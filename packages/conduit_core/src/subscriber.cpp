@@ -1,26 +1,250 @@
 #include "conduit_core/subscriber.hpp"
 #include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/numa.hpp"
+#include "conduit_core/publisher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
 
 namespace conduit {
 
-internal::Subscriber::Subscriber(const std::string& topic, const SubscriberOptions& options)
+namespace {
+
+/// How long wait() sleeps when the ring is retired but its successor cannot be opened.
+constexpr auto FOLLOW_RETRY = std::chrono::milliseconds(10);
+
+/**
+ * First subscriber on a NearSubscribers topic: pull the ring to our node.
+ */
+void place_near_subscriber(internal::ShmRegion& shm, internal::RingBufferReader& reader, int slot) {
+    auto* header = reader.header();
+    if (header->numa_policy == static_cast<uint32_t>(NumaPolicy::NearSubscribers)
+        && header->subscriber_mask.load(std::memory_order_acquire) == (1u << slot)) {
+        internal::prefer_numa_node(shm.data(), shm.size(), internal::current_numa_node(), true);
+    }
+}
+
+Message to_message(const internal::ReadResult& result) {
+    return Message{
+        .data = result.data,
+        .size = result.size,
+        .sequence = result.sequence,
+        .timestamp_ns = result.timestamp_ns
+    };
+}
+
+}  // namespace
+
+internal::Subscriber::Subscriber(const std::string& topic, const SubscriberOptions& options,
+                                 int32_t frame_offset)
     : topic_(topic),
       shm_(internal::ShmRegion::open(topic)),
-      reader_(std::make_unique<internal::RingBufferReader>(shm_.data(), shm_.size())),
-      slot_(reader_->claim_slot()) {
-    (void)options;  // reserved for future use
+      reader_(std::make_unique<internal::RingBufferReader>(shm_.data(), shm_.size())) {
+    // Resized topic: the original ring names the current generation. If that
+    // is already gone again we start here and follow like everyone else.
+    uint32_t generation = reader_->header()->next_generation.load(std::memory_order_acquire);
+    if (generation != 0) {
+        try {
+            shm_ = internal::ShmRegion::open(generation_name(topic, generation));
+            reader_ = std::make_unique<internal::RingBufferReader>(shm_.data(), shm_.size());
+        } catch (const ShmError&) {
+        }
+    }
+
+    attach_overflow(*reader_);
 
+    slot_ = reader_->claim_slot();
     if (slot_ < 0) {
         throw SubscriberError("Too many subscribers for topic: " + topic);
     }
+    place_near_subscriber(shm_, *reader_, slot_);
+
+    filter_.decimation = std::max<uint32_t>(options.decimation, 1);
+    filter_.min_interval_ns = static_cast<uint64_t>(std::max<int64_t>(options.min_interval.count(), 0));
+    if (options.max_rate_hz > 0) {
+        filter_.min_interval_ns = std::max(filter_.min_interval_ns, static_cast<uint64_t>(1e9 / options.max_rate_hz));
+    }
+    filter_.latest = options.latest_only;
+    if (!options.frame.empty()) {
+        if (frame_offset < 0) {
+            reader_->release_slot(slot_);
+            throw SubscriberError("Frame filter on " + topic + " needs a fixed-size message type with a Header");
+        }
+        filter_.frame_offset = frame_offset;
+        std::strncpy(filter_.frame, options.frame.c_str(), internal::FILTER_FRAME_SIZE - 1);
+    }
+    if (options.reliable && reader_->header()->slot_count < 2) {
+        // The slot of the message last read is never free: every write would time out
+        reader_->release_slot(slot_);
+        throw SubscriberError("Reliable subscriber on " + topic + " needs a depth of at least 2");
+    }
+    reader_->set_filter(slot_, filter_);
+    if (options.reliable) {
+        reliable_timeout_ = options.reliable_timeout;
+        reader_->set_reliable(slot_, *reliable_timeout_);
+    }
+}
+
+/**
+ * Map the topic's overflow arena and buffer pool if the ring uses them.
+ *
+ * All generations share them, so each is opened at most once.
+ */
+void internal::Subscriber::attach_overflow(RingBufferReader& reader) {
+    if (reader.header()->overflow_capacity != 0) {
+        if (!overflow_) {
+            overflow_ = std::make_unique<ShmRegion>(ShmRegion::open(overflow_name(topic_)));
+        }
+        reader.set_overflow(overflow_->data());
+    }
+    if (reader.header()->pool_blocks != 0) {
+        if (!pool_) {
+            pool_region_ = std::make_unique<ShmRegion>(ShmRegion::open(pool_name(topic_)));
+            pool_ = std::make_unique<BufferPool>(pool_region_->data());
+        }
+        reader.set_pool(pool_.get());
+    }
+}
+
+/**
+ * Make a read message ours until the next one.
+ *
+ * A pool block is referenced so the publisher cannot reuse it while the
+ * caller reads it. Returns false if the block was already released (we
+ * were lapped); the caller then moves on to the next message.
+ */
+bool internal::Subscriber::hold(const ReadResult& result) {
+    drop_held();
+    drop_peeked();
+    if (!result.block) {
+        return true;
+    }
+    if (!pool_->try_acquire(*result.block)) {
+        return false;
+    }
+    held_ = result.block;
+    return true;
+}
+
+void internal::Subscriber::drop_held() {
+    if (held_) {
+        pool_->release(*held_);
+        held_.reset();
+    }
+}
+
+/**
+ * Keep the pool block of a peeked message referenced until it is consumed.
+ *
+ * A message peeked again reuses its reference. Returns false if the block
+ * was already reused, i.e. the message is lost.
+ */
+bool internal::Subscriber::hold_peeked(const ReadResult& result) {
+    if (!result.block) {
+        return true;
+    }
+    auto it = std::find_if(peeked_.begin(), peeked_.end(),
+                           [&](const auto& entry) { return entry.first >= result.sequence; });
+    if (it != peeked_.end() && it->first == result.sequence) {
+        return true;
+    }
+    if (!pool_->try_acquire(*result.block)) {
+        return false;
+    }
+    peeked_.emplace(it, result.sequence, *result.block);
+    return true;
+}
+
+/**
+ * Release the peeked blocks of messages behind the read position
+ * (consumed, or skipped because the writer lapped us), or all of them.
+ */
+void internal::Subscriber::drop_peeked(bool all) {
+    if (peeked_.empty()) {
+        return;
+    }
+    uint64_t position = all ? UINT64_MAX : reader_->position(slot_);
+    while (!peeked_.empty() && peeked_.front().first < position) {
+        pool_->release(peeked_.front().second);
+        peeked_.pop_front();
+    }
+}
+
+/**
+ * Move to the ring that replaced ours (see Publisher::resize).
+ *
+ * Steps:
+ * 1. Only once the ring is retired and we have read all of it
+ * 2. Open the successor. If it has been replaced and unlinked in the
+ *    meantime, the original ring names the newest generation
+ * 3. Claim a slot there and continue at our old position - the new ring
+ *    carries on with the same sequence numbers
+ * 4. Release the old slot
+ *
+ * Returns false if there is nothing to follow or the successor is gone
+ * (publisher shut down).
+ */
+bool internal::Subscriber::follow() {
+    // Step 1
+    if (!reader_->retired(slot_)) {
+        return false;
+    }
+
+    // Step 2
+    try {
+        uint32_t generation = reader_->header()->next_generation.load(std::memory_order_acquire);
+        std::optional<ShmRegion> shm;
+        try {
+            shm.emplace(internal::ShmRegion::open(generation_name(topic_, generation)));
+        } catch (const ShmError&) {
+            auto origin = internal::ShmRegion::open(topic_);
+            generation = static_cast<RingBufferHeader*>(origin.data())->next_generation.load(std::memory_order_acquire);
+            shm.emplace(internal::ShmRegion::open(generation_name(topic_, generation)));
+        }
+        auto reader = std::make_unique<internal::RingBufferReader>(shm->data(), shm->size());
+        attach_overflow(*reader);
+
+        // Step 3
+        int slot = reader->claim_slot();
+        if (slot < 0) {
+            return false;
+        }
+        reader->seek(slot, reader_->position(slot_));
+        reader->set_filter(slot, filter_);
+        if (reliable_timeout_) {
+            reader->set_reliable(slot, *reliable_timeout_);
+        }
+        place_near_subscriber(*shm, *reader, slot);
+
+        // Step 4
+        reader_->release_slot(slot_);
+        shm_ = std::move(*shm);
+        reader_ = std::move(reader);
+        slot_ = slot;
+        return true;
+    } catch (const ShmError&) {
+        return false;
+    }
 }
 
 internal::Subscriber::Subscriber(Subscriber&& other) noexcept
     : topic_(std::move(other.topic_)),
       shm_(std::move(other.shm_)),
       reader_(std::move(other.reader_)),
-      slot_(other.slot_) {
+      slot_(other.slot_),
+      filter_(other.filter_),
+      reliable_timeout_(other.reliable_timeout_),
+      overflow_(std::move(other.overflow_)),
+      pool_region_(std::move(other.pool_region_)),
+      pool_(std::move(other.pool_)),
+      held_(other.held_),
+      peeked_(std::move(other.peeked_)) {
     other.slot_ = -1;
+    other.held_.reset();
+    other.peeked_.clear();
 }
 
 internal::Subscriber& internal::Subscriber::operator=(Subscriber&& other) noexcept {
@@ -29,13 +253,24 @@ internal::Subscriber& internal::Subscriber::operator=(Subscriber&& other) noexce
         if (slot_ >= 0 && reader_) {
             reader_->release_slot(slot_);
         }
+        drop_held();
+        drop_peeked(true);
 
         topic_ = std::move(other.topic_);
         shm_ = std::move(other.shm_);
         reader_ = std::move(other.reader_);
         slot_ = other.slot_;
+        filter_ = other.filter_;
+        reliable_timeout_ = other.reliable_timeout_;
+        overflow_ = std::move(other.overflow_);
+        pool_region_ = std::move(other.pool_region_);
+        pool_ = std::move(other.pool_);
+        held_ = other.held_;
+        peeked_ = std::move(other.peeked_);
 
         other.slot_ = -1;
+        other.held_.reset();
+        other.peeked_.clear();
     }
     return *this;
 }
@@ -44,45 +279,121 @@ internal::Subscriber::~Subscriber() {
     if (slot_ >= 0 && reader_) {
         reader_->release_slot(slot_);
     }
+    drop_held();
+    drop_peeked(true);
 }
 
 std::optional<Message> internal::Subscriber::take() {
-    auto result = reader_->try_read(slot_);
-    if (!result) {
-        return std::nullopt;
+    while (true) {
+        auto result = reader_->try_read(slot_);
+        if (!result && follow()) {
+            result = reader_->try_read(slot_);
+        }
+        if (!result) {
+            drop_held();
+            drop_peeked();
+            return std::nullopt;
+        }
+        if (hold(*result)) {
+            return to_message(*result);
+        }
     }
-
-    return Message{
-        .data = result->data,
-        .size = result->size,
-        .sequence = result->sequence,
-        .timestamp_ns = result->timestamp_ns
-    };
 }
 
 Message internal::Subscriber::wait() {
-    auto result = reader_->wait(slot_);
-    // wait() always returns a value (blocks until data available)
-    return Message{
-        .data = result->data,
-        .size = result->size,
-        .sequence = result->sequence,
-        .timestamp_ns = result->timestamp_ns
-    };
+    while (true) {
+        // The reader only gives up when the ring is retired and drained
+        if (auto result = reader_->wait(slot_)) {
+            if (hold(*result)) {
+                return to_message(*result);
+            }
+            continue;
+        }
+        if (!follow()) {
+            std::this_thread::sleep_for(FOLLOW_RETRY);
+        }
+    }
 }
 
 std::optional<Message> internal::Subscriber::wait_for(std::chrono::nanoseconds timeout) {
-    auto result = reader_->wait_for(slot_, timeout);
-    if (!result) {
-        return std::nullopt;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto remaining = std::max(deadline - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration::zero());
+        if (auto result = reader_->wait_for(slot_, remaining)) {
+            if (hold(*result)) {
+                return to_message(*result);
+            }
+            continue;
+        }
+        if (!follow()) {
+            return std::nullopt;
+        }
     }
+}
 
-    return Message{
-        .data = result->data,
-        .size = result->size,
-        .sequence = result->sequence,
-        .timestamp_ns = result->timestamp_ns
-    };
+/**
+ * Peek, holding the message's pool block. A next unread message whose
+ * block is gone is consumed like in take(); further ahead we report
+ * nothing rather than skip the messages before it.
+ */
+std::optional<Message> internal::Subscriber::peek(uint64_t offset) {
+    while (true) {
+        auto result = reader_->peek(slot_, offset);
+        if (!result && follow()) {
+            result = reader_->peek(slot_, offset);
+        }
+        drop_peeked();
+        if (!result) {
+            return std::nullopt;
+        }
+        if (hold_peeked(*result)) {
+            return to_message(*result);
+        }
+        if (offset > 0) {
+            return std::nullopt;
+        }
+        reader_->advance(slot_);
+    }
+}
+
+void internal::Subscriber::advance(uint64_t count) {
+    reader_->advance(slot_, count);
+    drop_peeked();
+}
+
+void internal::Subscriber::check_type(const TypeInfo& expected) const {
+    const internal::TopicInfo& info = reader_->header()->info;
+    if (expected.hash == 0 || info.type_hash == 0 || info.type_hash == expected.hash) {
+        return;
+    }
+
+    std::string name(info.type_name, strnlen(info.type_name, internal::TYPE_NAME_SIZE));
+    if (name == expected.name) {
+        // Same type, different definition: the binaries were built from different sources
+        throw SubscriberError("Layout mismatch on " + topic_ + ": '" + name + "' is "
+                              + std::to_string(info.type_size) + " bytes in the publisher and "
+                              + std::to_string(expected.size) + " bytes here (or its schema_version differs)");
+    }
+    throw SubscriberError("Type mismatch on " + topic_ + ": publisher sends '" + name
+                          + "', subscriber expects '" + std::string(expected.name) + "'");
+}
+
+std::optional<Message> internal::Subscriber::wait_peek_for(std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto remaining = std::max(deadline - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration::zero());
+        if (auto result = reader_->wait_peek_for(slot_, remaining)) {
+            drop_peeked();
+            if (hold_peeked(*result)) {
+                return to_message(*result);
+            }
+            reader_->advance(slot_);
+            continue;
+        }
+        if (!follow()) {
+            return std::nullopt;
+        }
+    }
 }
 
 }  // namespace conduit
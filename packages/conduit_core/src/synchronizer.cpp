@@ -0,0 +1,144 @@
+/**
+ * @file synchronizer.cpp
+ * @brief Matching messages across topics by timestamp, in place
+ *
+ * == The problem ==
+ *
+ * A fusion node wants (camera, lidar, imu) triples that belong together.
+ * The usual approach copies every message into a per-topic queue and
+ * searches the queues. Most of those copies are thrown away.
+ *
+ * == Matching in the ring ==
+ *
+ * Each topic's ring buffer already retains the last `depth` messages, and
+ * the reader's read_idx marks the oldest one we have not consumed. So the
+ * "queue" is the ring itself:
+ *
+ *   camera:  read_idx -> [t=100] [t=133] [t=166]
+ *   lidar:   read_idx -> [t=90]  [t=190]
+ *   imu:     read_idx -> [t=95]  [t=100] [t=105] ...
+ *
+ * We peek() at the heads, decide, and advance() past what we do not need.
+ * Only the messages of a finished match are ever decoded.
+ *
+ * == Algorithm ==
+ *
+ *   1. pivot = newest stamp among the heads
+ *   2. A head older than pivot - window can never match (every topic's
+ *      stamps only grow), so drop it and start over
+ *   3. Approximate policy: while a topic's next message is still not after
+ *      the pivot, it is a better candidate - drop the head
+ *   4. All heads lie in [pivot - window, pivot]: match
+ *
+ * With window = 0 step 2 keeps dropping until all heads are equal, which is
+ * the exact policy.
+ *
+ * If a topic has no message, we sleep on that topic's futex - the match
+ * cannot complete before it publishes.
+ */
+
+#include "conduit_core/synchronizer.hpp"
+#include "conduit_core/exceptions.hpp"
+
+#include <algorithm>
+
+namespace conduit {
+
+internal::SyncCore::SyncCore(const std::vector<std::string>& topics,
+                             const std::vector<StampFn>& stamps,
+                             const SyncOptions& options,
+                             const std::vector<TypeInfo>& types)
+    : stamps_(stamps),
+      heads_(topics.size()),
+      head_stamps_(topics.size()),
+      window_ns_(static_cast<uint64_t>(std::max<int64_t>(options.window.count(), 0))) {
+    if (topics.size() < 2) {
+        throw SubscriberError("Synchronizer needs at least two topics");
+    }
+    if (stamps.size() != topics.size()) {
+        throw SubscriberError("Synchronizer needs one stamp function per topic");
+    }
+
+    subscribers_.reserve(topics.size());
+    for (size_t i = 0; i < topics.size(); ++i) {
+        subscribers_.push_back(std::make_unique<Subscriber>(topics[i]));
+        if (i < types.size()) {
+            subscribers_.back()->check_type(types[i]);
+        }
+    }
+}
+
+bool internal::SyncCore::try_match() {
+    const size_t n = subscribers_.size();
+
+    while (true) {
+        // Step 1: Load heads and find the pivot
+        uint64_t pivot = 0;
+        for (size_t i = 0; i < n; ++i) {
+            auto head = subscribers_[i]->peek();
+            if (!head) {
+                missing_ = i;
+                return false;
+            }
+            heads_[i] = *head;
+            head_stamps_[i] = stamps_[i](*head);
+            pivot = std::max(pivot, head_stamps_[i]);
+        }
+
+        // Step 2: Drop heads that are too old to ever match
+        bool dropped_any = false;
+        for (size_t i = 0; i < n; ++i) {
+            if (head_stamps_[i] + window_ns_ < pivot) {
+                subscribers_[i]->advance();
+                ++dropped_;
+                dropped_any = true;
+            }
+        }
+        if (dropped_any) {
+            continue;
+        }
+
+        // Step 3: Prefer later messages that are still not after the pivot
+        if (window_ns_ > 0) {
+            for (size_t i = 0; i < n; ++i) {
+                while (auto next = subscribers_[i]->peek(1)) {
+                    uint64_t next_stamp = stamps_[i](*next);
+                    if (next_stamp > pivot) {
+                        break;
+                    }
+                    subscribers_[i]->advance();
+                    ++dropped_;
+                    heads_[i] = *next;
+                    head_stamps_[i] = next_stamp;
+                }
+            }
+        }
+
+        // Step 4: Every head is within the window
+        return true;
+    }
+}
+
+bool internal::SyncCore::wait_for_match(std::chrono::nanoseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!try_match()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+
+        // Sleep until the topic that is holding up the match publishes
+        auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+        subscribers_[missing_]->wait_peek_for(remaining);
+    }
+    return true;
+}
+
+void internal::SyncCore::consume() {
+    for (auto& subscriber : subscribers_) {
+        subscriber->advance();
+    }
+}
+
+}  // namespace conduit
@@ -0,0 +1,208 @@
+#include "conduit_core/async.hpp"
+#include "conduit_core/publisher.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+
+#include <conduit_types/primitives/int.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace conduit;
+using namespace std::chrono_literals;
+
+namespace {
+
+Int make_int(int64_t value) {
+    Int msg;
+    msg.value = value;
+    return msg;
+}
+
+// Coroutines take their state by reference as parameters; lambda captures
+// would dangle once the lambda temporary is gone.
+
+async::Task<void> read_one(async::Subscriber<Int>& sub, std::atomic<int64_t>& out) {
+    auto msg = co_await sub.next();
+    out.store(msg.data.value, std::memory_order_release);
+}
+
+async::Task<void> read_any(async::Subscriber<Int>& a, async::Subscriber<Int>& b,
+                           std::atomic<int>& index, std::atomic<int64_t>& value) {
+    auto msg = co_await async::when_any(a, b);
+    index.store(static_cast<int>(msg.index()), std::memory_order_release);
+    std::visit([&](const auto& m) { value.store(m.data.value, std::memory_order_release); }, msg);
+}
+
+async::Task<void> sleeper(std::chrono::milliseconds duration, std::atomic<int>& done) {
+    co_await async::sleep_for(duration);
+    done.fetch_add(1, std::memory_order_acq_rel);
+}
+
+async::Task<int> add(int a, int b) {
+    co_await async::yield();
+    co_return a + b;
+}
+
+async::Task<void> chain(std::atomic<int>& out) {
+    int x = co_await add(1, 2);
+    int y = co_await add(x, 4);
+    out.store(y, std::memory_order_release);
+}
+
+async::Task<void> read_with_timeout(async::Subscriber<Int>& sub, std::atomic<bool>& timed_out) {
+    auto msg = co_await sub.next_for(20ms);
+    timed_out.store(!msg.has_value(), std::memory_order_release);
+}
+
+async::Task<void> thrower() {
+    co_await async::yield();
+    throw std::runtime_error("boom");
+}
+
+}  // namespace
+
+class AsyncTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        internal::ShmRegion::unlink("async_a");
+        internal::ShmRegion::unlink("async_b");
+    }
+};
+
+TEST_F(AsyncTest, test_next) {
+    Publisher<Int> pub("async_a");
+    async::Subscriber<Int> sub("async_a");
+    std::atomic<int64_t> value{0};
+
+    async::Scheduler scheduler;
+    scheduler.spawn(read_one(sub, value));
+
+    std::thread publisher([&pub]() {
+        std::this_thread::sleep_for(20ms);
+        pub.publish(make_int(42));
+    });
+
+    scheduler.run();
+    publisher.join();
+
+    EXPECT_EQ(value.load(std::memory_order_acquire), 42);
+}
+
+TEST_F(AsyncTest, test_next_follows_resize) {
+    Publisher<Int> pub("async_a");
+    async::Subscriber<Int> sub("async_a");
+    std::atomic<int64_t> value{0};
+
+    // The subscriber only moves to the new ring inside next()
+    pub.resize(32, pub.max_message_size());
+
+    async::Scheduler scheduler;
+    scheduler.spawn(read_one(sub, value));
+
+    std::thread publisher([&pub]() {
+        std::this_thread::sleep_for(20ms);
+        pub.publish(make_int(42));
+    });
+
+    scheduler.run();
+    publisher.join();
+
+    EXPECT_EQ(value.load(std::memory_order_acquire), 42);
+}
+
+TEST_F(AsyncTest, test_when_any) {
+    Publisher<Int> pub_a("async_a");
+    Publisher<Int> pub_b("async_b");
+    async::Subscriber<Int> sub_a("async_a");
+    async::Subscriber<Int> sub_b("async_b");
+    std::atomic<int> index{-1};
+    std::atomic<int64_t> value{0};
+
+    async::Scheduler scheduler;
+    scheduler.spawn(read_any(sub_a, sub_b, index, value));
+
+    std::thread publisher([&pub_b]() {
+        std::this_thread::sleep_for(20ms);
+        pub_b.publish(make_int(7));
+    });
+
+    scheduler.run();
+    publisher.join();
+
+    EXPECT_EQ(index.load(std::memory_order_acquire), 1);
+    EXPECT_EQ(value.load(std::memory_order_acquire), 7);
+}
+
+TEST_F(AsyncTest, test_many_tasks_few_threads) {
+    constexpr int TASKS = 2000;
+    std::atomic<int> done{0};
+
+    async::Scheduler scheduler(2);
+    for (int i = 0; i < TASKS; ++i) {
+        scheduler.spawn(sleeper(std::chrono::milliseconds(1 + i % 20), done));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    scheduler.run();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(done.load(std::memory_order_acquire), TASKS);
+    EXPECT_GE(elapsed, 20ms);
+    EXPECT_LT(elapsed, 2s);
+}
+
+TEST_F(AsyncTest, test_task_chain) {
+    std::atomic<int> out{0};
+
+    async::Scheduler scheduler;
+    scheduler.spawn(chain(out));
+    scheduler.run();
+
+    EXPECT_EQ(out.load(std::memory_order_acquire), 7);
+}
+
+TEST_F(AsyncTest, test_next_for_timeout) {
+    Publisher<Int> pub("async_a");
+    async::Subscriber<Int> sub("async_a");
+    std::atomic<bool> timed_out{false};
+
+    async::Scheduler scheduler;
+    scheduler.spawn(read_with_timeout(sub, timed_out));
+    scheduler.run();
+
+    EXPECT_TRUE(timed_out.load(std::memory_order_acquire));
+}
+
+TEST_F(AsyncTest, test_exception_does_not_stop_scheduler) {
+    std::atomic<int> out{0};
+
+    async::Scheduler scheduler;
+    scheduler.spawn(thrower());
+    scheduler.spawn(chain(out));
+    scheduler.run();
+
+    EXPECT_EQ(out.load(std::memory_order_acquire), 7);
+}
+
+TEST_F(AsyncTest, test_stop_destroys_parked_tasks) {
+    Publisher<Int> pub("async_a");
+    async::Subscriber<Int> sub("async_a");
+    std::atomic<int64_t> value{0};
+
+    {
+        async::Scheduler scheduler;
+        scheduler.spawn(read_one(sub, value));  // Never receives anything
+
+        std::thread stopper([&scheduler]() {
+            std::this_thread::sleep_for(20ms);
+            scheduler.stop();
+        });
+        scheduler.run();
+        stopper.join();
+    }
+
+    EXPECT_EQ(value.load(std::memory_order_acquire), 0);
+}
@@ -0,0 +1,131 @@
+#include "conduit_core/internal/buffer_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace conduit::internal;
+
+class BufferPoolTest : public ::testing::Test {
+protected:
+    std::unique_ptr<uint8_t[]> allocate_region(uint32_t block_count, uint32_t block_size) {
+        size_t size = BufferPool::calculate_region_size(block_count, block_size);
+        auto region = std::make_unique<uint8_t[]>(size + CACHE_LINE_SIZE);
+        std::memset(region.get(), 0, size + CACHE_LINE_SIZE);
+        BufferPool::initialize(aligned(region), block_count, block_size);
+        return region;
+    }
+
+    static void* aligned(const std::unique_ptr<uint8_t[]>& region) {
+        auto address = reinterpret_cast<uintptr_t>(region.get());
+        return reinterpret_cast<void*>((address + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1));
+    }
+};
+
+TEST_F(BufferPoolTest, test_allocate_until_exhausted) {
+    auto region = allocate_region(4, 100);
+    BufferPool pool(aligned(region));
+    EXPECT_EQ(pool.block_size(), 128u);  // Rounded up to a cache line
+    EXPECT_EQ(pool.free_count(), 4u);
+
+    std::set<uint32_t> indices;
+    std::vector<BlockHandle> handles;
+    for (int i = 0; i < 4; ++i) {
+        auto handle = pool.allocate(64);
+        ASSERT_TRUE(handle.has_value());
+        EXPECT_EQ(handle->size, 64u);
+        indices.insert(handle->index);
+        handles.push_back(*handle);
+    }
+    EXPECT_EQ(indices.size(), 4u);
+    EXPECT_FALSE(pool.allocate(64).has_value());
+    EXPECT_EQ(pool.free_count(), 0u);
+
+    pool.release(handles[2]);
+    auto again = pool.allocate(64);
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(again->index, handles[2].index);
+}
+
+TEST_F(BufferPoolTest, test_too_large_rejected) {
+    auto region = allocate_region(2, 64);
+    BufferPool pool(aligned(region));
+    EXPECT_FALSE(pool.allocate(65).has_value());
+    EXPECT_EQ(pool.free_count(), 2u);
+}
+
+TEST_F(BufferPoolTest, test_last_reference_frees_block) {
+    auto region = allocate_region(1, 64);
+    BufferPool pool(aligned(region));
+
+    auto handle = pool.allocate(8);
+    ASSERT_TRUE(handle.has_value());
+    ASSERT_TRUE(pool.try_acquire(*handle));
+    ASSERT_TRUE(pool.try_acquire(*handle));
+
+    pool.release(*handle);
+    pool.release(*handle);
+    EXPECT_EQ(pool.free_count(), 0u);
+    EXPECT_TRUE(pool.valid(*handle));
+
+    pool.release(*handle);
+    EXPECT_EQ(pool.free_count(), 1u);
+    EXPECT_FALSE(pool.valid(*handle));
+}
+
+TEST_F(BufferPoolTest, test_stale_handle_rejected) {
+    auto region = allocate_region(1, 64);
+    BufferPool pool(aligned(region));
+
+    auto first = pool.allocate(8);
+    ASSERT_TRUE(first.has_value());
+    pool.release(*first);
+
+    // Same block, next use: a reader holding the old handle must not get it
+    auto second = pool.allocate(8);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->index, first->index);
+    EXPECT_NE(second->tag, first->tag);
+    EXPECT_FALSE(pool.try_acquire(*first));
+    EXPECT_TRUE(pool.try_acquire(*second));
+}
+
+TEST_F(BufferPoolTest, test_concurrent_allocate_release) {
+    constexpr uint32_t BLOCKS = 8;
+    constexpr int THREADS = 4;
+    constexpr int ITERATIONS = 20000;
+    auto region = allocate_region(BLOCKS, 64);
+    BufferPool pool(aligned(region));
+
+    // Each thread marks the block it owns; seeing another thread's mark
+    // means two threads were handed the same block
+    std::atomic<bool> conflict{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&pool, &conflict, t] {
+            for (int i = 0; i < ITERATIONS; ++i) {
+                auto handle = pool.allocate(8);
+                if (!handle) {
+                    continue;
+                }
+                auto* mark = reinterpret_cast<std::atomic<int>*>(pool.data(handle->index));
+                if (mark->exchange(t + 1) != 0) {
+                    conflict = true;
+                }
+                mark->store(0);
+                pool.release(*handle);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(conflict.load());
+    EXPECT_EQ(pool.free_count(), BLOCKS);
+}
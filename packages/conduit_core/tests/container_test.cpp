@@ -0,0 +1,206 @@
+#include "conduit_core/container.hpp"
+#include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+
+#include <conduit_types/primitives/int.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace conduit;
+using namespace std::chrono_literals;
+
+namespace {
+
+class ProducerNode : public Node {
+public:
+    Publisher<Int> pub{advertise<Int>("intra_topic")};
+};
+
+class SharedConsumerNode : public Node {
+public:
+    SharedConsumerNode() {
+        subscribe<Int>("intra_topic", &SharedConsumerNode::on_int);
+    }
+
+    std::mutex mutex;
+    std::shared_ptr<const Int> last;
+    std::atomic<int> count{0};
+
+private:
+    void on_int(const SharedMessage<Int>& msg) {
+        std::lock_guard<std::mutex> lock(mutex);
+        last = msg.data;
+        count.fetch_add(1, std::memory_order_release);
+    }
+};
+
+class TypedConsumerNode : public Node {
+public:
+    TypedConsumerNode() {
+        subscribe<Int>("intra_topic", &TypedConsumerNode::on_int);
+    }
+
+    std::atomic<int64_t> last_value{0};
+    std::atomic<int> count{0};
+
+private:
+    void on_int(const TypedMessage<Int>& msg) {
+        last_value.store(msg.data.value, std::memory_order_release);
+        count.fetch_add(1, std::memory_order_release);
+    }
+};
+
+}  // namespace
+
+class ContainerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        internal::ShmRegion::unlink("intra_topic");
+    }
+};
+
+TEST_F(ContainerTest, test_container_shared_message_zero_copy) {
+    Container container;
+    auto& producer = container.add<ProducerNode>();
+    auto& consumer = container.add<SharedConsumerNode>();
+    EXPECT_EQ(container.size(), 2u);
+
+    std::thread container_thread([&container]() {
+        container.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    auto msg = std::make_shared<Int>();
+    msg->value = 42;
+    std::shared_ptr<const Int> sent = msg;
+    EXPECT_TRUE(producer.pub.publish(sent));
+
+    for (int i = 0; i < 50 && consumer.count.load(std::memory_order_acquire) == 0; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    container.stop();
+    container_thread.join();
+
+    ASSERT_EQ(consumer.count.load(std::memory_order_acquire), 1);
+    std::lock_guard<std::mutex> lock(consumer.mutex);
+    EXPECT_EQ(consumer.last.get(), sent.get());  // Same object, not a copy
+}
+
+TEST_F(ContainerTest, test_container_typed_message_intra_process) {
+    Container container;
+    auto& producer = container.add<ProducerNode>();
+    auto& consumer = container.add<TypedConsumerNode>();
+
+    std::thread container_thread([&container]() {
+        container.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    Int msg;
+    msg.value = 7;
+    EXPECT_TRUE(producer.pub.publish(msg));
+
+    for (int i = 0; i < 50 && consumer.count.load(std::memory_order_acquire) == 0; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    container.stop();
+    container_thread.join();
+
+    EXPECT_EQ(consumer.count.load(std::memory_order_acquire), 1);
+    EXPECT_EQ(consumer.last_value.load(std::memory_order_acquire), 7);
+}
+
+TEST_F(ContainerTest, test_container_external_subscriber_sees_ring) {
+    Container container;
+    auto& producer = container.add<ProducerNode>();
+    auto& consumer = container.add<SharedConsumerNode>();
+
+    std::thread container_thread([&container]() {
+        container.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    // A raw shm reader, as `conduit echo` would use
+    internal::Subscriber external("intra_topic");
+
+    auto msg = std::make_shared<const Int>(Int{{}, 99});
+    EXPECT_TRUE(producer.pub.publish(msg));
+
+    auto received = external.wait_for(500ms);
+    ASSERT_TRUE(received.has_value());
+    ASSERT_EQ(received->size, sizeof(Int));
+    Int value;
+    std::memcpy(&value, received->data, sizeof(Int));
+    EXPECT_EQ(value.value, 99);
+
+    for (int i = 0; i < 50 && consumer.count.load(std::memory_order_acquire) == 0; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    container.stop();
+    container_thread.join();
+
+    EXPECT_EQ(consumer.count.load(std::memory_order_acquire), 1);
+}
+
+TEST_F(ContainerTest, test_container_external_subscriber_survives_resize) {
+    Container container;
+    auto& producer = container.add<ProducerNode>();
+    auto& consumer = container.add<SharedConsumerNode>();
+
+    std::thread container_thread([&container]() {
+        container.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    // Attached to generation 0; it follows only once it has drained that ring
+    internal::Subscriber external("intra_topic");
+    producer.pub.resize(32, producer.pub.max_message_size());
+
+    constexpr int count = 10;
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(producer.pub.publish(std::make_shared<const Int>(Int{{}, i})));
+    }
+
+    for (int i = 0; i < count; ++i) {
+        auto received = external.wait_for(500ms);
+        ASSERT_TRUE(received.has_value()) << "message " << i;
+        Int value;
+        std::memcpy(&value, received->data, sizeof(Int));
+        EXPECT_EQ(value.value, i);
+    }
+
+    for (int i = 0; i < 50 && consumer.count.load(std::memory_order_acquire) < count; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    container.stop();
+    container_thread.join();
+
+    EXPECT_EQ(consumer.count.load(std::memory_order_acquire), count);
+}
+
+TEST_F(ContainerTest, test_container_add_while_running_throws) {
+    Container container;
+    container.add<ProducerNode>();
+
+    std::thread container_thread([&container]() {
+        container.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    EXPECT_THROW(container.add<TypedConsumerNode>(), NodeError);
+
+    container.stop();
+    container_thread.join();
+    EXPECT_FALSE(container.running());
+}
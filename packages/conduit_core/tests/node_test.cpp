@@ -2,8 +2,12 @@
 #include "conduit_core/exceptions.hpp"
 #include "conduit_core/internal/shm_region.hpp"
 
+#include <conduit_types/primitives/int.hpp>
+
 #include <gtest/gtest.h>
 
+#include <sched.h>
+
 #include <atomic>
 #include <chrono>
 #include <optional>
@@ -24,6 +28,7 @@ protected:
         internal::ShmRegion::unlink("never_publishes");
         internal::ShmRegion::unlink("dummy");
         internal::ShmRegion::unlink("late");
+        internal::ShmRegion::unlink("reliable");
     }
 };
 
@@ -298,3 +303,92 @@ TEST_F(NodeTest, test_node_cannot_run_twice) {
     node.stop();
     node_thread.join();
 }
+
+TEST_F(NodeTest, test_node_thread_affinity) {
+    class TestNode : public Node {
+    public:
+        std::atomic<int> cpu_count{-1};
+        std::atomic<bool> cpu0_allowed{false};
+
+        explicit TestNode(const NodeOptions& options) : Node(options) {
+            subscribe("test_topic", &TestNode::on_message);
+        }
+
+        void on_message(const Message& msg) {
+            (void)msg;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            sched_getaffinity(0, sizeof(set), &set);
+            cpu0_allowed.store(CPU_ISSET(0, &set), std::memory_order_release);
+            cpu_count.store(CPU_COUNT(&set), std::memory_order_release);
+        }
+    };
+
+    internal::Publisher pub("test_topic");
+
+    NodeOptions options;
+    options.subscription_threads.cpus = {0};
+    options.prefault = true;
+
+    TestNode node(options);
+    std::thread node_thread([&node]() {
+        node.run();
+    });
+
+    std::this_thread::sleep_for(50ms);
+    pub.publish("hello", 5);
+    std::this_thread::sleep_for(50ms);
+
+    node.stop();
+    node_thread.join();
+
+    EXPECT_EQ(node.cpu_count.load(std::memory_order_acquire), 1);
+    EXPECT_TRUE(node.cpu0_allowed.load(std::memory_order_acquire));
+}
+
+TEST_F(NodeTest, test_node_reliable_in_process) {
+    class TestNode : public Node {
+    public:
+        Publisher<Int> pub{advertise<Int>("reliable", {.depth = 4})};
+        std::atomic<int> count{0};
+        std::atomic<bool> in_order{true};
+
+        TestNode() {
+            SubscriberOptions options;
+            options.reliable = true;
+            options.reliable_timeout = 1s;
+            subscribe<Int>("reliable", &TestNode::on_int, options);
+        }
+
+        void on_int(const TypedMessage<Int>& msg) {
+            if (msg.data.value != count.load(std::memory_order_relaxed)) {
+                in_order.store(false, std::memory_order_relaxed);
+            }
+            std::this_thread::sleep_for(1ms);
+            count.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    TestNode node;
+    std::thread node_thread([&node]() {
+        node.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    // The subscriber is far slower than the publisher; none may be dropped
+    constexpr int COUNT = 32;
+    for (int i = 0; i < COUNT; ++i) {
+        Int msg;
+        msg.value = i;
+        node.pub.publish(msg);
+    }
+    for (int i = 0; i < 100 && node.count.load(std::memory_order_acquire) < COUNT; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    node.stop();
+    node_thread.join();
+
+    EXPECT_EQ(node.count.load(std::memory_order_acquire), COUNT);
+    EXPECT_TRUE(node.in_order.load());
+}
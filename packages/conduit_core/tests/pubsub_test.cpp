@@ -1,6 +1,7 @@
 #include "conduit_core/publisher.hpp"
 #include "conduit_core/subscriber.hpp"
 #include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/numa.hpp"
 #include "conduit_core/internal/shm_region.hpp"
 #include "conduit_core/internal/time.hpp"
 
@@ -10,6 +11,7 @@
 #include <chrono>
 #include <cstring>
 #include <thread>
+#include <unistd.h>
 #include <vector>
 
 using namespace conduit;
@@ -19,8 +21,10 @@ class PubSubTest : public ::testing::Test {
 protected:
     void TearDown() override {
         // Clean up any test topics
-        for (int i = 1; i <= 10; ++i) {
+        for (int i = 1; i <= 22; ++i) {
             internal::ShmRegion::unlink("test_topic_" + std::to_string(i));
+            internal::ShmRegion::unlink(internal::overflow_name("test_topic_" + std::to_string(i)));
+            internal::ShmRegion::unlink(internal::pool_name("test_topic_" + std::to_string(i)));
         }
     }
 };
@@ -334,3 +338,384 @@ TEST_F(PubSubTest, test_gap_detection) {
         EXPECT_GE(messages[0].sequence, 6u);
     }
 }
+
+TEST_F(PubSubTest, test_memfd_publisher) {
+    const std::string topic = "test_topic_9";
+
+    {
+        internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64, .memfd = true});
+        EXPECT_TRUE(internal::ShmRegion::exists(topic));
+        EXPECT_NE(access(("/dev/shm/conduit_" + topic).c_str(), F_OK), 0);  // No file
+
+        internal::Subscriber sub(topic);
+        const char data[] = "memfd";
+        ASSERT_TRUE(pub.publish(data, sizeof(data)));
+
+        auto msg = sub.take();
+        ASSERT_TRUE(msg.has_value());
+        EXPECT_EQ(std::memcmp(msg->data, data, sizeof(data)), 0);
+
+        // Same name space as file-backed topics
+        EXPECT_THROW((internal::Publisher(topic)), ShmError);
+    }
+
+    // Gone with the publisher, nothing to unlink
+    EXPECT_FALSE(internal::ShmRegion::exists(topic));
+}
+
+TEST_F(PubSubTest, test_numa_placement) {
+    const std::string topic = "test_topic_10";
+
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 4096,
+                                    .numa = NumaPolicy::Node, .numa_node = 0});
+    pub.prefault();
+
+    internal::Subscriber sub(topic);
+    EXPECT_EQ(sub.take(), std::nullopt);
+
+    auto region = internal::ShmRegion::open(topic);
+    auto* header = static_cast<internal::RingBufferHeader*>(region.data());
+    EXPECT_EQ(header->numa_policy, static_cast<uint32_t>(NumaPolicy::Node));
+
+    // Every page is resident after prefault, and on node 0
+    auto nodes = internal::numa_page_nodes(region.data(), region.size(), region.page_size());
+    if (nodes.empty()) {
+        GTEST_SKIP() << "move_pages() not available";
+    }
+    size_t pages = (region.size() + region.page_size() - 1) / region.page_size();
+    EXPECT_EQ(nodes[0], pages);
+}
+
+TEST_F(PubSubTest, test_resize_keeps_backlog) {
+    const std::string topic = "test_topic_11";
+
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64});
+    internal::Subscriber sub(topic);
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pub.publish(&i, 1));
+    }
+    std::vector<uint8_t> big(1000, 7);
+    EXPECT_FALSE(pub.publish(big.data(), big.size()));
+
+    pub.resize(32, 1024);
+    EXPECT_EQ(pub.generation(), 1u);
+    EXPECT_EQ(pub.max_message_size(), 1024u);
+    ASSERT_TRUE(pub.publish(big.data(), big.size()));
+
+    // Old ring first, then the new one, with continuous sequence numbers
+    for (uint64_t i = 0; i < 3; ++i) {
+        auto msg = sub.take();
+        ASSERT_TRUE(msg.has_value());
+        EXPECT_EQ(msg->sequence, i);
+        EXPECT_EQ(*static_cast<const uint8_t*>(msg->data), i);
+    }
+    auto msg = sub.take();
+    ASSERT_TRUE(msg.has_value());
+    EXPECT_EQ(msg->sequence, 3u);
+    EXPECT_EQ(msg->size, big.size());
+    EXPECT_FALSE(sub.take().has_value());
+
+    // New subscribers start on the current ring
+    internal::Subscriber late(topic);
+    uint8_t value = 9;
+    pub.publish(&value, 1);
+    auto next = late.take();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->sequence, 4u);
+}
+
+TEST_F(PubSubTest, test_resize_wakes_waiting_subscriber) {
+    const std::string topic = "test_topic_12";
+
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64});
+    internal::Subscriber sub(topic);
+
+    std::atomic<bool> received{false};
+    std::thread waiter([&] {
+        auto msg = sub.wait_for(2s);
+        received = msg.has_value() && msg->size == 512;
+    });
+
+    std::this_thread::sleep_for(20ms);
+    pub.resize(16, 512);
+    std::vector<uint8_t> payload(512, 1);
+    pub.publish(payload.data(), payload.size());
+
+    waiter.join();
+    EXPECT_TRUE(received);
+}
+
+TEST_F(PubSubTest, test_resize_twice_with_lagging_subscriber) {
+    const std::string topic = "test_topic_13";
+
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64});
+    internal::Subscriber sub(topic);
+
+    uint8_t value = 1;
+    pub.publish(&value, 1);
+    pub.resize(16, 128);
+    pub.publish(&value, 1);
+    pub.resize(16, 256);  // Unlinks generation 1 before sub has seen it
+    EXPECT_FALSE(internal::ShmRegion::exists(internal::generation_name(topic, 1)));
+    pub.publish(&value, 1);
+
+    // Generation 0 backlog, then straight to generation 2
+    auto first = sub.take();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->sequence, 0u);
+    auto last = sub.take();
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->sequence, 2u);
+}
+
+TEST_F(PubSubTest, test_grow_on_large_message) {
+    const std::string topic = "test_topic_14";
+
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64, .grow = true});
+    internal::Subscriber sub(topic);
+    EXPECT_TRUE(pub.fits(100000));
+
+    std::vector<uint8_t> payload(200, 3);
+    ASSERT_TRUE(pub.publish(payload.data(), payload.size()));
+    EXPECT_EQ(pub.max_message_size(), 256u);
+
+    auto msg = sub.wait_for(100ms);
+    ASSERT_TRUE(msg.has_value());
+    EXPECT_EQ(msg->size, payload.size());
+}
+
+TEST_F(PubSubTest, test_overflow_large_message) {
+    const std::string topic = "test_topic_15";
+
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64, .overflow_size = 1 << 20});
+    internal::Subscriber sub(topic);
+    EXPECT_TRUE(pub.fits(1 << 20));
+    EXPECT_FALSE(pub.fits((1 << 20) + 1));
+
+    std::vector<uint8_t> small(32, 1);
+    std::vector<uint8_t> large(100000);
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<uint8_t>(i * 7);
+    }
+    ASSERT_TRUE(pub.publish(small.data(), small.size()));
+    ASSERT_TRUE(pub.publish(large.data(), large.size()));
+    ASSERT_TRUE(pub.publish(small.data(), small.size()));
+    std::vector<uint8_t> too_large((1 << 20) + 1);
+    EXPECT_FALSE(pub.publish(too_large.data(), too_large.size()));
+    EXPECT_EQ(pub.max_message_size(), 64u);  // Ring is unchanged
+
+    auto first = sub.take();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->size, small.size());
+
+    auto second = sub.take();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->sequence, 1u);
+    ASSERT_EQ(second->size, large.size());
+    EXPECT_EQ(std::memcmp(second->data, large.data(), large.size()), 0);
+
+    auto third = sub.take();
+    ASSERT_TRUE(third.has_value());
+    EXPECT_EQ(third->sequence, 2u);
+    EXPECT_EQ(third->size, small.size());
+}
+
+TEST_F(PubSubTest, test_overflow_skips_reused_message) {
+    const std::string topic = "test_topic_16";
+
+    // Arena of 4096 bytes: the 1500 byte messages land at 0, 1536, 4096 (the
+    // third does not fit before the end) and 5632. The first two are gone.
+    internal::Publisher pub(topic, {.depth = 16, .max_message_size = 64, .overflow_size = 4096});
+    internal::Subscriber sub(topic);
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        std::vector<uint8_t> payload(1500, i);
+        ASSERT_TRUE(pub.publish(payload.data(), payload.size()));
+    }
+
+    for (uint8_t i = 2; i < 4; ++i) {
+        auto msg = sub.take();
+        ASSERT_TRUE(msg.has_value());
+        EXPECT_EQ(msg->sequence, i);
+        ASSERT_EQ(msg->size, 1500u);
+        EXPECT_EQ(static_cast<const uint8_t*>(msg->data)[0], i);
+        EXPECT_EQ(static_cast<const uint8_t*>(msg->data)[1499], i);
+    }
+    EXPECT_FALSE(sub.take().has_value());
+}
+
+TEST_F(PubSubTest, test_loan_zero_copy) {
+    const std::string topic = "test_topic_17";
+
+    internal::Publisher pub(topic, {.depth = 4, .max_message_size = 64,
+                                    .pool_blocks = 8, .pool_block_size = 1 << 20});
+    internal::Subscriber sub(topic);
+
+    auto loan = pub.loan(1000);
+    ASSERT_TRUE(loan.has_value());
+    std::memset(loan->data(), 0x42, loan->size());
+    loan->resize(500);
+    ASSERT_TRUE(pub.publish(std::move(*loan)));
+
+    auto msg = sub.take();
+    ASSERT_TRUE(msg.has_value());
+    ASSERT_EQ(msg->size, 500u);
+    EXPECT_EQ(static_cast<const uint8_t*>(msg->data)[0], 0x42);
+    EXPECT_EQ(static_cast<const uint8_t*>(msg->data)[499], 0x42);
+
+    EXPECT_THROW(pub.loan((1 << 20) + 1), PublisherError);
+    internal::Publisher plain(topic + "_plain");
+    EXPECT_THROW(plain.loan(8), PublisherError);
+    internal::ShmRegion::unlink(topic + "_plain");
+}
+
+TEST_F(PubSubTest, test_pool_blocks_returned) {
+    const std::string topic = "test_topic_18";
+
+    // 4 blocks, 2 slots: the ring holds at most 2, the subscriber 1
+    internal::Publisher pub(topic, {.depth = 2, .max_message_size = 64,
+                                    .pool_blocks = 4, .pool_block_size = 4096});
+    internal::Subscriber sub(topic);
+
+    std::vector<uint8_t> large(1000);
+    for (uint8_t i = 0; i < 20; ++i) {
+        std::memset(large.data(), i, large.size());
+        ASSERT_TRUE(pub.publish(large.data(), large.size())) << "pool exhausted at " << int(i);
+
+        auto msg = sub.take();
+        ASSERT_TRUE(msg.has_value());
+        ASSERT_EQ(msg->size, large.size());
+        EXPECT_EQ(static_cast<const uint8_t*>(msg->data)[999], i);
+    }
+
+    // A loan that is never published goes back to the pool
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(pub.loan(100).has_value());
+    }
+}
+
+TEST_F(PubSubTest, test_peek_holds_pool_block) {
+    const std::string topic = "test_topic_21";
+
+    internal::Publisher pub(topic, {.depth = 2, .max_message_size = 64,
+                                    .pool_blocks = 4, .pool_block_size = 4096});
+    internal::Subscriber sub(topic);
+
+    std::vector<uint8_t> large(1000, 0xAA);
+    ASSERT_TRUE(pub.publish(large.data(), large.size()));
+    auto head = sub.peek();
+    ASSERT_TRUE(head.has_value());
+
+    // Lap the ring: the peeked block must not be handed out again
+    for (uint8_t i = 0; i < 10; ++i) {
+        std::memset(large.data(), i, large.size());
+        ASSERT_TRUE(pub.publish(large.data(), large.size()));
+    }
+    EXPECT_EQ(static_cast<const uint8_t*>(head->data)[0], 0xAA);
+    EXPECT_EQ(static_cast<const uint8_t*>(head->data)[999], 0xAA);
+
+    // Consumed: the block goes back and the pool does not run dry
+    sub.advance();
+    for (uint8_t i = 0; i < 20; ++i) {
+        ASSERT_TRUE(pub.publish(large.data(), large.size())) << "pool exhausted at " << int(i);
+        ASSERT_TRUE(sub.peek().has_value());
+        sub.advance();
+    }
+}
+
+TEST_F(PubSubTest, test_reliable_subscriber_not_lapped) {
+    const std::string topic = "test_topic_19";
+
+    // 8 slots, 500 messages published as fast as possible: a normal
+    // subscriber that reads slowly would be lapped many times
+    internal::Publisher pub(topic, {.depth = 8, .max_message_size = 64});
+    SubscriberOptions options;
+    options.reliable = true;
+    options.reliable_timeout = std::chrono::seconds(5);
+    internal::Subscriber sub(topic, options);
+
+    std::thread publisher([&pub] {
+        for (uint32_t i = 0; i < 500; ++i) {
+            pub.publish(&i, sizeof(i));
+        }
+    });
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        auto msg = sub.wait_for(std::chrono::seconds(5));
+        ASSERT_TRUE(msg.has_value()) << "missing message " << i;
+        EXPECT_EQ(msg->sequence, i);
+        uint32_t value;
+        std::memcpy(&value, msg->data, sizeof(value));
+        EXPECT_EQ(value, i);
+        if (i % 50 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    publisher.join();
+}
+
+TEST_F(PubSubTest, test_reliable_subscriber_timeout) {
+    const std::string topic = "test_topic_20";
+
+    internal::Publisher pub(topic, {.depth = 8, .max_message_size = 64});
+    SubscriberOptions options;
+    options.reliable = true;
+    options.reliable_timeout = std::chrono::milliseconds(50);
+    internal::Subscriber sub(topic, options);
+
+    // 7 messages fit (one slot stays with the message last read)
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < 7; ++i) {
+        pub.publish(&i, sizeof(i));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    // The 8th waits out the timeout, then the subscriber is lapped without further waits
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 7; i < 30; ++i) {
+        pub.publish(&i, sizeof(i));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(50));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+
+    auto msg = sub.take();
+    ASSERT_TRUE(msg.has_value());
+    EXPECT_EQ(msg->sequence, 22u);  // Oldest message still in the ring
+    while (sub.take().has_value()) {
+    }
+
+    // Caught up: the publisher waits for it again
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 30; i < 38; ++i) {
+        pub.publish(&i, sizeof(i));
+    }
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(PubSubTest, test_reliable_subscriber_needs_depth_two) {
+    const std::string topic = "test_topic_22";
+
+    // With one slot the message last read would block every write
+    internal::Publisher shallow(topic, {.depth = 1, .max_message_size = 64});
+    SubscriberOptions options;
+    options.reliable = true;
+    EXPECT_THROW(internal::Subscriber(topic, options), SubscriberError);
+    internal::Subscriber plain(topic);  // The slot was released
+
+    internal::Publisher pub(topic + "_resized", {.depth = 2, .max_message_size = 64});
+    internal::Subscriber sub(topic + "_resized", options);
+    EXPECT_THROW(pub.resize(1, 64), PublisherError);
+
+    // Depth 2 keeps every message without waiting
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < 10; ++i) {
+        pub.publish(&i, sizeof(i));
+        auto msg = sub.take();
+        ASSERT_TRUE(msg.has_value());
+        EXPECT_EQ(msg->sequence, i);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    internal::ShmRegion::unlink(topic + "_resized");
+}
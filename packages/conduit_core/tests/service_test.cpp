@@ -0,0 +1,206 @@
+#include "conduit_core/exceptions.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+#include "conduit_core/node.hpp"
+#include "conduit_core/service.hpp"
+
+#include <conduit_types/primitives/int.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using namespace std::chrono_literals;
+
+namespace {
+
+Int make_int(int64_t value) {
+    Int msg;
+    msg.value = value;
+    return msg;
+}
+
+Int double_it(const Int& req) {
+    return make_int(req.value * 2);
+}
+
+class DoublerNode : public Node {
+public:
+    DoublerNode() {
+        advertise_service("srv_test", &DoublerNode::on_request);
+    }
+
+private:
+    Int on_request(const Int& req) {
+        if (req.value < 0) {
+            throw std::runtime_error("negative");
+        }
+        return double_it(req);
+    }
+};
+
+// Serve requests on a background thread until destroyed
+class ServerThread {
+public:
+    template <typename Func>
+    ServerThread(ServiceServer<Int, Int>& server, Func handler)
+        : thread_([this, &server, handler]() {
+              while (running_.load(std::memory_order_acquire)) {
+                  server.serve_for(10ms, handler);
+              }
+          }) {}
+
+    ~ServerThread() {
+        running_.store(false, std::memory_order_release);
+        thread_.join();
+    }
+
+private:
+    std::atomic<bool> running_{true};
+    std::thread thread_;
+};
+
+}  // namespace
+
+class ServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        internal::ShmRegion::unlink(internal::service_region_name("srv_test"));
+    }
+    void TearDown() override {
+        internal::ShmRegion::unlink(internal::service_region_name("srv_test"));
+    }
+};
+
+TEST_F(ServiceTest, test_raw_round_trip) {
+    internal::ServiceServer server("srv_test");
+    internal::ServiceClient client("srv_test");
+
+    std::thread serving([&server]() {
+        server.serve_for(1s, [](const Message& req, void* res, size_t capacity) -> std::optional<size_t> {
+            EXPECT_GE(capacity, req.size);
+            std::memcpy(res, req.data, req.size);
+            return req.size;
+        });
+    });
+
+    const char payload[] = "ping";
+    auto response = client.call(payload, sizeof(payload), 1s);
+    serving.join();
+
+    ASSERT_TRUE(response.has_value());
+    ASSERT_EQ(response->size, sizeof(payload));
+    EXPECT_EQ(std::memcmp(response->data, payload, sizeof(payload)), 0);
+}
+
+TEST_F(ServiceTest, test_typed_call) {
+    ServiceServer<Int, Int> server("srv_test");
+    ServerThread serving(server, double_it);
+
+    ServiceClient<Int, Int> client("srv_test");
+    for (int64_t i = 0; i < 100; ++i) {
+        auto res = client.call(make_int(i), 1s);
+        ASSERT_TRUE(res.has_value());
+        EXPECT_EQ(res->value, 2 * i);
+    }
+}
+
+TEST_F(ServiceTest, test_timeout_without_server) {
+    ServiceClient<Int, Int> client("srv_test");
+
+    auto start = std::chrono::steady_clock::now();
+    auto res = client.call(make_int(1), 20ms);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(res.has_value());
+    EXPECT_GE(elapsed, 20ms);
+    EXPECT_LT(elapsed, 1s);
+}
+
+TEST_F(ServiceTest, test_client_before_server) {
+    ServiceClient<Int, Int> client("srv_test");
+
+    std::thread late_server([]() {
+        std::this_thread::sleep_for(20ms);
+        ServiceServer<Int, Int> server("srv_test");
+        server.serve_for(1s, double_it);
+    });
+
+    auto res = client.call(make_int(21), 1s);
+    late_server.join();
+
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res->value, 42);
+}
+
+TEST_F(ServiceTest, test_concurrent_clients) {
+    constexpr int CLIENTS = 4;
+    constexpr int CALLS = 200;
+
+    ServiceServer<Int, Int> server("srv_test");
+    ServerThread serving(server, double_it);
+
+    std::atomic<int> correct{0};
+    std::vector<std::thread> threads;
+    for (int c = 0; c < CLIENTS; ++c) {
+        threads.emplace_back([c, &correct]() {
+            ServiceClient<Int, Int> client("srv_test");
+            for (int i = 0; i < CALLS; ++i) {
+                int64_t value = c * 1000 + i;
+                auto res = client.call(make_int(value), 1s);
+                if (res && res->value == 2 * value) {
+                    correct.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(correct.load(), CLIENTS * CALLS);
+}
+
+TEST_F(ServiceTest, test_late_response_is_skipped) {
+    ServiceServer<Int, Int> server("srv_test");
+    ServerThread serving(server, [](const Int& req) {
+        if (req.value == 1) {
+            std::this_thread::sleep_for(50ms);
+        }
+        return double_it(req);
+    });
+
+    ServiceClient<Int, Int> client("srv_test");
+    EXPECT_FALSE(client.call(make_int(1), 5ms).has_value());
+
+    // The answer to the first call arrives while we wait for this one
+    auto res = client.call(make_int(5), 1s);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res->value, 10);
+}
+
+TEST_F(ServiceTest, test_node_service) {
+    DoublerNode node;
+    std::thread runner([&node]() { node.run(); });
+
+    ServiceClient<Int, Int> client("srv_test");
+    auto res = client.call(make_int(4), 1s);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res->value, 8);
+
+    // Handler exceptions reach the caller
+    EXPECT_THROW(client.call(make_int(-1), 1s), ServiceError);
+
+    node.stop();
+    runner.join();
+}
+
+TEST_F(ServiceTest, test_duplicate_service_throws) {
+    ServiceServer<Int, Int> server("srv_test");
+    EXPECT_THROW((ServiceServer<Int, Int>("srv_test")), ServiceError);
+}
@@ -2,7 +2,9 @@
 #include "conduit_core/exceptions.hpp"
 
 #include <gtest/gtest.h>
+#include <cstdlib>
 #include <cstring>
+#include <unistd.h>
 
 using namespace conduit::internal;
 using namespace conduit;
@@ -155,3 +157,97 @@ TEST_F(ShmRegionTest, test_shared_writes) {
     // Read from region1
     EXPECT_EQ(data1[1], 0xCAFEBABE);
 }
+
+TEST_F(ShmRegionTest, test_huge_pages_fallback) {
+    const std::string name = "test_region_1";
+    ShmRegion::unlink(name);
+
+    // No hugetlbfs: the region quietly lands in /dev/shm
+    setenv("CONDUIT_HUGETLBFS", "", 1);
+    auto region = ShmRegion::create(name, 4096, true);
+    unsetenv("CONDUIT_HUGETLBFS");
+
+    EXPECT_EQ(region.size(), 4096u);
+    EXPECT_EQ(region.page_size(), static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+    EXPECT_EQ(access("/dev/shm/conduit_test_region_1", F_OK), 0);
+}
+
+TEST_F(ShmRegionTest, test_huge_page_dir) {
+    const std::string name = "test_region_1";
+    ShmRegion::unlink(name);
+
+    // Any directory stands in for the hugetlbfs mount
+    char dir[] = "/tmp/conduit_huge_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    setenv("CONDUIT_HUGETLBFS", dir, 1);
+    std::string path = std::string(dir) + "/conduit_" + name;
+
+    {
+        auto region = ShmRegion::create(name, 1000, true);
+        EXPECT_EQ(region.size() % region.page_size(), 0u);
+        EXPECT_EQ(access(path.c_str(), F_OK), 0);
+        EXPECT_TRUE(ShmRegion::exists(name));
+        EXPECT_THROW(ShmRegion::create(name, 1000), ShmError);
+
+        static_cast<uint32_t*>(region.data())[0] = 0xDEADBEEF;
+        auto reader = ShmRegion::open(name);
+        EXPECT_EQ(static_cast<uint32_t*>(reader.data())[0], 0xDEADBEEF);
+        EXPECT_EQ(reader.page_size(), region.page_size());
+    }
+
+    ShmRegion::unlink(name);
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+    EXPECT_FALSE(ShmRegion::exists(name));
+
+    unsetenv("CONDUIT_HUGETLBFS");
+    rmdir(dir);
+}
+
+TEST_F(ShmRegionTest, test_parallel_prefault) {
+    const std::string name = "test_region_1";
+    ShmRegion::unlink(name);
+
+    // Odd size: the last chunk is shorter than the others
+    const size_t size = 64 * 4096 + 100;
+    auto region = ShmRegion::create(name, size);
+    auto* bytes = static_cast<uint8_t*>(region.data());
+    bytes[0] = 1;
+    bytes[size - 1] = 2;
+
+    region.prefault(true, 4);
+
+    // Prefaulting never changes the contents
+    EXPECT_EQ(bytes[0], 1);
+    EXPECT_EQ(bytes[size - 1], 2);
+    EXPECT_EQ(bytes[size / 2], 0);
+}
+
+TEST_F(ShmRegionTest, test_memfd_region) {
+    const std::string name = "test_region_2";
+    ShmRegion::unlink(name);
+
+    auto region = ShmRegion::create_memfd(name, 1000);
+    EXPECT_EQ(region.size() % region.page_size(), 0u);
+    EXPECT_TRUE(ShmRegion::exists(name));
+    EXPECT_THROW(ShmRegion::create(name, 1000), ShmError);
+    EXPECT_THROW(ShmRegion::create_memfd(name, 1000), ShmError);
+
+    static_cast<uint32_t*>(region.data())[0] = 0xCAFEBABE;
+    auto reader = ShmRegion::open(name);
+    ASSERT_EQ(reader.size(), region.size());
+    EXPECT_EQ(static_cast<uint32_t*>(reader.data())[0], 0xCAFEBABE);
+
+    // Moving keeps serving
+    ShmRegion moved = std::move(region);
+    EXPECT_TRUE(ShmRegion::exists(name));
+}
+
+TEST_F(ShmRegionTest, test_memfd_region_gone_with_owner) {
+    const std::string name = "test_region_2";
+    {
+        auto region = ShmRegion::create_memfd(name, 4096);
+        auto reader = ShmRegion::open(name);
+    }
+    EXPECT_FALSE(ShmRegion::exists(name));
+    EXPECT_THROW(ShmRegion::open(name), ShmError);
+}
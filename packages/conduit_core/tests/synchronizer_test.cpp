@@ -0,0 +1,173 @@
+#include "conduit_core/exceptions.hpp"
+#include "conduit_core/node.hpp"
+#include "conduit_core/synchronizer.hpp"
+#include "conduit_core/internal/shm_region.hpp"
+
+#include <conduit_types/derived/imu.hpp>
+#include <conduit_types/primitives/int.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace conduit;
+using namespace std::chrono_literals;
+
+namespace {
+
+Imu make_imu(uint64_t stamp) {
+    Imu msg{};
+    msg.header.timestamp_ns = stamp;
+    return msg;
+}
+
+}  // namespace
+
+class SynchronizerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        internal::ShmRegion::unlink("sync_a");
+        internal::ShmRegion::unlink("sync_b");
+        internal::ShmRegion::unlink("sync_c");
+    }
+};
+
+TEST_F(SynchronizerTest, test_exact_match) {
+    Publisher<Imu> pub_a("sync_a");
+    Publisher<Imu> pub_b("sync_b");
+    Publisher<Imu> pub_c("sync_c");
+
+    Synchronizer<Imu, Imu, Imu> sync({"sync_a", "sync_b", "sync_c"});
+
+    for (uint64_t t : {1, 2, 3}) pub_a.publish(make_imu(t));
+    for (uint64_t t : {2, 3}) pub_b.publish(make_imu(t));
+    for (uint64_t t : {0, 2, 3}) pub_c.publish(make_imu(t));
+
+    auto first = sync.take();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(std::get<0>(*first).data.header.timestamp_ns, 2u);
+    EXPECT_EQ(std::get<1>(*first).data.header.timestamp_ns, 2u);
+    EXPECT_EQ(std::get<2>(*first).data.header.timestamp_ns, 2u);
+
+    auto second = sync.take();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(std::get<0>(*second).data.header.timestamp_ns, 3u);
+
+    EXPECT_FALSE(sync.take().has_value());
+    EXPECT_EQ(sync.dropped(), 2u);  // a@1 and c@0
+}
+
+TEST_F(SynchronizerTest, test_approximate_window) {
+    Publisher<Imu> pub_a("sync_a");
+    Publisher<Imu> pub_b("sync_b");
+    Publisher<Imu> pub_c("sync_c");
+
+    Synchronizer<Imu, Imu, Imu> sync({"sync_a", "sync_b", "sync_c"}, SyncOptions{5ns});
+
+    pub_a.publish(make_imu(100));
+    pub_a.publish(make_imu(110));
+    pub_b.publish(make_imu(103));
+    pub_b.publish(make_imu(112));
+    pub_c.publish(make_imu(98));
+
+    auto match = sync.take();
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(std::get<0>(*match).data.header.timestamp_ns, 100u);
+    EXPECT_EQ(std::get<1>(*match).data.header.timestamp_ns, 103u);
+    EXPECT_EQ(std::get<2>(*match).data.header.timestamp_ns, 98u);
+
+    // a@110 and b@112 are waiting for c
+    EXPECT_FALSE(sync.wait_for(20ms).has_value());
+
+    pub_c.publish(make_imu(111));
+    auto next = sync.wait_for(100ms);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(std::get<2>(*next).data.header.timestamp_ns, 111u);
+}
+
+TEST_F(SynchronizerTest, test_approximate_prefers_closest_before_pivot) {
+    Publisher<Imu> pub_a("sync_a");
+    Publisher<Imu> pub_b("sync_b");
+
+    Synchronizer<Imu, Imu> sync({"sync_a", "sync_b"}, SyncOptions{50ns});
+
+    for (uint64_t t : {10, 20, 30}) pub_a.publish(make_imu(t));
+    pub_b.publish(make_imu(29));
+
+    auto match = sync.take();
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(std::get<0>(*match).data.header.timestamp_ns, 20u);
+    EXPECT_EQ(std::get<1>(*match).data.header.timestamp_ns, 29u);
+    EXPECT_EQ(sync.dropped(), 1u);
+}
+
+TEST_F(SynchronizerTest, test_headerless_types_use_publish_time) {
+    Publisher<Int> pub_a("sync_a");
+    Publisher<Int> pub_b("sync_b");
+
+    Synchronizer<Int, Int> sync({"sync_a", "sync_b"}, SyncOptions{1s});
+
+    Int value{};
+    value.value = 1;
+    pub_a.publish(value);
+    value.value = 2;
+    pub_b.publish(value);
+
+    auto match = sync.take();
+    ASSERT_TRUE(match.has_value());
+    EXPECT_EQ(std::get<0>(*match).data.value, 1);
+    EXPECT_EQ(std::get<1>(*match).data.value, 2);
+}
+
+TEST_F(SynchronizerTest, test_type_mismatch_rejected) {
+    Publisher<Imu> pub_a("sync_a");
+    Publisher<Int> pub_b("sync_b");
+
+    using Mismatched = Synchronizer<Imu, Imu>;
+    EXPECT_THROW(Mismatched({"sync_a", "sync_b"}), SubscriberError);
+}
+
+TEST_F(SynchronizerTest, test_node_synchronize) {
+    class FusionNode : public Node {
+    public:
+        std::atomic<int> count{0};
+        std::atomic<uint64_t> last_stamp{0};
+
+        FusionNode() {
+            synchronize<Imu, Imu>({"sync_a", "sync_b"}, &FusionNode::on_pair);
+        }
+
+        void on_pair(const TypedMessage<Imu>& a, const TypedMessage<Imu>& b) {
+            EXPECT_EQ(a.data.header.timestamp_ns, b.data.header.timestamp_ns);
+            last_stamp.store(a.data.header.timestamp_ns, std::memory_order_release);
+            count.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    Publisher<Imu> pub_a("sync_a");
+    Publisher<Imu> pub_b("sync_b");
+
+    FusionNode node;
+    std::thread node_thread([&node]() {
+        node.run();
+    });
+    std::this_thread::sleep_for(50ms);
+
+    for (uint64_t t = 1; t <= 3; ++t) {
+        pub_a.publish(make_imu(t));
+        pub_b.publish(make_imu(t));
+    }
+    pub_a.publish(make_imu(10));  // No partner
+
+    for (int i = 0; i < 50 && node.count.load(std::memory_order_acquire) < 3; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    node.stop();
+    node_thread.join();
+
+    EXPECT_EQ(node.count.load(std::memory_order_acquire), 3);
+    EXPECT_EQ(node.last_stamp.load(std::memory_order_acquire), 3u);
+}
@@ -1,3 +1,4 @@
+#include "conduit_core/exceptions.hpp"
 #include "conduit_core/publisher.hpp"
 #include "conduit_core/subscriber.hpp"
 #include "conduit_core/internal/shm_region.hpp"
@@ -7,6 +8,7 @@
 #include <conduit_types/primitives/bool.hpp>
 #include <conduit_types/primitives/uint.hpp>
 #include <conduit_types/primitives/time.hpp>
+#include <conduit_types/derived/imu.hpp>
 
 #include <gtest/gtest.h>
 
@@ -14,6 +16,7 @@
 #include <cstring>
 #include <string>
 #include <thread>
+#include <unistd.h>
 
 using namespace conduit;
 using namespace std::chrono_literals;
@@ -43,12 +46,29 @@ struct StringMessage : public VariableMessageType {
     }
 };
 
+// Two definitions of the same message, before and after a field change
+struct PoseV1 : FixedMessageType {
+    double x, y;
+};
+
+struct PoseV2 : FixedMessageType {
+    static constexpr uint32_t schema_version = 2;
+    double x, y;
+};
+
+// Fingerprints are compile-time constants
+static_assert(internal::type_info_v<Int>.name == "conduit::Int");
+static_assert(internal::type_info_v<Int>.hash != internal::type_info_v<Uint>.hash);
+static_assert(internal::type_info_v<Int>.layout == internal::type_info_v<Uint>.layout);
+static_assert(internal::type_info_v<PoseV1>.layout != internal::type_info_v<PoseV2>.layout);
+static_assert(internal::type_info_v<Imu>.layout != internal::type_info_v<PoseV1>.layout);
+
 // --- Tests ---
 
 class TypedPubSubTest : public ::testing::Test {
 protected:
     void TearDown() override {
-        for (int i = 1; i <= 10; ++i) {
+        for (int i = 1; i <= 21; ++i) {
             internal::ShmRegion::unlink("typed_test_" + std::to_string(i));
         }
     }
@@ -224,3 +244,230 @@ TEST_F(TypedPubSubTest, test_multiple_messages) {
         EXPECT_EQ(received->data.value, i);
     }
 }
+
+TEST_F(TypedPubSubTest, test_decimation_filter) {
+    const std::string topic = "typed_test_11";
+
+    Publisher<Int> pub(topic, {.depth = 128, .max_message_size = 64});
+    SubscriberOptions options;
+    options.decimation = 10;
+    Subscriber<Int> sub(topic, options);
+
+    for (int64_t i = 0; i < 100; ++i) {
+        Int msg{};
+        msg.value = i;
+        ASSERT_TRUE(pub.publish(msg));
+    }
+
+    for (int64_t i = 0; i < 100; i += 10) {
+        auto received = sub.take();
+        ASSERT_TRUE(received.has_value());
+        EXPECT_EQ(received->data.value, i);
+    }
+    EXPECT_FALSE(sub.take().has_value());
+}
+
+TEST_F(TypedPubSubTest, test_min_interval_filter) {
+    const std::string topic = "typed_test_12";
+
+    Publisher<Int> pub(topic);
+    SubscriberOptions options;
+    options.min_interval = 20ms;
+    Subscriber<Int> sub(topic, options);
+
+    Int msg{};
+    msg.value = 1;
+    pub.publish(msg);
+    msg.value = 2;
+    pub.publish(msg);  // Too soon after 1
+    std::this_thread::sleep_for(25ms);
+    msg.value = 3;
+    pub.publish(msg);
+
+    auto first = sub.take();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->data.value, 1);
+    auto second = sub.take();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->data.value, 3);
+    EXPECT_FALSE(sub.take().has_value());
+}
+
+TEST_F(TypedPubSubTest, test_frame_filter_skips_wakeups) {
+    const std::string topic = "typed_test_13";
+
+    Publisher<Imu> pub(topic);
+    SubscriberOptions options;
+    options.frame = "camera_left";
+    internal::Subscriber raw(topic, options, internal::frame_offset<Imu>());
+    Subscriber<Imu> sub(topic, options);
+
+    uint32_t before = raw.futex_word()->load();
+    Imu msg{};
+    set_frame(msg.header.frame, "camera_right");
+    for (int i = 0; i < 10; ++i) {
+        pub.publish(msg);
+    }
+    EXPECT_EQ(raw.futex_word()->load(), before);  // Never woken
+    EXPECT_FALSE(sub.take().has_value());
+
+    set_frame(msg.header.frame, "camera_left");
+    msg.header.timestamp_ns = 42;
+    pub.publish(msg);
+    EXPECT_NE(raw.futex_word()->load(), before);
+
+    auto received = sub.wait_for(100ms);
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(received->data.header.timestamp_ns, 42u);
+}
+
+TEST_F(TypedPubSubTest, test_frame_filter_needs_header) {
+    const std::string topic = "typed_test_14";
+
+    Publisher<Int> pub(topic);
+    SubscriberOptions options;
+    options.frame = "base_link";
+    EXPECT_THROW(Subscriber<Int>(topic, options), SubscriberError);
+}
+
+TEST_F(TypedPubSubTest, test_latest_only_skips_backlog) {
+    const std::string topic = "typed_test_15";
+
+    Publisher<Int> pub(topic, {.depth = 64, .max_message_size = 64});
+    SubscriberOptions options;
+    options.latest_only = true;
+    Subscriber<Int> sub(topic, options);
+
+    for (int64_t i = 0; i < 50; ++i) {
+        Int msg{};
+        msg.value = i;
+        pub.publish(msg);
+    }
+
+    auto received = sub.take();
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(received->data.value, 49);
+    EXPECT_FALSE(sub.take().has_value());
+}
+
+TEST_F(TypedPubSubTest, test_max_rate_newest_only) {
+    const std::string topic = "typed_test_16";
+
+    Publisher<Int> pub(topic);
+    SubscriberOptions options;
+    options.latest_only = true;
+    options.max_rate_hz = 50.0;
+    Subscriber<Int> sub(topic, options);
+
+    Int msg{};
+    msg.value = 1;
+    pub.publish(msg);
+    auto first = sub.wait_for(100ms);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->data.value, 1);
+
+    // Within the 20 ms period: not delivered, not even woken
+    msg.value = 2;
+    pub.publish(msg);
+    EXPECT_FALSE(sub.wait_for(5ms).has_value());
+
+    std::this_thread::sleep_for(25ms);
+    msg.value = 3;
+    pub.publish(msg);
+    msg.value = 4;
+    pub.publish(msg);
+
+    auto second = sub.wait_for(100ms);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->data.value, 4);
+}
+
+TEST_F(TypedPubSubTest, test_max_rate_delivers_end_of_burst) {
+    const std::string topic = "typed_test_21";
+
+    Publisher<Int> pub(topic);
+    SubscriberOptions options;
+    options.latest_only = true;
+    options.max_rate_hz = 50.0;
+    Subscriber<Int> sub(topic, options);
+
+    Int msg{};
+    msg.value = 1;
+    pub.publish(msg);
+    auto first = sub.wait_for(100ms);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->data.value, 1);
+
+    // Burst within the 20 ms period, then silence
+    for (int64_t i = 2; i <= 5; ++i) {
+        msg.value = i;
+        pub.publish(msg);
+    }
+    EXPECT_FALSE(sub.take().has_value());
+
+    auto start = std::chrono::steady_clock::now();
+    auto last = sub.wait_for(200ms);
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->data.value, 5);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+    EXPECT_FALSE(sub.take().has_value());
+}
+
+TEST_F(TypedPubSubTest, test_type_mismatch_rejected) {
+    const std::string topic = "typed_test_17";
+
+    Publisher<Int> pub(topic);
+    EXPECT_THROW((Subscriber<Double>(topic)), SubscriberError);
+    // The rejected subscriber gave its reader slot back
+    EXPECT_NO_THROW((Subscriber<Int>(topic)));
+}
+
+TEST_F(TypedPubSubTest, test_untyped_publisher_accepts_any_type) {
+    const std::string topic = "typed_test_18";
+
+    internal::Publisher pub(topic);
+    EXPECT_NO_THROW((Subscriber<Double>(topic)));
+}
+
+TEST_F(TypedPubSubTest, test_topic_info_and_stats) {
+    const std::string topic = "typed_test_19";
+
+    Publisher<Int> pub(topic);
+    Subscriber<Int> sub(topic);
+    for (int64_t i = 0; i < 5; ++i) {
+        Int msg{};
+        msg.value = i;
+        pub.publish(msg);
+    }
+
+    // Read the header the way conduit info does, without a reader slot
+    auto shm = internal::ShmRegion::open(topic);
+    auto* header = static_cast<internal::RingBufferHeader*>(shm.data());
+    EXPECT_STREQ(header->info.type_name, "conduit::Int");
+    EXPECT_EQ(header->info.type_hash, internal::type_info_v<Int>.hash);
+    EXPECT_EQ(header->info.type_size, sizeof(Int));
+    EXPECT_EQ(header->info.publisher_pid, getpid());
+    EXPECT_GT(header->info.created_ns, 0u);
+    EXPECT_EQ(header->stats.bytes_written.load(), 5 * sizeof(Int));
+    EXPECT_GT(header->stats.last_write_ns.load(), 0u);
+}
+
+TEST_F(TypedPubSubTest, test_layout_mismatch_rejected) {
+    const std::string topic = "typed_test_20";
+
+    Publisher<Int> pub(topic);
+    internal::Subscriber sub(topic);
+
+    // Same name built from another definition of the type
+    internal::TypeInfo other = internal::type_info_v<Int>;
+    other.layout ^= 1;
+    other.hash ^= 1;
+    other.size = 16;
+    try {
+        sub.check_type(other);
+        FAIL() << "Expected SubscriberError";
+    } catch (const SubscriberError& e) {
+        EXPECT_NE(std::string(e.what()).find("Layout mismatch"), std::string::npos);
+    }
+    EXPECT_NO_THROW(sub.check_type(internal::type_info_v<Int>));
+}
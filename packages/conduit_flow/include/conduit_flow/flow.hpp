@@ -6,6 +6,8 @@
 #include <variant>
 #include <vector>
 
+#include <conduit_core/scheduling.hpp>
+
 namespace conduit::flow {
 
 /// @brief Configuration for a single node in a flow.
@@ -15,6 +17,12 @@ struct NodeConfig {
     std::vector<std::string> args;               ///< Command-line arguments.
     std::map<std::string, std::string> env;      ///< Environment variable overrides.
     std::string working_dir;                     ///< Working directory for the process.
+    /// CPU affinity and policy, inherited by all threads. SCHED_DEADLINE is
+    /// applied by the node to its loop threads instead (via CONDUIT_SCHED_*_NS).
+    ThreadOptions scheduling;
+    bool lock_memory = false;                    ///< mlockall() in the node (via CONDUIT_LOCK_MEMORY).
+    bool prefault = false;                       ///< Prefault ring buffers (via CONDUIT_PREFAULT).
+    unsigned prefault_threads = 1;               ///< Threads per ring when prefaulting (via CONDUIT_PREFAULT_THREADS).
 };
 
 /// @brief Wait step: pause for a fixed duration.
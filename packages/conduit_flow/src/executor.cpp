@@ -1,5 +1,6 @@
 #include "conduit_flow/executor.hpp"
 #include <conduit_core/exceptions.hpp>
+#include <conduit_core/internal/scheduling.hpp>
 #include <conduit_core/internal/shm_region.hpp>
 #include <conduit_core/log.hpp>
 
@@ -56,6 +57,30 @@ pid_t Executor::Impl::spawn(const NodeConfig& node) {
             setenv(key.c_str(), value.c_str(), 1);
         }
 
+        if (node.lock_memory) {
+            setenv("CONDUIT_LOCK_MEMORY", "1", 1);
+        }
+        if (node.prefault) {
+            setenv("CONDUIT_PREFAULT", "1", 1);
+        }
+        if (node.prefault_threads > 1) {
+            setenv("CONDUIT_PREFAULT_THREADS", std::to_string(node.prefault_threads).c_str(), 1);
+        }
+
+        // Affinity and scheduling policy survive execvp(), so every thread
+        // the node creates starts out with these settings. Not so
+        // SCHED_DEADLINE: a deadline task may not clone(), so the node
+        // would fail to start its first thread. The node applies it to
+        // its own threads instead (see NodeOptions).
+        ThreadOptions process = node.scheduling;
+        if (process.policy == SchedPolicy::Deadline) {
+            setenv("CONDUIT_SCHED_RUNTIME_NS", std::to_string(process.runtime.count()).c_str(), 1);
+            setenv("CONDUIT_SCHED_DEADLINE_NS", std::to_string(process.deadline.count()).c_str(), 1);
+            setenv("CONDUIT_SCHED_PERIOD_NS", std::to_string(process.period.count()).c_str(), 1);
+            process.policy = SchedPolicy::Inherit;
+        }
+        internal::apply_thread_options(process);
+
         if (!node.working_dir.empty()) {
             if (chdir(node.working_dir.c_str()) < 0) {
                 fprintf(stderr, "chdir failed: %s\n", strerror(errno));
@@ -25,6 +25,62 @@ static std::chrono::milliseconds parse_duration(const std::string& str) {
     throw ConduitError("Unknown duration unit: " + unit);
 }
 
+/// SCHED_DEADLINE budgets are often well below a millisecond, so sched
+/// durations also take us and ns.
+static std::chrono::nanoseconds parse_sched_duration(const std::string& str) {
+    std::regex re(R"((\d+)\s*(ns|us|ms|s))");
+    std::smatch match;
+
+    if (!std::regex_match(str, match, re)) {
+        throw ConduitError("Invalid duration: " + str);
+    }
+
+    int64_t value = std::stoll(match[1].str());
+    std::string unit = match[2].str();
+
+    if (unit == "ns") return std::chrono::nanoseconds(value);
+    if (unit == "us") return std::chrono::microseconds(value);
+    if (unit == "ms") return std::chrono::milliseconds(value);
+    if (unit == "s") return std::chrono::seconds(value);
+
+    throw ConduitError("Unknown duration unit: " + unit);
+}
+
+static SchedPolicy parse_policy(const std::string& str) {
+    if (str == "other") return SchedPolicy::Other;
+    if (str == "fifo") return SchedPolicy::Fifo;
+    if (str == "rr") return SchedPolicy::RoundRobin;
+    if (str == "deadline") return SchedPolicy::Deadline;
+
+    throw ConduitError("Unknown scheduling policy: " + str);
+}
+
+static void parse_sched(const YAML::Node& node, ThreadOptions& options) {
+    if (!node.IsMap()) {
+        throw ConduitError("'sched' must be a map");
+    }
+
+    if (node["policy"]) {
+        options.policy = parse_policy(node["policy"].as<std::string>());
+    }
+
+    if (node["priority"]) {
+        options.priority = node["priority"].as<int>();
+    }
+
+    if (node["runtime"]) {
+        options.runtime = parse_sched_duration(node["runtime"].as<std::string>());
+    }
+
+    if (node["deadline"]) {
+        options.deadline = parse_sched_duration(node["deadline"].as<std::string>());
+    }
+
+    if (node["period"]) {
+        options.period = parse_sched_duration(node["period"].as<std::string>());
+    }
+}
+
 static NodeConfig parse_node(const YAML::Node& node) {
     NodeConfig config;
 
@@ -65,6 +121,28 @@ static NodeConfig parse_node(const YAML::Node& node) {
         if (node["working_dir"]) {
             config.working_dir = node["working_dir"].as<std::string>();
         }
+
+        if (node["cpus"]) {
+            for (const auto& cpu : node["cpus"]) {
+                config.scheduling.cpus.push_back(cpu.as<int>());
+            }
+        }
+
+        if (node["sched"]) {
+            parse_sched(node["sched"], config.scheduling);
+        }
+
+        if (node["lock_memory"]) {
+            config.lock_memory = node["lock_memory"].as<bool>();
+        }
+
+        if (node["prefault"]) {
+            config.prefault = node["prefault"].as<bool>();
+        }
+
+        if (node["prefault_threads"]) {
+            config.prefault_threads = node["prefault_threads"].as<unsigned>();
+        }
     } else {
         throw ConduitError("Invalid node format");
     }
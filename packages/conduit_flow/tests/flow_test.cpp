@@ -1,5 +1,6 @@
 #include <conduit_flow/flow.hpp>
 #include <conduit_flow/parser.hpp>
+#include <conduit_core/exceptions.hpp>
 #include <gtest/gtest.h>
 
 using namespace conduit::flow;
@@ -41,6 +42,78 @@ startup:
     EXPECT_EQ(node.working_dir, "/tmp");
 }
 
+TEST(FlowParser, NodeScheduling) {
+    auto config = parse_string(R"(
+startup:
+  - name: perception
+    exec: perception_node
+    cpus: [2, 3]
+    sched:
+      policy: fifo
+      priority: 80
+    lock_memory: true
+    prefault: true
+    prefault_threads: 4
+  - name: control
+    sched:
+      policy: deadline
+      runtime: 2ms
+      period: 10ms
+)");
+
+    ASSERT_EQ(config.startup.size(), 2);
+
+    auto& perception = std::get<NodeConfig>(config.startup[0]);
+    ASSERT_EQ(perception.scheduling.cpus.size(), 2);
+    EXPECT_EQ(perception.scheduling.cpus[0], 2);
+    EXPECT_EQ(perception.scheduling.cpus[1], 3);
+    EXPECT_EQ(perception.scheduling.policy, conduit::SchedPolicy::Fifo);
+    EXPECT_EQ(perception.scheduling.priority, 80);
+    EXPECT_TRUE(perception.lock_memory);
+    EXPECT_TRUE(perception.prefault);
+    EXPECT_EQ(perception.prefault_threads, 4u);
+
+    auto& control = std::get<NodeConfig>(config.startup[1]);
+    EXPECT_EQ(control.scheduling.policy, conduit::SchedPolicy::Deadline);
+    EXPECT_EQ(control.scheduling.runtime, std::chrono::milliseconds(2));
+    EXPECT_EQ(control.scheduling.period, std::chrono::milliseconds(10));
+    EXPECT_FALSE(control.lock_memory);
+    EXPECT_EQ(control.prefault_threads, 1u);
+}
+
+TEST(FlowParser, SchedSubMillisecond) {
+    auto config = parse_string(R"(
+startup:
+  - name: control
+    sched:
+      policy: deadline
+      runtime: 200us
+      deadline: 500000ns
+      period: 1ms
+)");
+
+    auto& control = std::get<NodeConfig>(config.startup[0]);
+    EXPECT_EQ(control.scheduling.runtime, std::chrono::microseconds(200));
+    EXPECT_EQ(control.scheduling.deadline, std::chrono::microseconds(500));
+    EXPECT_EQ(control.scheduling.period, std::chrono::milliseconds(1));
+
+    EXPECT_THROW(parse_string(R"(
+startup:
+  - name: control
+    sched:
+      runtime: 1.5ms
+)"), conduit::ConduitError);
+}
+
+TEST(FlowParser, InvalidSchedPolicy) {
+    EXPECT_THROW(parse_string(R"(
+startup:
+  - name: node
+    sched:
+      policy: batch
+)"), conduit::ConduitError);
+}
+
 TEST(FlowParser, WaitDuration) {
     auto config = parse_string(R"(
 startup:
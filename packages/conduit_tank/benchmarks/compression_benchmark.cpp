@@ -0,0 +1,77 @@
+// Chunk compression throughput by codec and thread count.
+//
+// Writes 256 MB of camera-like payloads (2 MB frames of smooth gradients
+// with a little noise) through a ChunkWriter into a sink
+// that discards the output, so only message copying and compression are
+// measured. "threads 0" compresses on the calling thread, as McapWriter
+// does; with more threads the calling thread only fills chunks.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./compression_benchmark
+
+#include "conduit_tank/internal/chunk_writer.hpp"
+
+#include <fmt/core.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t FRAME_SIZE = 2 * 1024 * 1024;
+constexpr size_t TOTAL = 256 * 1024 * 1024;
+
+class NullWritable : public mcap::IWritable {
+public:
+    void end() override {}
+    uint64_t size() const override { return size_; }
+
+protected:
+    void handleWrite(const std::byte*, uint64_t size) override { size_ += size; }
+
+private:
+    uint64_t size_ = 0;
+};
+
+void run(const char* name, Compression compression, uint32_t threads, const std::vector<uint8_t>& frame) {
+    internal::ChunkWriterOptions options;
+    options.compression = compression;
+    options.threads = threads;
+    options.chunk_size = 4 * 1024 * 1024;
+
+    NullWritable output;
+    auto start = Clock::now();
+    {
+        internal::ChunkWriter writer(output, options);
+        uint16_t channel = writer.add_channel("camera");
+        for (uint32_t i = 0; i < TOTAL / FRAME_SIZE; ++i) {
+            writer.write(channel, i, i, i, frame.data(), frame.size());
+        }
+        writer.close();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    fmt::print("{:<5} threads {}  {:>7.1f} MB/s  ratio {:.2f}\n", name, threads, TOTAL / seconds / 1e6,
+               static_cast<double>(TOTAL) / output.size());
+}
+
+}  // namespace
+
+int main() {
+    std::vector<uint8_t> frame(FRAME_SIZE);
+    std::mt19937 rng(7);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<uint8_t>((i % 1920) / 16 + (rng() % 16 == 0 ? 1 : 0));
+    }
+
+    for (uint32_t threads : {0u, 1u, 2u, 4u}) {
+        run("none", Compression::None, threads, frame);
+        run("lz4", Compression::Lz4, threads, frame);
+        run("zstd", Compression::Zstd, threads, frame);
+    }
+    return 0;
+}
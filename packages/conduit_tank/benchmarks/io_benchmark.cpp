@@ -0,0 +1,99 @@
+// Sustained recording of large messages, with and without O_DIRECT.
+//
+// Two topics publish 1 MB messages (incompressible) as fast as the 64-slot
+// rings allow for DURATION. Reported are the bytes written to disk per
+// second, the longest time a recording thread took to stage a message after
+// it was published, and the longest time the file writer waited for a free
+// I/O buffer. A record-loop stall that grows with disk latency would mean
+// disk writes block the recording path again.
+//
+// OUTPUT should be on a real disk: tmpfs refuses O_DIRECT, so both runs
+// then go through the page cache.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./io_benchmark [output.mcap]
+
+#include "conduit_tank/tank.hpp"
+#include <conduit_core/internal/shm_region.hpp>
+#include <conduit_core/publisher.hpp>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int TOPICS = 2;
+constexpr auto DURATION = std::chrono::seconds(3);
+constexpr uint32_t MESSAGE_SIZE = 1024 * 1024;
+constexpr uint32_t DEPTH = 64;
+
+std::string topic_name(int i) {
+    return "bench_io_" + std::to_string(i);
+}
+
+void run(const std::string& output, bool direct_io) {
+    std::vector<internal::Publisher> publishers;
+    for (int i = 0; i < TOPICS; ++i) {
+        internal::ShmRegion::unlink(topic_name(i));
+        publishers.emplace_back(topic_name(i), PublisherOptions{DEPTH, MESSAGE_SIZE});
+    }
+
+    TankOptions options;
+    options.direct_io = direct_io;
+    options.staging_size = 64 * 1024 * 1024;
+    Tank tank(output, options);
+    for (int i = 0; i < TOPICS; ++i) {
+        tank.add_topic(topic_name(i));
+    }
+    tank.start();
+
+    // Random payloads so Zstd cannot shrink them; ~1 kHz per topic
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    for (auto& pub : publishers) {
+        threads.emplace_back([&pub, start] {
+            std::mt19937 rng(42);
+            std::vector<uint8_t> payload(MESSAGE_SIZE);
+            for (auto& byte : payload) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            while (Clock::now() - start < DURATION) {
+                payload[0]++;
+                pub.publish(payload.data(), payload.size());
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    tank.stop();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    TankStats stats = tank.stats();
+    fmt::print("{:<10}  {:>7.1f} MB/s  messages={:>6}  dropped={:>5}  "
+               "max record stall={:>8.3f} ms  max I/O wait={:>8.3f} ms\n",
+               direct_io ? "O_DIRECT" : "buffered", stats.bytes / seconds / 1e6, stats.messages,
+               stats.dropped, stats.max_record_latency.count() / 1e6, stats.max_io_wait.count() / 1e6);
+
+    std::remove(output.c_str());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string output = argc > 1 ? argv[1] : "/tmp/io_benchmark.mcap";
+    run(output, false);
+    run(output, true);
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Playback throughput against recording throughput.
+//
+// Records 256 MB of camera-like 1 MB frames (smooth gradients with a little
+// noise) on two channels through the same ChunkWriter + AsyncFileWriter path
+// Tank uses, then replays the file as fast as possible, once with no
+// subscriber and once with a reliable subscriber per topic that reads every
+// message. Replay has to keep up with what was recorded: the replay MB/s
+// should not be below the record MB/s for any codec.
+//
+// The file is written with O_DIRECT, so the first replay of each codec reads
+// it from disk and the second from the page cache.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./playback_benchmark [file.mcap]
+
+#include "conduit_tank/player.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include <conduit_core/subscriber.hpp>
+#include <conduit_core/internal/shm_region.hpp>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t FRAME_SIZE = 1024 * 1024;
+constexpr size_t TOTAL = 256 * 1024 * 1024;
+const char* TOPICS[] = {"playback_bench_0", "playback_bench_1"};
+
+std::vector<uint8_t> make_frame(uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> frame(FRAME_SIZE);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<uint8_t>((i % 1920) / 16 + (rng() % 16 == 0));
+    }
+    return frame;
+}
+
+double record(const std::string& path, Compression compression) {
+    internal::ChunkWriterOptions options;
+    options.compression = compression;
+    options.chunk_size = 4 * 1024 * 1024;
+    std::vector<uint8_t> frames[] = {make_frame(1), make_frame(2)};
+
+    auto start = Clock::now();
+    {
+        internal::AsyncFileWriter file(path, 4 * 1024 * 1024, 2, true);
+        internal::ChunkWriter writer(file, options);
+        uint16_t channels[] = {writer.add_channel(TOPICS[0]), writer.add_channel(TOPICS[1])};
+        for (uint32_t i = 0; i < TOTAL / FRAME_SIZE; ++i) {
+            uint64_t time = i * 10'000'000ull;
+            writer.write(channels[i % 2], i, time, time, frames[i % 2].data(), FRAME_SIZE);
+        }
+        writer.close();
+    }
+    return TOTAL / std::chrono::duration<double>(Clock::now() - start).count() / 1e6;
+}
+
+double replay(const std::string& path, bool subscribe, PlayerStats& stats) {
+    PlayerOptions options;
+    options.rate = 0;
+    Player player(path, options);
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    if (subscribe) {
+        for (const char* topic : TOPICS) {
+            SubscriberOptions sub_options;
+            sub_options.reliable = true;
+            sub_options.reliable_timeout = std::chrono::seconds(1);
+            auto sub = std::make_shared<internal::Subscriber>(topic, sub_options);
+            readers.emplace_back([sub, &done]() {
+                while (!done) {
+                    sub->wait_for(std::chrono::milliseconds(10));
+                }
+            });
+        }
+    }
+
+    auto start = Clock::now();
+    player.start();
+    player.wait();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    stats = player.stats();
+    return stats.bytes / seconds / 1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "/tmp/playback_benchmark.mcap";
+
+    fmt::print("{} MB of {} KB frames on 2 topics\n\n", TOTAL >> 20, FRAME_SIZE >> 10);
+    fmt::print("codec  record MB/s  replay MB/s  with readers  decompress wait\n");
+
+    struct Codec {
+        const char* name;
+        Compression compression;
+    };
+    for (const Codec& codec : {Codec{"none", Compression::None}, Codec{"lz4", Compression::Lz4},
+                               Codec{"zstd", Compression::Zstd}}) {
+        double recorded = record(path, codec.compression);
+        PlayerStats stats;
+        double alone = replay(path, false, stats);
+        double read = replay(path, true, stats);
+        fmt::print("{:<5}  {:>11.1f}  {:>11.1f}  {:>12.1f}  {:>12.2f} ms\n", codec.name, recorded, alone, read,
+                   std::chrono::duration<double, std::milli>(stats.max_decompress_wait).count());
+    }
+
+    for (const char* topic : TOPICS) {
+        internal::ShmRegion::unlink(topic);
+    }
+    std::remove(path.c_str());
+    return 0;
+}
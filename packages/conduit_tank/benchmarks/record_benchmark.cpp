@@ -0,0 +1,109 @@
+// Recording throughput across 1-32 topics.
+//
+// Each topic has a publisher thread sending 256-byte messages at RATE_HZ
+// for DURATION into a 256-slot ring. One Tank records all topics. Reported
+// are messages written per second and the number dropped, either because a
+// publisher lapped the recording thread or because a staging queue was
+// full. With one mutex around the file writer, per-topic threads start to
+// queue on it and lose messages as the topic count grows.
+//
+// "recorder CPU" is the process CPU time minus the publisher threads',
+// as a percentage of one core: what recording costs at this rate.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./record_benchmark
+
+#include "conduit_tank/tank.hpp"
+#include <conduit_core/internal/shm_region.hpp>
+#include <conduit_core/publisher.hpp>
+
+#include <fmt/core.h>
+
+#include <time.h>  // clock_gettime
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int RATE_HZ = 20000;
+constexpr auto DURATION = std::chrono::seconds(1);
+constexpr size_t MESSAGE_SIZE = 256;
+constexpr char OUTPUT[] = "/tmp/record_benchmark.mcap";
+
+double cpu_seconds(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+std::string topic_name(int i) {
+    return "bench_record_" + std::to_string(i);
+}
+
+void run(int topics) {
+    std::vector<internal::Publisher> publishers;
+    for (int i = 0; i < topics; ++i) {
+        internal::ShmRegion::unlink(topic_name(i));
+        publishers.emplace_back(topic_name(i), PublisherOptions{256, MESSAGE_SIZE});
+    }
+
+    Tank tank(OUTPUT);
+    for (int i = 0; i < topics; ++i) {
+        tank.add_topic(topic_name(i));
+    }
+    tank.start();
+
+    // Paced publishers: message n is due at start + n / RATE_HZ
+    std::atomic<uint64_t> published{0};
+    std::atomic<double> publisher_cpu{0};
+    std::vector<std::thread> threads;
+    double cpu_start = cpu_seconds(CLOCK_PROCESS_CPUTIME_ID);
+    auto start = Clock::now();
+    for (auto& pub : publishers) {
+        threads.emplace_back([&pub, &published, &publisher_cpu, start] {
+            std::vector<uint8_t> payload(MESSAGE_SIZE, 0x5a);
+            const auto interval = std::chrono::nanoseconds(1'000'000'000 / RATE_HZ);
+            uint64_t sent = 0;
+            while (Clock::now() - start < DURATION) {
+                while (Clock::now() < start + interval * sent) {
+                }
+                pub.publish(payload.data(), payload.size());
+                ++sent;
+            }
+            published += sent;
+            double cpu = cpu_seconds(CLOCK_THREAD_CPUTIME_ID);
+            double total = publisher_cpu.load();
+            while (!publisher_cpu.compare_exchange_weak(total, total + cpu)) {
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    tank.stop();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    double recorder_cpu = cpu_seconds(CLOCK_PROCESS_CPUTIME_ID) - cpu_start - publisher_cpu.load();
+
+    fmt::print("{:>3} topics  published={:>8}  recorded={:>8}  {:>9.0f} msg/s  dropped={}  recorder CPU {:.0f}%\n",
+               topics, published.load(), tank.message_count(), tank.message_count() / seconds,
+               tank.dropped_count(), 100 * recorder_cpu / seconds);
+
+    std::remove(OUTPUT);
+}
+
+}  // namespace
+
+int main() {
+    for (int topics : {1, 2, 4, 8, 16, 32}) {
+        run(topics);
+    }
+    return 0;
+}
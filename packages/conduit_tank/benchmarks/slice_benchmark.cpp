@@ -0,0 +1,123 @@
+// Time-range slicing of a large recording: index against scan.
+//
+// Records 2 GB of camera-like 1 MB frames at 30 Hz (about 68 s) plus a
+// small 100 Hz topic, then cuts 5 s of the small topic out of the middle:
+// with the summary index, and with the summary cut off so the record
+// prefixes of the whole file have to be walked first. For comparison,
+// "full" decompresses every chunk, which is what finding the range costs
+// without any index. The file's pages are dropped from the page cache
+// before each run.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./slice_benchmark [file.mcap]
+
+#include "conduit_tank/slice.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
+
+#include <fmt/core.h>
+
+#include <fcntl.h>   // posix_fadvise
+#include <unistd.h>  // truncate
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace conduit;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t FRAME_SIZE = 1024 * 1024;
+constexpr size_t TOTAL = 2048ull * 1024 * 1024;
+constexpr uint64_t FRAME_PERIOD_NS = 33'333'333;
+
+void record(const std::string& path) {
+    std::mt19937 rng(1);
+    std::vector<uint8_t> frame(FRAME_SIZE);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<uint8_t>((i % 1920) / 16 + (rng() % 16 == 0));
+    }
+    std::vector<uint8_t> pose(64);
+
+    internal::ChunkWriterOptions options;
+    options.chunk_size = 4 * 1024 * 1024;
+    internal::AsyncFileWriter file(path, 4 * 1024 * 1024, 2, true);
+    internal::ChunkWriter writer(file, options);
+    uint16_t camera = writer.add_channel("camera");
+    uint16_t odom = writer.add_channel("odom");
+
+    uint64_t next_pose = 0;
+    for (uint32_t i = 0; i < TOTAL / FRAME_SIZE; ++i) {
+        uint64_t time = i * FRAME_PERIOD_NS;
+        for (; next_pose <= time; next_pose += 10'000'000) {
+            writer.write(odom, 0, next_pose, next_pose, pose.data(), pose.size());
+        }
+        writer.write(camera, i, time, time, frame.data(), frame.size());
+    }
+    writer.close();
+}
+
+void drop_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+void run(const char* name, const std::string& path) {
+    SliceOptions options;
+    options.start = std::chrono::seconds(30);
+    options.end = std::chrono::seconds(35);
+    options.topics = {"odom"};
+
+    drop_cache(path);
+    auto start = Clock::now();
+    SliceStats stats = slice(path, path + ".slice", options);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    fmt::print("{:<8} {:>9.1f} ms  {:>5} messages  {:>4} of {} chunks read\n", name, ms, stats.messages,
+               stats.chunks_read, stats.chunks_total);
+    std::remove((path + ".slice").c_str());
+}
+
+void run_full(const std::string& path) {
+    drop_cache(path);
+    auto start = Clock::now();
+    internal::McapReader reader(path);
+    std::vector<uint8_t> records;
+    for (const auto& chunk : reader.chunks()) {
+        reader.decompress(chunk, records);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    fmt::print("{:<8} {:>9.1f} ms  {:>5} chunks read\n", "full", ms, reader.chunks().size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "/tmp/slice_benchmark.mcap";
+
+    fmt::print("Recording {} MB...\n", TOTAL >> 20);
+    record(path);
+
+    run("index", path);
+    run_full(path);
+
+    // Without the summary the reader has to walk the file
+    FILE* f = std::fopen(path.c_str(), "rb");
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fclose(f);
+    if (truncate(path.c_str(), size - 64) == 0) {
+        run("scan", path);
+    }
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Cost of keeping history for snapshots, and of reading a window out of it.
+//
+// The idle path of a Snapshot recorder is one HistoryBuffer::push() per
+// message. This pushes messages of several sizes into a 256 MB history
+// that is already full, so every push also evicts, and reports ns per
+// message and GB/s next to a StagingQueue push + pop of the same message
+// (what Tank's topic and writer threads do). Then it reads a 5 s window
+// of 1 MB frames at 30 Hz back out the way the snapshot writer does:
+// seek() to the start, read() every record.
+//
+// Build with -DBUILD_BENCHMARKS=ON, run ./snapshot_benchmark
+
+#include "conduit_tank/internal/history_buffer.hpp"
+#include "conduit_tank/internal/staging_queue.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace conduit::internal;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t HISTORY_SIZE = 256 * 1024 * 1024;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void push_benchmark(size_t size) {
+    const uint64_t count = std::max<uint64_t>(HISTORY_SIZE / size * 4, 100000);
+    std::vector<uint8_t> payload(size, 0x5a);
+
+    HistoryBuffer history(HISTORY_SIZE);
+    for (uint64_t i = 0; i < HISTORY_SIZE / size; ++i) {  // Fill and fault in
+        history.push(i, i, payload.data(), size);
+    }
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < count; ++i) {
+        history.push(i, i, payload.data(), size);
+    }
+    double history_s = seconds_since(start);
+
+    StagingQueue queue(4 * 1024 * 1024);
+    start = Clock::now();
+    for (uint64_t i = 0; i < count; ++i) {
+        queue.push(i, i, payload.data(), size);
+        queue.front();
+        queue.pop();
+    }
+    double queue_s = seconds_since(start);
+
+    fmt::print("{:>8}  {:>10.1f}  {:>9.2f}  {:>10.1f}\n", size, history_s / count * 1e9,
+               count * size / history_s / 1e9, queue_s / count * 1e9);
+}
+
+void window_benchmark() {
+    constexpr size_t FRAME_SIZE = 1024 * 1024;
+    constexpr uint64_t PERIOD_NS = 33'333'333;
+    std::vector<uint8_t> frame(FRAME_SIZE, 0x5a);
+
+    HistoryBuffer history(HISTORY_SIZE);
+    uint64_t frames = HISTORY_SIZE / (FRAME_SIZE + 64) * 2;  // Wraps once
+    for (uint64_t i = 0; i < frames; ++i) {
+        history.push(i * PERIOD_NS, i, frame.data(), frame.size());
+    }
+    const uint64_t end_ns = (frames - 1) * PERIOD_NS;
+    const uint64_t start_ns = end_ns - 5'000'000'000ull;
+
+    auto start = Clock::now();
+    uint64_t position = history.seek(start_ns);
+    double seek_s = seconds_since(start);
+
+    StagedMessage header;
+    std::vector<uint8_t> payload;
+    uint64_t read = 0;
+    start = Clock::now();
+    while (history.read(position, header, payload) == HistoryRead::Ok) {
+        ++read;
+    }
+    double read_s = seconds_since(start);
+
+    fmt::print("\n5 s window of 1 MB frames at 30 Hz: {} frames, seek {:.2f} ms, copy {:.1f} ms ({:.1f} GB/s)\n",
+               read, seek_s * 1e3, read_s * 1e3, read * FRAME_SIZE / read_s / 1e9);
+}
+
+}  // namespace
+
+int main() {
+    fmt::print("{} MB history, full (every push evicts)\n\n", HISTORY_SIZE >> 20);
+    fmt::print("    size  history ns  GB/s  staging ns\n");
+    for (size_t size : {64, 1024, 16 * 1024, 1024 * 1024}) {
+        push_benchmark(size);
+    }
+    window_benchmark();
+    return 0;
+}
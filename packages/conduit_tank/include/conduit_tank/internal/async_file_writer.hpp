@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mcap/writer.hpp>
+
+namespace conduit {
+namespace internal {
+
+/// Alignment of O_DIRECT buffers, file offsets and write sizes.
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+/// @brief Output of the MCAP writer, written to disk by a dedicated I/O thread.
+///
+/// The MCAP writer hands over finished (compressed) chunks through
+/// handleWrite(), which only copies them into the current buffer. Full
+/// buffers are written by the I/O thread, with O_DIRECT where the file
+/// system supports it. Memory is bounded to buffer_count x buffer_size: when
+/// every buffer is waiting for the disk, handleWrite() blocks until one is
+/// free.
+class AsyncFileWriter : public mcap::IWritable {
+public:
+    /// @brief Create (truncate) the file and start the I/O thread.
+    /// @param path Output file.
+    /// @param buffer_size Bytes per buffer (rounded up to DIRECT_IO_ALIGNMENT).
+    /// @param buffer_count Number of buffers, at least 2.
+    /// @param direct_io Bypass the page cache with O_DIRECT if possible.
+    /// @throws TankError If the file cannot be created.
+    AsyncFileWriter(const std::string& path, size_t buffer_size, uint32_t buffer_count, bool direct_io);
+    ~AsyncFileWriter() override;
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    /// @brief Hand the partly filled buffer to the I/O thread without waiting.
+    ///
+    /// Everything written so far reaches the file even if the process dies
+    /// afterwards. The bytes after the last full block are kept and written
+    /// again with the next buffer, which starts at that block.
+    void flush();
+
+    /// @brief Flush the last buffer, wait for the I/O thread, sync and close the file.
+    void end() override;
+
+    /// @brief Bytes handed to the writer so far.
+    uint64_t size() const override { return size_.load(std::memory_order_relaxed); }
+
+    /// @brief Check whether the file is written with O_DIRECT.
+    bool direct() const { return direct_; }
+
+    /// @brief Longest time handleWrite() waited for a free buffer.
+    std::chrono::nanoseconds max_wait() const { return std::chrono::nanoseconds(max_wait_ns_.load()); }
+
+    /// @brief Bytes the I/O thread has written to disk (including padding of the last block).
+    uint64_t bytes_on_disk() const { return bytes_on_disk_.load(); }
+
+protected:
+    void handleWrite(const std::byte* data, uint64_t size) override;
+
+private:
+    struct Buffer {
+        std::byte* data = nullptr;
+        size_t used = 0;
+        uint64_t offset = 0;  ///< File offset of data[0].
+    };
+
+    int fd_ = -1;
+    std::atomic<bool> direct_{false};  ///< Cleared by the I/O thread if writes refuse O_DIRECT.
+    size_t buffer_size_;
+    std::vector<Buffer> buffers_;
+    Buffer* current_ = nullptr;
+    /// Bytes written so far. Writes come from one thread at a time; size() may be
+    /// read from others (Tank checks it for splitting while chunks are written).
+    std::atomic<uint64_t> size_{0};
+    bool ended_ = false;
+    std::byte* tail_ = nullptr;  ///< Bytes after the last full block at flush(); starts the next buffer.
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Buffer*> full_;   ///< Waiting for the I/O thread, in file order.
+    std::deque<Buffer*> free_;
+    bool stopping_ = false;
+    int error_ = 0;              ///< errno of the first failed write.
+    std::thread thread_;
+
+    std::atomic<uint64_t> max_wait_ns_{0};
+    std::atomic<uint64_t> bytes_on_disk_{0};
+
+    void submit();
+    void take_free();
+    void io_loop();
+    bool write_fully(const Buffer& buffer, size_t length);
+};
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mcap/writer.hpp>
+
+#include "conduit_tank/tank.hpp"
+#include "conduit_tank/internal/mcap_format.hpp"
+
+namespace conduit {
+namespace internal {
+
+/// @brief Chunking and compression settings of a ChunkWriter.
+struct ChunkWriterOptions {
+    Compression compression = Compression::Zstd;
+    int compression_level = 1;
+    uint32_t threads = 2;             ///< Compression threads; 0 compresses in write().
+    size_t chunk_size = 1024 * 1024;  ///< Uncompressed bytes per chunk.
+};
+
+/// @brief MCAP writer that compresses chunks on a thread pool.
+///
+/// write() appends Message records to the open chunk. A full chunk is
+/// handed to the compression threads and a new one started; up to
+/// 2 x threads chunks are in flight. Compressed chunks are written to the
+/// output in the order they were closed, each followed by its message
+/// indexes, so the file is the same as with serial compression. close()
+/// writes the summary section (channels, statistics, chunk indexes) and
+/// ends the output.
+///
+/// write() and add_channel() must be called from one thread.
+class ChunkWriter {
+public:
+    /// @brief Write the file header and start the compression threads.
+    /// @param output Destination; must outlive the writer.
+    /// @param options Chunking and compression settings.
+    ChunkWriter(mcap::IWritable& output, const ChunkWriterOptions& options);
+    ~ChunkWriter();
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    /// @brief Add a channel without schema.
+    /// @param topic Topic name.
+    /// @param message_encoding Encoding of the payloads ("" for raw bytes).
+    /// @return Channel id for write().
+    uint16_t add_channel(const std::string& topic, const std::string& message_encoding = "");
+
+    /// @brief Append a message to the open chunk.
+    /// @param channel_id Channel from add_channel().
+    /// @param sequence Publisher sequence number.
+    /// @param log_time Record time in nanoseconds.
+    /// @param publish_time Publish time in nanoseconds.
+    /// @param data Payload.
+    /// @param size Payload size in bytes.
+    void write(uint16_t channel_id, uint32_t sequence, uint64_t log_time, uint64_t publish_time,
+               const void* data, size_t size);
+
+    /// @brief Write the open chunk now and wait until every chunk is in the output.
+    ///
+    /// The output then holds a complete data section, readable without the
+    /// summary. Call from the thread that calls write().
+    void flush();
+
+    /// @brief Flush the open chunk, wait for all chunks, write the summary and end the output.
+    void close();
+
+    /// @brief Number of chunks written to the output.
+    uint64_t chunk_count() const { return chunks_written_.load(); }
+
+    /// @brief Longest time write() waited for a compression thread.
+    std::chrono::nanoseconds max_wait() const { return std::chrono::nanoseconds(max_wait_ns_.load()); }
+
+private:
+    struct Channel {
+        uint16_t id;
+        std::string topic;
+        std::string message_encoding;
+        uint64_t message_count = 0;
+    };
+
+    /// One chunk on its way from write() to the output.
+    struct Job {
+        uint64_t number;                  ///< Order of output.
+        McapBuffer records;               ///< Uncompressed Message records.
+        std::map<uint16_t, std::vector<std::pair<uint64_t, uint64_t>>> index;  ///< (log time, offset).
+        uint64_t start_time = UINT64_MAX;
+        uint64_t end_time = 0;
+        std::vector<uint8_t> compressed;
+        std::string compression;          ///< "", "lz4" or "zstd" as stored.
+        bool done = false;
+    };
+
+    /// Summary entry for one chunk written to the output.
+    struct ChunkIndex {
+        uint64_t start_time;
+        uint64_t end_time;
+        uint64_t offset;
+        uint64_t length;
+        std::map<uint16_t, uint64_t> message_index_offsets;
+        uint64_t message_index_length;
+        std::string compression;
+        uint64_t compressed_size;
+        uint64_t uncompressed_size;
+    };
+
+    mcap::IWritable& output_;
+    ChunkWriterOptions options_;
+    std::vector<Channel> channels_;
+    std::unique_ptr<Job> open_;
+    uint64_t next_number_ = 0;
+    uint64_t message_count_ = 0;
+    uint64_t start_time_ = UINT64_MAX;
+    uint64_t end_time_ = 0;
+    bool closed_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Job*> pending_;                ///< Waiting for a compression thread.
+    std::map<uint64_t, std::unique_ptr<Job>> in_flight_;  ///< Submitted, not yet written.
+    uint64_t next_output_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+
+    std::mutex output_mutex_;                 ///< Held while writing to output_.
+    std::vector<ChunkIndex> chunk_indexes_;
+
+    std::atomic<uint64_t> chunks_written_{0};
+    std::atomic<uint64_t> max_wait_ns_{0};
+
+    void submit();
+    void compress(Job& job) const;
+    void worker_loop();
+    void finish(Job* job);
+    void write_chunk(const Job& job);
+    void write_summary();
+    void emit(const McapBuffer& buffer);
+};
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "conduit_tank/internal/staging_queue.hpp"
+
+namespace conduit {
+namespace internal {
+
+/// @brief Outcome of reading a HistoryBuffer record.
+enum class HistoryRead {
+    Ok,           ///< The record was read.
+    End,          ///< No record at the position yet.
+    Overwritten,  ///< The record was evicted; continue from begin().
+};
+
+/// @brief Circular history of a topic's newest messages.
+///
+/// Records have the StagingQueue layout (StagedMessage header plus payload,
+/// 32-byte aligned, never wrapping). Unlike a StagingQueue it never refuses
+/// a push: the producer evicts the oldest records to make room. Readers do
+/// not hold the producer back; they read optimistically and learn from
+/// HistoryRead::Overwritten that a record was evicted while they read it.
+class HistoryBuffer {
+public:
+    /// @brief Create an empty history.
+    ///
+    /// The memory is allocated but not touched, so pages are only faulted in
+    /// as the history fills.
+    ///
+    /// @param capacity Buffer size in bytes (rounded down to STAGING_ALIGNMENT).
+    explicit HistoryBuffer(size_t capacity);
+
+    HistoryBuffer(const HistoryBuffer&) = delete;
+    HistoryBuffer& operator=(const HistoryBuffer&) = delete;
+
+    /// @brief Copy a message in, evicting the oldest ones if needed (producer only).
+    /// @return false if the message is larger than the whole buffer.
+    bool push(uint64_t timestamp_ns, uint64_t sequence, const void* data, size_t size,
+              StagedKind kind = StagedKind::Message);
+
+    /// @brief Position of the oldest record.
+    uint64_t begin() const { return head_.load(std::memory_order_acquire); }
+
+    /// @brief Position after the newest record.
+    uint64_t end() const { return tail_.load(std::memory_order_acquire); }
+
+    /// @brief Read the header of the record at @p position.
+    /// @param position Record position; moved past a wrap filler if there is one.
+    /// @param header Receives the header.
+    HistoryRead peek(uint64_t& position, StagedMessage& header) const;
+
+    /// @brief Copy the record at @p position and move to the next one.
+    /// @param position Record position; on Ok, the position of the next record.
+    /// @param header Receives the header.
+    /// @param payload Receives the payload; its capacity is reused.
+    HistoryRead read(uint64_t& position, StagedMessage& header, std::vector<uint8_t>& payload) const;
+
+    /// @brief Position of the oldest record at or after @p timestamp_ns (end() if none).
+    uint64_t seek(uint64_t timestamp_ns) const;
+
+    /// @brief Buffer size in bytes.
+    size_t capacity() const { return capacity_; }
+
+private:
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t capacity_;
+
+    /// Oldest record (bytes ever evicted). Moves before the bytes are reused.
+    alignas(64) std::atomic<uint64_t> head_{0};
+
+    /// Producer position (bytes ever pushed).
+    alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+}  // namespace internal
+}  // namespace conduit
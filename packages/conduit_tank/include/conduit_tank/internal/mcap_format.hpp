@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace conduit {
+namespace internal {
+
+/// @brief MCAP file magic, at the start and the end of every file.
+constexpr uint8_t MCAP_MAGIC[8] = {0x89, 'M', 'C', 'A', 'P', '0', '\r', '\n'};
+
+/// @brief MCAP record opcodes (https://mcap.dev/spec).
+enum class McapOp : uint8_t {
+    Header = 0x01,
+    Footer = 0x02,
+    Schema = 0x03,
+    Channel = 0x04,
+    Message = 0x05,
+    Chunk = 0x06,
+    MessageIndex = 0x07,
+    ChunkIndex = 0x08,
+    Attachment = 0x09,
+    AttachmentIndex = 0x0A,
+    Statistics = 0x0B,
+    Metadata = 0x0C,
+    MetadataIndex = 0x0D,
+    SummaryOffset = 0x0E,
+    DataEnd = 0x0F,
+};
+
+/// Bytes before a record's content: opcode (1) + content length (8).
+constexpr size_t MCAP_RECORD_PREFIX = 9;
+
+/// Message record content before the payload: channel id, sequence, log and publish time.
+constexpr size_t MCAP_MESSAGE_PREFIX = 2 + 4 + 8 + 8;
+
+/// @brief Little-endian MCAP record serialization into a byte vector.
+///
+/// begin() writes the opcode and a length placeholder, end() patches the
+/// length in, so a record's fields can be appended without sizing them
+/// first. Fields are written with the primitive encodings of the spec:
+/// integers little-endian, strings and byte arrays with a length prefix.
+class McapBuffer {
+public:
+    std::vector<uint8_t>& bytes() { return bytes_; }
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+    size_t size() const { return bytes_.size(); }
+    void clear() { bytes_.clear(); }
+
+    /// @brief Start a record; returns its offset for end().
+    size_t begin(McapOp op) {
+        size_t start = bytes_.size();
+        u8(static_cast<uint8_t>(op));
+        u64(0);
+        return start;
+    }
+
+    /// @brief Fill in the content length of the record started at @p start.
+    void end(size_t start) {
+        uint64_t length = bytes_.size() - start - MCAP_RECORD_PREFIX;
+        std::memcpy(bytes_.data() + start + 1, &length, sizeof(length));
+    }
+
+    void u8(uint8_t v) { bytes_.push_back(v); }
+    void u16(uint16_t v) { raw(&v, sizeof(v)); }
+    void u32(uint32_t v) { raw(&v, sizeof(v)); }
+    void u64(uint64_t v) { raw(&v, sizeof(v)); }
+
+    void str(const std::string& s) {
+        u32(static_cast<uint32_t>(s.size()));
+        raw(s.data(), s.size());
+    }
+
+    void raw(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        bytes_.insert(bytes_.end(), p, p + size);
+    }
+
+private:
+    std::vector<uint8_t> bytes_;  // Written in host order: little-endian hosts only
+};
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "conduit_tank/internal/mcap_format.hpp"
+
+namespace conduit {
+namespace internal {
+
+/// @brief Channel record of an MCAP file.
+struct McapChannel {
+    uint16_t id;
+    std::string topic;
+    std::string message_encoding;
+};
+
+/// @brief Chunk of an MCAP file, located by offset in the mapped file.
+///
+/// Message records outside of chunks are collected into uncompressed
+/// "loose" chunks of their own, so a reader only ever deals with chunks.
+struct McapChunk {
+    uint64_t start_time = 0;         ///< Earliest message log time.
+    uint64_t end_time = 0;           ///< Latest message log time.
+    uint64_t offset = 0;             ///< File offset of the Chunk record (loose: of the first record).
+    uint64_t length = 0;             ///< Bytes from offset.
+    uint64_t uncompressed_size = 0;  ///< Size of the records after decompression.
+    std::string compression;         ///< "", "lz4" or "zstd".
+    bool loose = false;              ///< Top-level records, not a Chunk record.
+    /// File offset of each channel's MessageIndex record. Empty if the
+    /// chunk has no index; a channel missing from a non-empty map has no
+    /// messages in the chunk.
+    std::map<uint16_t, uint64_t> message_indexes;
+};
+
+/// @brief Message record inside a decompressed chunk; data points into it.
+struct McapMessage {
+    uint16_t channel_id;
+    uint32_t sequence;
+    uint64_t log_time;
+    uint64_t publish_time;
+    const uint8_t* data;
+    size_t size;
+};
+
+/// @brief Memory-mapped MCAP file.
+///
+/// The constructor maps the file and reads its summary section: channels
+/// and chunk indexes, without touching the data. Files without a summary
+/// (a recording cut short by a crash) are indexed by walking the record
+/// prefixes of the data section instead, up to the last complete record.
+/// Chunk contents are only read when they are decompressed.
+class McapReader {
+public:
+    /// @brief Map a file and index its channels and chunks.
+    /// @param path MCAP file.
+    /// @throws TankError If the file cannot be mapped or is not MCAP.
+    explicit McapReader(const std::string& path);
+    ~McapReader();
+
+    McapReader(const McapReader&) = delete;
+    McapReader& operator=(const McapReader&) = delete;
+
+    const std::vector<McapChannel>& channels() const { return channels_; }
+
+    /// @brief Chunks in file order.
+    const std::vector<McapChunk>& chunks() const { return chunks_; }
+
+    /// @brief Whether the index came from the summary section.
+    bool indexed() const { return indexed_; }
+
+    /// @brief Log time of the first and last message (0 if there are none).
+    uint64_t start_time() const { return start_time_; }
+    uint64_t end_time() const { return end_time_; }
+
+    /// @brief The records of a chunk as stored in the file (compressed).
+    /// @throws TankError If the chunk record is corrupt.
+    std::pair<const uint8_t*, size_t> records(const McapChunk& chunk) const;
+
+    /// @brief Decompress a chunk's records.
+    /// @param chunk One of chunks().
+    /// @param out Receives the records; its capacity is reused.
+    /// @throws TankError On an unknown compression or corrupt data.
+    void decompress(const McapChunk& chunk, std::vector<uint8_t>& out) const;
+
+    /// @brief Read one channel's message index of a chunk.
+    /// @param chunk One of chunks().
+    /// @param channel_id Channel to look up.
+    /// @param entries Receives (log time, offset into the decompressed records).
+    /// @return false if the chunk has no index; entries is then empty.
+    /// @throws TankError If the index record is corrupt.
+    bool message_index(const McapChunk& chunk, uint16_t channel_id,
+                       std::vector<std::pair<uint64_t, uint64_t>>& entries) const;
+
+    /// @brief Ask the kernel to read a chunk into the page cache.
+    void prefetch(const McapChunk& chunk) const;
+
+    /// @brief Parse the Message record at @p offset of decompressed records.
+    /// @return false if there is no complete Message record there.
+    static bool message_at(const uint8_t* records, size_t size, size_t offset, McapMessage& msg);
+
+    /// @brief Call @p callback with every Message record in decompressed records.
+    ///
+    /// Other records are skipped; a truncated record ends the walk.
+    template <typename F>
+    static void for_each_message(const uint8_t* records, size_t size, F&& callback);
+
+private:
+    int fd_ = -1;
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<McapChannel> channels_;
+    std::vector<McapChunk> chunks_;
+    bool indexed_ = false;
+    uint64_t start_time_ = 0;
+    uint64_t end_time_ = 0;
+
+    bool load_summary();
+    void scan();
+};
+
+inline bool McapReader::message_at(const uint8_t* records, size_t size, size_t offset, McapMessage& msg) {
+    if (offset > size || size - offset < MCAP_RECORD_PREFIX ||
+        static_cast<McapOp>(records[offset]) != McapOp::Message) {
+        return false;
+    }
+    uint64_t length;
+    std::memcpy(&length, records + offset + 1, sizeof(length));
+    if (length < MCAP_MESSAGE_PREFIX || length > size - offset - MCAP_RECORD_PREFIX) {
+        return false;
+    }
+    const uint8_t* content = records + offset + MCAP_RECORD_PREFIX;
+    std::memcpy(&msg.channel_id, content, 2);
+    std::memcpy(&msg.sequence, content + 2, 4);
+    std::memcpy(&msg.log_time, content + 6, 8);
+    std::memcpy(&msg.publish_time, content + 14, 8);
+    msg.data = content + MCAP_MESSAGE_PREFIX;
+    msg.size = length - MCAP_MESSAGE_PREFIX;
+    return true;
+}
+
+template <typename F>
+void McapReader::for_each_message(const uint8_t* records, size_t size, F&& callback) {
+    size_t pos = 0;
+    while (pos + MCAP_RECORD_PREFIX <= size) {
+        uint64_t length;
+        std::memcpy(&length, records + pos + 1, sizeof(length));
+        if (length > size - pos - MCAP_RECORD_PREFIX) {
+            return;
+        }
+
+        McapMessage msg;
+        if (message_at(records, size, pos, msg)) {
+            callback(msg);
+        }
+        pos += MCAP_RECORD_PREFIX + length;
+    }
+}
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace conduit {
+namespace internal {
+
+/// @brief Path of file @p index in a numbered series: "run.mcap" -> "run_007.mcap".
+///
+/// Used for the files of a split recording and for snapshots.
+inline std::string numbered_path(const std::string& path, uint32_t index) {
+    size_t slash = path.rfind('/');
+    size_t dot = path.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = path.size();
+    }
+    char number[16];
+    std::snprintf(number, sizeof(number), "_%03u", index);
+    return path.substr(0, dot) + number + path.substr(dot);
+}
+
+}  // namespace internal
+}  // namespace conduit
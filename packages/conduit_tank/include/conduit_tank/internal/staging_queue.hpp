@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace conduit {
+namespace internal {
+
+/// Record alignment in a StagingQueue (also the size of StagedMessage).
+constexpr size_t STAGING_ALIGNMENT = 32;
+
+/// @brief What a staged record holds.
+enum class StagedKind : uint32_t {
+    Message = 0,  ///< A message from the topic.
+    Gap = 1,      ///< A gap marker: messages before the next one were lost.
+};
+
+/// @brief Header of a message copied into a StagingQueue, followed by its payload.
+struct StagedMessage {
+    uint64_t timestamp_ns;  ///< Publish timestamp (CLOCK_MONOTONIC_RAW).
+    uint64_t sequence;      ///< Ring sequence number.
+    uint32_t size;          ///< Payload size in bytes.
+    uint32_t wrap;          ///< Non-zero for the filler record before the buffer wraps.
+    StagedKind kind;        ///< Message or gap marker.
+    uint32_t reserved;
+
+    /// @brief Payload following the header.
+    const void* data() const { return this + 1; }
+};
+static_assert(sizeof(StagedMessage) == STAGING_ALIGNMENT, "records are aligned to the header size");
+
+/// @brief Lock-free single-producer single-consumer queue of variable-size messages.
+///
+/// One recording thread copies each message out of its ring slot with
+/// push(); the writer thread reads with front() and pop(). Records are
+/// stored contiguously in a circular byte buffer, so a payload is never
+/// split and can be handed to the file writer as is.
+class StagingQueue {
+public:
+    /// @brief Create an empty queue.
+    /// @param capacity Buffer size in bytes (rounded up to a power of two).
+    explicit StagingQueue(size_t capacity);
+
+    StagingQueue(const StagingQueue&) = delete;
+    StagingQueue& operator=(const StagingQueue&) = delete;
+
+    /// @brief Copy a message into the queue (producer only).
+    /// @param timestamp_ns Publish timestamp.
+    /// @param sequence Ring sequence number.
+    /// @param data Payload.
+    /// @param size Payload size in bytes.
+    /// @param kind Message or gap marker.
+    /// @return false if the queue has no room for it.
+    bool push(uint64_t timestamp_ns, uint64_t sequence, const void* data, size_t size,
+              StagedKind kind = StagedKind::Message);
+
+    /// @brief Oldest message in the queue (consumer only).
+    /// @return The message, valid until pop(); nullptr if the queue is empty.
+    const StagedMessage* front();
+
+    /// @brief Remove the message returned by front() (consumer only).
+    void pop();
+
+    /// @brief Whether the queue holds nothing (either side; changes nothing).
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /// @brief Buffer size in bytes.
+    size_t capacity() const { return capacity_; }
+
+private:
+    /// @brief Whether @p length bytes fit after @p tail (producer only).
+    bool has_room(uint64_t tail, size_t length);
+
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t capacity_;
+    size_t mask_;
+
+    /// Consumer position (bytes ever popped).
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t cached_tail_ = 0;  ///< Consumer's last view of tail_.
+
+    /// Producer position (bytes ever pushed).
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    uint64_t cached_head_ = 0;  ///< Producer's last view of head_.
+};
+
+}  // namespace internal
+}  // namespace conduit
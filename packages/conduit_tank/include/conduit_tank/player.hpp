@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <conduit_core/scheduling.hpp>
+
+namespace conduit {
+
+/// @brief Configuration for a Player.
+struct PlayerOptions {
+    /// Playback speed relative to the recording: 2.0 plays twice as fast.
+    /// 0 publishes as fast as possible, ignoring the recorded timing.
+    double rate = 1.0;
+    /// Topics to play; empty plays every recorded topic.
+    std::vector<std::string> topics;
+    /// Chunks decompressed ahead of playback. Memory use is about this
+    /// many uncompressed chunks (1 MB each for Tank recordings).
+    uint32_t read_ahead = 4;
+    /// Ring depth of the publishers. Slots grow to fit the largest message.
+    uint32_t depth = 16;
+    /// Scheduling applied to the playback and decompression threads.
+    ThreadOptions threads;
+};
+
+/// @brief Player statistics, see Player::stats().
+struct PlayerStats {
+    uint64_t messages = 0;  ///< Messages published.
+    uint64_t bytes = 0;     ///< Payload bytes published.
+    uint64_t failed = 0;    ///< Messages the publisher rejected.
+    /// Longest a message was published after its scheduled time (0 when
+    /// playing as fast as possible).
+    std::chrono::nanoseconds max_lag{0};
+    /// Longest playback waited for a chunk to be decompressed.
+    std::chrono::nanoseconds max_decompress_wait{0};
+};
+
+/// @brief Replays an MCAP recording as live topics.
+///
+/// The file is memory-mapped. A decompression thread keeps read_ahead
+/// chunks ready while the playback thread publishes their messages at
+/// their recorded time offsets, scaled by the rate. Publishers are created
+/// in the constructor, so subscribers can attach before start().
+///
+/// Channels whose names are not valid topics (e.g. the "<topic>/gaps"
+/// channels Tank writes for lost messages) are not played.
+///
+/// @see Tank
+class Player {
+public:
+    /// @brief Open a recording and create a publisher per recorded topic.
+    /// @param path Path to the MCAP file.
+    /// @param options Playback configuration.
+    /// @throws TankError If the file cannot be read.
+    explicit Player(const std::string& path, const PlayerOptions& options = {});
+    ~Player();
+
+    // No copy, no move
+    Player(const Player&) = delete;
+    Player& operator=(const Player&) = delete;
+    Player(Player&&) = delete;
+    Player& operator=(Player&&) = delete;
+
+    /// @brief Topics that will be played.
+    std::vector<std::string> topics() const;
+
+    /// @brief Time between the first and the last recorded message.
+    std::chrono::nanoseconds duration() const;
+
+    /// @brief Start playback in the background.
+    void start();
+
+    /// @brief Stop playback early; waits for the threads to exit.
+    void stop();
+
+    /// @brief Check if playback is in progress (false once everything is published).
+    bool playing() const;
+
+    /// @brief Block until playback has finished or was stopped.
+    void wait();
+
+    /// @brief Get the number of messages published so far.
+    uint64_t message_count() const;
+
+    /// @brief Get throughput and timing statistics.
+    PlayerStats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace conduit
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "conduit_tank/tank.hpp"
+
+namespace conduit {
+
+/// @brief Configuration for slice().
+struct SliceOptions {
+    /// Start of the range, relative to the first message of the recording.
+    std::chrono::nanoseconds start{0};
+    /// End of the range (inclusive), relative to the first message.
+    std::chrono::nanoseconds end = std::chrono::nanoseconds::max();
+    /// Topics to keep; empty keeps every channel. A topic's gap markers
+    /// ("<topic>/gaps") are kept with it.
+    std::vector<std::string> topics;
+    /// Chunk compression of the output.
+    Compression compression = Compression::Zstd;
+    /// Compression level passed to the library.
+    int compression_level = 1;
+};
+
+/// @brief What slice() did.
+struct SliceStats {
+    uint64_t messages = 0;       ///< Messages written to the output.
+    uint64_t chunks_read = 0;    ///< Input chunks decompressed.
+    uint64_t chunks_total = 0;   ///< Input chunks in the file.
+    bool indexed = false;        ///< The input's summary index was used.
+};
+
+/// @brief Copy a time range of a recording into a new MCAP file.
+///
+/// Uses the input's chunk and message indexes: only chunks overlapping the
+/// range and holding one of the topics are read, and within them only the
+/// indexed messages in range are copied. Recordings without a summary
+/// (cut short by a crash) are indexed by walking the data section first.
+///
+/// @param input Recorded MCAP file.
+/// @param output New MCAP file; overwritten if it exists.
+/// @param options Range, topics and output compression.
+/// @return Statistics.
+/// @throws TankError If a file cannot be read or written, or a topic is
+///         not in the recording.
+SliceStats slice(const std::string& input, const std::string& output, const SliceOptions& options = {});
+
+}  // namespace conduit
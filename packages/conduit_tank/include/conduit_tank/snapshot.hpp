@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <conduit_core/scheduling.hpp>
+
+#include "conduit_tank/tank.hpp"
+
+namespace conduit {
+
+/// @brief Configuration for a Snapshot recorder.
+struct SnapshotOptions {
+    /// Scheduling applied to every snapshot thread.
+    ThreadOptions threads;
+    /// Bytes of history for all topics together. Topics added without a
+    /// history size of their own share what the others leave in equal
+    /// parts. Memory is only touched as the histories fill.
+    size_t memory_budget = 256 * 1024 * 1024;
+    /// History before the trigger written to a snapshot.
+    std::chrono::nanoseconds pre_trigger = std::chrono::seconds(10);
+    /// Time after the trigger also written; the file is written once it
+    /// has passed.
+    std::chrono::nanoseconds post_trigger = std::chrono::seconds(2);
+    /// Topic whose messages trigger a snapshot (any payload); empty for
+    /// trigger() only.
+    std::string trigger_topic;
+    /// Chunk compression of the snapshot files.
+    Compression compression = Compression::Zstd;
+    /// Compression level passed to the library.
+    int compression_level = 1;
+    /// Threads compressing chunks while a snapshot is written.
+    uint32_t compression_threads = 2;
+};
+
+/// @brief Snapshot recorder statistics, see Snapshot::stats().
+struct SnapshotStats {
+    uint64_t snapshots = 0;    ///< Files written.
+    uint64_t triggers = 0;     ///< Triggers received; several can share one file.
+    uint64_t messages = 0;     ///< Messages written to snapshot files.
+    uint64_t dropped = 0;      ///< Messages lapped in their ring before reaching the history.
+    /// Messages of a snapshot window evicted from the history before they
+    /// were written (the history was too small for pre + post trigger).
+    uint64_t overwritten = 0;
+    uint64_t buffered_bytes = 0;  ///< Bytes held in the histories.
+    /// Shortest time span held by a topic whose history is full; 0 while
+    /// no history is full. Below pre_trigger means the budget is too small.
+    std::chrono::nanoseconds history{0};
+};
+
+/// @brief Keeps the last seconds of topics in memory and writes them to
+/// MCAP when triggered.
+///
+/// Each topic has a circular history of its newest messages, filled by its
+/// own thread with batch reads from the ring; old messages are evicted as
+/// new ones arrive. When triggered, by a message on the trigger topic or
+/// by trigger(), the messages from pre_trigger before to post_trigger
+/// after the trigger are written to "<stem>_000<ext>", "<stem>_001<ext>",
+/// ... next to output_path, in the format Tank records.
+///
+/// While nothing is triggered the only work is copying messages into the
+/// histories; the writer thread sleeps. Writing a snapshot never holds up
+/// the topic threads. Triggers that arrive before a pending snapshot is
+/// written extend it instead of starting another.
+///
+/// Topics must be added before calling start().
+///
+/// @see Tank
+class Snapshot {
+public:
+    /// @brief Construct a snapshot recorder.
+    /// @param output_path Path the snapshot files are numbered after.
+    /// @param options Recorder configuration.
+    explicit Snapshot(const std::string& output_path, const SnapshotOptions& options = {});
+    ~Snapshot();
+
+    // No copy, no move
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot(Snapshot&&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+
+    /// @brief Add a topic to keep (must be called before start()).
+    /// @param topic Topic name.
+    /// @param history_size Bytes of history for this topic; 0 for a share
+    ///        of the memory budget.
+    void add_topic(const std::string& topic, size_t history_size = 0);
+
+    /// @brief Start filling the histories.
+    /// @throws TankError If a topic or the trigger topic does not exist, or
+    ///         the history sizes exceed the memory budget.
+    void start();
+
+    /// @brief Stop, writing a pending snapshot with what has arrived so far.
+    void stop();
+
+    /// @brief Check if the recorder is running.
+    bool running() const;
+
+    /// @brief Trigger a snapshot around the current time.
+    void trigger();
+
+    /// @brief Trigger a snapshot around @p timestamp_ns (CLOCK_MONOTONIC_RAW,
+    ///        like message timestamps).
+    void trigger(uint64_t timestamp_ns);
+
+    /// @brief Number of snapshot files written so far.
+    uint64_t snapshot_count() const;
+
+    /// @brief Path of the newest snapshot file ("" before the first).
+    std::string last_snapshot() const;
+
+    /// @brief Get snapshot and history statistics.
+    SnapshotStats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace conduit
@@ -1,23 +1,117 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
 
+#include <conduit_core/scheduling.hpp>
+
 namespace conduit {
 
+/// @brief Chunk compression of a recording.
+enum class Compression {
+    None,  ///< Store chunks uncompressed.
+    Lz4,   ///< LZ4 frames: fast, moderate ratio.
+    Zstd,  ///< Zstandard: better ratio, slower at high levels.
+};
+
+/// @brief Configuration for a Tank recorder.
+struct TankOptions {
+    /// Scheduling applied to every recording thread.
+    ThreadOptions threads;
+    /// Bytes buffered per topic between its recording thread and the file
+    /// writer (rounded up to a power of two). Messages that find it full
+    /// are dropped.
+    size_t staging_size = 4 * 1024 * 1024;
+    /// Write the file with O_DIRECT, bypassing the page cache. Ignored on
+    /// file systems that do not support it (e.g. tmpfs).
+    bool direct_io = true;
+    /// Bytes per I/O buffer between the file writer and the disk.
+    size_t io_buffer_size = 4 * 1024 * 1024;
+    /// Number of I/O buffers (at least 2). Together with io_buffer_size
+    /// this bounds the memory used for writing.
+    uint32_t io_buffers = 2;
+    /// Chunk compression.
+    Compression compression = Compression::Zstd;
+    /// Compression level passed to the library (Zstd: 1-19, negative for
+    /// faster; LZ4: 0-2 fast, 3-12 high compression).
+    int compression_level = 1;
+    /// Threads compressing chunks in parallel. 0 compresses on the writer
+    /// thread.
+    uint32_t compression_threads = 2;
+    /// Uncompressed bytes per chunk. Larger chunks compress better but
+    /// take longer to reach the disk.
+    size_t chunk_size = 1024 * 1024;
+    /// Record without loss: topics are read by reliable subscribers, so a
+    /// publisher waits instead of overwriting unrecorded messages, and a
+    /// recording thread waits for room in its staging queue instead of
+    /// dropping. Slows publishers down to what the disk sustains.
+    bool lossless = false;
+    /// Longest a publisher waits for the recorder in lossless mode before
+    /// it moves on and the skipped messages are recorded as a gap.
+    std::chrono::nanoseconds block_timeout = std::chrono::milliseconds(100);
+    /// Start a new file once the current one holds this many bytes; 0
+    /// never splits by size. A file can exceed it by about one chunk.
+    uint64_t split_size = 0;
+    /// Start a new file once the current one spans this much message time;
+    /// 0 never splits by duration.
+    std::chrono::nanoseconds split_duration{0};
+    /// Keep only the newest max_files files of a split recording, deleting
+    /// older ones as new ones are finished (a "black box" of the last
+    /// max_files x split_duration). 0 keeps every file; otherwise at least 2.
+    uint32_t max_files = 0;
+    /// Get written messages into the file at least this often, so that a
+    /// crash loses at most this much of the recording. 0 writes only when
+    /// chunks fill up.
+    std::chrono::nanoseconds flush_interval = std::chrono::seconds(1);
+};
+
+/// @brief Recorder statistics, see Tank::stats().
+struct TankStats {
+    uint64_t messages = 0;  ///< Messages written to the file.
+    uint64_t dropped = 0;   ///< Messages lost (see Tank::dropped_count()).
+    uint64_t gaps = 0;      ///< Gap markers written for lost messages.
+    uint64_t bytes = 0;     ///< Bytes written to disk so far (all files).
+    uint32_t files = 0;     ///< Files started (1 unless the recording is split).
+    /// Longest time from publish until a recording thread had staged a message.
+    std::chrono::nanoseconds max_record_latency{0};
+    /// Longest time the file writer waited for the disk (all I/O buffers busy).
+    std::chrono::nanoseconds max_io_wait{0};
+    /// Longest time the writer thread waited for a compression thread.
+    std::chrono::nanoseconds max_compression_wait{0};
+};
+
 /// @brief MCAP-based message recorder with Zstd/LZ4 compression.
 ///
 /// Records messages from one or more topics into an MCAP file.
 /// Topics must be added before calling start(). The recorded file
-/// can be replayed with the conduit CLI tools.
+/// can be replayed with Player or `conduit play`.
+///
+/// Each topic is read by its own thread, which copies messages into a
+/// per-topic staging queue. A single writer thread drains the queues into
+/// chunks, oldest message first. Full chunks are compressed by a pool of
+/// threads and written in order by an I/O thread.
+///
+/// Lost messages are not silently missing from the file: before the next
+/// message of a topic that lost some, a gap marker is written to the
+/// channel "<topic>/gaps" as JSON, e.g. {"first_sequence":120,"count":8}.
+///
+/// With TankOptions::split_size or split_duration the recording is split
+/// into "<stem>_000<ext>", "<stem>_001<ext>", ... next to output_path. Each
+/// file is a complete recording with every channel; no message is lost or
+/// duplicated at a split. A file cut short by a crash lacks its summary
+/// but holds everything up to the last flush and can still be read
+/// (Player, slice()).
 ///
 /// @see Node
 class Tank {
 public:
     /// @brief Construct a recorder targeting the given output file.
     /// @param output_path Path to the MCAP output file.
-    explicit Tank(const std::string& output_path);
+    /// @param options Recorder configuration.
+    explicit Tank(const std::string& output_path, const TankOptions& options = {});
     ~Tank();
 
     // No copy, no move
@@ -31,6 +125,8 @@ public:
     void add_topic(const std::string& topic);
 
     /// @brief Start recording messages from all added topics.
+    /// @throws TankError If the file cannot be created or max_files is
+    ///         set without splitting, or to 1.
     void start();
 
     /// @brief Stop recording and finalize the MCAP file.
@@ -44,6 +140,18 @@ public:
     /// @return Message count.
     uint64_t message_count() const;
 
+    /// @brief Get the number of messages lost so far.
+    ///
+    /// Counts messages the publisher overwrote before they were read and
+    /// messages that found their staging queue full.
+    ///
+    /// @return Dropped message count.
+    uint64_t dropped_count() const;
+
+    /// @brief Get throughput and latency statistics.
+    /// @return Statistics since start().
+    TankStats stats() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
@@ -0,0 +1,296 @@
+/**
+ * @file async_file_writer.cpp
+ * @brief Asynchronous file writer - Keeps disk latency away from recording
+ *
+ * == Why? ==
+ *
+ * A write() into the page cache is usually fast, until writeback kicks in
+ * or the cache fills up: then one call can block for tens of milliseconds.
+ * If that happens on the thread that drains the staging queues, the
+ * queues fill up and messages are dropped.
+ *
+ * == How ==
+ *
+ *   writer thread                       I/O thread
+ *   ─────────────                       ──────────
+ *   McapWriter finishes a chunk
+ *   handleWrite(): memcpy into  ──full──>  pwrite(buffer, offset)
+ *   the current buffer                    (O_DIRECT: no page cache)
+ *                               <─free───
+ *
+ * With two or more buffers one is filled while the other is written
+ * (double buffering). The buffers are all the memory this stage uses; if
+ * the disk cannot keep up at all, handleWrite() waits for a free buffer and
+ * records how long it waited.
+ *
+ * == O_DIRECT ==
+ *
+ * Bypassing the page cache makes write latency what the disk does, not
+ * what writeback happens to be doing, and keeps a long recording from
+ * evicting everything else from memory. It requires buffers, offsets and
+ * lengths aligned to the logical block size (4096 covers common disks).
+ * Buffers are filled completely except the last, which is padded to the
+ * alignment and truncated back to the real size in end(). Some file
+ * systems (tmpfs) refuse O_DIRECT; we then write through the page cache.
+ *
+ * == Flush ==
+ *
+ * flush() hands over a partial buffer early, padded like the last one.
+ * Its bytes after the last full block are copied aside and the next
+ * buffer starts at that block with them, so the padding is overwritten
+ * by the next write. The I/O thread writes buffers in order, so the file
+ * never goes back to an older version of the block.
+ *
+ *   flush:  |block|block|tail+padding|
+ *   next:               |tail + new data ...|
+ *
+ * io_uring would let one thread keep several writes in flight, but a single
+ * sequential writer saturates a disk with plain pwrite() and needs no
+ * extra dependency.
+ */
+
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include <conduit_core/exceptions.hpp>
+#include <conduit_core/log.hpp>
+
+#include <fcntl.h>   // open, O_DIRECT, fcntl
+#include <unistd.h>  // pwrite, ftruncate, fdatasync, close
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>   // aligned_alloc
+#include <cstring>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+size_t align_up(size_t n) {
+    return (n + DIRECT_IO_ALIGNMENT - 1) & ~(DIRECT_IO_ALIGNMENT - 1);
+}
+
+}  // namespace
+
+/**
+ * Open the file and start the I/O thread.
+ *
+ * Steps:
+ * 1. Open with O_DIRECT if asked; EINVAL means the file system does not
+ *    support it, so open again without
+ * 2. Allocate aligned buffers; all of them start out free
+ * 3. Start the I/O thread
+ */
+AsyncFileWriter::AsyncFileWriter(const std::string& path, size_t buffer_size, uint32_t buffer_count,
+                                 bool direct_io)
+    : buffer_size_(align_up(std::max<size_t>(buffer_size, DIRECT_IO_ALIGNMENT))) {
+    // Step 1
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    if (direct_io) {
+        fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        direct_ = fd_ >= 0;
+    }
+    if (fd_ < 0) {
+        fd_ = ::open(path.c_str(), flags, 0644);
+    }
+    if (fd_ < 0) {
+        throw TankError("Cannot create " + path + ": " + strerror(errno));
+    }
+
+    // Step 2
+    buffers_.resize(std::max<uint32_t>(buffer_count, 2));
+    tail_ = static_cast<std::byte*>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, DIRECT_IO_ALIGNMENT));
+    for (auto& buffer : buffers_) {
+        buffer.data = static_cast<std::byte*>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, buffer_size_));
+        if (buffer.data == nullptr || tail_ == nullptr) {
+            for (auto& allocated : buffers_) {
+                std::free(allocated.data);
+            }
+            std::free(tail_);
+            ::close(fd_);
+            throw TankError("Cannot allocate I/O buffers for " + path);
+        }
+        free_.push_back(&buffer);
+    }
+
+    // Step 3
+    thread_ = std::thread(&AsyncFileWriter::io_loop, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    end();
+    for (auto& buffer : buffers_) {
+        std::free(buffer.data);
+    }
+    std::free(tail_);
+}
+
+/**
+ * Copy bytes from the MCAP writer into buffers, handing each full one over.
+ */
+void AsyncFileWriter::handleWrite(const std::byte* data, uint64_t size) {
+    while (size > 0) {
+        if (current_ == nullptr) {
+            take_free();
+        }
+        size_t n = std::min<size_t>(size, buffer_size_ - current_->used);
+        std::memcpy(current_->data + current_->used, data, n);
+        current_->used += n;
+        size_.store(size_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        data += n;
+        size -= n;
+
+        if (current_->used == buffer_size_) {
+            submit();
+        }
+    }
+}
+
+/**
+ * Make a free buffer current, waiting for the I/O thread if there is none.
+ */
+void AsyncFileWriter::take_free() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (free_.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        changed_.wait(lock, [this] { return !free_.empty(); });
+        auto waited = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        if (waited > max_wait_ns_.load(std::memory_order_relaxed)) {
+            max_wait_ns_.store(waited, std::memory_order_relaxed);
+        }
+    }
+    current_ = free_.front();
+    free_.pop_front();
+
+    // Buffers before this one were full or flushed: start at the last block
+    uint64_t size = size_.load(std::memory_order_relaxed);
+    current_->offset = size & ~static_cast<uint64_t>(DIRECT_IO_ALIGNMENT - 1);
+    current_->used = static_cast<size_t>(size - current_->offset);
+    std::memcpy(current_->data, tail_, current_->used);
+}
+
+/**
+ * Hand over the current buffer early, keeping its partial last block.
+ */
+void AsyncFileWriter::flush() {
+    if (current_ == nullptr || current_->used == 0) {
+        return;
+    }
+    size_t tail = static_cast<size_t>(size_.load(std::memory_order_relaxed) & (DIRECT_IO_ALIGNMENT - 1));
+    std::memcpy(tail_, current_->data + current_->used - tail, tail);
+    submit();
+}
+
+void AsyncFileWriter::submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        full_.push_back(current_);
+    }
+    current_ = nullptr;
+    changed_.notify_all();
+}
+
+/**
+ * Write full buffers in order until end() and nothing is left.
+ */
+void AsyncFileWriter::io_loop() {
+    while (true) {
+        Buffer* buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this] { return !full_.empty() || stopping_; });
+            if (full_.empty()) {
+                return;
+            }
+            buffer = full_.front();
+            full_.pop_front();
+        }
+
+        // Only the last or a flushed buffer can be partial; O_DIRECT writes whole blocks
+        size_t length = direct_ ? align_up(buffer->used) : buffer->used;
+        if (!write_fully(*buffer, length)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error_ == 0) {
+                error_ = errno;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(buffer);
+        }
+        changed_.notify_all();
+    }
+}
+
+/**
+ * pwrite() until everything is written.
+ *
+ * A file system can accept O_DIRECT at open() and still refuse it on
+ * write() (EINVAL); we then drop O_DIRECT and retry through the page cache.
+ */
+bool AsyncFileWriter::write_fully(const Buffer& buffer, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t n = ::pwrite(fd_, buffer.data + written, length - written,
+                             static_cast<off_t>(buffer.offset + written));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EINVAL && direct_) {
+                direct_ = false;
+                fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(n);
+        bytes_on_disk_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+    }
+    return true;
+}
+
+/**
+ * Finish the file.
+ *
+ * Steps:
+ * 1. Hand over the partial last buffer
+ * 2. Let the I/O thread write everything and exit
+ * 3. Cut off the padding of the last O_DIRECT block, flush to disk and
+ *    close: once end() returns, the summary and its indexes are durable
+ */
+void AsyncFileWriter::end() {
+    if (ended_) {
+        return;
+    }
+    ended_ = true;
+
+    // Step 1
+    if (current_ != nullptr && current_->used > 0) {
+        submit();
+    }
+
+    // Step 2
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+
+    // Step 3
+    if (ftruncate(fd_, static_cast<off_t>(size_.load(std::memory_order_relaxed))) < 0 && error_ == 0) {
+        error_ = errno;
+    }
+    if (fdatasync(fd_) < 0 && error_ == 0) {
+        error_ = errno;
+    }
+    ::close(fd_);
+    if (error_ != 0) {
+        log::error("Recording incomplete, write failed: {}", strerror(error_));
+    }
+}
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,496 @@
+/**
+ * @file chunk_writer.cpp
+ * @brief Chunk writer - MCAP output with parallel chunk compression
+ *
+ * == Why? ==
+ *
+ * mcap::McapWriter compresses each chunk inside write() when it fills up.
+ * Zstd manages a few hundred MB/s on one core, so a recording of several
+ * camera streams is capped by the writer thread's compression speed, and
+ * every chunk boundary stalls the writer for the full compression time.
+ *
+ * == How ==
+ *
+ *   writer thread          compression threads          output (ordered)
+ *   ─────────────          ───────────────────          ────────────────
+ *   write() into chunk 4
+ *   chunk 4 full ──────>   [3] zstd ───────┐
+ *   write() into chunk 5   [2] zstd ──┐    │
+ *                                     └────┼──────────>  chunk 2 + indexes
+ *                                          └──────────>  chunk 3 + indexes
+ *
+ * Chunks are numbered as they are closed. A thread that finishes a chunk
+ * writes it only if all earlier chunks are written, then keeps writing any
+ * later ones that are already done. The file is therefore identical to a
+ * serially written one, whichever thread finishes first.
+ *
+ * At most 2 x threads chunks are in flight; write() waits for one to be
+ * written when the limit is reached, which bounds memory at a few chunk
+ * sizes when the CPU cannot keep up.
+ *
+ * == Format ==
+ *
+ * We write the records ourselves (mcap_format.hpp) because McapWriter has
+ * no way to hand it a chunk compressed elsewhere. The layout follows what
+ * McapWriter produces: header, channels, chunks each followed by their
+ * message indexes, data end, and a summary with channels, statistics and
+ * chunk indexes that readers use to seek. CRCs are left at 0 ("not
+ * computed"), which the spec allows.
+ */
+
+#include "conduit_tank/internal/chunk_writer.hpp"
+
+#include <lz4frame.h>
+#include <zstd.h>
+
+#include <algorithm>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+};
+
+/// Per-thread Zstd context, reused across chunks.
+ZSTD_CCtx* zstd_context() {
+    thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> ctx(ZSTD_createCCtx());
+    return ctx.get();
+}
+
+void write_map_header(McapBuffer& buf, size_t entries, size_t entry_size) {
+    buf.u32(static_cast<uint32_t>(entries * entry_size));
+}
+
+}  // namespace
+
+/**
+ * Write the file header and start the compression threads.
+ */
+ChunkWriter::ChunkWriter(mcap::IWritable& output, const ChunkWriterOptions& options)
+    : output_(output), options_(options) {
+    McapBuffer buf;
+    buf.raw(MCAP_MAGIC, sizeof(MCAP_MAGIC));
+    size_t record = buf.begin(McapOp::Header);
+    buf.str("");  // profile
+    buf.str("conduit");
+    buf.end(record);
+    emit(buf);
+
+    for (uint32_t i = 0; i < options_.threads; ++i) {
+        threads_.emplace_back(&ChunkWriter::worker_loop, this);
+    }
+}
+
+ChunkWriter::~ChunkWriter() {
+    close();
+}
+
+/**
+ * Register a channel and write its record to the data section.
+ *
+ * Channels go before the chunks that use them; readers that scan the file
+ * without the summary need them there.
+ */
+uint16_t ChunkWriter::add_channel(const std::string& topic, const std::string& message_encoding) {
+    Channel channel;
+    channel.id = static_cast<uint16_t>(channels_.size() + 1);  // 0 is reserved
+    channel.topic = topic;
+    channel.message_encoding = message_encoding;
+    channels_.push_back(channel);
+
+    McapBuffer buf;
+    size_t record = buf.begin(McapOp::Channel);
+    buf.u16(channel.id);
+    buf.u16(0);  // no schema
+    buf.str(topic);
+    buf.str(message_encoding);
+    write_map_header(buf, 0, 0);
+    buf.end(record);
+
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    emit(buf);
+    return channel.id;
+}
+
+/**
+ * Append a Message record to the open chunk, submitting it when full.
+ */
+void ChunkWriter::write(uint16_t channel_id, uint32_t sequence, uint64_t log_time, uint64_t publish_time,
+                        const void* data, size_t size) {
+    if (!open_) {
+        open_ = std::make_unique<Job>();
+        open_->records.bytes().reserve(options_.chunk_size + MCAP_RECORD_PREFIX + MCAP_MESSAGE_PREFIX + size);
+    }
+    Job& job = *open_;
+
+    uint64_t offset = job.records.size();
+    size_t record = job.records.begin(McapOp::Message);
+    job.records.u16(channel_id);
+    job.records.u32(sequence);
+    job.records.u64(log_time);
+    job.records.u64(publish_time);
+    job.records.raw(data, size);
+    job.records.end(record);
+
+    job.index[channel_id].emplace_back(log_time, offset);
+    job.start_time = std::min(job.start_time, log_time);
+    job.end_time = std::max(job.end_time, log_time);
+    start_time_ = std::min(start_time_, log_time);
+    end_time_ = std::max(end_time_, log_time);
+    ++message_count_;
+    if (channel_id >= 1 && channel_id <= channels_.size()) {
+        ++channels_[channel_id - 1].message_count;
+    }
+
+    if (job.records.size() >= options_.chunk_size) {
+        submit();
+    }
+}
+
+/**
+ * Close the open chunk and hand it over for compression.
+ *
+ * Steps:
+ * 1. Wait while the in-flight limit is reached
+ * 2. Queue it for the threads, or compress and write it here without threads
+ */
+void ChunkWriter::submit() {
+    Job* job = open_.get();
+    job->number = next_number_++;
+
+    // Step 1
+    const size_t limit = std::max<size_t>(2 * options_.threads, 1);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (in_flight_.size() >= limit) {
+            auto start = std::chrono::steady_clock::now();
+            changed_.wait(lock, [this, limit] { return in_flight_.size() < limit; });
+            auto waited = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+            if (waited > max_wait_ns_.load(std::memory_order_relaxed)) {
+                max_wait_ns_.store(waited, std::memory_order_relaxed);
+            }
+        }
+        in_flight_[job->number] = std::move(open_);
+        if (!threads_.empty()) {
+            pending_.push_back(job);
+        }
+    }
+
+    // Step 2
+    if (threads_.empty()) {
+        compress(*job);
+        finish(job);
+    } else {
+        changed_.notify_all();
+    }
+}
+
+/**
+ * Compress a chunk's records with the configured codec.
+ *
+ * Like McapWriter, a chunk that does not get smaller is stored
+ * uncompressed (compression "").
+ */
+void ChunkWriter::compress(Job& job) const {
+    const auto& raw = job.records.bytes();
+    size_t size = 0;
+
+    if (options_.compression == Compression::Zstd) {
+        job.compressed.resize(ZSTD_compressBound(raw.size()));
+        size_t result = ZSTD_compressCCtx(zstd_context(), job.compressed.data(), job.compressed.size(),
+                                          raw.data(), raw.size(), options_.compression_level);
+        if (!ZSTD_isError(result)) {
+            size = result;
+            job.compression = "zstd";
+        }
+    } else if (options_.compression == Compression::Lz4) {
+        LZ4F_preferences_t prefs{};
+        prefs.compressionLevel = options_.compression_level;
+        prefs.frameInfo.contentSize = raw.size();
+        job.compressed.resize(LZ4F_compressFrameBound(raw.size(), &prefs));
+        size_t result = LZ4F_compressFrame(job.compressed.data(), job.compressed.size(),
+                                           raw.data(), raw.size(), &prefs);
+        if (!LZ4F_isError(result)) {
+            size = result;
+            job.compression = "lz4";
+        }
+    }
+
+    if (job.compression.empty() || size >= raw.size()) {
+        job.compression.clear();
+        job.compressed.clear();
+        job.compressed.shrink_to_fit();
+    } else {
+        job.compressed.resize(size);
+    }
+}
+
+/**
+ * Compress queued chunks until close().
+ */
+void ChunkWriter::worker_loop() {
+    while (true) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            changed_.wait(lock, [this] { return !pending_.empty() || stopping_; });
+            if (pending_.empty()) {
+                return;
+            }
+            job = pending_.front();
+            pending_.pop_front();
+        }
+        compress(*job);
+        finish(job);
+    }
+}
+
+/**
+ * Mark a chunk compressed and write every chunk that is now next in order.
+ *
+ * A thread that marks its chunk done always takes output_mutex_ and looks
+ * again, so a chunk finished while another thread is writing is never
+ * left behind.
+ */
+void ChunkWriter::finish(Job* job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job->done = true;
+    }
+
+    std::lock_guard<std::mutex> output_lock(output_mutex_);
+    while (true) {
+        Job* next;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = in_flight_.find(next_output_);
+            if (it == in_flight_.end() || !it->second->done) {
+                return;
+            }
+            next = it->second.get();
+        }
+
+        write_chunk(*next);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_flight_.erase(next_output_);
+            ++next_output_;
+        }
+        changed_.notify_all();
+    }
+}
+
+/**
+ * Write a Chunk record followed by one MessageIndex record per channel.
+ *
+ * Called with output_mutex_ held.
+ */
+void ChunkWriter::write_chunk(const Job& job) {
+    const auto& raw = job.records.bytes();
+    const bool compressed = !job.compression.empty();
+    const uint8_t* payload = compressed ? job.compressed.data() : raw.data();
+    const uint64_t payload_size = compressed ? job.compressed.size() : raw.size();
+
+    ChunkIndex entry;
+    entry.start_time = job.start_time;
+    entry.end_time = job.end_time;
+    entry.offset = output_.size();
+    entry.compression = job.compression;
+    entry.compressed_size = payload_size;
+    entry.uncompressed_size = raw.size();
+
+    // Chunk header; the records follow without another copy
+    McapBuffer head;
+    head.u8(static_cast<uint8_t>(McapOp::Chunk));
+    head.u64(8 + 8 + 8 + 4 + 4 + job.compression.size() + 8 + payload_size);
+    head.u64(job.start_time);
+    head.u64(job.end_time);
+    head.u64(raw.size());
+    head.u32(0);  // uncompressed CRC: not computed
+    head.str(job.compression);
+    head.u64(payload_size);
+    emit(head);
+    output_.write(reinterpret_cast<const std::byte*>(payload), payload_size);
+    entry.length = head.size() + payload_size;
+
+    // Message indexes: offsets are into the uncompressed records
+    McapBuffer indexes;
+    uint64_t indexes_start = output_.size();
+    for (const auto& [channel_id, entries] : job.index) {
+        entry.message_index_offsets[channel_id] = indexes_start + indexes.size();
+        size_t record = indexes.begin(McapOp::MessageIndex);
+        indexes.u16(channel_id);
+        write_map_header(indexes, entries.size(), 16);
+        for (const auto& [time, offset] : entries) {
+            indexes.u64(time);
+            indexes.u64(offset);
+        }
+        indexes.end(record);
+    }
+    emit(indexes);
+    entry.message_index_length = indexes.size();
+
+    chunk_indexes_.push_back(std::move(entry));
+    chunks_written_.fetch_add(1);
+}
+
+/**
+ * Write everything after the last chunk.
+ *
+ * Steps:
+ * 1. DataEnd closes the data section
+ * 2. Summary groups: channels, statistics, chunk indexes
+ * 3. One SummaryOffset per group, so readers can jump to e.g. the chunk indexes
+ * 4. Footer pointing at both, and the closing magic
+ */
+void ChunkWriter::write_summary() {
+    McapBuffer buf;
+
+    // Step 1
+    size_t record = buf.begin(McapOp::DataEnd);
+    buf.u32(0);  // data section CRC: not computed
+    buf.end(record);
+
+    // Step 2
+    const uint64_t base = output_.size();
+    const uint64_t summary_start = base + buf.size();
+    struct Group {
+        McapOp op;
+        uint64_t start;
+        uint64_t length;
+    };
+    std::vector<Group> groups;
+
+    uint64_t group_start = buf.size();
+    for (const auto& channel : channels_) {
+        record = buf.begin(McapOp::Channel);
+        buf.u16(channel.id);
+        buf.u16(0);
+        buf.str(channel.topic);
+        buf.str(channel.message_encoding);
+        write_map_header(buf, 0, 0);
+        buf.end(record);
+    }
+    if (!channels_.empty()) {
+        groups.push_back({McapOp::Channel, base + group_start, buf.size() - group_start});
+    }
+
+    group_start = buf.size();
+    record = buf.begin(McapOp::Statistics);
+    buf.u64(message_count_);
+    buf.u16(0);  // schemas
+    buf.u32(static_cast<uint32_t>(channels_.size()));
+    buf.u32(0);  // attachments
+    buf.u32(0);  // metadata
+    buf.u32(static_cast<uint32_t>(chunk_indexes_.size()));
+    buf.u64(message_count_ > 0 ? start_time_ : 0);
+    buf.u64(end_time_);
+    write_map_header(buf, channels_.size(), 2 + 8);
+    for (const auto& channel : channels_) {
+        buf.u16(channel.id);
+        buf.u64(channel.message_count);
+    }
+    buf.end(record);
+    groups.push_back({McapOp::Statistics, base + group_start, buf.size() - group_start});
+
+    group_start = buf.size();
+    for (const auto& index : chunk_indexes_) {
+        record = buf.begin(McapOp::ChunkIndex);
+        buf.u64(index.start_time);
+        buf.u64(index.end_time);
+        buf.u64(index.offset);
+        buf.u64(index.length);
+        write_map_header(buf, index.message_index_offsets.size(), 2 + 8);
+        for (const auto& [channel_id, offset] : index.message_index_offsets) {
+            buf.u16(channel_id);
+            buf.u64(offset);
+        }
+        buf.u64(index.message_index_length);
+        buf.str(index.compression);
+        buf.u64(index.compressed_size);
+        buf.u64(index.uncompressed_size);
+        buf.end(record);
+    }
+    if (!chunk_indexes_.empty()) {
+        groups.push_back({McapOp::ChunkIndex, base + group_start, buf.size() - group_start});
+    }
+
+    // Step 3
+    const uint64_t summary_offset_start = base + buf.size();
+    for (const auto& group : groups) {
+        record = buf.begin(McapOp::SummaryOffset);
+        buf.u8(static_cast<uint8_t>(group.op));
+        buf.u64(group.start);
+        buf.u64(group.length);
+        buf.end(record);
+    }
+
+    // Step 4
+    record = buf.begin(McapOp::Footer);
+    buf.u64(summary_start);
+    buf.u64(summary_offset_start);
+    buf.u32(0);  // summary CRC: not computed
+    buf.end(record);
+    buf.raw(MCAP_MAGIC, sizeof(MCAP_MAGIC));
+
+    emit(buf);
+}
+
+/**
+ * Write the open chunk and wait until nothing is in flight.
+ */
+void ChunkWriter::flush() {
+    if (open_ && open_->records.size() > 0) {
+        submit();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return in_flight_.empty(); });
+}
+
+/**
+ * Finish the file.
+ *
+ * Steps:
+ * 1. Submit the open chunk
+ * 2. Wait until every chunk is written, then stop the threads
+ * 3. Summary, and end the output
+ */
+void ChunkWriter::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    // Step 1
+    if (open_ && open_->records.size() > 0) {
+        submit();
+    }
+
+    // Step 2
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return in_flight_.empty(); });
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+
+    // Step 3
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    write_summary();
+    output_.end();
+}
+
+void ChunkWriter::emit(const McapBuffer& buffer) {
+    output_.write(reinterpret_cast<const std::byte*>(buffer.bytes().data()), buffer.size());
+}
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,164 @@
+/**
+ * @file history_buffer.cpp
+ * @brief History buffer - The last N bytes of a topic, kept for snapshots
+ *
+ * == Layout ==
+ *
+ * Same records as a StagingQueue, in a circular buffer addressed by
+ * monotonic positions (offset = position % capacity):
+ *
+ *   [hdr|payload..][hdr|payload....][wrap][hdr|p]
+ *    ^head (oldest)                             ^tail
+ *
+ * push() needs room for its record (and a wrap filler if the record does
+ * not fit before the end of the buffer). Instead of failing like a
+ * StagingQueue, it advances head past the oldest records until there is.
+ *
+ * == Readers ==
+ *
+ * The producer must never wait for a snapshot being written, so readers
+ * take no lock. The producer publishes the new head before it overwrites
+ * anything; a reader copies a record, then checks that head has not
+ * moved past it:
+ *
+ *   producer: head = new head; release fence; write bytes; tail = ...
+ *   reader:   copy bytes; acquire fence; if head > position: discard
+ *
+ * As with a seqlock, a copy that raced with the producer can be torn, but
+ * it is then always discarded.
+ */
+
+#include "conduit_tank/internal/history_buffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+size_t record_size(size_t payload) {
+    return (sizeof(StagedMessage) + payload + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+}
+
+}  // namespace
+
+HistoryBuffer::HistoryBuffer(size_t capacity)
+    : capacity_(std::max(capacity & ~(STAGING_ALIGNMENT - 1), STAGING_ALIGNMENT)) {
+    buffer_.reset(new uint8_t[capacity_]);  // Not value-initialized: no pages touched
+}
+
+/**
+ * Copy a message in.
+ *
+ * Steps:
+ * 1. Work out the space needed, including a wrap filler
+ * 2. Evict the oldest records until it fits; if the buffer is empty and
+ *    only the filler is in the way, skip the filler too. Publish the new
+ *    head before touching the bytes
+ * 3. Write the filler and the record, then publish the new tail
+ */
+bool HistoryBuffer::push(uint64_t timestamp_ns, uint64_t sequence, const void* data, size_t size,
+                         StagedKind kind) {
+    // Step 1
+    const size_t length = record_size(size);
+    if (length > capacity_) {
+        return false;
+    }
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    size_t offset = tail % capacity_;
+    size_t filler = offset + length > capacity_ ? capacity_ - offset : 0;
+
+    // Step 2
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (tail + filler + length - head > capacity_) {
+        while (tail + filler + length - head > capacity_ && head < tail) {
+            auto* oldest = reinterpret_cast<const StagedMessage*>(buffer_.get() + head % capacity_);
+            head += oldest->wrap ? sizeof(StagedMessage) + oldest->size : record_size(oldest->size);
+        }
+        if (tail + filler + length - head > capacity_) {
+            head = tail + filler;
+        }
+        head_.store(head, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    // Step 3
+    if (filler > 0) {
+        auto* wrap = reinterpret_cast<StagedMessage*>(buffer_.get() + offset);
+        wrap->size = static_cast<uint32_t>(filler - sizeof(StagedMessage));
+        wrap->wrap = 1;
+        tail += filler;
+        offset = 0;
+    }
+    auto* record = reinterpret_cast<StagedMessage*>(buffer_.get() + offset);
+    record->timestamp_ns = timestamp_ns;
+    record->sequence = sequence;
+    record->size = static_cast<uint32_t>(size);
+    record->wrap = 0;
+    record->kind = kind;
+    std::memcpy(record + 1, data, size);
+
+    tail_.store(tail + length, std::memory_order_release);
+    return true;
+}
+
+HistoryRead HistoryBuffer::peek(uint64_t& position, StagedMessage& header) const {
+    while (true) {
+        if (position >= tail_.load(std::memory_order_acquire)) {
+            return HistoryRead::End;
+        }
+        std::memcpy(&header, buffer_.get() + position % capacity_, sizeof(header));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (head_.load(std::memory_order_relaxed) > position) {
+            return HistoryRead::Overwritten;
+        }
+        if (!header.wrap) {
+            return HistoryRead::Ok;
+        }
+        position += sizeof(StagedMessage) + header.size;
+    }
+}
+
+HistoryRead HistoryBuffer::read(uint64_t& position, StagedMessage& header, std::vector<uint8_t>& payload) const {
+    HistoryRead result = peek(position, header);
+    if (result != HistoryRead::Ok) {
+        return result;
+    }
+    payload.resize(header.size);
+    std::memcpy(payload.data(), buffer_.get() + position % capacity_ + sizeof(StagedMessage), header.size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (head_.load(std::memory_order_relaxed) > position) {
+        return HistoryRead::Overwritten;
+    }
+    position += record_size(header.size);
+    return HistoryRead::Ok;
+}
+
+/**
+ * Walk the headers from the oldest record; restart from the new oldest if
+ * the producer evicts the one being looked at.
+ */
+uint64_t HistoryBuffer::seek(uint64_t timestamp_ns) const {
+    uint64_t position = begin();
+    StagedMessage header;
+    while (true) {
+        switch (peek(position, header)) {
+            case HistoryRead::End:
+                return position;
+            case HistoryRead::Overwritten:
+                position = begin();
+                break;
+            case HistoryRead::Ok:
+                if (header.timestamp_ns >= timestamp_ns) {
+                    return position;
+                }
+                position += record_size(header.size);
+                break;
+        }
+    }
+}
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,432 @@
+/**
+ * @file mcap_reader.cpp
+ * @brief MCAP reader - Memory-mapped, indexed access to recorded chunks
+ *
+ * == Why mmap? ==
+ *
+ * Chunks are decompressed straight from the page cache, without a read()
+ * copy into a buffer first, and only the pages of the chunks actually used
+ * are ever read from disk. Playback prefetches the chunks it is about to
+ * need (MADV_WILLNEED); a time-range slice touches only the chunks in its
+ * range.
+ *
+ * == Index ==
+ *
+ *   magic | Header | Channel... | Chunk | MessageIndex... | ... | DataEnd | summary | Footer | magic
+ *                                                                          ^^^^^^^   ^^^^^^
+ *   summary: Channel... Statistics ChunkIndex...        Footer points at the summary start
+ *
+ * A ChunkIndex gives a chunk's time range, position and compression, and
+ * where each channel's MessageIndex record is; a MessageIndex lists
+ * (log time, offset) of that channel's messages inside the decompressed
+ * chunk. With both, finding the messages of one topic in a time range
+ * reads the summary, the few MessageIndex records in range and the chunks
+ * that hold matches, nothing else.
+ *
+ * Without a summary (footer missing or zero), scan() walks the data
+ * section instead: it reads only the prefix of each record (opcode and
+ * length) and the header fields of chunks and message indexes, so it
+ * touches a few pages per chunk. It stops at DataEnd or at the first
+ * record that runs past the end of the file.
+ */
+
+#include "conduit_tank/internal/mcap_reader.hpp"
+#include <conduit_core/exceptions.hpp>
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, madvise
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close, sysconf
+#include <lz4frame.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+/// Footer record: prefix + summary start, summary offset start, CRC.
+constexpr size_t FOOTER_SIZE = MCAP_RECORD_PREFIX + 8 + 8 + 4;
+
+template <typename T>
+T load(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+/// Bounds-checked reads of record fields; every read fails once one has.
+class FieldReader {
+public:
+    FieldReader(const uint8_t* begin, const uint8_t* end) : p_(begin), end_(end) {}
+
+    bool ok() const { return ok_; }
+    const uint8_t* position() const { return p_; }
+
+    template <typename T>
+    T get() {
+        if (!take(sizeof(T))) {
+            return T{};
+        }
+        return load<T>(p_ - sizeof(T));
+    }
+
+    std::string str() {
+        uint32_t length = get<uint32_t>();
+        if (!take(length)) {
+            return {};
+        }
+        return std::string(reinterpret_cast<const char*>(p_ - length), length);
+    }
+
+    bool skip(uint64_t n) { return take(n); }
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+    bool ok_ = true;
+
+    bool take(uint64_t n) {
+        if (!ok_ || static_cast<uint64_t>(end_ - p_) < n) {
+            ok_ = false;
+            return false;
+        }
+        p_ += n;
+        return true;
+    }
+};
+
+bool parse_channel(const uint8_t* content, const uint8_t* end, McapChannel& channel) {
+    FieldReader r(content, end);
+    channel.id = r.get<uint16_t>();
+    r.get<uint16_t>();  // Schema id
+    channel.topic = r.str();
+    channel.message_encoding = r.str();
+    return r.ok();
+}
+
+}  // namespace
+
+/**
+ * Map the file and index it.
+ *
+ * Steps:
+ * 1. Open and map the whole file read-only
+ * 2. Check the magic
+ * 3. Read the summary; walk the data section if there is none
+ */
+McapReader::McapReader(const std::string& path) {
+    // Step 1
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw TankError("Cannot open " + path + ": " + strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd_, &st) < 0) {
+        int error = errno;
+        ::close(fd_);
+        throw TankError("Cannot stat " + path + ": " + strerror(error));
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapped == MAP_FAILED) {
+            int error = errno;
+            ::close(fd_);
+            throw TankError("Cannot map " + path + ": " + strerror(error));
+        }
+        data_ = static_cast<const uint8_t*>(mapped);
+    }
+
+    // Step 2
+    if (size_ < sizeof(MCAP_MAGIC) || std::memcmp(data_, MCAP_MAGIC, sizeof(MCAP_MAGIC)) != 0) {
+        if (data_ != nullptr) {
+            munmap(const_cast<uint8_t*>(data_), size_);
+        }
+        ::close(fd_);
+        throw TankError(path + " is not an MCAP file");
+    }
+
+    // Step 3
+    indexed_ = load_summary();
+    if (!indexed_) {
+        channels_.clear();
+        chunks_.clear();
+        scan();
+    }
+
+    if (!chunks_.empty()) {
+        start_time_ = UINT64_MAX;
+        for (const auto& chunk : chunks_) {
+            start_time_ = std::min(start_time_, chunk.start_time);
+            end_time_ = std::max(end_time_, chunk.end_time);
+        }
+    }
+}
+
+McapReader::~McapReader() {
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+/**
+ * Read channels and chunk indexes from the summary section.
+ *
+ * Returns false if the file has no usable summary.
+ */
+bool McapReader::load_summary() {
+    if (size_ < 2 * sizeof(MCAP_MAGIC) + FOOTER_SIZE ||
+        std::memcmp(data_ + size_ - sizeof(MCAP_MAGIC), MCAP_MAGIC, sizeof(MCAP_MAGIC)) != 0) {
+        return false;
+    }
+    const size_t footer = size_ - sizeof(MCAP_MAGIC) - FOOTER_SIZE;
+    if (static_cast<McapOp>(data_[footer]) != McapOp::Footer) {
+        return false;
+    }
+    const uint64_t summary_start = load<uint64_t>(data_ + footer + MCAP_RECORD_PREFIX);
+    if (summary_start < sizeof(MCAP_MAGIC) || summary_start >= footer) {
+        return false;  // 0: written without a summary
+    }
+
+    size_t pos = summary_start;
+    while (pos < footer) {
+        if (footer - pos < MCAP_RECORD_PREFIX) {
+            return false;
+        }
+        auto op = static_cast<McapOp>(data_[pos]);
+        uint64_t length = load<uint64_t>(data_ + pos + 1);
+        if (length > footer - pos - MCAP_RECORD_PREFIX) {
+            return false;
+        }
+        const uint8_t* content = data_ + pos + MCAP_RECORD_PREFIX;
+        const uint8_t* content_end = content + length;
+
+        if (op == McapOp::Channel) {
+            McapChannel channel;
+            if (!parse_channel(content, content_end, channel)) {
+                return false;
+            }
+            channels_.push_back(std::move(channel));
+        } else if (op == McapOp::ChunkIndex) {
+            FieldReader r(content, content_end);
+            McapChunk chunk;
+            chunk.start_time = r.get<uint64_t>();
+            chunk.end_time = r.get<uint64_t>();
+            chunk.offset = r.get<uint64_t>();
+            chunk.length = r.get<uint64_t>();
+            uint32_t map_size = r.get<uint32_t>();
+            for (uint32_t i = 0; i + 10 <= map_size && r.ok(); i += 10) {
+                uint16_t channel_id = r.get<uint16_t>();
+                chunk.message_indexes[channel_id] = r.get<uint64_t>();
+            }
+            r.get<uint64_t>();  // Message index length
+            chunk.compression = r.str();
+            r.get<uint64_t>();  // Compressed size
+            chunk.uncompressed_size = r.get<uint64_t>();
+            if (!r.ok() || chunk.offset > size_ || chunk.length > size_ - chunk.offset) {
+                return false;
+            }
+            chunks_.push_back(std::move(chunk));
+        }
+        pos += MCAP_RECORD_PREFIX + length;
+    }
+
+    std::sort(chunks_.begin(), chunks_.end(),
+              [](const McapChunk& a, const McapChunk& b) { return a.offset < b.offset; });
+    return true;
+}
+
+/**
+ * Collect channels, chunks and message indexes from the data section.
+ *
+ * Message records outside chunks are gathered into loose chunks spanning
+ * consecutive top-level records; for_each_message() skips whatever else
+ * lies between them.
+ */
+void McapReader::scan() {
+    size_t pos = sizeof(MCAP_MAGIC);
+    bool loose = false;  // Last chunk collects top-level messages and ends at pos
+    bool after_chunk = false;  // MessageIndex records belong to the last chunk
+
+    while (pos + MCAP_RECORD_PREFIX <= size_) {
+        auto op = static_cast<McapOp>(data_[pos]);
+        uint64_t length = load<uint64_t>(data_ + pos + 1);
+        if (length > size_ - pos - MCAP_RECORD_PREFIX) {
+            break;  // Truncated recording
+        }
+        const uint8_t* content = data_ + pos + MCAP_RECORD_PREFIX;
+        const uint8_t* content_end = content + length;
+        size_t next = pos + MCAP_RECORD_PREFIX + length;
+
+        if (op == McapOp::DataEnd || op == McapOp::Footer) {
+            break;
+        }
+
+        if (op == McapOp::Channel) {
+            McapChannel channel;
+            if (parse_channel(content, content_end, channel)) {
+                channels_.push_back(std::move(channel));
+            }
+        } else if (op == McapOp::Chunk) {
+            FieldReader r(content, content_end);
+            McapChunk chunk;
+            chunk.start_time = r.get<uint64_t>();
+            chunk.end_time = r.get<uint64_t>();
+            chunk.uncompressed_size = r.get<uint64_t>();
+            r.get<uint32_t>();  // CRC
+            chunk.compression = r.str();
+            chunk.offset = pos;
+            chunk.length = next - pos;
+            if (r.ok()) {
+                chunks_.push_back(std::move(chunk));
+            }
+            loose = false;
+            after_chunk = r.ok();
+        } else if (op == McapOp::MessageIndex && after_chunk && length >= 2) {
+            chunks_.back().message_indexes[load<uint16_t>(content)] = pos;
+        } else if (op == McapOp::Message && length >= MCAP_MESSAGE_PREFIX) {
+            uint64_t log_time = load<uint64_t>(content + 6);
+            if (!loose) {
+                McapChunk chunk;
+                chunk.start_time = log_time;
+                chunk.end_time = log_time;
+                chunk.offset = pos;
+                chunk.loose = true;
+                chunks_.push_back(std::move(chunk));
+                loose = true;
+            }
+            McapChunk& chunk = chunks_.back();
+            chunk.start_time = std::min(chunk.start_time, log_time);
+            chunk.end_time = std::max(chunk.end_time, log_time);
+        }
+        if (op != McapOp::Chunk && op != McapOp::MessageIndex) {
+            after_chunk = false;
+        }
+
+        if (loose) {
+            McapChunk& chunk = chunks_.back();
+            chunk.length = next - chunk.offset;
+            chunk.uncompressed_size = chunk.length;
+        }
+        pos = next;
+    }
+}
+
+std::pair<const uint8_t*, size_t> McapReader::records(const McapChunk& chunk) const {
+    if (chunk.offset > size_ || chunk.length > size_ - chunk.offset) {
+        throw TankError("Corrupt chunk: outside the file");
+    }
+    const uint8_t* begin = data_ + chunk.offset;
+    if (chunk.loose) {
+        return {begin, chunk.length};
+    }
+
+    FieldReader r(begin, begin + chunk.length);
+    auto op = static_cast<McapOp>(r.get<uint8_t>());
+    r.skip(8 + 8 + 8 + 8 + 4);  // Length, times, uncompressed size, CRC
+    r.str();
+    uint64_t size = r.get<uint64_t>();
+    const uint8_t* records = r.position();
+    if (!r.ok() || op != McapOp::Chunk || !r.skip(size)) {
+        throw TankError("Corrupt chunk record");
+    }
+    return {records, size};
+}
+
+void McapReader::decompress(const McapChunk& chunk, std::vector<uint8_t>& out) const {
+    auto [records, records_size] = this->records(chunk);
+    out.resize(chunk.uncompressed_size);
+
+    if (chunk.compression.empty()) {
+        if (records_size != chunk.uncompressed_size) {
+            throw TankError("Corrupt chunk: size mismatch");
+        }
+        std::memcpy(out.data(), records, records_size);
+    } else if (chunk.compression == "zstd") {
+        size_t result = ZSTD_decompress(out.data(), out.size(), records, records_size);
+        if (ZSTD_isError(result) || result != out.size()) {
+            throw TankError("Corrupt zstd chunk");
+        }
+    } else if (chunk.compression == "lz4") {
+        LZ4F_dctx* ctx = nullptr;
+        if (LZ4F_isError(LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION))) {
+            throw TankError("Cannot create LZ4 context");
+        }
+        size_t produced = 0;
+        size_t consumed = 0;
+        size_t result = 1;
+        while (result != 0 && consumed < records_size && produced < out.size()) {
+            size_t dst = out.size() - produced;
+            size_t src = records_size - consumed;
+            result = LZ4F_decompress(ctx, out.data() + produced, &dst, records + consumed, &src, nullptr);
+            if (LZ4F_isError(result)) {
+                break;
+            }
+            produced += dst;
+            consumed += src;
+        }
+        LZ4F_freeDecompressionContext(ctx);
+        if (LZ4F_isError(result) || produced != out.size()) {
+            throw TankError("Corrupt lz4 chunk");
+        }
+    } else {
+        throw TankError("Unsupported chunk compression: " + chunk.compression);
+    }
+}
+
+bool McapReader::message_index(const McapChunk& chunk, uint16_t channel_id,
+                               std::vector<std::pair<uint64_t, uint64_t>>& entries) const {
+    entries.clear();
+    if (chunk.message_indexes.empty()) {
+        return false;
+    }
+    auto it = chunk.message_indexes.find(channel_id);
+    if (it == chunk.message_indexes.end()) {
+        return true;  // No messages of this channel in the chunk
+    }
+    if (it->second > size_) {
+        throw TankError("Corrupt message index: outside the file");
+    }
+
+    FieldReader r(data_ + it->second, data_ + size_);
+    auto op = static_cast<McapOp>(r.get<uint8_t>());
+    r.get<uint64_t>();  // Length
+    uint16_t id = r.get<uint16_t>();
+    uint32_t bytes = r.get<uint32_t>();
+    if (!r.ok() || op != McapOp::MessageIndex || id != channel_id) {
+        throw TankError("Corrupt message index");
+    }
+    entries.reserve(bytes / 16);
+    for (uint32_t i = 0; i + 16 <= bytes; i += 16) {
+        uint64_t time = r.get<uint64_t>();
+        uint64_t offset = r.get<uint64_t>();
+        entries.emplace_back(time, offset);
+    }
+    if (!r.ok()) {
+        throw TankError("Corrupt message index");
+    }
+    return true;
+}
+
+void McapReader::prefetch(const McapChunk& chunk) const {
+    static const uintptr_t page_mask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+    if (chunk.offset >= size_) {
+        return;
+    }
+    auto begin = reinterpret_cast<uintptr_t>(data_ + chunk.offset) & ~page_mask;
+    auto end = reinterpret_cast<uintptr_t>(data_ + std::min<uint64_t>(chunk.offset + chunk.length, size_));
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+}
+
+}  // namespace internal
+}  // namespace conduit
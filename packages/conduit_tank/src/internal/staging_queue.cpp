@@ -0,0 +1,152 @@
+/**
+ * @file staging_queue.cpp
+ * @brief SPSC staging queue - Decouples topic threads from the file writer
+ *
+ * == Why? ==
+ *
+ * Every recorded topic has its own thread reading its ring. If each thread
+ * wrote to the MCAP file itself they would all queue on one mutex, and a
+ * topic stuck behind a slow write (a chunk being compressed) would be
+ * lapped by its publisher. Instead each thread copies messages into its
+ * own StagingQueue and a single writer thread drains all of them.
+ *
+ * == Layout ==
+ *
+ * A circular byte buffer with monotonic head (consumer) and tail
+ * (producer) counters; offset = counter & mask. Each record is a
+ * StagedMessage header plus payload, padded to 32 bytes:
+ *
+ *   [hdr|payload..][hdr|payload....][hdr|p][wrap]
+ *    ^head                                  ^tail
+ *
+ * A record never wraps. If it does not fit before the end of the buffer
+ * the producer writes a wrap record that fills the rest, and the record
+ * starts at offset 0. Since everything is 32-byte aligned, the space left
+ * at the end always has room for a header. The wrap record is published on
+ * its own, so the record then only needs room at the start of the buffer,
+ * not the filler and the record together.
+ *
+ * Each side caches the other side's counter and only reloads it when the
+ * cached value says the queue is full (producer) or empty (consumer), so
+ * the shared cache lines are touched once per burst, not per message.
+ */
+
+#include "conduit_tank/internal/staging_queue.hpp"
+
+#include <cstring>
+
+namespace conduit {
+namespace internal {
+
+namespace {
+
+size_t round_up_power_of_two(size_t n) {
+    size_t power = STAGING_ALIGNMENT;
+    while (power < n) {
+        power *= 2;
+    }
+    return power;
+}
+
+size_t record_size(size_t payload) {
+    return (sizeof(StagedMessage) + payload + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+}
+
+}  // namespace
+
+StagingQueue::StagingQueue(size_t capacity)
+    : capacity_(round_up_power_of_two(capacity)),
+      mask_(capacity_ - 1) {
+    buffer_ = std::make_unique<uint8_t[]>(capacity_);
+}
+
+/**
+ * Copy a message in.
+ *
+ * Steps:
+ * 1. Reject a message larger than the whole buffer
+ * 2. If it does not fit before the end of the buffer, publish a wrap
+ *    record filling the rest once there is room for it
+ * 3. Check for room against the cached head, reloading it only if short
+ * 4. Write the message and publish the new tail
+ */
+bool StagingQueue::push(uint64_t timestamp_ns, uint64_t sequence, const void* data, size_t size,
+                        StagedKind kind) {
+    // Step 1
+    const size_t length = record_size(size);
+    if (length > capacity_) {
+        return false;
+    }
+
+    // Step 2
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    size_t offset = tail & mask_;
+    if (offset + length > capacity_) {
+        const size_t filler = capacity_ - offset;
+        if (!has_room(tail, filler)) {
+            return false;
+        }
+        auto* wrap = reinterpret_cast<StagedMessage*>(buffer_.get() + offset);
+        wrap->size = static_cast<uint32_t>(filler - sizeof(StagedMessage));
+        wrap->wrap = 1;
+        tail += filler;
+        offset = 0;
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    // Step 3
+    if (!has_room(tail, length)) {
+        return false;
+    }
+
+    // Step 4
+    auto* record = reinterpret_cast<StagedMessage*>(buffer_.get() + offset);
+    record->timestamp_ns = timestamp_ns;
+    record->sequence = sequence;
+    record->size = static_cast<uint32_t>(size);
+    record->wrap = 0;
+    record->kind = kind;
+    std::memcpy(record + 1, data, size);
+
+    tail_.store(tail + length, std::memory_order_release);
+    return true;
+}
+
+bool StagingQueue::has_room(uint64_t tail, size_t length) {
+    if (tail + length - cached_head_ > capacity_) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail + length - cached_head_ > capacity_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const StagedMessage* StagingQueue::front() {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    while (true) {
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return nullptr;
+            }
+        }
+
+        auto* record = reinterpret_cast<const StagedMessage*>(buffer_.get() + (head & mask_));
+        if (!record->wrap) {
+            return record;
+        }
+        // Skip the filler; the producer already counted it in tail_
+        head += sizeof(StagedMessage) + record->size;
+        head_.store(head, std::memory_order_release);
+    }
+}
+
+void StagingQueue::pop() {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    auto* record = reinterpret_cast<const StagedMessage*>(buffer_.get() + (head & mask_));
+    head_.store(head + record_size(record->size), std::memory_order_release);
+}
+
+}  // namespace internal
+}  // namespace conduit
@@ -0,0 +1,353 @@
+/**
+ * @file player.cpp
+ * @brief Player - Replays an MCAP recording as live topics
+ *
+ * == Threads ==
+ *
+ *   decompression thread                playback thread
+ *   ────────────────────                ───────────────
+ *   decompress chunk n+1..n+read_ahead  walk the records of chunk n
+ *   from the mapped file          ──>   wait until each message is due
+ *   into recycled buffers               publish it on its topic
+ *
+ * Decompression is the slow part of reading a recording, so it runs ahead
+ * on its own thread and playback only waits for it when it falls behind.
+ * Buffers go back to the decompression thread once played, so memory is
+ * bounded at read_ahead + 1 uncompressed chunks and nothing is allocated
+ * per chunk after the first few. Uncompressed chunks are played straight
+ * from the mapping; the decompression thread only asks the kernel to read
+ * them in (MADV_WILLNEED).
+ *
+ * == Timing ==
+ *
+ * Message i is due at start + (log_time_i - first_log_time) / rate, on the
+ * steady clock. Deadlines are absolute, so a late message (slow
+ * subscriber, long decompression) does not shift the rest: playback
+ * catches up instead of drifting. The wait is a condition variable wait,
+ * so stop() ends it at once. With rate 0 nothing waits.
+ *
+ * Messages are published in file order, which for Tank recordings is
+ * timestamp order across all topics.
+ */
+
+#include "conduit_tank/player.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
+#include <conduit_core/exceptions.hpp>
+#include <conduit_core/log.hpp>
+#include <conduit_core/publisher.hpp>
+#include <conduit_core/internal/scheduling.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace conduit {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void store_max(std::atomic<uint64_t>& target, uint64_t value) {
+    if (value > target.load(std::memory_order_relaxed)) {
+        target.store(value, std::memory_order_relaxed);
+    }
+}
+
+/// Records of one chunk, ready to play.
+struct ReadyChunk {
+    std::vector<uint8_t> buffer;      ///< Decompressed records; empty if played from the mapping.
+    const uint8_t* records = nullptr;
+    size_t size = 0;
+};
+
+}  // namespace
+
+struct Player::Impl {
+    PlayerOptions options;
+    std::unique_ptr<internal::McapReader> reader;
+    std::map<std::string, std::unique_ptr<internal::Publisher>> publishers;
+    std::vector<internal::Publisher*> channel_publishers;  ///< By channel id; null if not played.
+
+    std::thread decode_thread;
+    std::thread play_thread;
+    std::atomic<bool> running{false};
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<ReadyChunk> ready;             ///< Decompressed chunks, in file order.
+    std::vector<std::vector<uint8_t>> spare;  ///< Played buffers for reuse.
+    bool decoded_all = false;
+    bool stopping = false;
+
+    std::atomic<uint64_t> message_count{0};
+    std::atomic<uint64_t> byte_count{0};
+    std::atomic<uint64_t> failed_count{0};
+    std::atomic<uint64_t> max_lag_ns{0};
+    std::atomic<uint64_t> max_wait_ns{0};
+
+    void decode_loop();
+    void play_loop();
+    bool next_chunk(ReadyChunk& chunk);
+    bool wait_until(Clock::time_point deadline);
+};
+
+/**
+ * Open the recording and create the publishers.
+ *
+ * Steps:
+ * 1. Map and index the file
+ * 2. Pick the channels to play: the requested topics, or all whose names
+ *    are valid topics
+ * 3. Create one publisher per topic; slots grow to fit the messages
+ */
+Player::Player(const std::string& path, const PlayerOptions& options)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->options = options;
+
+    // Step 1
+    impl_->reader = std::make_unique<internal::McapReader>(path);
+
+    // Step 2
+    for (const auto& topic : options.topics) {
+        const auto& channels = impl_->reader->channels();
+        if (std::none_of(channels.begin(), channels.end(),
+                         [&](const internal::McapChannel& c) { return c.topic == topic; })) {
+            throw TankError("Topic not in recording: " + topic);
+        }
+    }
+
+    // Step 3
+    PublisherOptions pub_options;
+    pub_options.depth = options.depth;
+    pub_options.grow = true;
+    for (const auto& channel : impl_->reader->channels()) {
+        bool wanted = options.topics.empty()
+            ? channel.topic.find('/') == std::string::npos
+            : std::find(options.topics.begin(), options.topics.end(), channel.topic) != options.topics.end();
+        if (!wanted || channel.topic.empty()) {
+            continue;
+        }
+
+        auto& publisher = impl_->publishers[channel.topic];
+        if (!publisher) {
+            publisher = std::make_unique<internal::Publisher>(channel.topic, pub_options);
+        }
+        if (impl_->channel_publishers.size() <= channel.id) {
+            impl_->channel_publishers.resize(channel.id + 1, nullptr);
+        }
+        impl_->channel_publishers[channel.id] = publisher.get();
+    }
+}
+
+Player::~Player() {
+    stop();
+}
+
+std::vector<std::string> Player::topics() const {
+    std::vector<std::string> topics;
+    for (const auto& entry : impl_->publishers) {
+        topics.push_back(entry.first);
+    }
+    return topics;
+}
+
+std::chrono::nanoseconds Player::duration() const {
+    return std::chrono::nanoseconds(impl_->reader->end_time() - impl_->reader->start_time());
+}
+
+void Player::start() {
+    if (impl_->running || impl_->play_thread.joinable()) {
+        throw TankError("Already playing");
+    }
+
+    impl_->running = true;
+    impl_->decode_thread = std::thread([this]() {
+        impl_->decode_loop();
+    });
+    impl_->play_thread = std::thread([this]() {
+        impl_->play_loop();
+    });
+}
+
+void Player::stop() {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->changed.notify_all();
+    wait();
+}
+
+bool Player::playing() const {
+    return impl_->running.load();
+}
+
+void Player::wait() {
+    if (impl_->play_thread.joinable()) {
+        impl_->play_thread.join();
+    }
+    // Playback is over: the decompression thread may still be reading ahead
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->changed.notify_all();
+    if (impl_->decode_thread.joinable()) {
+        impl_->decode_thread.join();
+    }
+}
+
+uint64_t Player::message_count() const {
+    return impl_->message_count.load();
+}
+
+PlayerStats Player::stats() const {
+    PlayerStats stats;
+    stats.messages = impl_->message_count.load();
+    stats.bytes = impl_->byte_count.load();
+    stats.failed = impl_->failed_count.load();
+    stats.max_lag = std::chrono::nanoseconds(impl_->max_lag_ns.load());
+    stats.max_decompress_wait = std::chrono::nanoseconds(impl_->max_wait_ns.load());
+    return stats;
+}
+
+/**
+ * Decompress chunks in file order, staying at most read_ahead chunks ahead.
+ */
+void Player::Impl::decode_loop() {
+    internal::apply_thread_options(options.threads);
+
+    const size_t read_ahead = std::max<uint32_t>(options.read_ahead, 1);
+    for (const auto& chunk : reader->chunks()) {
+        ReadyChunk decoded;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return ready.size() < read_ahead || stopping; });
+            if (stopping) {
+                return;
+            }
+            if (!spare.empty() && !chunk.compression.empty()) {
+                decoded.buffer = std::move(spare.back());
+                spare.pop_back();
+            }
+        }
+
+        reader->prefetch(chunk);
+        try {
+            if (chunk.compression.empty()) {
+                std::tie(decoded.records, decoded.size) = reader->records(chunk);
+            } else {
+                reader->decompress(chunk, decoded.buffer);
+                decoded.records = decoded.buffer.data();
+                decoded.size = decoded.buffer.size();
+            }
+        } catch (const TankError& e) {
+            log::error("Playback ends early: {}", e.what());
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(std::move(decoded));
+        }
+        changed.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        decoded_all = true;
+    }
+    changed.notify_all();
+}
+
+/**
+ * Publish every message of every chunk when it is due.
+ */
+void Player::Impl::play_loop() {
+    internal::apply_thread_options(options.threads);
+
+    const bool timed = options.rate > 0;
+    const uint64_t first_time = reader->start_time();
+    const Clock::time_point start = Clock::now();
+
+    ReadyChunk chunk;
+    bool stopped = false;
+    while (!stopped && next_chunk(chunk)) {
+        internal::McapReader::for_each_message(chunk.records, chunk.size, [&](const internal::McapMessage& msg) {
+            if (stopped || msg.channel_id >= channel_publishers.size()) {
+                return;
+            }
+            internal::Publisher* publisher = channel_publishers[msg.channel_id];
+            if (publisher == nullptr) {
+                return;
+            }
+
+            Clock::time_point due;
+            if (timed) {
+                auto offset = std::chrono::duration<double, std::nano>(
+                    static_cast<double>(msg.log_time - std::min(msg.log_time, first_time)) / options.rate);
+                due = start + std::chrono::duration_cast<Clock::duration>(offset);
+                if (Clock::now() < due && !wait_until(due)) {
+                    stopped = true;
+                    return;
+                }
+            }
+
+            if (publisher->publish(msg.data, msg.size)) {
+                message_count.fetch_add(1, std::memory_order_relaxed);
+                byte_count.fetch_add(msg.size, std::memory_order_relaxed);
+            } else {
+                failed_count.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (timed) {
+                auto lag = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - due).count();
+                store_max(max_lag_ns, static_cast<uint64_t>(std::max<int64_t>(lag, 0)));
+            }
+        });
+    }
+
+    running = false;
+}
+
+/**
+ * Move the next decompressed chunk into @p chunk, recycling the old buffer.
+ *
+ * Returns false when everything is played or stop() was called.
+ */
+bool Player::Impl::next_chunk(ReadyChunk& chunk) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (chunk.buffer.capacity() > 0) {
+        spare.push_back(std::move(chunk.buffer));
+        chunk.buffer = std::vector<uint8_t>();
+    }
+
+    auto begin = Clock::now();
+    changed.wait(lock, [&] { return !ready.empty() || decoded_all || stopping; });
+    store_max(max_wait_ns, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count()));
+
+    if (stopping || ready.empty()) {
+        return false;
+    }
+    chunk = std::move(ready.front());
+    ready.pop_front();
+    lock.unlock();
+    changed.notify_all();  // Room for the decompression thread
+    return true;
+}
+
+/**
+ * Sleep until @p deadline; false if stop() was called first.
+ */
+bool Player::Impl::wait_until(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return !changed.wait_until(lock, deadline, [&] { return stopping; });
+}
+
+}  // namespace conduit
@@ -0,0 +1,165 @@
+/**
+ * @file slice.cpp
+ * @brief Slice - Copies a time range of a recording into a new file
+ *
+ * == How ==
+ *
+ *   summary ──> chunk indexes ──> chunks overlapping [start, end]
+ *                                   │ with a wanted channel
+ *                                   v
+ *               message indexes ──> (log time, offset) in range
+ *                                   │ any left?
+ *                                   v
+ *               decompress chunk ──> copy those records ──> ChunkWriter
+ *
+ * Only the summary, the message indexes of candidate chunks and the
+ * chunks that really hold selected messages are read. For a 30 s window of
+ * an hour-long recording that is a handful of chunks, whatever the size
+ * of the file. Offsets are sorted before copying, so messages keep their
+ * order in the file.
+ */
+
+#include "conduit_tank/slice.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
+#include <conduit_core/exceptions.hpp>
+
+#include <sys/stat.h>  // stat
+
+#include <algorithm>
+#include <map>
+
+namespace conduit {
+
+namespace {
+
+/// Bytes per I/O buffer of the output file.
+constexpr size_t OUTPUT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/// Absolute log time @p offset after @p first, saturating.
+uint64_t after(uint64_t first, std::chrono::nanoseconds offset) {
+    if (offset.count() <= 0) {
+        return first;
+    }
+    auto n = static_cast<uint64_t>(offset.count());
+    return n > UINT64_MAX - first ? UINT64_MAX : first + n;
+}
+
+bool same_file(const std::string& a, const std::string& b) {
+    struct stat sa, sb;
+    return stat(a.c_str(), &sa) == 0 && stat(b.c_str(), &sb) == 0 && sa.st_dev == sb.st_dev &&
+           sa.st_ino == sb.st_ino;
+}
+
+}  // namespace
+
+/**
+ * Steps:
+ * 1. Index the input; resolve the topics to channels
+ * 2. Open the output with the same channels
+ * 3. For each chunk in range: select messages through the message index,
+ *    or by walking the chunk if it has none, and copy them
+ * 4. Finish the output (summary and index)
+ */
+SliceStats slice(const std::string& input, const std::string& output, const SliceOptions& options) {
+    SliceStats stats;
+
+    // Step 1
+    if (same_file(input, output)) {
+        throw TankError("Cannot slice " + input + " into itself");
+    }
+    internal::McapReader reader(input);
+    stats.chunks_total = reader.chunks().size();
+    stats.indexed = reader.indexed();
+
+    auto wanted = [&](const std::string& topic) {
+        if (options.topics.empty()) {
+            return true;
+        }
+        return std::any_of(options.topics.begin(), options.topics.end(),
+                           [&](const std::string& t) { return topic == t || topic == t + "/gaps"; });
+    };
+    for (const auto& topic : options.topics) {
+        const auto& channels = reader.channels();
+        if (std::none_of(channels.begin(), channels.end(),
+                         [&](const internal::McapChannel& c) { return c.topic == topic; })) {
+            throw TankError("Topic not in recording: " + topic);
+        }
+    }
+
+    const uint64_t from = after(reader.start_time(), options.start);
+    const uint64_t to = options.end == std::chrono::nanoseconds::max()
+        ? UINT64_MAX : after(reader.start_time(), options.end);
+
+    // Step 2
+    internal::ChunkWriterOptions writer_options;
+    writer_options.compression = options.compression;
+    writer_options.compression_level = options.compression_level;
+    internal::AsyncFileWriter file(output, OUTPUT_BUFFER_SIZE, 2, true);
+    internal::ChunkWriter writer(file, writer_options);
+
+    std::map<uint16_t, uint16_t> channel_map;  // Input id -> output id
+    for (const auto& channel : reader.channels()) {
+        if (wanted(channel.topic) && channel_map.count(channel.id) == 0) {
+            channel_map[channel.id] = writer.add_channel(channel.topic, channel.message_encoding);
+        }
+    }
+
+    // Step 3
+    std::vector<uint8_t> records;
+    std::vector<std::pair<uint64_t, uint64_t>> entries;
+    std::vector<uint64_t> offsets;
+    for (const auto& chunk : reader.chunks()) {
+        if (chunk.end_time < from || chunk.start_time > to) {
+            continue;
+        }
+
+        if (!chunk.message_indexes.empty()) {
+            offsets.clear();
+            for (const auto& [input_id, output_id] : channel_map) {
+                reader.message_index(chunk, input_id, entries);
+                for (const auto& [time, offset] : entries) {
+                    if (time >= from && time <= to) {
+                        offsets.push_back(offset);
+                    }
+                }
+            }
+            if (offsets.empty()) {
+                continue;
+            }
+            std::sort(offsets.begin(), offsets.end());
+
+            reader.decompress(chunk, records);
+            ++stats.chunks_read;
+            for (uint64_t offset : offsets) {
+                internal::McapMessage msg;
+                if (!internal::McapReader::message_at(records.data(), records.size(), offset, msg)) {
+                    throw TankError("Corrupt message index in " + input);
+                }
+                writer.write(channel_map[msg.channel_id], msg.sequence, msg.log_time, msg.publish_time, msg.data,
+                             msg.size);
+                ++stats.messages;
+            }
+            continue;
+        }
+
+        // No index: look at every message
+        reader.decompress(chunk, records);
+        ++stats.chunks_read;
+        internal::McapReader::for_each_message(records.data(), records.size(), [&](const internal::McapMessage& msg) {
+            auto it = channel_map.find(msg.channel_id);
+            if (it == channel_map.end() || msg.log_time < from || msg.log_time > to) {
+                return;
+            }
+            writer.write(it->second, msg.sequence, msg.log_time, msg.publish_time, msg.data, msg.size);
+            ++stats.messages;
+        });
+    }
+
+    // Step 4
+    writer.close();
+    return stats;
+}
+
+}  // namespace conduit
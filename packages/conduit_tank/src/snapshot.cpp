@@ -0,0 +1,569 @@
+/**
+ * @file snapshot.cpp
+ * @brief Snapshot - Writes the seconds around a trigger to MCAP
+ *
+ * == Threads ==
+ *
+ *   topic thread (one per topic)       writer thread (one)
+ *   ────────────────────────────       ───────────────────
+ *   sleep on the ring's futex          sleep until triggered
+ *   copy every available message       wait for the post-trigger time
+ *   into its HistoryBuffer,            merge the windows of all histories
+ *   evicting the oldest                into a new MCAP file
+ *
+ *   trigger thread (if trigger_topic)
+ *   sleep on the trigger ring's futex; each message calls trigger()
+ *
+ * == Idle path ==
+ *
+ * Until something is triggered the topic threads do what Tank's do, minus
+ * waking a writer: one batch of copies per wakeup and counters published
+ * once per batch. The writer and trigger threads sleep on a condition
+ * variable and a futex. The history memory is allocated untouched, so an
+ * idle topic costs no resident memory beyond what it has filled.
+ *
+ * == Windows ==
+ *
+ * A trigger at t asks for [t - pre_trigger, t + post_trigger]. The writer
+ * waits until t + post_trigger (plus SETTLE_TIME for the last messages to
+ * reach the histories), then takes the window; triggers arriving while it
+ * waits only move its end. The histories keep filling while the file is
+ * written. The producer never waits for the writer, so a message of the
+ * window can be evicted before it was copied; the writer then continues
+ * from the oldest message left and marks the loss with a gap marker, as
+ * Tank does. A history that holds pre + post trigger with some margin
+ * never gets there.
+ */
+
+#include "conduit_tank/snapshot.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include "conduit_tank/internal/history_buffer.hpp"
+#include "conduit_tank/internal/numbered_path.hpp"
+#include <conduit_core/subscriber.hpp>
+#include <conduit_core/exceptions.hpp>
+#include <conduit_core/log.hpp>
+#include <conduit_core/internal/futex.hpp>
+#include <conduit_core/internal/scheduling.hpp>
+#include <conduit_core/internal/time.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace conduit {
+
+namespace {
+
+/// Most messages a topic thread copies before publishing its counters.
+constexpr size_t MAX_BATCH = 256;
+
+/// How long after the end of a window the writer waits for its last
+/// messages to travel from the rings into the histories.
+constexpr std::chrono::milliseconds SETTLE_TIME{20};
+
+/// Smallest history a topic can get.
+constexpr size_t MIN_HISTORY_SIZE = 64 * 1024;
+
+/// Bytes per I/O buffer of a snapshot file.
+constexpr size_t OUTPUT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/// Appended to a topic name for its gap marker channel.
+constexpr const char* GAP_CHANNEL_SUFFIX = "/gaps";
+
+int gap_marker(char (&marker)[64], uint64_t first, uint64_t count) {
+    return std::snprintf(marker, sizeof(marker), "{\"first_sequence\":%llu,\"count\":%llu}",
+                         static_cast<unsigned long long>(first), static_cast<unsigned long long>(count));
+}
+
+}  // namespace
+
+struct HistoryTopic {
+    std::string topic;
+    size_t history_size = 0;  ///< Requested; 0 = share of the budget.
+    std::unique_ptr<internal::Subscriber> subscriber;
+    std::unique_ptr<internal::HistoryBuffer> history;
+    std::thread thread;
+    /// Lost messages not yet marked in the history (topic thread).
+    uint64_t gap_first = 0;
+    uint64_t gap_count = 0;
+    std::atomic<uint64_t> newest_ns{0};  ///< Timestamp of the newest message in the history.
+
+    // Writing a snapshot (writer thread)
+    uint64_t position = 0;
+    bool has_next = false;
+    internal::StagedMessage next;
+    std::vector<uint8_t> payload;
+    bool overwritten = false;  ///< Continued from the oldest message after an eviction.
+    std::optional<uint64_t> last_sequence;
+    uint16_t channel_id = 0;
+    uint16_t gap_channel_id = 0;
+};
+
+/// Time range of a pending snapshot (absolute timestamps).
+struct SnapshotWindow {
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+struct Snapshot::Impl {
+    std::string output_path;
+    SnapshotOptions options;
+    std::vector<std::unique_ptr<HistoryTopic>> topics;
+    std::unique_ptr<internal::Subscriber> trigger_subscriber;
+    std::atomic<bool> running{false};
+    std::atomic<uint32_t> stop_word{0};  ///< Bumped by stop() to wake topic threads.
+    std::thread trigger_thread;
+    std::thread writer_thread;
+
+    std::mutex mutex;  ///< Guards pending, stopping and last_path.
+    std::condition_variable changed;
+    std::optional<SnapshotWindow> pending;
+    bool stopping = false;
+    std::string last_path;
+
+    std::atomic<uint64_t> snapshot_count{0};
+    std::atomic<uint64_t> trigger_count{0};
+    std::atomic<uint64_t> message_count{0};
+    std::atomic<uint64_t> dropped_count{0};
+    std::atomic<uint64_t> overwritten_count{0};
+
+    void trigger(uint64_t timestamp_ns);
+    void history_loop(HistoryTopic* ht);
+    void history_batch(HistoryTopic* ht, const Message& first, uint64_t& expected);
+    void trigger_loop();
+    void write_loop();
+    void write_snapshot(const SnapshotWindow& window);
+    void advance(HistoryTopic* ht, const SnapshotWindow& window);
+};
+
+Snapshot::Snapshot(const std::string& output_path, const SnapshotOptions& options)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->output_path = output_path;
+    impl_->options = options;
+}
+
+Snapshot::~Snapshot() {
+    if (impl_->running) {
+        stop();
+    }
+}
+
+void Snapshot::add_topic(const std::string& topic, size_t history_size) {
+    if (impl_->running) {
+        throw TankError("Cannot add topic while running");
+    }
+
+    auto ht = std::make_unique<HistoryTopic>();
+    ht->topic = topic;
+    ht->history_size = history_size;
+    impl_->topics.push_back(std::move(ht));
+}
+
+/**
+ * Steps:
+ * 1. Size the histories: explicit sizes first, the rest of the budget
+ *    split among the other topics
+ * 2. Subscribe to every topic and the trigger topic
+ * 3. Start the threads
+ */
+void Snapshot::start() {
+    if (impl_->running) {
+        throw TankError("Already running");
+    }
+
+    // Step 1
+    size_t fixed = 0;
+    size_t shared = 0;
+    for (const auto& ht : impl_->topics) {
+        fixed += ht->history_size;
+        shared += ht->history_size == 0 ? 1 : 0;
+    }
+    if (fixed > impl_->options.memory_budget) {
+        throw TankError("Topic history sizes exceed the memory budget");
+    }
+    const size_t share = shared > 0 ? (impl_->options.memory_budget - fixed) / shared : 0;
+    if (shared > 0 && share < MIN_HISTORY_SIZE) {
+        throw TankError("Memory budget too small for " + std::to_string(impl_->topics.size()) + " topics");
+    }
+
+    // Step 2
+    for (auto& ht : impl_->topics) {
+        ht->subscriber = std::make_unique<internal::Subscriber>(ht->topic);
+        ht->history = std::make_unique<internal::HistoryBuffer>(ht->history_size > 0 ? ht->history_size : share);
+    }
+    if (!impl_->options.trigger_topic.empty()) {
+        impl_->trigger_subscriber = std::make_unique<internal::Subscriber>(impl_->options.trigger_topic);
+    }
+
+    // Step 3
+    impl_->running = true;
+    impl_->stopping = false;
+    impl_->writer_thread = std::thread([this]() {
+        impl_->write_loop();
+    });
+    if (impl_->trigger_subscriber) {
+        impl_->trigger_thread = std::thread([this]() {
+            impl_->trigger_loop();
+        });
+    }
+    for (auto& ht : impl_->topics) {
+        ht->thread = std::thread([this, ht_ptr = ht.get()]() {
+            impl_->history_loop(ht_ptr);
+        });
+    }
+}
+
+void Snapshot::stop() {
+    if (!impl_->running) {
+        return;
+    }
+
+    impl_->running = false;
+    impl_->stop_word.fetch_add(1);
+    internal::futex_wake_all(&impl_->stop_word);
+    for (auto& ht : impl_->topics) {
+        if (ht->thread.joinable()) {
+            ht->thread.join();
+        }
+    }
+    if (impl_->trigger_thread.joinable()) {
+        impl_->trigger_thread.join();
+    }
+
+    // The writer writes a pending snapshot right away, then exits
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->changed.notify_all();
+    if (impl_->writer_thread.joinable()) {
+        impl_->writer_thread.join();
+    }
+}
+
+bool Snapshot::running() const {
+    return impl_->running.load();
+}
+
+void Snapshot::trigger() {
+    impl_->trigger(internal::get_timestamp_ns());
+}
+
+void Snapshot::trigger(uint64_t timestamp_ns) {
+    impl_->trigger(timestamp_ns);
+}
+
+uint64_t Snapshot::snapshot_count() const {
+    return impl_->snapshot_count.load();
+}
+
+std::string Snapshot::last_snapshot() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->last_path;
+}
+
+SnapshotStats Snapshot::stats() const {
+    SnapshotStats stats;
+    stats.snapshots = impl_->snapshot_count.load();
+    stats.triggers = impl_->trigger_count.load();
+    stats.messages = impl_->message_count.load();
+    stats.dropped = impl_->dropped_count.load();
+    stats.overwritten = impl_->overwritten_count.load();
+
+    for (const auto& ht : impl_->topics) {
+        if (!ht->history) {
+            continue;
+        }
+        uint64_t begin = ht->history->begin();
+        stats.buffered_bytes += ht->history->end() - begin;
+
+        // Full once something was evicted
+        internal::StagedMessage oldest;
+        if (begin > 0 && ht->history->peek(begin, oldest) == internal::HistoryRead::Ok) {
+            uint64_t newest = ht->newest_ns.load(std::memory_order_relaxed);
+            auto span = std::chrono::nanoseconds(newest > oldest.timestamp_ns ? newest - oldest.timestamp_ns : 0);
+            if (stats.history.count() == 0 || span < stats.history) {
+                stats.history = span;
+            }
+        }
+    }
+    return stats;
+}
+
+/**
+ * Open a window around @p timestamp_ns, or extend the pending one.
+ */
+void Snapshot::Impl::trigger(uint64_t timestamp_ns) {
+    trigger_count.fetch_add(1, std::memory_order_relaxed);
+    const auto pre = static_cast<uint64_t>(options.pre_trigger.count());
+    const auto post = static_cast<uint64_t>(options.post_trigger.count());
+    uint64_t end_ns = timestamp_ns + post;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending) {
+            pending->end_ns = std::max(pending->end_ns, end_ns);
+        } else {
+            pending = SnapshotWindow{timestamp_ns > pre ? timestamp_ns - pre : 0, end_ns};
+        }
+    }
+    changed.notify_all();
+}
+
+/**
+ * Copy messages from one topic's ring into its history.
+ *
+ * Same wait as Tank::Impl::record_loop(): the topic's futex word and the
+ * stop word at once.
+ */
+void Snapshot::Impl::history_loop(HistoryTopic* ht) {
+    internal::apply_thread_options(options.threads);
+
+    bool first = true;
+    uint64_t expected = 0;
+    while (running) {
+        uint32_t stop_seen = stop_word.load();
+        std::atomic<uint32_t>* word = ht->subscriber->futex_word();
+        uint32_t seen = word->load(std::memory_order_acquire);
+
+        auto msg = ht->subscriber->take();
+        if (!msg.has_value()) {
+            // The word moves when the topic is resized; look again before sleeping on it
+            if (ht->subscriber->futex_word() == word && running) {
+                internal::FutexWaitEntry entries[] = {{word, seen}, {&stop_word, stop_seen}};
+                internal::futex_wait_any(entries, 2);
+            }
+            continue;
+        }
+
+        if (first) {
+            expected = msg->sequence;
+            first = false;
+        }
+        history_batch(ht, *msg, expected);
+    }
+}
+
+/**
+ * Copy @p first and everything else available, up to MAX_BATCH messages.
+ *
+ * A message the publisher lapped before we read it is marked with a gap
+ * marker ahead of the next one, as in Tank. A message larger than the whole
+ * history cannot be kept and counts as dropped.
+ */
+void Snapshot::Impl::history_batch(HistoryTopic* ht, const Message& first, uint64_t& expected) {
+    uint64_t dropped = 0;
+    uint64_t newest_ns = 0;
+    size_t count = 0;
+    std::optional<Message> msg = first;
+    do {
+        if (msg->sequence > expected) {
+            uint64_t lost = msg->sequence - expected;
+            if (ht->gap_count == 0) {
+                ht->gap_first = expected;
+            }
+            ht->gap_count += lost;
+            dropped += lost;
+        }
+        expected = msg->sequence + 1;
+
+        if (ht->gap_count > 0) {
+            char marker[64];
+            int length = gap_marker(marker, ht->gap_first, ht->gap_count);
+            ht->history->push(msg->timestamp_ns, ht->gap_first, marker, static_cast<size_t>(length),
+                              internal::StagedKind::Gap);
+            ht->gap_count = 0;
+        }
+        if (ht->history->push(msg->timestamp_ns, msg->sequence, msg->data, msg->size)) {
+            newest_ns = msg->timestamp_ns;
+        } else {
+            ht->gap_first = msg->sequence;
+            ht->gap_count = 1;
+            ++dropped;
+        }
+    } while (++count < MAX_BATCH && (msg = ht->subscriber->take()).has_value());
+
+    if (dropped > 0) {
+        dropped_count.fetch_add(dropped, std::memory_order_relaxed);
+    }
+    if (newest_ns != 0) {
+        ht->newest_ns.store(newest_ns, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Trigger on every message of the trigger topic.
+ */
+void Snapshot::Impl::trigger_loop() {
+    internal::apply_thread_options(options.threads);
+
+    while (running) {
+        uint32_t stop_seen = stop_word.load();
+        std::atomic<uint32_t>* word = trigger_subscriber->futex_word();
+        uint32_t seen = word->load(std::memory_order_acquire);
+
+        auto msg = trigger_subscriber->take();
+        if (!msg.has_value()) {
+            if (trigger_subscriber->futex_word() == word && running) {
+                internal::FutexWaitEntry entries[] = {{word, seen}, {&stop_word, stop_seen}};
+                internal::futex_wait_any(entries, 2);
+            }
+            continue;
+        }
+        trigger(msg->timestamp_ns);
+    }
+}
+
+/**
+ * Write each window once its end (plus SETTLE_TIME) has passed; on stop(),
+ * write a pending window right away.
+ */
+void Snapshot::Impl::write_loop() {
+    internal::apply_thread_options(options.threads);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this] { return pending.has_value() || stopping; });
+        if (!pending) {
+            return;
+        }
+
+        while (!stopping) {
+            uint64_t due = pending->end_ns + static_cast<uint64_t>(std::chrono::nanoseconds(SETTLE_TIME).count());
+            uint64_t now = internal::get_timestamp_ns();
+            if (now >= due) {
+                break;
+            }
+            changed.wait_for(lock, std::chrono::nanoseconds(due - now));
+        }
+
+        SnapshotWindow window = *pending;
+        pending.reset();
+        lock.unlock();
+        try {
+            write_snapshot(window);
+        } catch (const TankError& e) {
+            log::error("Snapshot not written: {}", e.what());
+        }
+        lock.lock();
+    }
+}
+
+/**
+ * Write one window to the next numbered file.
+ *
+ * Steps:
+ * 1. Open the file with every topic's channel
+ * 2. Find each history's first message in the window
+ * 3. Write the messages of all histories merged by timestamp, oldest first;
+ *    mark messages evicted before they were copied as a gap
+ * 4. Finish the file
+ */
+void Snapshot::Impl::write_snapshot(const SnapshotWindow& window) {
+    // Step 1
+    std::string path = internal::numbered_path(output_path, static_cast<uint32_t>(snapshot_count.load()));
+    internal::ChunkWriterOptions writer_options;
+    writer_options.compression = options.compression;
+    writer_options.compression_level = options.compression_level;
+    writer_options.threads = options.compression_threads;
+    internal::AsyncFileWriter file(path, OUTPUT_BUFFER_SIZE, 2, true);
+    internal::ChunkWriter writer(file, writer_options);
+    for (auto& ht : topics) {
+        ht->channel_id = writer.add_channel(ht->topic);
+        ht->gap_channel_id = 0;
+    }
+
+    // Step 2
+    for (auto& ht : topics) {
+        ht->position = ht->history->seek(window.start_ns);
+        ht->overwritten = false;
+        ht->last_sequence.reset();
+        advance(ht.get(), window);
+    }
+
+    // Step 3
+    uint64_t count = 0;
+    while (true) {
+        HistoryTopic* oldest = nullptr;
+        for (auto& ht : topics) {
+            if (ht->has_next && (oldest == nullptr || ht->next.timestamp_ns < oldest->next.timestamp_ns)) {
+                oldest = ht.get();
+            }
+        }
+        if (oldest == nullptr) {
+            break;
+        }
+
+        const internal::StagedMessage& msg = oldest->next;
+        bool gap = msg.kind == internal::StagedKind::Gap;
+        if (oldest->overwritten && !gap && oldest->last_sequence && msg.sequence > *oldest->last_sequence + 1) {
+            uint64_t lost = msg.sequence - *oldest->last_sequence - 1;
+            overwritten_count.fetch_add(lost, std::memory_order_relaxed);
+            char marker[64];
+            int length = gap_marker(marker, *oldest->last_sequence + 1, lost);
+            if (oldest->gap_channel_id == 0) {
+                oldest->gap_channel_id = writer.add_channel(oldest->topic + GAP_CHANNEL_SUFFIX, "json");
+            }
+            writer.write(oldest->gap_channel_id, static_cast<uint32_t>(*oldest->last_sequence + 1),
+                         msg.timestamp_ns, msg.timestamp_ns, marker, static_cast<size_t>(length));
+        }
+        oldest->overwritten = false;
+
+        uint16_t channel_id = oldest->channel_id;
+        if (gap) {
+            if (oldest->gap_channel_id == 0) {
+                oldest->gap_channel_id = writer.add_channel(oldest->topic + GAP_CHANNEL_SUFFIX, "json");
+            }
+            channel_id = oldest->gap_channel_id;
+        } else {
+            oldest->last_sequence = msg.sequence;
+            ++count;
+        }
+        writer.write(channel_id, static_cast<uint32_t>(msg.sequence), msg.timestamp_ns, msg.timestamp_ns,
+                     oldest->payload.data(), msg.size);
+        advance(oldest, window);
+    }
+
+    // Step 4
+    writer.close();
+    message_count.fetch_add(count, std::memory_order_relaxed);
+    snapshot_count.fetch_add(1);
+    std::lock_guard<std::mutex> lock(mutex);
+    last_path = path;
+}
+
+/**
+ * Copy a history's next message of the window into ht->next/payload.
+ *
+ * A message evicted while we get to it sends us to the oldest message
+ * left; the gap shows in the sequence numbers.
+ */
+void Snapshot::Impl::advance(HistoryTopic* ht, const SnapshotWindow& window) {
+    ht->has_next = false;
+    while (true) {
+        switch (ht->history->read(ht->position, ht->next, ht->payload)) {
+            case internal::HistoryRead::End:
+                return;
+            case internal::HistoryRead::Overwritten:
+                ht->position = ht->history->begin();
+                ht->overwritten = true;
+                continue;
+            case internal::HistoryRead::Ok:
+                break;
+        }
+        if (ht->next.timestamp_ns > window.end_ns) {
+            return;
+        }
+        if (ht->next.timestamp_ns >= window.start_ns) {
+            ht->has_next = true;
+            return;
+        }
+    }
+}
+
+}  // namespace conduit
@@ -1,40 +1,216 @@
-#include "conduit_tank/tank.hpp"
-#include <conduit_core/subscriber.hpp>
-#include <conduit_core/exceptions.hpp>
+/**
+ * @file tank.cpp
+ * @brief Tank - Records topics into an MCAP file
+ *
+ * == Threads ==
+ *
+ *   topic thread (one per topic)        writer thread (one)
+ *   ────────────────────────────        ───────────────────
+ *   sleep on the ring's futex           pick the oldest head of all queues
+ *   copy every available message  ──>   append it to the open chunk
+ *   into its StagingQueue               pop it, repeat
+ *
+ * Topic threads never block on the file: they only copy into their own
+ * queue. If the writer falls behind and a queue is full, the message is
+ * dropped and counted. Messages the topic thread missed because the
+ * publisher lapped the ring (sequence gaps) are counted as dropped too.
+ *
+ * The writer always takes the oldest message at the head of any queue, so
+ * messages staged together are written in timestamp order.
+ *
+ * == Batches ==
+ *
+ * At 10 kHz the per-message overhead is mostly shared counters and wakeups,
+ * not copying. Both sides therefore work in batches of up to MAX_BATCH: a
+ * topic thread drains everything published since it woke, then updates
+ * the drop and latency counters and bumps data_word once; the writer
+ * writes a batch and adds it to message_count in one step.
+ *
+ * == Waking the writer ==
+ *
+ * The writer sleeps on a futex when every queue is empty. Topic threads
+ * only make the wake syscall when the writer has announced it is going to
+ * sleep:
+ *
+ *   writer: sleeping = true; check queues again; futex_wait(data_word)
+ *   topic:  push batch; data_word++; if (sleeping) futex_wake(data_word)
+ *
+ * Both sides use sequentially consistent operations, so either the writer
+ * sees the message on its second check or the topic thread sees sleeping.
+ *
+ * == Gaps ==
+ *
+ * A loss is recorded, not only counted: the topic thread remembers the
+ * lost sequence range and stages a gap marker ahead of the next message
+ * it stages. The writer puts markers on a "<topic>/gaps" channel, created
+ * on the first one, so a reader sees exactly where the topic has holes.
+ * Topic names cannot contain '/', so the channel never collides.
+ *
+ * == Lossless ==
+ *
+ * With TankOptions::lossless both places that drop stop dropping:
+ *
+ *   ring    the subscriber is reliable: the publisher waits (up to
+ *           block_timeout) before overwriting a message it has not read
+ *   queue   a topic thread that finds its queue full sleeps on space_word
+ *           until the writer has popped something
+ *
+ * The writer bumps space_word after a batch only while topics_waiting is
+ * non-zero, with the same announce-then-check pattern as data_word. Back-
+ * pressure thus reaches the publisher only when the disk cannot keep up.
+ * A publisher that hits block_timeout still laps the recorder; that loss
+ * shows up as a gap.
+ *
+ * == Disk ==
+ *
+ * The writer thread only appends messages to the open chunk. Full chunks
+ * are compressed by the ChunkWriter's threads and handed, in order, to an
+ * AsyncFileWriter, whose own thread writes them to disk (O_DIRECT where
+ * possible). A disk stall delays only that thread until its buffers run
+ * out.
+ *
+ * == Splitting ==
+ *
+ * Before writing a message the writer checks split_size/split_duration.
+ * When due it opens the next file, adds every channel and swaps it in;
+ * the message goes to the new file. Meanwhile the topic threads keep
+ * staging, so nothing is dropped at the split. Finishing the old file
+ * (last chunk, summary, sync) is left to a closer thread:
+ *
+ *   writer   ... msg n | open next, swap | msg n+1 ...
+ *   closer               close previous: last chunk, summary, fdatasync
+ *                        delete the oldest files beyond max_files
+ *
+ * Only one closer runs; a split that comes before it finished waits for
+ * it. A gap marker is never separated from the message after it.
+ *
+ * == Flushing ==
+ *
+ * A chunk reaches the disk only when it is full. At a low data rate that
+ * can take minutes, all of which a crash would lose. Every flush_interval
+ * the writer therefore cuts the open chunk and hands the partial I/O
+ * buffer over (ChunkWriter::flush(), AsyncFileWriter::flush()). The file
+ * then has a complete data section; only the summary is missing, and
+ * McapReader rebuilds the index by scanning.
+ */
 
+// The MCAP implementation (mcap::IWritable) is compiled here; define it
+// before anything else includes the mcap headers
 #define MCAP_IMPLEMENTATION
 #include <mcap/writer.hpp>
 
+#include "conduit_tank/tank.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include "conduit_tank/internal/numbered_path.hpp"
+#include "conduit_tank/internal/staging_queue.hpp"
+#include <conduit_core/subscriber.hpp>
+#include <conduit_core/exceptions.hpp>
+#include <conduit_core/log.hpp>
+#include <conduit_core/internal/futex.hpp>
+#include <conduit_core/internal/scheduling.hpp>
+#include <conduit_core/internal/time.hpp>
+
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <deque>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace conduit {
 
+namespace {
+
+/// Most messages a thread handles before publishing its counters. Bounds
+/// how long the writer goes without a wakeup while a topic thread drains a
+/// long backlog.
+constexpr size_t MAX_BATCH = 256;
+
+/// Appended to a topic name for its gap marker channel.
+constexpr const char* GAP_CHANNEL_SUFFIX = "/gaps";
+
+void store_max(std::atomic<uint64_t>& target, uint64_t value) {
+    if (value > target.load(std::memory_order_relaxed)) {
+        target.store(value, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace
+
 struct TopicRecorder {
     std::string topic;
     std::unique_ptr<internal::Subscriber> subscriber;
+    std::unique_ptr<internal::StagingQueue> staging;
     std::thread thread;
-    mcap::ChannelId channel_id;
+    uint16_t channel_id = 0;
+    uint16_t gap_channel_id = 0;  ///< 0 until the first gap marker (writer thread).
+    /// Lost messages not yet marked in the file (topic thread).
+    uint64_t gap_first = 0;
+    uint64_t gap_count = 0;
+    /// Longest time from publish until a message was staged (written by the topic thread).
+    std::atomic<uint64_t> max_latency_ns{0};
 };
 
 struct Tank::Impl {
     std::string output_path;
+    TankOptions options;
     std::vector<std::unique_ptr<TopicRecorder>> topic_recorders;
     std::atomic<bool> running{false};
     std::atomic<uint64_t> message_count{0};
+    std::atomic<uint64_t> dropped_count{0};
+    std::atomic<uint64_t> gap_count{0};
+
+    internal::ChunkWriterOptions writer_options;
+    std::mutex file_mutex;  ///< Held while swapping file and writer (stats() reads them).
+    std::unique_ptr<internal::AsyncFileWriter> file;
+    std::unique_ptr<internal::ChunkWriter> writer;  ///< Writes into file.
+    std::thread writer_thread;
 
-    mcap::McapWriter writer;
-    std::mutex write_mutex;
+    // Splitting (writer thread, except where noted)
+    bool splitting = false;
+    uint32_t file_index = 0;
+    uint64_t file_start_ns = 0;   ///< Time of the first message in the file; 0 before it.
+    bool after_gap = false;       ///< Last record written was a gap marker.
+    std::thread closer;           ///< Finishes the previous file.
+    std::mutex files_mutex;
+    std::deque<std::string> files;  ///< Split files on disk, oldest first (writer and closer).
+    std::atomic<uint32_t> file_count{0};
+    std::atomic<uint64_t> closed_bytes{0};  ///< Bytes of finished files.
+    std::atomic<uint64_t> closed_io_wait_ns{0};
+    std::atomic<uint64_t> closed_compression_wait_ns{0};
+    std::atomic<bool> writing{false};
+    std::atomic<uint32_t> data_word{0};   ///< Bumped after every batch of pushes.
+    std::atomic<uint32_t> stop_word{0};   ///< Bumped by stop() to wake topic threads.
+    std::atomic<bool> writer_sleeping{false};
+    std::atomic<uint32_t> space_word{0};  ///< Bumped after a batch while topics wait for room.
+    std::atomic<uint32_t> topics_waiting{0};
 
     void record_loop(TopicRecorder* tr);
+    size_t record_batch(TopicRecorder* tr, const Message& first, uint64_t& expected);
+    bool stage(TopicRecorder* tr, const Message& msg);
+    bool push(TopicRecorder* tr, uint64_t timestamp_ns, uint64_t sequence, const void* data, size_t size,
+              internal::StagedKind kind);
+    void wake_writer();
+    void write_loop();
+    size_t write_batch();
+    void open_file(uint32_t index, std::unique_ptr<internal::AsyncFileWriter>& next_file,
+                   std::unique_ptr<internal::ChunkWriter>& next_writer);
+    bool split_due(uint64_t timestamp_ns) const;
+    void rotate();
+    void close_file(std::unique_ptr<internal::ChunkWriter> old_writer,
+                    std::unique_ptr<internal::AsyncFileWriter> old_file);
+    void remove_old_files();
+    void flush();
 };
 
-Tank::Tank(const std::string& output_path)
+Tank::Tank(const std::string& output_path, const TankOptions& options)
     : impl_(std::make_unique<Impl>()) {
     impl_->output_path = output_path;
+    impl_->options = options;
 }
 
 Tank::~Tank() {
@@ -58,31 +234,38 @@ void Tank::start() {
         throw TankError("Already recording");
     }
 
-    // Open MCAP file
-    mcap::McapWriterOptions options("");
-    options.compression = mcap::Compression::Zstd;
-
-    auto status = impl_->writer.open(impl_->output_path, options);
-    if (!status.ok()) {
-        throw TankError("Failed to open MCAP: " + status.message);
+    impl_->splitting = impl_->options.split_size > 0 || impl_->options.split_duration.count() > 0;
+    if (impl_->options.max_files > 0 && !impl_->splitting) {
+        throw TankError("max_files needs split_size or split_duration");
+    }
+    if (impl_->options.max_files == 1) {
+        throw TankError("max_files must be at least 2: the newest file is still being written");
     }
 
-    // Create channels (no schema - raw bytes)
-    for (auto& tr : impl_->topic_recorders) {
-        mcap::Channel channel;
-        channel.topic = tr->topic;
-        channel.messageEncoding = "";
-        channel.schemaId = 0;
+    // Open MCAP file; compressed chunks go to the I/O thread
+    impl_->writer_options.compression = impl_->options.compression;
+    impl_->writer_options.compression_level = impl_->options.compression_level;
+    impl_->writer_options.threads = impl_->options.compression_threads;
+    impl_->writer_options.chunk_size = impl_->options.chunk_size;
+    impl_->open_file(0, impl_->file, impl_->writer);
 
-        impl_->writer.addChannel(channel);
-        tr->channel_id = channel.id;
+    // The writer reads every queue, so they all exist before it starts
+    SubscriberOptions subscriber_options;
+    subscriber_options.reliable = impl_->options.lossless;
+    subscriber_options.reliable_timeout = impl_->options.block_timeout;
+    for (auto& tr : impl_->topic_recorders) {
+        tr->subscriber = std::make_unique<internal::Subscriber>(tr->topic, subscriber_options);
+        tr->staging = std::make_unique<internal::StagingQueue>(impl_->options.staging_size);
     }
 
     impl_->running = true;
+    impl_->writing = true;
 
     // Start threads
+    impl_->writer_thread = std::thread([this]() {
+        impl_->write_loop();
+    });
     for (auto& tr : impl_->topic_recorders) {
-        tr->subscriber = std::make_unique<internal::Subscriber>(tr->topic);
         tr->thread = std::thread([this, tr_ptr = tr.get()]() {
             impl_->record_loop(tr_ptr);
         });
@@ -95,16 +278,28 @@ void Tank::stop() {
     }
 
     impl_->running = false;
+    impl_->stop_word.fetch_add(1);
+    internal::futex_wake_all(&impl_->stop_word);
 
-    // Join threads
+    // Join threads; the writer drains what the topic threads staged
     for (auto& tr : impl_->topic_recorders) {
         if (tr->thread.joinable()) {
             tr->thread.join();
         }
     }
+    impl_->writing = false;
+    impl_->data_word.fetch_add(1);
+    internal::futex_wake_all(&impl_->data_word);
+    if (impl_->writer_thread.joinable()) {
+        impl_->writer_thread.join();
+    }
 
-    // Close file
-    impl_->writer.close();
+    // Close file, and wait for the previous one of a split recording
+    impl_->writer->close();
+    if (impl_->closer.joinable()) {
+        impl_->closer.join();
+    }
+    impl_->remove_old_files();
 }
 
 bool Tank::recording() const {
@@ -115,29 +310,416 @@ uint64_t Tank::message_count() const {
     return impl_->message_count.load();
 }
 
+uint64_t Tank::dropped_count() const {
+    return impl_->dropped_count.load();
+}
+
+TankStats Tank::stats() const {
+    TankStats stats;
+    stats.messages = impl_->message_count.load();
+    stats.dropped = impl_->dropped_count.load();
+    stats.gaps = impl_->gap_count.load();
+    uint64_t latency_ns = 0;
+    for (const auto& tr : impl_->topic_recorders) {
+        latency_ns = std::max(latency_ns, tr->max_latency_ns.load(std::memory_order_relaxed));
+    }
+    stats.max_record_latency = std::chrono::nanoseconds(latency_ns);
+    stats.files = impl_->file_count.load();
+
+    std::lock_guard<std::mutex> lock(impl_->file_mutex);
+    stats.bytes = impl_->closed_bytes.load();
+    stats.max_io_wait = std::chrono::nanoseconds(impl_->closed_io_wait_ns.load());
+    stats.max_compression_wait = std::chrono::nanoseconds(impl_->closed_compression_wait_ns.load());
+    if (impl_->file) {
+        stats.bytes += impl_->file->bytes_on_disk();
+        stats.max_io_wait = std::max(stats.max_io_wait, impl_->file->max_wait());
+        stats.max_compression_wait = std::max(stats.max_compression_wait, impl_->writer->max_wait());
+    }
+    return stats;
+}
+
+/**
+ * Copy messages from one topic's ring into its staging queue.
+ *
+ * Sleeps on the topic's futex word and the stop word at once, so stop()
+ * ends the wait immediately instead of at the next timeout. Each wakeup
+ * drains whatever has been published since (see record_batch()).
+ */
 void Tank::Impl::record_loop(TopicRecorder* tr) {
-    using namespace std::chrono_literals;
+    internal::apply_thread_options(options.threads);
 
+    bool first = true;
+    uint64_t expected = 0;
     while (running) {
-        auto msg = tr->subscriber->wait_for(100ms);
-
-        if (msg.has_value()) {
-            mcap::Message mcap_msg;
-            mcap_msg.channelId = tr->channel_id;
-            mcap_msg.publishTime = msg->timestamp_ns;
-            mcap_msg.logTime = msg->timestamp_ns;
-            mcap_msg.sequence = static_cast<uint32_t>(msg->sequence);
-            mcap_msg.data = reinterpret_cast<const std::byte*>(msg->data);
-            mcap_msg.dataSize = msg->size;
-
-            {
-                std::lock_guard<std::mutex> lock(write_mutex);
-                (void)writer.write(mcap_msg);
+        uint32_t stop_seen = stop_word.load();
+        std::atomic<uint32_t>* word = tr->subscriber->futex_word();
+        uint32_t seen = word->load(std::memory_order_acquire);
+
+        auto msg = tr->subscriber->take();
+        if (!msg.has_value()) {
+            // The word moves when the topic is resized; look again before sleeping on it
+            if (tr->subscriber->futex_word() == word && running) {
+                internal::FutexWaitEntry entries[] = {{word, seen}, {&stop_word, stop_seen}};
+                internal::futex_wait_any(entries, 2);
+            }
+            continue;
+        }
+
+        if (first) {
+            expected = msg->sequence;
+            first = false;
+        }
+        record_batch(tr, *msg, expected);
+    }
+}
+
+/**
+ * Stage @p first and everything else available, up to MAX_BATCH messages.
+ *
+ * Steps:
+ * 1. Take and stage messages, counting drops and the latency locally;
+ *    losses are remembered for the next gap marker
+ * 2. Publish the counters once for the whole batch
+ * 3. Wake the writer once, if it is asleep
+ */
+size_t Tank::Impl::record_batch(TopicRecorder* tr, const Message& first, uint64_t& expected) {
+    // Step 1
+    uint64_t dropped = 0;
+    uint64_t max_latency_ns = 0;
+    size_t count = 0;
+    std::optional<Message> msg = first;
+    do {
+        // Lapped by the publisher: those messages never reached us
+        if (msg->sequence > expected) {
+            uint64_t lost = msg->sequence - expected;
+            if (tr->gap_count == 0) {
+                tr->gap_first = expected;
+            }
+            tr->gap_count += lost;
+            dropped += lost;
+        }
+        expected = msg->sequence + 1;
+
+        if (stage(tr, *msg)) {
+            max_latency_ns = std::max(max_latency_ns, internal::get_timestamp_ns() - msg->timestamp_ns);
+        } else {
+            // Writer is behind
+            if (tr->gap_count == 0) {
+                tr->gap_first = msg->sequence;
+            }
+            ++tr->gap_count;
+            ++dropped;
+        }
+    } while (++count < MAX_BATCH && (msg = tr->subscriber->take()).has_value());
+
+    // Step 2
+    if (dropped > 0) {
+        dropped_count.fetch_add(dropped, std::memory_order_relaxed);
+    }
+    if (max_latency_ns > tr->max_latency_ns.load(std::memory_order_relaxed)) {
+        tr->max_latency_ns.store(max_latency_ns, std::memory_order_relaxed);
+    }
+
+    // Step 3
+    wake_writer();
+    return count;
+}
+
+/**
+ * Stage a message, preceded by a gap marker if messages were lost before it.
+ *
+ * The marker goes to the queue first, so it is written before the message
+ * (same timestamp, earlier in the queue). If the message itself does not
+ * fit, the marker stays pending and grows by one.
+ */
+bool Tank::Impl::stage(TopicRecorder* tr, const Message& msg) {
+    if (tr->gap_count > 0) {
+        char marker[64];
+        int length = std::snprintf(marker, sizeof(marker), "{\"first_sequence\":%llu,\"count\":%llu}",
+                                   static_cast<unsigned long long>(tr->gap_first),
+                                   static_cast<unsigned long long>(tr->gap_count));
+        if (!push(tr, msg.timestamp_ns, tr->gap_first, marker, static_cast<size_t>(length),
+                  internal::StagedKind::Gap)) {
+            return false;
+        }
+        tr->gap_count = 0;
+    }
+    return push(tr, msg.timestamp_ns, msg.sequence, msg.data, msg.size, internal::StagedKind::Message);
+}
+
+/**
+ * Push into the topic's staging queue; in lossless mode wait for room.
+ *
+ * Waiting needs the writer awake, but the batch's data_word bump comes
+ * only at its end, so wake it here first. The writer keeps running until
+ * all topic threads have exited, so the wait ends even during stop().
+ * A message larger than the whole queue can never fit and is dropped.
+ */
+bool Tank::Impl::push(TopicRecorder* tr, uint64_t timestamp_ns, uint64_t sequence, const void* data, size_t size,
+                      internal::StagedKind kind) {
+    while (!tr->staging->push(timestamp_ns, sequence, data, size, kind)) {
+        if (!options.lossless || tr->staging->empty()) {
+            return false;
+        }
+        wake_writer();
+
+        uint32_t seen = space_word.load();
+        topics_waiting.fetch_add(1);
+        if (!tr->staging->push(timestamp_ns, sequence, data, size, kind)) {
+            internal::futex_wait(&space_word, seen);
+            topics_waiting.fetch_sub(1);
+            continue;
+        }
+        topics_waiting.fetch_sub(1);
+        return true;
+    }
+    return true;
+}
+
+void Tank::Impl::wake_writer() {
+    data_word.fetch_add(1);
+    if (writer_sleeping.load()) {
+        internal::futex_wake(&data_word);
+    }
+}
+
+/**
+ * Drain all staging queues into the MCAP file until stop() and empty.
+ *
+ * Messages are flushed at most flush_interval after the first one written
+ * since the last flush; while they are pending the writer sleeps no longer
+ * than until that deadline.
+ */
+void Tank::Impl::write_loop() {
+    using Clock = std::chrono::steady_clock;
+    internal::apply_thread_options(options.threads);
+
+    const bool flushing = options.flush_interval.count() > 0;
+    bool unflushed = false;
+    Clock::time_point flush_at;
+    auto written = [&](size_t count) {
+        if (count == 0 || !flushing) {
+            return;
+        }
+        auto now = Clock::now();
+        if (!unflushed) {
+            unflushed = true;
+            flush_at = now + options.flush_interval;
+        } else if (now >= flush_at) {
+            flush();
+            unflushed = false;
+        }
+    };
+
+    while (true) {
+        size_t count = write_batch();
+        written(count);
+        if (count > 0) {
+            continue;
+        }
+        if (!writing) {
+            // Topic threads have exited: one last pass found nothing
+            if (write_batch() == 0) {
+                return;
             }
+            continue;
+        }
+        if (unflushed && Clock::now() >= flush_at) {
+            flush();
+            unflushed = false;
+        }
 
-            message_count.fetch_add(1);
+        // stop() bumps data_word too, so only a pending flush needs a timeout
+        uint32_t seen = data_word.load();
+        writer_sleeping.store(true);
+        count = write_batch();
+        if (count == 0) {
+            std::optional<std::chrono::nanoseconds> timeout;
+            if (unflushed) {
+                timeout = std::max(flush_at - Clock::now(), Clock::duration::zero());
+            }
+            internal::futex_wait(&data_word, seen, timeout);
         }
+        writer_sleeping.store(false);
+        written(count);
+    }
+}
+
+/**
+ * Write up to MAX_BATCH messages, each time the oldest at the head of any
+ * staging queue.
+ *
+ * Returns the number written; 0 if every queue is empty.
+ */
+size_t Tank::Impl::write_batch() {
+    size_t count = 0;
+    size_t gaps = 0;
+    while (count < MAX_BATCH) {
+        TopicRecorder* oldest = nullptr;
+        const internal::StagedMessage* oldest_msg = nullptr;
+        for (auto& tr : topic_recorders) {
+            const internal::StagedMessage* msg = tr->staging->front();
+            if (msg != nullptr && (oldest_msg == nullptr || msg->timestamp_ns < oldest_msg->timestamp_ns)) {
+                oldest = tr.get();
+                oldest_msg = msg;
+            }
+        }
+        if (oldest == nullptr) {
+            break;
+        }
+
+        // A gap marker stays in the file of the message it precedes
+        if (splitting && !after_gap && split_due(oldest_msg->timestamp_ns)) {
+            rotate();
+        }
+        if (file_start_ns == 0) {
+            file_start_ns = oldest_msg->timestamp_ns;
+        }
+        after_gap = oldest_msg->kind == internal::StagedKind::Gap;
+
+        uint16_t channel_id = oldest->channel_id;
+        if (oldest_msg->kind == internal::StagedKind::Gap) {
+            if (oldest->gap_channel_id == 0) {
+                oldest->gap_channel_id = writer->add_channel(oldest->topic + GAP_CHANNEL_SUFFIX, "json");
+            }
+            channel_id = oldest->gap_channel_id;
+            ++gaps;
+        }
+        writer->write(channel_id, static_cast<uint32_t>(oldest_msg->sequence),
+                      oldest_msg->timestamp_ns, oldest_msg->timestamp_ns, oldest_msg->data(), oldest_msg->size);
+        oldest->staging->pop();
+        ++count;
+    }
+
+    if (count > gaps) {
+        message_count.fetch_add(count - gaps, std::memory_order_relaxed);
+    }
+    if (gaps > 0) {
+        gap_count.fetch_add(gaps, std::memory_order_relaxed);
+    }
+
+    // Topic threads waiting for room in lossless mode; front() skipping a
+    // wrap filler frees room even when nothing was written
+    if (topics_waiting.load() > 0) {
+        space_word.fetch_add(1);
+        internal::futex_wake_all(&space_word);
     }
+    return count;
+}
+
+/**
+ * Create file @p index with its header and every topic's channel.
+ *
+ * A split recording numbers its files; otherwise the file is output_path.
+ * Gap channels are added again on the first marker in the new file.
+ */
+void Tank::Impl::open_file(uint32_t index, std::unique_ptr<internal::AsyncFileWriter>& next_file,
+                           std::unique_ptr<internal::ChunkWriter>& next_writer) {
+    std::string path = splitting ? internal::numbered_path(output_path, index) : output_path;
+    next_file = std::make_unique<internal::AsyncFileWriter>(path, options.io_buffer_size, options.io_buffers,
+                                                            options.direct_io);
+    next_writer = std::make_unique<internal::ChunkWriter>(*next_file, writer_options);
+
+    // Create channels (no schema - raw bytes)
+    for (auto& tr : topic_recorders) {
+        tr->channel_id = next_writer->add_channel(tr->topic);
+        tr->gap_channel_id = 0;
+    }
+
+    file_index = index;
+    file_start_ns = 0;
+    file_count.fetch_add(1, std::memory_order_relaxed);
+    if (splitting) {
+        std::lock_guard<std::mutex> lock(files_mutex);
+        files.push_back(path);
+    }
+}
+
+bool Tank::Impl::split_due(uint64_t timestamp_ns) const {
+    if (options.split_size > 0 && file->size() >= options.split_size) {
+        return true;
+    }
+    auto duration = static_cast<uint64_t>(options.split_duration.count());
+    return duration > 0 && file_start_ns != 0 && timestamp_ns >= file_start_ns &&
+           timestamp_ns - file_start_ns >= duration;
+}
+
+/**
+ * Continue the recording in the next file.
+ *
+ * Steps:
+ * 1. Open the next file; if that fails, keep writing the current one
+ * 2. Swap it in: the next message goes to the new file
+ * 3. Finish the previous file on the closer thread
+ */
+void Tank::Impl::rotate() {
+    // Step 1
+    std::unique_ptr<internal::AsyncFileWriter> next_file;
+    std::unique_ptr<internal::ChunkWriter> next_writer;
+    try {
+        open_file(file_index + 1, next_file, next_writer);
+    } catch (const TankError& e) {
+        log::error("Cannot split the recording, continuing in the current file: {}", e.what());
+        splitting = false;
+        return;
+    }
+
+    // Step 2
+    {
+        std::lock_guard<std::mutex> lock(file_mutex);
+        std::swap(file, next_file);
+        std::swap(writer, next_writer);
+    }
+
+    // Step 3
+    if (closer.joinable()) {
+        closer.join();
+    }
+    closer = std::thread([this, old_writer = std::move(next_writer), old_file = std::move(next_file)]() mutable {
+        internal::apply_thread_options(options.threads);
+        close_file(std::move(old_writer), std::move(old_file));
+    });
+}
+
+/**
+ * Finish a file of a split recording, then make room for the next.
+ */
+void Tank::Impl::close_file(std::unique_ptr<internal::ChunkWriter> old_writer,
+                            std::unique_ptr<internal::AsyncFileWriter> old_file) {
+    old_writer->close();
+    store_max(closed_compression_wait_ns, static_cast<uint64_t>(old_writer->max_wait().count()));
+    store_max(closed_io_wait_ns, static_cast<uint64_t>(old_file->max_wait().count()));
+    closed_bytes.fetch_add(old_file->bytes_on_disk(), std::memory_order_relaxed);
+    old_writer.reset();
+    old_file.reset();
+    remove_old_files();
+}
+
+/**
+ * Delete the oldest files beyond max_files.
+ *
+ * The newest file is the one being written and max_files is at least 2,
+ * so only finished files are deleted.
+ */
+void Tank::Impl::remove_old_files() {
+    if (options.max_files == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(files_mutex);
+    while (files.size() > options.max_files) {
+        if (std::remove(files.front().c_str()) != 0) {
+            log::warn("Cannot delete old recording {}", files.front());
+        }
+        files.pop_front();
+    }
+}
+
+/**
+ * Get everything written so far into the file (see "Flushing").
+ */
+void Tank::Impl::flush() {
+    writer->flush();
+    file->flush();
 }
 
 }  // namespace conduit
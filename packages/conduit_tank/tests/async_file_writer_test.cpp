@@ -0,0 +1,108 @@
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include <conduit_core/exceptions.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using namespace conduit::internal;
+
+namespace {
+
+constexpr char OUTPUT[] = "/tmp/async_file_writer_test.bin";
+
+std::vector<std::byte> pattern(size_t size, uint8_t seed) {
+    std::vector<std::byte> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<std::byte>(seed + i * 7);
+    }
+    return data;
+}
+
+std::vector<std::byte> read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> chars((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<std::byte> data(chars.size());
+    std::memcpy(data.data(), chars.data(), chars.size());
+    return data;
+}
+
+}  // namespace
+
+class AsyncFileWriterTest : public ::testing::TestWithParam<bool> {
+protected:
+    void TearDown() override {
+        std::remove(OUTPUT);
+    }
+};
+
+TEST_P(AsyncFileWriterTest, test_writes_everything_in_order) {
+    // Writes straddle buffer boundaries; the total is not block aligned
+    std::vector<std::byte> expected;
+    {
+        AsyncFileWriter writer(OUTPUT, 8192, 2, GetParam());
+        for (uint8_t i = 0; i < 50; ++i) {
+            auto chunk = pattern(1000 + i * 37, i);
+            writer.write(chunk.data(), chunk.size());
+            expected.insert(expected.end(), chunk.begin(), chunk.end());
+        }
+        EXPECT_EQ(writer.size(), expected.size());
+        writer.end();
+        EXPECT_GE(writer.bytes_on_disk(), expected.size());
+    }
+
+    EXPECT_EQ(read_file(OUTPUT), expected);
+}
+
+TEST_P(AsyncFileWriterTest, test_flush_rewrites_partial_block) {
+    // Flushes land inside blocks; later buffers rewrite them in place
+    std::vector<std::byte> expected;
+    {
+        AsyncFileWriter writer(OUTPUT, 8192, 2, GetParam());
+        for (uint8_t i = 0; i < 40; ++i) {
+            auto chunk = pattern(300 + i * 53, i);
+            writer.write(chunk.data(), chunk.size());
+            expected.insert(expected.end(), chunk.begin(), chunk.end());
+            if (i % 3 == 0) {
+                writer.flush();
+            }
+        }
+
+        // Flushed bytes are in the file before end()
+        writer.flush();
+        auto written = [&] {
+            auto flushed = read_file(OUTPUT);
+            return flushed.size() >= expected.size() &&
+                   std::equal(expected.begin(), expected.end(), flushed.begin());
+        };
+        for (int i = 0; i < 1000 && !written(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_TRUE(written());
+        writer.end();
+    }
+
+    EXPECT_EQ(read_file(OUTPUT), expected);
+}
+
+TEST_P(AsyncFileWriterTest, test_empty_file) {
+    {
+        AsyncFileWriter writer(OUTPUT, 4096, 2, GetParam());
+    }
+    EXPECT_TRUE(read_file(OUTPUT).empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(DirectIo, AsyncFileWriterTest, ::testing::Bool());
+
+TEST(AsyncFileWriterErrorTest, test_bad_path_throws) {
+    EXPECT_THROW((AsyncFileWriter("/nonexistent/dir/file.mcap", 4096, 2, true)), TankError);
+}
@@ -0,0 +1,164 @@
+#include "conduit_tank/internal/chunk_writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <lz4frame.h>
+#include <zstd.h>
+
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace conduit;
+using namespace conduit::internal;
+
+namespace {
+
+/// Output collected in memory.
+class MemoryWritable : public mcap::IWritable {
+public:
+    std::vector<uint8_t> bytes;
+    bool ended = false;
+
+    void end() override { ended = true; }
+    uint64_t size() const override { return bytes.size(); }
+
+protected:
+    void handleWrite(const std::byte* data, uint64_t size) override {
+        const auto* p = reinterpret_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+};
+
+template <typename T>
+T read_at(const std::vector<uint8_t>& bytes, size_t offset) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+struct Parsed {
+    std::vector<std::tuple<uint16_t, uint32_t, uint64_t>> messages;  ///< channel, sequence, log time
+    size_t chunks = 0;
+    size_t chunk_indexes = 0;
+    uint64_t statistics_messages = 0;
+};
+
+std::vector<uint8_t> decompress(const std::string& compression, const uint8_t* data, size_t size,
+                                size_t uncompressed_size) {
+    std::vector<uint8_t> out(uncompressed_size);
+    if (compression == "zstd") {
+        EXPECT_EQ(ZSTD_decompress(out.data(), out.size(), data, size), uncompressed_size);
+    } else if (compression == "lz4") {
+        LZ4F_dctx* ctx;
+        LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
+        size_t dst = out.size();
+        size_t src = size;
+        LZ4F_decompress(ctx, out.data(), &dst, data, &src, nullptr);
+        LZ4F_freeDecompressionContext(ctx);
+        EXPECT_EQ(dst, uncompressed_size);
+    } else {
+        EXPECT_EQ(compression, "");
+        std::memcpy(out.data(), data, size);
+    }
+    return out;
+}
+
+/// Walk the records from header to footer.
+Parsed parse(const std::vector<uint8_t>& file) {
+    Parsed parsed;
+    EXPECT_EQ(std::memcmp(file.data(), MCAP_MAGIC, 8), 0);
+    EXPECT_EQ(std::memcmp(file.data() + file.size() - 8, MCAP_MAGIC, 8), 0);
+
+    size_t pos = 8;
+    while (pos + MCAP_RECORD_PREFIX <= file.size() - 8) {
+        auto op = static_cast<McapOp>(file[pos]);
+        auto length = read_at<uint64_t>(file, pos + 1);
+        size_t content = pos + MCAP_RECORD_PREFIX;
+
+        if (op == McapOp::Chunk) {
+            ++parsed.chunks;
+            auto uncompressed_size = read_at<uint64_t>(file, content + 16);
+            auto compression_length = read_at<uint32_t>(file, content + 28);
+            std::string compression(reinterpret_cast<const char*>(file.data() + content + 32), compression_length);
+            size_t records = content + 32 + compression_length;
+            auto records_size = read_at<uint64_t>(file, records);
+            auto raw = decompress(compression, file.data() + records + 8, records_size, uncompressed_size);
+
+            size_t r = 0;
+            while (r < raw.size()) {
+                EXPECT_EQ(static_cast<McapOp>(raw[r]), McapOp::Message);
+                auto message_length = read_at<uint64_t>(raw, r + 1);
+                parsed.messages.emplace_back(read_at<uint16_t>(raw, r + 9), read_at<uint32_t>(raw, r + 11),
+                                             read_at<uint64_t>(raw, r + 15));
+                r += MCAP_RECORD_PREFIX + message_length;
+            }
+        } else if (op == McapOp::ChunkIndex) {
+            ++parsed.chunk_indexes;
+        } else if (op == McapOp::Statistics) {
+            parsed.statistics_messages = read_at<uint64_t>(file, content);
+        } else if (op == McapOp::Footer) {
+            auto summary_start = read_at<uint64_t>(file, content);
+            EXPECT_GT(summary_start, 8u);
+            EXPECT_EQ(static_cast<McapOp>(file[summary_start]), McapOp::Channel);
+        }
+        pos = content + length;
+    }
+    EXPECT_EQ(pos, file.size() - 8);
+    return parsed;
+}
+
+}  // namespace
+
+class ChunkWriterTest : public ::testing::TestWithParam<std::tuple<Compression, uint32_t>> {};
+
+TEST_P(ChunkWriterTest, test_messages_in_order) {
+    ChunkWriterOptions options;
+    options.compression = std::get<0>(GetParam());
+    options.threads = std::get<1>(GetParam());
+    options.chunk_size = 4096;  // Many chunks in flight at once
+
+    MemoryWritable output;
+    {
+        ChunkWriter writer(output, options);
+        uint16_t a = writer.add_channel("a");
+        uint16_t b = writer.add_channel("b");
+        std::vector<uint8_t> payload(300, 0x42);
+        for (uint32_t i = 0; i < 1000; ++i) {
+            writer.write(i % 2 == 0 ? a : b, i, 1000 + i, 1000 + i, payload.data(), payload.size());
+        }
+        writer.close();
+        EXPECT_GT(writer.chunk_count(), 10u);
+    }
+    EXPECT_TRUE(output.ended);
+    if (options.compression != Compression::None) {
+        EXPECT_LT(output.bytes.size(), 1000u * 300u / 4);  // Repeated payload compresses well
+    }
+
+    Parsed parsed = parse(output.bytes);
+    ASSERT_EQ(parsed.messages.size(), 1000u);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(std::get<0>(parsed.messages[i]), i % 2 == 0 ? 1 : 2);
+        EXPECT_EQ(std::get<1>(parsed.messages[i]), i);
+        EXPECT_EQ(std::get<2>(parsed.messages[i]), 1000 + i);
+    }
+    EXPECT_EQ(parsed.chunk_indexes, parsed.chunks);
+    EXPECT_EQ(parsed.statistics_messages, 1000u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Codecs, ChunkWriterTest,
+                         ::testing::Combine(::testing::Values(Compression::None, Compression::Lz4,
+                                                              Compression::Zstd),
+                                            ::testing::Values(0u, 3u)));
+
+TEST(ChunkWriterEmptyTest, test_empty_file_has_summary) {
+    MemoryWritable output;
+    {
+        ChunkWriter writer(output, ChunkWriterOptions{});
+        writer.add_channel("unused");
+    }
+    Parsed parsed = parse(output.bytes);
+    EXPECT_TRUE(parsed.messages.empty());
+    EXPECT_EQ(parsed.chunks, 0u);
+}
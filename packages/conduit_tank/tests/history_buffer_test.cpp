@@ -0,0 +1,134 @@
+#include "conduit_tank/internal/history_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace conduit::internal;
+
+TEST(HistoryBufferTest, test_read_in_order) {
+    HistoryBuffer history(1024);
+    EXPECT_EQ(history.begin(), history.end());
+
+    for (uint64_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(history.push(100 + i, i, &i, sizeof(i)));
+    }
+
+    uint64_t position = history.begin();
+    StagedMessage header;
+    std::vector<uint8_t> payload;
+    for (uint64_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(history.read(position, header, payload), HistoryRead::Ok);
+        EXPECT_EQ(header.timestamp_ns, 100 + i);
+        EXPECT_EQ(header.sequence, i);
+        ASSERT_EQ(payload.size(), sizeof(uint64_t));
+        uint64_t value;
+        std::memcpy(&value, payload.data(), sizeof(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(history.read(position, header, payload), HistoryRead::End);
+}
+
+TEST(HistoryBufferTest, test_evicts_oldest) {
+    HistoryBuffer history(256);
+    std::vector<uint8_t> payload(60, 0xab);  // 96 bytes per record
+
+    // Records wrap at different offsets; only the newest two fit
+    for (uint64_t i = 0; i < 20; ++i) {
+        ASSERT_TRUE(history.push(i, i, payload.data(), payload.size()));
+    }
+    uint64_t position = history.begin();
+    StagedMessage header;
+    std::vector<uint8_t> read;
+    ASSERT_EQ(history.read(position, header, read), HistoryRead::Ok);
+    EXPECT_EQ(header.sequence, 18u);
+    EXPECT_EQ(read, payload);
+    ASSERT_EQ(history.read(position, header, read), HistoryRead::Ok);
+    EXPECT_EQ(header.sequence, 19u);
+    EXPECT_EQ(history.read(position, header, read), HistoryRead::End);
+
+    std::vector<uint8_t> too_large(300);
+    EXPECT_FALSE(history.push(20, 20, too_large.data(), too_large.size()));
+}
+
+TEST(HistoryBufferTest, test_reader_sees_eviction) {
+    HistoryBuffer history(256);
+    std::vector<uint8_t> payload(60);
+
+    history.push(0, 0, payload.data(), payload.size());
+    uint64_t position = history.begin();
+    for (uint64_t i = 1; i < 4; ++i) {
+        history.push(i, i, payload.data(), payload.size());
+    }
+
+    StagedMessage header;
+    std::vector<uint8_t> read;
+    EXPECT_EQ(history.read(position, header, read), HistoryRead::Overwritten);
+}
+
+TEST(HistoryBufferTest, test_seek) {
+    HistoryBuffer history(4096);
+    for (uint64_t i = 0; i < 10; ++i) {
+        history.push(i * 10, i, &i, sizeof(i));
+    }
+
+    StagedMessage header;
+    uint64_t position = history.seek(35);
+    ASSERT_EQ(history.peek(position, header), HistoryRead::Ok);
+    EXPECT_EQ(header.sequence, 4u);
+    position = history.seek(0);
+    ASSERT_EQ(history.peek(position, header), HistoryRead::Ok);
+    EXPECT_EQ(header.sequence, 0u);
+    EXPECT_EQ(history.seek(1000), history.end());
+}
+
+TEST(HistoryBufferTest, test_concurrent_reader_never_sees_torn_records) {
+    constexpr uint64_t COUNT = 200000;
+    HistoryBuffer history(4096);
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < COUNT; ++i) {
+            // Payload filled with its sequence; varying sizes wrap at different offsets
+            std::vector<uint64_t> payload(1 + i % 7, i);
+            history.push(i, i, payload.data(), payload.size() * sizeof(uint64_t));
+        }
+        done = true;
+    });
+
+    uint64_t position = 0;
+    uint64_t last = 0;
+    uint64_t read_count = 0;
+    StagedMessage header;
+    std::vector<uint8_t> payload;
+    while (true) {
+        bool finished = done.load();
+        HistoryRead result = history.read(position, header, payload);
+        if (result == HistoryRead::Overwritten) {
+            position = history.begin();
+            continue;
+        }
+        if (result == HistoryRead::End) {
+            if (finished) {
+                break;
+            }
+            continue;
+        }
+        ASSERT_EQ(payload.size(), (1 + header.sequence % 7) * sizeof(uint64_t));
+        for (size_t j = 0; j < payload.size() / sizeof(uint64_t); ++j) {
+            uint64_t value;
+            std::memcpy(&value, payload.data() + j * sizeof(uint64_t), sizeof(value));
+            ASSERT_EQ(value, header.sequence);
+        }
+        if (read_count > 0) {
+            ASSERT_GT(header.sequence, last);
+        }
+        last = header.sequence;
+        ++read_count;
+    }
+    producer.join();
+    EXPECT_GT(read_count, 0u);
+}
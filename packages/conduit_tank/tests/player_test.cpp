@@ -0,0 +1,207 @@
+#include "conduit_tank/player.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
+#include <conduit_core/exceptions.hpp>
+#include <conduit_core/subscriber.hpp>
+#include <conduit_core/internal/shm_region.hpp>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>  // truncate
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using namespace conduit::internal;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr char RECORDING[] = "/tmp/player_test.mcap";
+
+/// Write @p count messages alternating between "player_a" and "player_b",
+/// @p interval apart, plus one gap marker. Payloads hold the message index.
+void write_recording(Compression compression, uint32_t count, std::chrono::nanoseconds interval) {
+    ChunkWriterOptions options;
+    options.compression = compression;
+    options.chunk_size = 2048;  // Many chunks
+
+    AsyncFileWriter file(RECORDING, 64 * 1024, 2, false);
+    ChunkWriter writer(file, options);
+    uint16_t a = writer.add_channel("player_a");
+    uint16_t b = writer.add_channel("player_b");
+    uint16_t gaps = writer.add_channel("player_a/gaps", "json");
+
+    std::vector<uint8_t> payload(100);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t time = 1000000 + i * static_cast<uint64_t>(interval.count());
+        std::memcpy(payload.data(), &i, sizeof(i));
+        writer.write(i % 2 == 0 ? a : b, i, time, time, payload.data(), payload.size());
+        if (i == count / 2) {
+            const char marker[] = R"({"first_sequence":0,"count":1})";
+            writer.write(gaps, 0, time, time, marker, sizeof(marker) - 1);
+        }
+    }
+    writer.close();
+}
+
+}  // namespace
+
+class PlayerTest : public ::testing::TestWithParam<Compression> {
+protected:
+    void TearDown() override {
+        ShmRegion::unlink("player_a");
+        ShmRegion::unlink("player_b");
+        std::remove(RECORDING);
+    }
+};
+
+TEST_P(PlayerTest, test_reader_finds_all_messages) {
+    write_recording(GetParam(), 1000, 1ms);
+
+    McapReader reader(RECORDING);
+    EXPECT_TRUE(reader.indexed());
+    ASSERT_EQ(reader.channels().size(), 3u);
+    EXPECT_EQ(reader.channels()[2].topic, "player_a/gaps");
+    EXPECT_GT(reader.chunks().size(), 10u);
+    EXPECT_EQ(reader.start_time(), 1000000u);
+    EXPECT_EQ(reader.end_time(), 1000000u + 999u * 1000000u);
+
+    uint32_t next = 0;
+    size_t markers = 0;
+    std::vector<uint8_t> records;
+    for (const auto& chunk : reader.chunks()) {
+        reader.decompress(chunk, records);
+        McapReader::for_each_message(records.data(), records.size(), [&](const McapMessage& msg) {
+            if (msg.channel_id == 3) {
+                ++markers;
+                return;
+            }
+            uint32_t index;
+            std::memcpy(&index, msg.data, sizeof(index));
+            EXPECT_EQ(index, next);
+            EXPECT_EQ(msg.channel_id, next % 2 == 0 ? 1 : 2);
+            ++next;
+        });
+    }
+    EXPECT_EQ(next, 1000u);
+    EXPECT_EQ(markers, 1u);
+}
+
+TEST_P(PlayerTest, test_plays_every_message) {
+    write_recording(GetParam(), 1000, 1ms);
+
+    PlayerOptions options;
+    options.rate = 0;
+    Player player(RECORDING, options);
+    EXPECT_EQ(player.topics(), (std::vector<std::string>{"player_a", "player_b"}));
+
+    // Reliable: the player waits for us instead of lapping
+    SubscriberOptions sub_options;
+    sub_options.reliable = true;
+    sub_options.reliable_timeout = 5s;
+    internal::Subscriber sub_a("player_a", sub_options);
+    internal::Subscriber sub_b("player_b", sub_options);
+
+    player.start();
+    uint32_t received = 0;
+    auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (received < 1000 && std::chrono::steady_clock::now() < deadline) {
+        for (auto* sub : {&sub_a, &sub_b}) {
+            if (auto msg = sub->wait_for(1ms)) {
+                uint32_t index;
+                std::memcpy(&index, msg->data, sizeof(index));
+                EXPECT_EQ(index % 2, sub == &sub_a ? 0u : 1u);
+                ++received;
+            }
+        }
+    }
+    player.wait();
+
+    EXPECT_EQ(received, 1000u);
+    EXPECT_EQ(player.message_count(), 1000u);
+    EXPECT_FALSE(player.playing());
+}
+
+INSTANTIATE_TEST_SUITE_P(Codecs, PlayerTest,
+                         ::testing::Values(Compression::None, Compression::Lz4, Compression::Zstd));
+
+TEST_F(PlayerTest, test_keeps_recorded_timing) {
+    // 20 messages 10 ms apart: 190 ms at rate 1, 95 ms at rate 2
+    write_recording(Compression::Zstd, 20, 10ms);
+
+    for (double rate : {1.0, 2.0}) {
+        PlayerOptions options;
+        options.rate = rate;
+        Player player(RECORDING, options);
+        EXPECT_EQ(player.duration(), 190ms);
+
+        auto start = std::chrono::steady_clock::now();
+        player.start();
+        player.wait();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(player.message_count(), 20u);
+        EXPECT_GE(elapsed, std::chrono::duration_cast<std::chrono::nanoseconds>(190ms / rate));
+        EXPECT_LT(elapsed, std::chrono::duration_cast<std::chrono::nanoseconds>(190ms / rate) + 100ms);
+    }
+}
+
+TEST_F(PlayerTest, test_stop_ends_playback) {
+    write_recording(Compression::Zstd, 20, 1s);
+
+    Player player(RECORDING);
+    player.start();
+    std::this_thread::sleep_for(50ms);
+    EXPECT_TRUE(player.playing());
+
+    auto start = std::chrono::steady_clock::now();
+    player.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+    EXPECT_FALSE(player.playing());
+    EXPECT_EQ(player.message_count(), 1u);
+}
+
+TEST_F(PlayerTest, test_reads_truncated_recording) {
+    write_recording(Compression::Zstd, 1000, 1ms);
+
+    // A crash leaves no summary and a partial last record
+    FILE* f = std::fopen(RECORDING, "rb");
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fclose(f);
+    ASSERT_EQ(truncate(RECORDING, size / 2), 0);
+
+    McapReader reader(RECORDING);
+    EXPECT_FALSE(reader.indexed());
+    EXPECT_EQ(reader.channels().size(), 3u);
+    ASSERT_FALSE(reader.chunks().empty());
+    EXPECT_FALSE(reader.chunks().front().message_indexes.empty());
+    size_t messages = 0;
+    std::vector<uint8_t> records;
+    for (const auto& chunk : reader.chunks()) {
+        reader.decompress(chunk, records);
+        McapReader::for_each_message(records.data(), records.size(), [&](const McapMessage&) { ++messages; });
+    }
+    EXPECT_GT(messages, 100u);
+    EXPECT_LT(messages, 1000u);
+}
+
+TEST_F(PlayerTest, test_rejects_bad_input) {
+    EXPECT_THROW(Player("/tmp/player_test_missing.mcap"), TankError);
+
+    FILE* f = std::fopen(RECORDING, "wb");
+    std::fputs("not a recording", f);
+    std::fclose(f);
+    EXPECT_THROW(Player{RECORDING}, TankError);
+
+    write_recording(Compression::None, 10, 1ms);
+    PlayerOptions options;
+    options.topics = {"missing"};
+    EXPECT_THROW(Player(RECORDING, options), TankError);
+}
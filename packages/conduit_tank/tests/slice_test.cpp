@@ -0,0 +1,145 @@
+#include "conduit_tank/slice.hpp"
+#include "conduit_tank/internal/async_file_writer.hpp"
+#include "conduit_tank/internal/chunk_writer.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
+#include <conduit_core/exceptions.hpp>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>  // truncate
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace conduit;
+using namespace conduit::internal;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr char INPUT[] = "/tmp/slice_test_input.mcap";
+constexpr char OUTPUT[] = "/tmp/slice_test_output.mcap";
+constexpr uint64_t FIRST_TIME = 5'000'000'000;
+
+/// 10 s of "a" and "b" alternating every 10 ms, and a gap marker for "a" at 2.5 s.
+void write_recording() {
+    ChunkWriterOptions options;
+    options.chunk_size = 4096;
+
+    AsyncFileWriter file(INPUT, 64 * 1024, 2, false);
+    ChunkWriter writer(file, options);
+    uint16_t a = writer.add_channel("a");
+    uint16_t b = writer.add_channel("b");
+    uint16_t gaps = writer.add_channel("a/gaps", "json");
+
+    std::vector<uint8_t> payload(100);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        uint64_t time = FIRST_TIME + i * 10'000'000ull;
+        std::memcpy(payload.data(), &i, sizeof(i));
+        writer.write(i % 2 == 0 ? a : b, i, time, time, payload.data(), payload.size());
+        if (i == 250) {
+            const char marker[] = R"({"first_sequence":0,"count":1})";
+            writer.write(gaps, 0, time, time, marker, sizeof(marker) - 1);
+        }
+    }
+    writer.close();
+}
+
+struct Output {
+    std::vector<std::string> topics;
+    std::vector<std::pair<std::string, uint32_t>> messages;  ///< topic, sequence
+    uint64_t first_time = 0;
+};
+
+Output read_output() {
+    McapReader reader(OUTPUT);
+    EXPECT_TRUE(reader.indexed());
+    Output out;
+    std::map<uint16_t, std::string> names;
+    for (const auto& channel : reader.channels()) {
+        out.topics.push_back(channel.topic);
+        names[channel.id] = channel.topic;
+    }
+    out.first_time = reader.start_time();
+    std::vector<uint8_t> records;
+    for (const auto& chunk : reader.chunks()) {
+        reader.decompress(chunk, records);
+        McapReader::for_each_message(records.data(), records.size(), [&](const McapMessage& msg) {
+            out.messages.emplace_back(names[msg.channel_id], msg.sequence);
+        });
+    }
+    return out;
+}
+
+}  // namespace
+
+class SliceTest : public ::testing::Test {
+protected:
+    void SetUp() override { write_recording(); }
+
+    void TearDown() override {
+        std::remove(INPUT);
+        std::remove(OUTPUT);
+    }
+};
+
+TEST_F(SliceTest, test_slices_time_range_of_one_topic) {
+    SliceOptions options;
+    options.start = 2s;
+    options.end = 3s;
+    options.topics = {"a"};
+    SliceStats stats = slice(INPUT, OUTPUT, options);
+
+    // a: even sequences 200..300; its gap marker comes along
+    EXPECT_TRUE(stats.indexed);
+    EXPECT_EQ(stats.messages, 52u);
+    EXPECT_LT(stats.chunks_read, stats.chunks_total / 5);
+
+    Output out = read_output();
+    EXPECT_EQ(out.topics, (std::vector<std::string>{"a", "a/gaps"}));
+    ASSERT_EQ(out.messages.size(), 52u);
+    EXPECT_EQ(out.messages.front(), std::make_pair(std::string("a"), 200u));
+    EXPECT_EQ(out.messages.back(), std::make_pair(std::string("a"), 300u));
+    EXPECT_EQ(out.first_time, FIRST_TIME + 2'000'000'000ull);
+}
+
+TEST_F(SliceTest, test_keeps_everything_by_default) {
+    SliceStats stats = slice(INPUT, OUTPUT);
+    EXPECT_EQ(stats.messages, 1001u);
+    EXPECT_EQ(stats.chunks_read, stats.chunks_total);
+
+    Output out = read_output();
+    ASSERT_EQ(out.messages.size(), 1001u);
+    EXPECT_EQ(out.messages[0].second, 0u);
+    EXPECT_EQ(out.messages[1000].second, 999u);
+}
+
+TEST_F(SliceTest, test_slices_recording_without_summary) {
+    // Cut the summary off, as a crash would
+    FILE* f = std::fopen(INPUT, "rb");
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fclose(f);
+    ASSERT_EQ(truncate(INPUT, size - 64), 0);
+
+    SliceOptions options;
+    options.start = 2s;
+    options.end = 3s;
+    options.topics = {"b"};
+    SliceStats stats = slice(INPUT, OUTPUT, options);
+
+    EXPECT_FALSE(stats.indexed);
+    EXPECT_EQ(stats.messages, 50u);  // Odd sequences 201..299
+    EXPECT_EQ(read_output().messages.size(), 50u);
+}
+
+TEST_F(SliceTest, test_rejects_bad_input) {
+    SliceOptions options;
+    options.topics = {"missing"};
+    EXPECT_THROW(slice(INPUT, OUTPUT, options), TankError);
+    EXPECT_THROW(slice(INPUT, INPUT), TankError);
+    EXPECT_THROW(slice("/tmp/slice_test_missing.mcap", OUTPUT), TankError);
+}
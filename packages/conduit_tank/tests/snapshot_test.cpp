@@ -0,0 +1,169 @@
+#include "conduit_tank/snapshot.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
+#include <conduit_core/publisher.hpp>
+#include <conduit_core/exceptions.hpp>
+#include <conduit_core/internal/shm_region.hpp>
+#include <conduit_core/internal/time.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace conduit;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr char OUTPUT[] = "/tmp/snapshot_test.mcap";
+constexpr char FIRST_FILE[] = "/tmp/snapshot_test_000.mcap";
+
+/// Log times of the messages on @p topic, in file order.
+std::vector<uint64_t> read_times(const std::string& path, const std::string& topic) {
+    internal::McapReader reader(path);
+    uint16_t channel_id = 0;
+    for (const auto& channel : reader.channels()) {
+        if (channel.topic == topic) {
+            channel_id = channel.id;
+        }
+    }
+    std::vector<uint64_t> times;
+    std::vector<uint8_t> records;
+    for (const auto& chunk : reader.chunks()) {
+        reader.decompress(chunk, records);
+        internal::McapReader::for_each_message(records.data(), records.size(), [&](const internal::McapMessage& msg) {
+            if (msg.channel_id == channel_id) {
+                times.push_back(msg.log_time);
+            }
+        });
+    }
+    return times;
+}
+
+bool wait_for_snapshots(const Snapshot& snapshot, uint64_t count) {
+    for (int i = 0; i < 300 && snapshot.snapshot_count() < count; ++i) {
+        std::this_thread::sleep_for(10ms);
+    }
+    return snapshot.snapshot_count() >= count;
+}
+
+}  // namespace
+
+class SnapshotTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        internal::ShmRegion::unlink("snapshot_data");
+        internal::ShmRegion::unlink("snapshot_fault");
+        std::remove(FIRST_FILE);
+        std::remove("/tmp/snapshot_test_001.mcap");
+    }
+};
+
+TEST_F(SnapshotTest, test_trigger_writes_window) {
+    internal::Publisher pub("snapshot_data");
+
+    SnapshotOptions options;
+    options.pre_trigger = 200ms;
+    options.post_trigger = 100ms;
+    Snapshot snapshot(OUTPUT, options);
+    snapshot.add_topic("snapshot_data");
+    snapshot.start();
+
+    std::vector<uint8_t> payload(100);
+    for (int i = 0; i < 50; ++i) {
+        pub.publish(payload.data(), payload.size());
+        std::this_thread::sleep_for(10ms);
+    }
+    uint64_t trigger_ns = internal::get_timestamp_ns();
+    snapshot.trigger(trigger_ns);
+    for (int i = 0; i < 20; ++i) {
+        pub.publish(payload.data(), payload.size());
+        std::this_thread::sleep_for(10ms);
+    }
+
+    ASSERT_TRUE(wait_for_snapshots(snapshot, 1));
+    snapshot.stop();
+    EXPECT_EQ(snapshot.last_snapshot(), FIRST_FILE);
+
+    // Only the window, with messages on both sides of the trigger
+    auto times = read_times(FIRST_FILE, "snapshot_data");
+    ASSERT_FALSE(times.empty());
+    EXPECT_GE(times.front(), trigger_ns - 200'000'000);
+    EXPECT_LE(times.back(), trigger_ns + 100'000'000);
+    EXPECT_LT(times.front(), trigger_ns);
+    EXPECT_GT(times.back(), trigger_ns);
+    EXPECT_LT(times.size(), 70u);
+    EXPECT_EQ(snapshot.stats().messages, times.size());
+    EXPECT_EQ(snapshot.stats().overwritten, 0u);
+}
+
+TEST_F(SnapshotTest, test_trigger_topic) {
+    internal::Publisher pub("snapshot_data");
+    internal::Publisher fault("snapshot_fault");
+
+    SnapshotOptions options;
+    options.pre_trigger = 1s;
+    options.post_trigger = 10ms;
+    options.trigger_topic = "snapshot_fault";
+    Snapshot snapshot(OUTPUT, options);
+    snapshot.add_topic("snapshot_data");
+    snapshot.start();
+
+    std::vector<uint8_t> payload(100);
+    for (int i = 0; i < 10; ++i) {
+        pub.publish(payload.data(), payload.size());
+    }
+    std::this_thread::sleep_for(10ms);
+    fault.publish(payload.data(), 1);
+
+    ASSERT_TRUE(wait_for_snapshots(snapshot, 1));
+    snapshot.stop();
+    EXPECT_EQ(snapshot.stats().triggers, 1u);
+    EXPECT_EQ(read_times(FIRST_FILE, "snapshot_data").size(), 10u);
+}
+
+TEST_F(SnapshotTest, test_stop_writes_pending_snapshot) {
+    internal::Publisher pub("snapshot_data");
+
+    SnapshotOptions options;
+    options.post_trigger = 60s;
+    Snapshot snapshot(OUTPUT, options);
+    snapshot.add_topic("snapshot_data");
+    snapshot.start();
+
+    std::vector<uint8_t> payload(100);
+    pub.publish(payload.data(), payload.size());
+    std::this_thread::sleep_for(10ms);
+    snapshot.trigger();
+    snapshot.stop();
+
+    EXPECT_EQ(snapshot.snapshot_count(), 1u);
+    EXPECT_EQ(read_times(FIRST_FILE, "snapshot_data").size(), 1u);
+}
+
+TEST_F(SnapshotTest, test_no_trigger_no_file) {
+    internal::Publisher pub("snapshot_data");
+
+    Snapshot snapshot(OUTPUT);
+    snapshot.add_topic("snapshot_data");
+    snapshot.start();
+    std::vector<uint8_t> payload(100);
+    pub.publish(payload.data(), payload.size());
+    std::this_thread::sleep_for(10ms);
+    EXPECT_GT(snapshot.stats().buffered_bytes, 0u);
+    snapshot.stop();
+
+    EXPECT_EQ(snapshot.snapshot_count(), 0u);
+    EXPECT_FALSE(std::fopen(FIRST_FILE, "r"));
+}
+
+TEST_F(SnapshotTest, test_history_sizes_must_fit_budget) {
+    SnapshotOptions options;
+    options.memory_budget = 1024 * 1024;
+    Snapshot snapshot(OUTPUT, options);
+    snapshot.add_topic("snapshot_data", 2 * 1024 * 1024);
+    EXPECT_THROW(snapshot.start(), TankError);
+}
@@ -0,0 +1,118 @@
+#include "conduit_tank/internal/staging_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace conduit::internal;
+
+TEST(StagingQueueTest, test_push_pop_in_order) {
+    StagingQueue queue(1024);
+    EXPECT_EQ(queue.front(), nullptr);
+
+    for (uint64_t i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.push(100 + i, i, &i, sizeof(i)));
+    }
+    for (uint64_t i = 0; i < 5; ++i) {
+        const StagedMessage* msg = queue.front();
+        ASSERT_NE(msg, nullptr);
+        EXPECT_EQ(msg->timestamp_ns, 100 + i);
+        EXPECT_EQ(msg->sequence, i);
+        ASSERT_EQ(msg->size, sizeof(uint64_t));
+        uint64_t value;
+        std::memcpy(&value, msg->data(), sizeof(value));
+        EXPECT_EQ(value, i);
+        queue.pop();
+    }
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(StagingQueueTest, test_full_queue_rejects) {
+    StagingQueue queue(256);
+    std::vector<uint8_t> payload(90);  // 128 bytes per record with header
+
+    EXPECT_TRUE(queue.push(1, 0, payload.data(), payload.size()));
+    EXPECT_TRUE(queue.push(2, 1, payload.data(), payload.size()));
+    EXPECT_FALSE(queue.push(3, 2, payload.data(), payload.size()));
+
+    queue.pop();
+    EXPECT_TRUE(queue.push(3, 2, payload.data(), payload.size()));
+
+    std::vector<uint8_t> too_large(300);
+    EXPECT_FALSE(queue.push(4, 3, too_large.data(), too_large.size()));
+}
+
+TEST(StagingQueueTest, test_wraps_without_splitting) {
+    StagingQueue queue(256);
+    std::vector<uint8_t> payload(60, 0xab);  // 96 bytes per record
+
+    // 96 + 96 = 192: the third record does not fit in the last 64 bytes
+    for (uint64_t i = 0; i < 20; ++i) {
+        ASSERT_TRUE(queue.push(i, i, payload.data(), payload.size()));
+        ASSERT_TRUE(queue.push(i, i, payload.data(), payload.size()));
+        for (int j = 0; j < 2; ++j) {
+            const StagedMessage* msg = queue.front();
+            ASSERT_NE(msg, nullptr);
+            EXPECT_EQ(msg->sequence, i);
+            ASSERT_EQ(msg->size, payload.size());
+            EXPECT_EQ(std::memcmp(msg->data(), payload.data(), payload.size()), 0);
+            queue.pop();
+        }
+    }
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(StagingQueueTest, test_wrap_then_large_record) {
+    StagingQueue queue(4096);
+    std::vector<uint8_t> half(2048 - sizeof(StagedMessage));
+    ASSERT_TRUE(queue.push(1, 0, half.data(), half.size()));
+    queue.front();
+    queue.pop();
+
+    // Tail at 2048: the record fits neither before the end nor beside the filler
+    std::vector<uint8_t> large(2560, 0xcd);
+    EXPECT_FALSE(queue.push(2, 1, large.data(), large.size()));
+    EXPECT_EQ(queue.front(), nullptr);
+    ASSERT_TRUE(queue.push(2, 1, large.data(), large.size()));
+
+    const StagedMessage* msg = queue.front();
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->sequence, 1u);
+    ASSERT_EQ(msg->size, large.size());
+    EXPECT_EQ(std::memcmp(msg->data(), large.data(), large.size()), 0);
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(StagingQueueTest, test_concurrent_producer_consumer) {
+    constexpr uint64_t COUNT = 200000;
+    StagingQueue queue(4096);
+
+    std::thread producer([&queue] {
+        for (uint64_t i = 0; i < COUNT;) {
+            // Vary the size so records wrap at different offsets
+            std::vector<uint64_t> payload(1 + i % 7, i);
+            if (queue.push(i, i, payload.data(), payload.size() * sizeof(uint64_t))) {
+                ++i;
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    while (expected < COUNT) {
+        const StagedMessage* msg = queue.front();
+        if (msg == nullptr) {
+            continue;
+        }
+        ASSERT_EQ(msg->sequence, expected);
+        ASSERT_EQ(msg->size, (1 + expected % 7) * sizeof(uint64_t));
+        uint64_t last;
+        std::memcpy(&last, static_cast<const uint8_t*>(msg->data()) + msg->size - sizeof(last), sizeof(last));
+        ASSERT_EQ(last, expected);
+        queue.pop();
+        ++expected;
+    }
+    producer.join();
+}
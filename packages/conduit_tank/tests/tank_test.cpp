@@ -1,13 +1,19 @@
 #include "conduit_tank/tank.hpp"
+#include "conduit_tank/internal/mcap_reader.hpp"
 #include <conduit_core/publisher.hpp>
 #include <conduit_core/exceptions.hpp>
 #include <conduit_core/internal/shm_region.hpp>
 
 #include <gtest/gtest.h>
 
+#include <sys/wait.h>  // waitpid
+#include <unistd.h>    // fork, _exit
+
 #include <chrono>
 #include <cstdio>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace conduit;
 using namespace std::chrono_literals;
@@ -32,6 +38,23 @@ protected:
         }
         return false;
     }
+
+    /// Sequence numbers of the messages on channel 1, in file order.
+    std::vector<uint32_t> read_sequences(const std::string& path) {
+        internal::McapReader reader(path);
+        std::vector<uint32_t> sequences;
+        std::vector<uint8_t> records;
+        for (const auto& chunk : reader.chunks()) {
+            reader.decompress(chunk, records);
+            internal::McapReader::for_each_message(records.data(), records.size(),
+                                                   [&](const internal::McapMessage& msg) {
+                if (msg.channel_id == 1) {
+                    sequences.push_back(msg.sequence);
+                }
+            });
+        }
+        return sequences;
+    }
 };
 
 TEST_F(TankTest, test_tank_basic) {
@@ -150,3 +173,257 @@ TEST_F(TankTest, test_tank_stop_idempotent) {
 
     std::remove(output_path.c_str());
 }
+
+TEST_F(TankTest, test_tank_records_all_in_order) {
+    const std::string output_path = "/tmp/test_order.mcap";
+
+    internal::Publisher pub_a("topic_a");
+    internal::Publisher pub_b("topic_b");
+
+    Tank tank(output_path);
+    tank.add_topic("topic_a");
+    tank.add_topic("topic_b");
+    tank.start();
+
+    for (int i = 0; i < 100; ++i) {
+        pub_a.publish(&i, sizeof(i));
+        pub_b.publish(&i, sizeof(i));
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(50ms);
+    tank.stop();
+
+    EXPECT_EQ(tank.message_count(), 200u);
+    EXPECT_EQ(tank.dropped_count(), 0u);
+
+    std::remove(output_path.c_str());
+}
+
+TEST_F(TankTest, test_tank_counts_staging_drops) {
+    const std::string output_path = "/tmp/test_drops.mcap";
+
+    internal::Publisher pub("topic");
+
+    // Staging too small for any of the messages: all of them are dropped
+    TankOptions options;
+    options.staging_size = 64;
+    Tank tank(output_path, options);
+    tank.add_topic("topic");
+    tank.start();
+
+    std::vector<uint8_t> payload(200);
+    for (int i = 0; i < 10; ++i) {
+        pub.publish(payload.data(), payload.size());
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(50ms);
+    tank.stop();
+
+    EXPECT_EQ(tank.message_count(), 0u);
+    EXPECT_EQ(tank.dropped_count(), 10u);
+
+    std::remove(output_path.c_str());
+}
+
+TEST_F(TankTest, test_tank_writes_gap_marker) {
+    const std::string output_path = "/tmp/test_gaps.mcap";
+
+    internal::Publisher pub("topic");
+
+    TankOptions options;
+    options.staging_size = 512;
+    Tank tank(output_path, options);
+    tank.add_topic("topic");
+    tank.start();
+
+    // Too large for the staging queue: dropped, then marked before the next message
+    std::vector<uint8_t> large(1000);
+    pub.publish(large.data(), large.size());
+    std::this_thread::sleep_for(10ms);
+    int small = 1;
+    pub.publish(&small, sizeof(small));
+    std::this_thread::sleep_for(50ms);
+    tank.stop();
+
+    TankStats stats = tank.stats();
+    EXPECT_EQ(stats.messages, 1u);
+    EXPECT_EQ(stats.dropped, 1u);
+    EXPECT_EQ(stats.gaps, 1u);
+
+    std::remove(output_path.c_str());
+}
+
+TEST_F(TankTest, test_tank_lossless_burst) {
+    const std::string output_path = "/tmp/test_lossless.mcap";
+
+    PublisherOptions pub_options;
+    pub_options.depth = 16;
+    internal::Publisher pub("topic", pub_options);
+
+    // A burst far larger than the ring and the staging queue
+    TankOptions options;
+    options.staging_size = 4096;
+    options.lossless = true;
+    options.block_timeout = 5s;
+    Tank tank(output_path, options);
+    tank.add_topic("topic");
+    tank.start();
+
+    std::vector<uint8_t> payload(100);
+    for (int i = 0; i < 2000; ++i) {
+        pub.publish(payload.data(), payload.size());
+    }
+    std::this_thread::sleep_for(100ms);
+    tank.stop();
+
+    TankStats stats = tank.stats();
+    EXPECT_EQ(stats.messages, 2000u);
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.gaps, 0u);
+
+    std::remove(output_path.c_str());
+}
+
+TEST_F(TankTest, test_tank_writes_index_on_stop) {
+    const std::string output_path = "/tmp/test_index.mcap";
+
+    internal::Publisher pub("topic");
+
+    TankOptions options;
+    options.chunk_size = 1024;  // Several chunks
+    Tank tank(output_path, options);
+    tank.add_topic("topic");
+    tank.start();
+
+    std::vector<uint8_t> payload(100);
+    for (int i = 0; i < 100; ++i) {
+        pub.publish(payload.data(), payload.size());
+        std::this_thread::sleep_for(100us);
+    }
+    std::this_thread::sleep_for(50ms);
+    tank.stop();
+
+    // Summary with a chunk index per chunk, each pointing at a message index
+    internal::McapReader reader(output_path);
+    EXPECT_TRUE(reader.indexed());
+    ASSERT_GT(reader.chunks().size(), 1u);
+    std::vector<std::pair<uint64_t, uint64_t>> entries;
+    size_t indexed_messages = 0;
+    for (const auto& chunk : reader.chunks()) {
+        EXPECT_TRUE(reader.message_index(chunk, 1, entries));
+        indexed_messages += entries.size();
+    }
+    EXPECT_EQ(indexed_messages, 100u);
+
+    std::remove(output_path.c_str());
+}
+
+TEST_F(TankTest, test_tank_split_by_size) {
+    const std::string output_path = "/tmp/test_split.mcap";
+
+    internal::Publisher pub("topic");
+
+    TankOptions options;
+    options.compression = Compression::None;  // Zeros would compress to nothing
+    options.chunk_size = 1024;
+    options.split_size = 4096;
+    Tank tank(output_path, options);
+    tank.add_topic("topic");
+    tank.start();
+
+    std::vector<uint8_t> payload(100);
+    for (int i = 0; i < 300; ++i) {
+        pub.publish(payload.data(), payload.size());
+        std::this_thread::sleep_for(100us);
+    }
+    std::this_thread::sleep_for(50ms);
+    tank.stop();
+
+    // Every file is complete; together they hold each message once, in order
+    uint32_t files = tank.stats().files;
+    ASSERT_GT(files, 2u);
+    std::vector<uint32_t> sequences;
+    for (uint32_t i = 0; i < files; ++i) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/tmp/test_split_%03u.mcap", i);
+        EXPECT_TRUE(internal::McapReader(path).indexed());
+        auto file_sequences = read_sequences(path);
+        sequences.insert(sequences.end(), file_sequences.begin(), file_sequences.end());
+        std::remove(path);
+    }
+    ASSERT_EQ(sequences.size(), 300u);
+    for (size_t i = 1; i < sequences.size(); ++i) {
+        EXPECT_EQ(sequences[i], sequences[i - 1] + 1);
+    }
+    EXPECT_FALSE(file_exists(output_path));
+}
+
+TEST_F(TankTest, test_tank_max_files_keeps_newest) {
+    internal::Publisher pub("topic");
+
+    TankOptions options;
+    options.compression = Compression::None;  // Zeros would compress to nothing
+    options.chunk_size = 1024;
+    options.split_size = 4096;
+    options.max_files = 2;
+    Tank tank("/tmp/test_ring.mcap", options);
+    tank.add_topic("topic");
+    tank.start();
+
+    std::vector<uint8_t> payload(100);
+    for (int i = 0; i < 300; ++i) {
+        pub.publish(payload.data(), payload.size());
+        std::this_thread::sleep_for(100us);
+    }
+    std::this_thread::sleep_for(50ms);
+    tank.stop();
+
+    uint32_t files = tank.stats().files;
+    ASSERT_GT(files, 3u);
+    for (uint32_t i = 0; i < files; ++i) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/tmp/test_ring_%03u.mcap", i);
+        EXPECT_EQ(file_exists(path), i + 2 >= files) << path;
+        std::remove(path);
+    }
+}
+
+TEST_F(TankTest, test_tank_max_files_needs_split) {
+    TankOptions options;
+    options.max_files = 3;
+    Tank tank("/tmp/test_ring.mcap", options);
+    tank.add_topic("topic");
+    EXPECT_THROW(tank.start(), TankError);
+}
+
+TEST_F(TankTest, test_tank_flushed_messages_survive_crash) {
+    const std::string output_path = "/tmp/test_crash.mcap";
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // Killed mid-recording: no stop(), no summary
+        internal::Publisher pub("topic");
+        TankOptions options;
+        options.flush_interval = 20ms;
+        Tank tank(output_path, options);
+        tank.add_topic("topic");
+        tank.start();
+
+        std::vector<uint8_t> payload(100);
+        for (int i = 0; i < 50; ++i) {
+            pub.publish(payload.data(), payload.size());
+            std::this_thread::sleep_for(100us);
+        }
+        std::this_thread::sleep_for(300ms);
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+
+    EXPECT_FALSE(internal::McapReader(output_path).indexed());
+    EXPECT_EQ(read_sequences(output_path).size(), 50u);
+
+    std::remove(output_path.c_str());
+}
@@ -4,7 +4,7 @@ _conduit() {
     cur="${COMP_WORDS[COMP_CWORD]}"
     prev="${COMP_WORDS[COMP_CWORD-1]}"
 
-    commands="topics info echo hz record flow"
+    commands="topics info echo hz record play slice snapshot flow"
 
     if [[ ${COMP_CWORD} -eq 1 ]]; then
         COMPREPLY=($(compgen -W "${commands}" -- "${cur}"))
@@ -19,6 +19,11 @@ _conduit() {
                 COMPREPLY=($(compgen -W "${flows}" -- "${cur}"))
             fi
             ;;
+        play|slice)
+            if [[ ${COMP_CWORD} -eq 2 ]]; then
+                COMPREPLY=($(compgen -f -X '!*.mcap' -- "${cur}"))
+            fi
+            ;;
         info|echo|hz)
             if [[ ${COMP_CWORD} -eq 2 ]]; then
                 local topics
@@ -7,6 +7,9 @@ int cmd_info(int argc, char** argv);
 int cmd_echo(int argc, char** argv);
 int cmd_hz(int argc, char** argv);
 int cmd_record(int argc, char** argv);
+int cmd_play(int argc, char** argv);
+int cmd_slice(int argc, char** argv);
+int cmd_snapshot(int argc, char** argv);
 int cmd_flow(int argc, char** argv);
 
 }  // namespace conduit::tools
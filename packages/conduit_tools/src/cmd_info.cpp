@@ -1,11 +1,37 @@
 #include "conduit_tools/commands.hpp"
+#include <conduit_core/internal/buffer_pool.hpp>
+#include <conduit_core/internal/numa.hpp>
 #include <conduit_core/internal/ring_buffer.hpp>
 #include <conduit_core/internal/shm_region.hpp>
+#include <conduit_core/internal/time.hpp>
+#include <conduit_core/exceptions.hpp>
 #include <conduit_core/log.hpp>
+#include <conduit_core/publisher.hpp>
+#include <cstring>
+#include <ctime>
 #include <string>
 
 namespace conduit::tools {
 
+static const char* numa_policy_name(uint32_t policy) {
+    switch (static_cast<NumaPolicy>(policy)) {
+        case NumaPolicy::FirstTouch: return "first touch";
+        case NumaPolicy::Node: return "node";
+        case NumaPolicy::NearPublisher: return "near publisher";
+        case NumaPolicy::NearSubscribers: return "near subscribers";
+    }
+    return "unknown";
+}
+
+static std::string format_time(uint64_t realtime_ns) {
+    std::time_t seconds = static_cast<std::time_t>(realtime_ns / 1'000'000'000);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+    return text;
+}
+
 int cmd_info(int argc, char** argv) {
     if (argc < 2) {
         log::error("Usage: conduit info <topic>");
@@ -22,17 +48,87 @@ int cmd_info(int argc, char** argv) {
     auto shm = internal::ShmRegion::open(topic);
     auto* header = static_cast<internal::RingBufferHeader*>(shm.data());
 
+    // Resized topic: the original ring names the current generation
+    uint32_t generation = header->next_generation.load(std::memory_order_acquire);
+    if (generation != 0) {
+        shm = internal::ShmRegion::open(internal::generation_name(topic, generation));
+        header = static_cast<internal::RingBufferHeader*>(shm.data());
+    }
+
     uint32_t mask = header->subscriber_mask.load(std::memory_order_acquire);
     int sub_count = __builtin_popcount(mask);
     uint64_t write_idx = header->write_idx.load(std::memory_order_acquire);
 
+    const internal::TopicInfo& info = header->info;
+    std::string type_name(info.type_name, strnlen(info.type_name, internal::TYPE_NAME_SIZE));
+    std::string publisher_name(info.publisher_name, strnlen(info.publisher_name, internal::PROCESS_NAME_SIZE));
+
     fmt::print("Topic:              {}\n", topic);
+    if (type_name.empty()) {
+        fmt::print("Type:               (untyped)\n");
+    } else {
+        fmt::print("Type:               {} (hash {:016x}, {} bytes)\n", type_name, info.type_hash,
+                   info.type_size > 0 ? std::to_string(info.type_size) : std::string("variable"));
+    }
+    fmt::print("Publisher:          {} (pid {})\n", publisher_name, info.publisher_pid);
+    fmt::print("Created:            {}\n", format_time(info.created_ns));
+    fmt::print("Generation:         {}\n", header->generation);
     fmt::print("Slot count:         {}\n", header->slot_count);
     fmt::print("Slot size:          {} bytes\n", header->slot_size);
+    if (header->overflow_capacity > 0) {
+        fmt::print("Overflow arena:     {} bytes\n", header->overflow_capacity);
+    }
+    if (header->pool_blocks > 0) {
+        try {
+            auto pool_shm = internal::ShmRegion::open(internal::pool_name(topic));
+            internal::BufferPool pool(pool_shm.data());
+            fmt::print("Buffer pool:        {} x {} bytes, {} free\n", pool.block_count(), pool.block_size(),
+                       pool.free_count());
+        } catch (const ShmError&) {
+            fmt::print("Buffer pool:        {} blocks (not accessible)\n", header->pool_blocks);
+        }
+    }
     fmt::print("Max subscribers:    {}\n", header->max_subscribers);
     fmt::print("Active subscribers: {}\n", sub_count);
     fmt::print("Messages published: {}\n", write_idx);
 
+    // Rates cover the writer's last completed window; a publisher that has
+    // gone quiet for longer than that is reported as idle
+    const internal::TopicStats& stats = header->stats;
+    uint64_t window_ns = stats.window_ns.load(std::memory_order_relaxed);
+    uint64_t last_write_ns = stats.last_write_ns.load(std::memory_order_relaxed);
+    double rate_hz = 0;
+    double bandwidth = 0;
+    if (window_ns > 0 && internal::get_timestamp_ns() - last_write_ns < 2 * internal::STATS_WINDOW_NS) {
+        double seconds = static_cast<double>(window_ns) / 1e9;
+        rate_hz = static_cast<double>(stats.window_messages.load(std::memory_order_relaxed)) / seconds;
+        bandwidth = static_cast<double>(stats.window_bytes.load(std::memory_order_relaxed)) / seconds;
+    }
+    fmt::print("Bytes published:    {}\n", stats.bytes_written.load(std::memory_order_relaxed));
+    fmt::print("Rate:               {:.1f} Hz\n", rate_hz);
+    fmt::print("Bandwidth:          {:.2f} MB/s\n", bandwidth / 1e6);
+
+    // Lag: messages published but not yet read, per reader slot
+    for (uint32_t bits = mask; bits != 0; bits &= bits - 1) {
+        int slot = __builtin_ctz(bits);
+        uint64_t read_idx = header->read_idx[slot].value.load(std::memory_order_acquire);
+        uint64_t lag = write_idx > read_idx ? write_idx - read_idx : 0;
+        fmt::print("  subscriber {:2}:    {} behind{}\n", slot, lag,
+                   lag > header->slot_count ? " (lapped)" : "");
+    }
+    fmt::print("Page size:          {} KB\n", shm.page_size() / 1024);
+    fmt::print("NUMA policy:        {}\n", numa_policy_name(header->numa_policy));
+
+    // Where the pages actually are (not allocated = never touched yet)
+    auto nodes = internal::numa_page_nodes(shm.data(), shm.size(), shm.page_size());
+    for (const auto& [node, pages] : nodes) {
+        if (node < 0) {
+            fmt::print("  not allocated:    {} pages\n", pages);
+        } else {
+            fmt::print("  node {}:           {} pages\n", node, pages);
+        }
+    }
+
     return 0;
 }
 
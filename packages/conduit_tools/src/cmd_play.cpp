@@ -0,0 +1,105 @@
+#include "conduit_tools/commands.hpp"
+#include <conduit_core/log.hpp>
+#include <conduit_tank/player.hpp>
+#include <csignal>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace conduit::tools {
+
+static Player* g_player = nullptr;
+
+static void signal_handler(int) {
+    if (g_player) g_player->stop();
+}
+
+static bool parse_rate(const std::string& text, double& rate) {
+    try {
+        size_t end = 0;
+        rate = std::stod(text, &end);
+        return end == text.size() && rate > 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+int cmd_play(int argc, char** argv) {
+    std::string input;
+    PlayerOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if ((arg == "-r" || arg == "--rate") && i + 1 < argc) {
+            if (!parse_rate(argv[++i], options.rate)) {
+                log::error("Invalid rate: {}", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--fast") {
+            options.rate = 0;
+        } else if (arg == "-h" || arg == "--help") {
+            fmt::print("Usage: conduit play <input.mcap> [options] [topic1] [topic2] ...\n");
+            fmt::print("  -r, --rate X  Playback speed (default 1.0 = recorded timing)\n");
+            fmt::print("      --fast    Publish as fast as possible\n");
+            return 0;
+        } else if (arg[0] != '-') {
+            if (input.empty()) {
+                input = arg;
+            } else {
+                options.topics.push_back(arg);
+            }
+        } else {
+            log::error("Unknown option: {}", arg);
+            return 1;
+        }
+    }
+
+    if (input.empty()) {
+        log::error("Input file required");
+        return 1;
+    }
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    try {
+        Player player(input, options);
+        g_player = &player;
+
+        for (const auto& topic : player.topics()) {
+            log::info("Playing topic: {}", topic);
+        }
+        log::info("Duration: {:.1f} s", std::chrono::duration<double>(player.duration()).count());
+
+        player.start();
+        int ticks = 0;
+        while (player.playing()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (++ticks % 10 == 0) {
+                log::info("Messages: {}", player.message_count());
+            }
+        }
+        player.wait();
+        g_player = nullptr;
+
+        PlayerStats stats = player.stats();
+        log::info("Done. Total: {}, {:.1f} MB published", stats.messages, stats.bytes / 1e6);
+        if (stats.failed > 0) {
+            log::warn("{} messages could not be published", stats.failed);
+        }
+        if (stats.max_lag > std::chrono::milliseconds(10)) {
+            log::warn("Playback fell behind the recorded timing by up to {} ms",
+                      std::chrono::duration_cast<std::chrono::milliseconds>(stats.max_lag).count());
+        }
+
+    } catch (const std::exception& e) {
+        log::error("Error: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
+
+}  // namespace conduit::tools
@@ -2,6 +2,7 @@
 #include <conduit_core/log.hpp>
 #include <conduit_tank/tank.hpp>
 #include <csignal>
+#include <exception>
 #include <string>
 #include <thread>
 #include <vector>
@@ -14,17 +15,99 @@ static void signal_handler(int) {
     if (g_tank) g_tank->stop();
 }
 
+static bool parse_compression(const std::string& name, Compression& compression) {
+    if (name == "zstd") {
+        compression = Compression::Zstd;
+    } else if (name == "lz4") {
+        compression = Compression::Lz4;
+    } else if (name == "none") {
+        compression = Compression::None;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool parse_int(const std::string& text, int& value) {
+    try {
+        size_t end = 0;
+        value = std::stoi(text, &end);
+        return end == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+static bool parse_positive(const std::string& text, double& value) {
+    try {
+        size_t end = 0;
+        value = std::stod(text, &end);
+        return end == text.size() && value > 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
 int cmd_record(int argc, char** argv) {
     std::string output;
     std::vector<std::string> topics;
+    TankOptions options;
 
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
 
         if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
             output = argv[++i];
+        } else if ((arg == "-c" || arg == "--compression") && i + 1 < argc) {
+            if (!parse_compression(argv[++i], options.compression)) {
+                log::error("Unknown compression: {} (zstd, lz4 or none)", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--level" && i + 1 < argc) {
+            if (!parse_int(argv[++i], options.compression_level)) {
+                log::error("Invalid compression level: {}", argv[i]);
+                return 1;
+            }
+        } else if ((arg == "-j" || arg == "--threads") && i + 1 < argc) {
+            int threads;
+            if (!parse_int(argv[++i], threads) || threads < 0) {
+                log::error("Invalid thread count: {}", argv[i]);
+                return 1;
+            }
+            options.compression_threads = static_cast<uint32_t>(threads);
+        } else if (arg == "--lossless") {
+            options.lossless = true;
+        } else if (arg == "--split-size" && i + 1 < argc) {
+            double megabytes;
+            if (!parse_positive(argv[++i], megabytes)) {
+                log::error("Invalid split size: {}", argv[i]);
+                return 1;
+            }
+            options.split_size = static_cast<uint64_t>(megabytes * 1e6);
+        } else if (arg == "--split-duration" && i + 1 < argc) {
+            double seconds;
+            if (!parse_positive(argv[++i], seconds)) {
+                log::error("Invalid split duration: {}", argv[i]);
+                return 1;
+            }
+            options.split_duration =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+        } else if (arg == "--max-files" && i + 1 < argc) {
+            int files;
+            if (!parse_int(argv[++i], files) || files < 2) {
+                log::error("Invalid file count: {} (at least 2)", argv[i]);
+                return 1;
+            }
+            options.max_files = static_cast<uint32_t>(files);
         } else if (arg == "-h" || arg == "--help") {
-            fmt::print("Usage: conduit record -o <output.mcap> <topic1> [topic2] ...\n");
+            fmt::print("Usage: conduit record -o <output.mcap> [options] <topic1> [topic2] ...\n");
+            fmt::print("  -c, --compression TYPE  zstd (default), lz4 or none\n");
+            fmt::print("      --level N           Compression level (default 1)\n");
+            fmt::print("  -j, --threads N         Compression threads (default 2, 0 = writer thread)\n");
+            fmt::print("      --lossless          Make publishers wait for the recorder instead of dropping\n");
+            fmt::print("      --split-size MB     Start a new file every MB megabytes\n");
+            fmt::print("      --split-duration S  Start a new file every S seconds\n");
+            fmt::print("      --max-files N       Keep only the newest N files (needs a split)\n");
             return 0;
         } else if (arg[0] != '-') {
             topics.push_back(arg);
@@ -44,11 +127,16 @@ int cmd_record(int argc, char** argv) {
         return 1;
     }
 
+    if (options.max_files > 0 && options.split_size == 0 && options.split_duration.count() == 0) {
+        log::error("--max-files needs --split-size or --split-duration");
+        return 1;
+    }
+
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
 
     try {
-        Tank tank(output);
+        Tank tank(output, options);
         g_tank = &tank;
 
         for (const auto& topic : topics) {
@@ -62,10 +150,21 @@ int cmd_record(int argc, char** argv) {
 
         while (tank.recording()) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
-            log::info("Messages: {}", tank.message_count());
+            log::info("Messages: {} (dropped {})", tank.message_count(), tank.dropped_count());
         }
 
-        log::info("Stopped. Total: {}", tank.message_count());
+        TankStats stats = tank.stats();
+        log::info("Stopped. Total: {}, dropped: {} ({} gaps marked), {:.1f} MB written", stats.messages,
+                  stats.dropped, stats.gaps, stats.bytes / 1e6);
+        if (stats.files > 1) {
+            log::info("Split into {} files{}", stats.files,
+                      options.max_files > 0 && stats.files > options.max_files
+                          ? fmt::format(", the newest {} kept", options.max_files) : std::string());
+        }
+        if (stats.max_io_wait > std::chrono::milliseconds(100)) {
+            log::warn("Disk too slow: the writer waited up to {} ms for I/O",
+                      std::chrono::duration_cast<std::chrono::milliseconds>(stats.max_io_wait).count());
+        }
 
     } catch (const std::exception& e) {
         log::error("Error: {}", e.what());
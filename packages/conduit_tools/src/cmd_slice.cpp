@@ -0,0 +1,96 @@
+#include "conduit_tools/commands.hpp"
+#include <conduit_core/log.hpp>
+#include <conduit_tank/slice.hpp>
+#include <chrono>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace conduit::tools {
+
+static bool parse_seconds(const std::string& text, std::chrono::nanoseconds& value) {
+    try {
+        size_t end = 0;
+        double seconds = std::stod(text, &end);
+        if (end != text.size() || seconds < 0) {
+            return false;
+        }
+        value = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+int cmd_slice(int argc, char** argv) {
+    std::string input;
+    std::string output;
+    SliceOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+        } else if ((arg == "-s" || arg == "--start") && i + 1 < argc) {
+            if (!parse_seconds(argv[++i], options.start)) {
+                log::error("Invalid start time: {}", argv[i]);
+                return 1;
+            }
+        } else if ((arg == "-e" || arg == "--end") && i + 1 < argc) {
+            if (!parse_seconds(argv[++i], options.end)) {
+                log::error("Invalid end time: {}", argv[i]);
+                return 1;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            fmt::print("Usage: conduit slice <input.mcap> -o <output.mcap> [options] [topic1] [topic2] ...\n");
+            fmt::print("  -s, --start SEC  Start, in seconds from the first message (default 0)\n");
+            fmt::print("  -e, --end SEC    End, in seconds from the first message (default: last)\n");
+            return 0;
+        } else if (arg[0] != '-') {
+            if (input.empty()) {
+                input = arg;
+            } else {
+                options.topics.push_back(arg);
+            }
+        } else {
+            log::error("Unknown option: {}", arg);
+            return 1;
+        }
+    }
+
+    if (input.empty()) {
+        log::error("Input file required");
+        return 1;
+    }
+
+    if (output.empty()) {
+        log::error("Output file required (-o)");
+        return 1;
+    }
+
+    if (options.end < options.start) {
+        log::error("End is before start");
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        SliceStats stats = slice(input, output, options);
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        log::info("Wrote {} messages to {} in {:.2f} s ({} of {} chunks read)", stats.messages, output, elapsed,
+                  stats.chunks_read, stats.chunks_total);
+        if (!stats.indexed) {
+            log::warn("{} has no index (recording not stopped cleanly?); scanned it instead", input);
+        }
+
+    } catch (const std::exception& e) {
+        log::error("Error: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
+
+}  // namespace conduit::tools
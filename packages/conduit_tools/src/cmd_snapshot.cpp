@@ -0,0 +1,168 @@
+#include "conduit_tools/commands.hpp"
+#include <conduit_core/log.hpp>
+#include <conduit_core/internal/time.hpp>
+#include <conduit_tank/snapshot.hpp>
+#include <unistd.h>  // getpid
+#include <atomic>
+#include <csignal>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace conduit::tools {
+
+static std::atomic<bool> g_stop{false};
+static std::atomic<uint64_t> g_trigger_ns{0};
+
+static void stop_handler(int) {
+    g_stop = true;
+}
+
+// Only notes the time: trigger() takes a lock, the main loop calls it
+static void trigger_handler(int) {
+    g_trigger_ns = internal::get_timestamp_ns();
+}
+
+static bool parse_seconds(const std::string& text, std::chrono::nanoseconds& value) {
+    try {
+        size_t end = 0;
+        double seconds = std::stod(text, &end);
+        if (end != text.size() || seconds < 0) {
+            return false;
+        }
+        value = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+static bool parse_megabytes(const std::string& text, size_t& bytes) {
+    try {
+        size_t end = 0;
+        double megabytes = std::stod(text, &end);
+        if (end != text.size() || megabytes <= 0) {
+            return false;
+        }
+        bytes = static_cast<size_t>(megabytes * 1024 * 1024);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+int cmd_snapshot(int argc, char** argv) {
+    std::string output;
+    std::vector<std::string> topics;
+    SnapshotOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--pre" && i + 1 < argc) {
+            if (!parse_seconds(argv[++i], options.pre_trigger)) {
+                log::error("Invalid time: {}", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--post" && i + 1 < argc) {
+            if (!parse_seconds(argv[++i], options.post_trigger)) {
+                log::error("Invalid time: {}", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--memory" && i + 1 < argc) {
+            if (!parse_megabytes(argv[++i], options.memory_budget)) {
+                log::error("Invalid memory budget: {}", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--trigger" && i + 1 < argc) {
+            options.trigger_topic = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            fmt::print("Usage: conduit snapshot -o <output.mcap> [options] <topic1> [topic2] ...\n");
+            fmt::print("  --pre SEC        History written before the trigger (default 10)\n");
+            fmt::print("  --post SEC       Time written after the trigger (default 2)\n");
+            fmt::print("  --memory MB      History memory for all topics (default 256)\n");
+            fmt::print("  --trigger TOPIC  Write a snapshot on every message of TOPIC\n");
+            fmt::print("SIGUSR1 also triggers a snapshot: kill -USR1 <pid>\n");
+            return 0;
+        } else if (arg[0] != '-') {
+            topics.push_back(arg);
+        } else {
+            log::error("Unknown option: {}", arg);
+            return 1;
+        }
+    }
+
+    if (output.empty()) {
+        log::error("Output file required (-o)");
+        return 1;
+    }
+
+    if (topics.empty()) {
+        log::error("At least one topic required");
+        return 1;
+    }
+
+    std::signal(SIGINT, stop_handler);
+    std::signal(SIGTERM, stop_handler);
+    std::signal(SIGUSR1, trigger_handler);
+
+    try {
+        Snapshot snapshot(output, options);
+        for (const auto& topic : topics) {
+            snapshot.add_topic(topic);
+            log::info("Keeping topic: {}", topic);
+        }
+
+        snapshot.start();
+        log::info("Keeping the last {:.1f} s in {} MB; trigger with {}kill -USR1 {}",
+                  std::chrono::duration<double>(options.pre_trigger).count(), options.memory_budget >> 20,
+                  options.trigger_topic.empty() ? "" : "topic " + options.trigger_topic + " or ", getpid());
+        log::info("Press Ctrl+C to stop.");
+
+        uint64_t written = 0;
+        bool warned = false;
+        auto next_check = std::chrono::steady_clock::now();
+        while (!g_stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            if (uint64_t trigger_ns = g_trigger_ns.exchange(0); trigger_ns != 0) {
+                log::info("Triggered, writing in {:.1f} s",
+                          std::chrono::duration<double>(options.post_trigger).count());
+                snapshot.trigger(trigger_ns);
+            }
+            if (snapshot.snapshot_count() > written) {
+                written = snapshot.snapshot_count();
+                log::info("Snapshot written: {}", snapshot.last_snapshot());
+            }
+
+            // Once a history is full, check that it covers the window
+            if (!warned && std::chrono::steady_clock::now() >= next_check) {
+                next_check += std::chrono::seconds(1);
+                SnapshotStats stats = snapshot.stats();
+                if (stats.history.count() > 0 && stats.history < options.pre_trigger + options.post_trigger) {
+                    log::warn("History holds only {:.1f} s of a topic, less than --pre + --post: raise --memory",
+                              std::chrono::duration<double>(stats.history).count());
+                    warned = true;
+                }
+            }
+        }
+
+        snapshot.stop();
+        SnapshotStats stats = snapshot.stats();
+        if (snapshot.snapshot_count() > written) {
+            log::info("Snapshot written: {}", snapshot.last_snapshot());
+        }
+        log::info("Stopped. Snapshots: {} ({} triggers), dropped: {}, overwritten before written: {}",
+                  stats.snapshots, stats.triggers, stats.dropped, stats.overwritten);
+
+    } catch (const std::exception& e) {
+        log::error("Error: {}", e.what());
+        return 1;
+    }
+
+    return 0;
+}
+
+}  // namespace conduit::tools
@@ -1,7 +1,12 @@
 #include "conduit_tools/commands.hpp"
+#include <conduit_core/internal/ring_buffer.hpp>
+#include <conduit_core/internal/shm_region.hpp>
 #include <conduit_core/log.hpp>
 #include <filesystem>
+#include <fstream>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -11,26 +16,54 @@ int cmd_topics(int argc, char** argv) {
     (void)argc;
     (void)argv;
 
-    const fs::path shm_dir = "/dev/shm";
     const std::string prefix = "conduit_";
+    const std::string service_prefix = "conduit_srv.";
 
-    if (!fs::exists(shm_dir)) {
-        fmt::print("No active topics.\n");
-        return 0;
+    // Huge page topics live on the hugetlbfs mount instead of /dev/shm
+    std::vector<fs::path> dirs = {"/dev/shm"};
+    std::string huge_dir = internal::ShmRegion::huge_page_dir();
+    if (!huge_dir.empty()) {
+        dirs.emplace_back(huge_dir);
+    }
+
+    std::set<std::string> topics;
+    for (const auto& dir : dirs) {
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            if (entry.is_regular_file()) {
+                std::string filename = entry.path().filename().string();
+                if (filename.rfind(prefix, 0) == 0 && filename.rfind(service_prefix, 0) != 0) {
+                    topics.insert(filename.substr(prefix.length()));
+                }
+            }
+        }
     }
 
-    bool found = false;
-    for (const auto& entry : fs::directory_iterator(shm_dir)) {
-        if (entry.is_regular_file()) {
-            std::string filename = entry.path().filename().string();
-            if (filename.rfind(prefix, 0) == 0) {
-                fmt::print("{}\n", filename.substr(prefix.length()));
-                found = true;
+    // Memfd topics have no file; their publishers listen on @conduit/{topic}
+    std::ifstream sockets("/proc/net/unix");
+    const std::string socket_prefix = "@conduit/";
+    std::string line;
+    while (std::getline(sockets, line)) {
+        auto pos = line.find(socket_prefix);
+        if (pos != std::string::npos) {
+            std::string name = line.substr(pos + socket_prefix.length());
+            if (name.rfind("srv.", 0) != 0) {
+                topics.insert(name);
             }
         }
     }
 
-    if (!found) {
+    // Later generations of a resized ring ("camera@2"), overflow arenas
+    // ("camera@overflow") and buffer pools ("camera@pool") belong to their topic
+    for (auto it = topics.begin(); it != topics.end();) {
+        it = it->find(internal::GENERATION_SEPARATOR) != std::string::npos ? topics.erase(it) : std::next(it);
+    }
+
+    for (const auto& topic : topics) {
+        fmt::print("{}\n", topic);
+    }
+
+    if (topics.empty()) {
         fmt::print("No active topics.\n");
     }
 
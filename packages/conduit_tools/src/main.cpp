@@ -13,12 +13,18 @@ void print_usage() {
     fmt::print("  echo <topic>       Print messages (hex)\n");
     fmt::print("  hz <topic>         Measure publish rate\n");
     fmt::print("  record             Record topics to MCAP\n");
+    fmt::print("  play <file>        Replay an MCAP recording\n");
+    fmt::print("  slice <file>       Cut a time range out of a recording\n");
+    fmt::print("  snapshot           Keep recent history, write it on a trigger\n");
     fmt::print("  flow <name>        Run a flow by name or path\n");
     fmt::print("\n");
     fmt::print("Examples:\n");
     fmt::print("  conduit topics\n");
     fmt::print("  conduit echo imu\n");
     fmt::print("  conduit record -o recording.mcap imu lidar\n");
+    fmt::print("  conduit play recording.mcap --rate 2\n");
+    fmt::print("  conduit slice recording.mcap -o fault.mcap -s 120 -e 150\n");
+    fmt::print("  conduit snapshot -o fault.mcap --trigger fault imu lidar\n");
     fmt::print("  conduit flow demo\n");
 }
 
@@ -39,6 +45,9 @@ int main(int argc, char** argv) {
     if (cmd == "echo")   return tools::cmd_echo(sub_argc, sub_argv);
     if (cmd == "hz")     return tools::cmd_hz(sub_argc, sub_argv);
     if (cmd == "record") return tools::cmd_record(sub_argc, sub_argv);
+    if (cmd == "play")   return tools::cmd_play(sub_argc, sub_argv);
+    if (cmd == "slice")  return tools::cmd_slice(sub_argc, sub_argv);
+    if (cmd == "snapshot") return tools::cmd_snapshot(sub_argc, sub_argv);
     if (cmd == "flow")   return tools::cmd_flow(sub_argc, sub_argv);
 
     if (cmd == "-h" || cmd == "--help" || cmd == "help") {